@@ -0,0 +1,27 @@
+# benchmark_git_commit(<var> <dir>): short hash of <dir>'s HEAD, suffixed "-dirty" for
+# uncommitted changes, or "unknown" outside a git checkout.
+function(benchmark_git_commit var dir)
+    execute_process(
+            COMMAND git rev-parse --short HEAD
+            WORKING_DIRECTORY ${dir}
+            OUTPUT_VARIABLE commit
+            OUTPUT_STRIP_TRAILING_WHITESPACE
+            ERROR_QUIET
+            RESULT_VARIABLE status
+    )
+    if(NOT status EQUAL 0 OR commit STREQUAL "")
+        set(${var} "unknown" PARENT_SCOPE)
+        return()
+    endif()
+
+    execute_process(
+            COMMAND git status --porcelain --untracked-files=no
+            WORKING_DIRECTORY ${dir}
+            OUTPUT_VARIABLE changes
+            ERROR_QUIET
+    )
+    if(NOT changes STREQUAL "")
+        string(APPEND commit "-dirty")
+    endif()
+    set(${var} ${commit} PARENT_SCOPE)
+endfunction()
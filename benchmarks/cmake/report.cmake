@@ -0,0 +1,26 @@
+cmake_minimum_required(VERSION 3.20)
+
+# Runs RUNNER and stores its JSON output as RESULTS_DIR/<commit>.json, plus a copy as
+# latest.json for benchmarks_compare. Repetitions are kept with their mean / median / stddev
+# aggregates so results from different commits can be compared with noise in view.
+
+include(${CMAKE_CURRENT_LIST_DIR}/commit.cmake)
+benchmark_git_commit(commit ${SOURCE_DIR})
+
+file(MAKE_DIRECTORY ${RESULTS_DIR})
+set(output ${RESULTS_DIR}/${commit}.json)
+
+execute_process(
+        COMMAND ${RUNNER}
+                --benchmark_filter=${FILTER}
+                --benchmark_repetitions=${REPETITIONS}
+                --benchmark_out=${output}
+                --benchmark_out_format=json
+        RESULT_VARIABLE status
+)
+if(NOT status EQUAL 0)
+    message(FATAL_ERROR "benchmarks_run failed (${status})")
+endif()
+
+configure_file(${output} ${RESULTS_DIR}/latest.json COPYONLY)
+message(STATUS "Benchmark results: ${output}")
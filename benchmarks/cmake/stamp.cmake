@@ -0,0 +1,9 @@
+cmake_minimum_required(VERSION 3.20)
+
+# Writes OUTPUT with SOURCE_DIR's commit. The file is only touched when the text changes, so
+# unchanged trees do not rebuild.
+
+include(${CMAKE_CURRENT_LIST_DIR}/commit.cmake)
+benchmark_git_commit(commit ${SOURCE_DIR})
+
+file(CONFIGURE OUTPUT ${OUTPUT} CONTENT "#pragma once\n\n#define BENCHMARK_GIT_COMMIT \"@commit@\"\n" @ONLY)
@@ -0,0 +1,19 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include "benchmark-commit.hpp"
+#include "datasets.hpp"
+
+// Extra keys for the "context" block of every report, so a results file says which code and
+// which dataset limits produced it.
+namespace
+{
+    const bool registered = []
+    {
+        benchmark::AddCustomContext("git_commit", BENCHMARK_GIT_COMMIT);
+        benchmark::AddCustomContext("max_bytes", std::to_string(datasets::max_bytes()));
+        benchmark::AddCustomContext("max_entities", std::to_string(datasets::max_entities()));
+        return true;
+    }();
+}
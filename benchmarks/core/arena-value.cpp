@@ -0,0 +1,56 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include "core/arena-value.hpp"
+#include "io/json-stream.hpp"
+
+namespace
+{
+    std::string make_records(std::size_t count)
+    {
+        std::string json = "[";
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            json += i ? "," : "";
+            json += "{\"id\":" + std::to_string(i) + ",\"name\":\"item " + std::to_string(i)
+                  + "\",\"pose\":{\"x\":1.5,\"y\":-2.25},\"tags\":[\"alpha\",\"beta\"]}";
+        }
+        return json + "]";
+    }
+}
+
+// parse and destroy a heap-allocated Value tree: one allocation per string, node and vector
+static void BM_Dom_ValueTree(benchmark::State& state)
+{
+    const auto json = make_records(static_cast<std::size_t>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        Value root;
+        JsonValueCollector collector("", [&](Value && value) { root = std::move(value); });
+        JsonStreamParser parser{ collector };
+        parser.feed(json);
+        parser.finish();
+        benchmark::DoNotOptimize(root);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(json.size()));
+}
+BENCHMARK(BM_Dom_ValueTree)->Arg(1 << 12);
+
+// the same document in an arena: a few block allocations, freed together
+static void BM_Dom_Arena(benchmark::State& state)
+{
+    const auto json = make_records(static_cast<std::size_t>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        ArenaDocument document;
+        document.parse(json);
+        benchmark::DoNotOptimize(document.root());
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(json.size()));
+}
+BENCHMARK(BM_Dom_Arena)->Arg(1 << 12);
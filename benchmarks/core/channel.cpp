@@ -0,0 +1,126 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "core/channel.hpp"
+
+namespace
+{
+    constexpr std::size_t transfer = 1 << 16;
+
+    template <typename Channel>
+    void push_all(Channel & channel, std::size_t count, std::size_t batch)
+    {
+        std::vector<std::uint64_t> values(batch);
+        std::size_t sent = 0;
+        while (sent < count)
+        {
+            const auto n = std::min(batch, count - sent);
+            std::span<const std::uint64_t> rest(values.data(), n);
+            while (!rest.empty())
+            {
+                const auto pushed = channel.push_n(rest);
+                rest = rest.subspan(pushed);
+                if (pushed == 0)
+                {
+                    std::this_thread::yield();
+                }
+            }
+            sent += n;
+        }
+    }
+
+    template <typename Channel>
+    void pop_all(Channel & channel, std::size_t count, std::size_t batch)
+    {
+        std::vector<std::uint64_t> values(batch);
+        std::size_t received = 0;
+        while (received < count)
+        {
+            const auto popped = channel.pop_n(std::span<std::uint64_t>(values.data(), std::min(batch, count - received)));
+            received += popped;
+            if (popped == 0)
+            {
+                std::this_thread::yield();
+            }
+        }
+        benchmark::DoNotOptimize(values.data());
+    }
+}
+
+// items through one producer/consumer pair; the argument is the batch size
+static void BM_SpscChannel_Throughput(benchmark::State& state)
+{
+    const auto batch = static_cast<std::size_t>(state.range(0));
+    SpscChannel<std::uint64_t> channel(1024);
+
+    for (auto _ : state)
+    {
+        std::thread producer([&] { push_all(channel, transfer, batch); });
+        pop_all(channel, transfer, batch);
+        producer.join();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * transfer));
+}
+BENCHMARK(BM_SpscChannel_Throughput)->Arg(1)->Arg(16)->Arg(256)->UseRealTime();
+
+// two producers and two consumers sharing one channel
+static void BM_MpmcChannel_Throughput(benchmark::State& state)
+{
+    const auto batch = static_cast<std::size_t>(state.range(0));
+    MpmcChannel<std::uint64_t> channel(1024);
+
+    for (auto _ : state)
+    {
+        std::thread producerA([&] { push_all(channel, transfer / 2, batch); });
+        std::thread producerB([&] { push_all(channel, transfer / 2, batch); });
+        std::thread consumer([&] { pop_all(channel, transfer / 2, batch); });
+        pop_all(channel, transfer / 2, batch);
+        producerA.join();
+        producerB.join();
+        consumer.join();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * transfer));
+}
+BENCHMARK(BM_MpmcChannel_Throughput)->Arg(1)->Arg(16)->UseRealTime();
+
+// ping-pong through two channels; one iteration is a full round trip
+static void BM_SpscChannel_RoundTrip(benchmark::State& state)
+{
+    SpscChannel<std::uint64_t> ping(16);
+    SpscChannel<std::uint64_t> pong(16);
+
+    std::thread echo([&] {
+        std::uint64_t value;
+        while (ping.pop_wait(value))
+        {
+            while (!pong.try_push(value))
+            {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    std::uint64_t value = 0;
+    for (auto _ : state)
+    {
+        while (!ping.try_push(value))
+        {
+            std::this_thread::yield();
+        }
+        while (!pong.try_pop(value))
+        {
+            std::this_thread::yield();
+        }
+        ++value;
+    }
+
+    ping.close();
+    echo.join();
+}
+BENCHMARK(BM_SpscChannel_RoundTrip)->UseRealTime();
@@ -0,0 +1,82 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "core/handle.hpp"
+#include "datasets.hpp"
+
+namespace
+{
+    // a register with `count` live handles, returned in shuffled order to defeat the prefetcher
+    std::vector<Handle> make_handles(HandleRegister & reg, std::size_t count)
+    {
+        reg.reserve(count, count);
+
+        std::vector<Handle> handles(count);
+        reg.insert(0, handles);
+
+        std::mt19937 rng(42);
+        std::shuffle(handles.begin(), handles.end(), rng);
+        return handles;
+    }
+}
+
+static void BM_HandleRegister_GetIndex(benchmark::State& state)
+{
+    HandleRegister reg;
+    const auto handles = make_handles(reg, static_cast<std::size_t>(state.range(0)));
+    std::vector<uint32_t> out(handles.size());
+
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < handles.size(); ++i)
+        {
+            out[i] = reg.get_index(handles[i]);
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_HandleRegister_GetIndex)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+
+static void BM_HandleRegister_Resolve(benchmark::State& state)
+{
+    HandleRegister reg;
+    const auto handles = make_handles(reg, static_cast<std::size_t>(state.range(0)));
+    std::vector<uint32_t> out(handles.size());
+
+    for (auto _ : state)
+    {
+        reg.resolve(handles, out);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_HandleRegister_Resolve)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+
+// erase + reinsert on a steady live set; handle_capacity stays flat however long it runs,
+// e.g. --benchmark_min_time=60s for ~10^8 operations
+static void BM_HandleRegister_Churn(benchmark::State& state)
+{
+    HandleRegister reg;
+    auto handles = make_handles(reg, static_cast<std::size_t>(state.range(0)));
+
+    std::size_t next = 0;
+    for (auto _ : state)
+    {
+        auto & h = handles[next];
+        const auto index = reg.get_index(h);
+        reg.erase(h);
+        h = reg.insert(index);
+        benchmark::DoNotOptimize(h);
+
+        next = next + 1 < handles.size() ? next + 1 : 0;
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    state.counters["handle_capacity"] = static_cast<double>(reg.handle_capacity());
+}
+BENCHMARK(BM_HandleRegister_Churn)->Apply(datasets::entity_counts);
@@ -0,0 +1,66 @@
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include "core/module-graph.hpp"
+#include "core/module.hpp"
+
+namespace
+{
+    // burns a fixed amount of CPU per step, standing in for input / simulation / output work
+    class BusyModule : public IModule
+    {
+    public:
+        explicit BusyModule(std::chrono::microseconds work)
+            : IModule(ExecutionMode::MAX_RATE)
+            , m_work(work)
+        { }
+
+    protected:
+        void step(std::chrono::duration<double>) override
+        {
+            const auto until = std::chrono::steady_clock::now() + m_work;
+            while (std::chrono::steady_clock::now() < until)
+            {
+            }
+        }
+
+    private:
+        std::chrono::microseconds m_work;
+    };
+}
+
+// input -> simulate -> output, 50us each; the argument is the number of frames in flight
+static void BM_ModuleGraph_Pipeline(benchmark::State& state)
+{
+    ThreadPool pool(3);
+    ModuleGraph graph(static_cast<std::size_t>(state.range(0)), pool);
+
+    std::vector<std::unique_ptr<BusyModule>> stages;
+    for (int i = 0; i < 3; ++i)
+    {
+        stages.push_back(std::make_unique<BusyModule>(std::chrono::microseconds(50)));
+        stages.back()->init();
+    }
+    graph.connect(*stages[0], *stages[1]);
+    graph.connect(*stages[1], *stages[2]);
+    for (auto & stage : stages)
+    {
+        stage->start();
+    }
+
+    constexpr std::uint64_t frames = 64;
+    for (auto _ : state)
+    {
+        graph.runFrames(frames);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(frames));
+
+    for (auto & stage : stages)
+    {
+        stage->stop();
+    }
+}
+BENCHMARK(BM_ModuleGraph_Pipeline)->Arg(1)->Arg(2)->Arg(3)->UseRealTime();
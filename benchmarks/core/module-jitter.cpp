@@ -0,0 +1,102 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "core/module-executor.hpp"
+#include "core/module.hpp"
+
+// FIXED_RATE scheduling quality rather than speed: each iteration runs the modules at 1 kHz for a
+// short window, and the counters report how late steps started against their deadlines.
+namespace
+{
+    constexpr double frequencyHz = 1000.0;
+    constexpr auto window = std::chrono::milliseconds(250);
+
+    // a light step, so the lateness measured is the scheduler's and not the work's
+    class TickModule : public IModule
+    {
+    public:
+        TickModule()
+            : IModule(ExecutionMode::FIXED_RATE, frequencyHz)
+        { }
+
+    protected:
+        void step(std::chrono::duration<double>) override
+        {
+            const auto until = std::chrono::steady_clock::now() + std::chrono::microseconds(20);
+            while (std::chrono::steady_clock::now() < until)
+            {
+            }
+        }
+    };
+
+    void run_window(benchmark::State & state, std::vector<std::unique_ptr<TickModule>> & modules)
+    {
+        double meanJitter = 0.0;
+        double maxJitter = 0.0;
+        double overruns = 0.0;
+        double achievedHz = 0.0;
+
+        for (auto _ : state)
+        {
+            for (auto & module : modules)
+            {
+                module->reset(); // STOPPED by the previous window, back to INITIALIZED
+                module->resetTimingStats();
+                module->start();
+            }
+            std::this_thread::sleep_for(window);
+            for (auto & module : modules)
+            {
+                module->stop();
+            }
+
+            for (const auto & module : modules)
+            {
+                const auto timing = module->timingStats();
+                meanJitter += std::chrono::duration<double, std::micro>(timing.meanJitter()).count();
+                maxJitter = std::max(maxJitter, std::chrono::duration<double, std::micro>(timing.maxJitter).count());
+                overruns += static_cast<double>(timing.overruns);
+                achievedHz += module->stepStats().achievedHz;
+            }
+        }
+
+        const auto samples = static_cast<double>(state.iterations() * static_cast<benchmark::IterationCount>(modules.size()));
+        state.counters["mean_jitter_us"] = meanJitter / samples;
+        state.counters["max_jitter_us"] = maxJitter;
+        state.counters["overruns"] = overruns / samples;
+        state.counters["achieved_hz"] = achievedHz / samples;
+    }
+}
+
+// one module on its own thread; the argument is the spin window in microseconds
+static void BM_FixedRate_DedicatedThread(benchmark::State& state)
+{
+    std::vector<std::unique_ptr<TickModule>> modules;
+    modules.push_back(std::make_unique<TickModule>());
+    modules.back()->setSpinWindow(std::chrono::microseconds(state.range(0)));
+    modules.back()->init();
+
+    run_window(state, modules);
+}
+BENCHMARK(BM_FixedRate_DedicatedThread)->ArgName("spin_us")->Arg(0)->Arg(200)->Iterations(4)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// several modules on a two-worker executor; the argument is the module count
+static void BM_FixedRate_SharedExecutor(benchmark::State& state)
+{
+    ModuleExecutor executor(2);
+    std::vector<std::unique_ptr<TickModule>> modules;
+    for (int64_t i = 0; i < state.range(0); ++i)
+    {
+        modules.push_back(std::make_unique<TickModule>());
+        modules.back()->setExecutor(&executor);
+        modules.back()->init();
+    }
+
+    run_window(state, modules);
+}
+BENCHMARK(BM_FixedRate_SharedExecutor)->ArgName("modules")->Arg(4)->Arg(16)->Iterations(4)->UseRealTime()->Unit(benchmark::kMillisecond);
@@ -0,0 +1,84 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include "core/shared-value.hpp"
+#include "datasets.hpp"
+
+// Snapshots of a document that is also being edited: a deep Value copy against a SharedValue
+// copy, and what one edit costs on either side. The edit touches a member halfway through the
+// document, `depth` objects down.
+
+namespace
+{
+    std::string edit_path(const Value & document, std::size_t depth)
+    {
+        std::string path = std::to_string(document.as<Value::array_t>().size() / 2);
+        for (std::size_t level = 1; level < depth; ++level)
+        {
+            path += "/child";
+        }
+        return path + "/score";
+    }
+}
+
+static void BM_Value_Snapshot(benchmark::State& state)
+{
+    const auto & document = datasets::document(static_cast<std::size_t>(state.range(0)), static_cast<std::size_t>(state.range(1)));
+
+    for (auto _ : state)
+    {
+        Value snapshot = document;
+        benchmark::DoNotOptimize(snapshot);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_Value_Snapshot)->Apply(datasets::document_sizes);
+
+static void BM_SharedValue_Snapshot(benchmark::State& state)
+{
+    const SharedValue document{ datasets::document(static_cast<std::size_t>(state.range(0)), static_cast<std::size_t>(state.range(1))) };
+
+    for (auto _ : state)
+    {
+        SharedValue snapshot = document;
+        benchmark::DoNotOptimize(snapshot);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_SharedValue_Snapshot)->Apply(datasets::document_sizes);
+
+// one edit after every snapshot, so each set() copies its path again
+static void BM_SharedValue_SnapshotThenSet(benchmark::State& state)
+{
+    const auto depth = static_cast<std::size_t>(state.range(1));
+    const auto & source = datasets::document(static_cast<std::size_t>(state.range(0)), depth);
+    const auto path = edit_path(source, depth);
+    SharedValue document{ source };
+
+    double score = 0.0;
+    for (auto _ : state)
+    {
+        const SharedValue snapshot = document;
+        document.set(path, Value{ score += 1.0 });
+        benchmark::DoNotOptimize(snapshot);
+    }
+}
+BENCHMARK(BM_SharedValue_SnapshotThenSet)->Apply(datasets::document_sizes);
+
+// the same edits with nothing sharing the tree: updated in place
+static void BM_SharedValue_SetUnshared(benchmark::State& state)
+{
+    const auto depth = static_cast<std::size_t>(state.range(1));
+    const auto & source = datasets::document(static_cast<std::size_t>(state.range(0)), depth);
+    const auto path = edit_path(source, depth);
+    SharedValue document{ source };
+
+    double score = 0.0;
+    for (auto _ : state)
+    {
+        document.set(path, Value{ score += 1.0 });
+    }
+    benchmark::DoNotOptimize(document);
+}
+BENCHMARK(BM_SharedValue_SetUnshared)->Apply(datasets::document_sizes);
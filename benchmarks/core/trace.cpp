@@ -0,0 +1,43 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+
+#include "core/histogram.hpp"
+#include "core/trace.hpp"
+
+static void BM_LatencyHistogram_Record(benchmark::State& state)
+{
+    LatencyHistogram histogram;
+    std::uint64_t value = 1;
+    for (auto _ : state)
+    {
+        histogram.record(value);
+        value = value * 6364136223846793005ull + 1442695040888963407ull;
+        value >>= 44;
+    }
+    benchmark::DoNotOptimize(histogram.count());
+}
+BENCHMARK(BM_LatencyHistogram_Record);
+
+static void BM_TraceScope(benchmark::State& state)
+{
+    const bool enabled = state.range(0) != 0;
+    trace::clear();
+    trace::set_enabled(enabled);
+    std::size_t n = 0;
+    for (auto _ : state)
+    {
+        trace::Scope scope("bench");
+        // keep the buffer from filling up so every iteration records
+        if (enabled && ++n == trace::thread_capacity)
+        {
+            state.PauseTiming();
+            trace::clear();
+            n = 0;
+            state.ResumeTiming();
+        }
+    }
+    trace::set_enabled(false);
+    trace::clear();
+}
+BENCHMARK(BM_TraceScope)->Arg(0)->Arg(1);
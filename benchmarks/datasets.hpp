@@ -0,0 +1,192 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include "core/value.hpp"
+#include "io/json-writer.hpp"
+
+// Generated inputs shared by the benchmarks. Every dataset is a pure function of its arguments,
+// so runs on different commits measure the same bytes.
+//
+// The size ladders stop at BENCHMARK_MAX_BYTES (default 64M) and BENCHMARK_MAX_ENTITIES
+// (default 1M) to keep a plain `benchmarks_run` short; both take K / M / G suffixes, e.g.
+// BENCHMARK_MAX_BYTES=1G BENCHMARK_MAX_ENTITIES=10M for the full 1 KB .. 1 GB and 10M-entity runs.
+namespace datasets
+{
+    inline std::size_t env_limit(const char * name, std::size_t fallback)
+    {
+        const char * text = std::getenv(name);
+        if (text == nullptr || *text == '\0')
+        {
+            return fallback;
+        }
+
+        char * end = nullptr;
+        auto value = static_cast<std::size_t>(std::strtoull(text, &end, 10));
+        switch (end != nullptr ? *end : '\0')
+        {
+        case 'G': case 'g': value <<= 10; [[fallthrough]];
+        case 'M': case 'm': value <<= 10; [[fallthrough]];
+        case 'K': case 'k': value <<= 10; break;
+        default: break;
+        }
+        return value;
+    }
+
+    inline std::size_t max_bytes()
+    {
+        static const auto limit = env_limit("BENCHMARK_MAX_BYTES", std::size_t{ 64 } << 20);
+        return limit;
+    }
+
+    inline std::size_t max_entities()
+    {
+        static const auto limit = env_limit("BENCHMARK_MAX_ENTITIES", std::size_t{ 1 } << 20);
+        return limit;
+    }
+
+    // --- Argument ladders, for ->Apply() ---
+
+    // {bytes, depth}: 1 KB to 1 GB of JSON, records nested 1, 4 and 16 objects deep
+    inline void document_sizes(benchmark::internal::Benchmark * b)
+    {
+        b->ArgNames({ "bytes", "depth" });
+        for (const std::int64_t bytes : { std::int64_t{ 1 } << 10, std::int64_t{ 64 } << 10, std::int64_t{ 4 } << 20,
+                                          std::int64_t{ 64 } << 20, std::int64_t{ 1 } << 30 })
+        {
+            if (static_cast<std::size_t>(bytes) > max_bytes())
+            {
+                continue;
+            }
+            for (const std::int64_t depth : { 1, 4, 16 })
+            {
+                b->Args({ bytes, depth });
+            }
+        }
+    }
+
+    // element counts from 1K to 10M
+    inline void entity_counts(benchmark::internal::Benchmark * b)
+    {
+        b->ArgNames({ "entities" });
+        for (const std::int64_t count : { std::int64_t{ 1 } << 10, std::int64_t{ 1 } << 16, std::int64_t{ 1 } << 20, std::int64_t{ 10'000'000 } })
+        {
+            if (static_cast<std::size_t>(count) <= max_entities())
+            {
+                b->Arg(count);
+            }
+        }
+    }
+
+    // --- Documents ---
+
+    namespace detail
+    {
+        // one record: an object with a counter, a name, a score, tags, a position and, below
+        // depth 1, a nested child record
+        inline Value make_record(std::uint32_t id, std::size_t depth)
+        {
+            auto record = Value::object_t{ };
+            record.emplace("id", Value{ id });
+            record.emplace("name", Value{ "entity " + std::to_string(id) });
+            record.emplace("score", Value{ static_cast<double>(id % 1000) / 8.0 });
+            record.emplace("tags", Value{ Value::array_t{ Value{ std::string{ "alpha" } }, Value{ std::string{ "beta" } } } });
+            record.emplace("position", Value{ Value::array_t{ Value{ static_cast<float>(id) * 0.5f }, Value{ 1.25f }, Value{ -2.0f } } });
+            if (depth > 1)
+            {
+                record.emplace("child", make_record(id * 31u + 7u, depth - 1));
+            }
+            return Value{ std::move(record) };
+        }
+
+        inline void append_record(std::string & out, std::uint32_t id, std::size_t depth)
+        {
+            out += R"({"id":)";
+            out += std::to_string(id);
+            out += R"(,"name":"entity )";
+            out += std::to_string(id);
+            out += R"(","score":)";
+            out += std::to_string(static_cast<double>(id % 1000) / 8.0);
+            out += R"(,"tags":["alpha","beta"],"position":[)";
+            out += std::to_string(static_cast<float>(id) * 0.5f);
+            out += R"(,1.25,-2.0])";
+            if (depth > 1)
+            {
+                out += R"(,"child":)";
+                append_record(out, id * 31u + 7u, depth - 1);
+            }
+            out += '}';
+        }
+
+        template <typename Make>
+        const auto & cached(std::size_t bytes, std::size_t depth, Make && make)
+        {
+            using result_type = std::decay_t<decltype(make())>;
+            static std::mutex mutex;
+            static std::map<std::pair<std::size_t, std::size_t>, result_type> cache;
+
+            const std::lock_guard lock{ mutex };
+            auto it = cache.find({ bytes, depth });
+            if (it == cache.end())
+            {
+                // one large input at a time: a 1 GB text and its tree do not have to coexist
+                // with every smaller entry
+                if (bytes >= (std::size_t{ 64 } << 20))
+                {
+                    cache.clear();
+                }
+                it = cache.emplace(std::pair{ bytes, depth }, make()).first;
+            }
+            return it->second;
+        }
+    }
+
+    // An array of records whose Value JSON (Value::write_json) is about `bytes` long.
+    inline const Value & document(std::size_t bytes, std::size_t depth)
+    {
+        return detail::cached(bytes, depth, [&]
+        {
+            JsonWriter writer;
+            writer.write(detail::make_record(0, depth));
+            const auto per_record = std::max<std::size_t>(writer.size() + 1, 1);
+
+            auto records = Value::array_t{ };
+            records.reserve(bytes / per_record + 1);
+            for (std::size_t i = 0; i * per_record < bytes || i == 0; ++i)
+            {
+                records.push_back(detail::make_record(static_cast<std::uint32_t>(i), depth));
+            }
+            return Value{ std::move(records) };
+        });
+    }
+
+    // Plain JSON as other programs write it (bare numbers, no type wrappers), about `bytes` long:
+    // the same records as document(), as one array.
+    inline const std::string & json_text(std::size_t bytes, std::size_t depth)
+    {
+        return detail::cached(bytes, depth, [&]
+        {
+            std::string text;
+            text.reserve(bytes + 1024);
+            text += '[';
+            for (std::uint32_t i = 0; text.size() < bytes || i == 0; ++i)
+            {
+                if (i > 0)
+                {
+                    text += ',';
+                }
+                detail::append_record(text, i, depth);
+            }
+            text += ']';
+            return text;
+        });
+    }
+}
@@ -0,0 +1,104 @@
+#include <benchmark/benchmark.h>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "io/binary-stream.hpp"
+
+namespace
+{
+    // a snapshot replay: entities with keys and strings, plus a float signal per entity
+    Value make_snapshot(std::size_t entities)
+    {
+        auto items = Value::array_t{ };
+        items.reserve(entities);
+        for (std::size_t i = 0; i < entities; ++i)
+        {
+            auto signal = Value::array_t{ };
+            for (int s = 0; s < 64; ++s)
+            {
+                signal.emplace_back(static_cast<float>(i + s) * 0.5f);
+            }
+
+            auto entity = Value::object_t{ };
+            entity.emplace("id", Value{ static_cast<uint32_t>(i) });
+            entity.emplace("name", Value{ "entity " + std::to_string(i) });
+            entity.emplace("signal", Value{ std::move(signal) });
+            items.emplace_back(std::move(entity));
+        }
+        return Value{ std::move(items) };
+    }
+
+    constexpr std::size_t entities = 1 << 10;
+}
+
+static void BM_BinaryStream_WriteOstream(benchmark::State& state)
+{
+    const auto snapshot = make_snapshot(entities);
+    std::size_t bytes = 0;
+
+    for (auto _ : state)
+    {
+        std::ostringstream os;
+        snapshot.write_binary(os);
+        bytes = os.str().size();
+        benchmark::DoNotOptimize(bytes);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+}
+BENCHMARK(BM_BinaryStream_WriteOstream);
+
+static void BM_BinaryStream_WriteBuffer(benchmark::State& state)
+{
+    const auto snapshot = make_snapshot(entities);
+    std::vector<char> bytes;
+
+    for (auto _ : state)
+    {
+        bytes.clear();
+        BinaryStreamWriter writer{ bytes };
+        writer.write(snapshot);
+        benchmark::DoNotOptimize(bytes.data());
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes.size()));
+}
+BENCHMARK(BM_BinaryStream_WriteBuffer);
+
+static void BM_BinaryStream_ReadIstream(benchmark::State& state)
+{
+    std::ostringstream os;
+    make_snapshot(entities).write_binary(os);
+    const auto bytes = os.str();
+
+    for (auto _ : state)
+    {
+        std::istringstream is{ bytes };
+        benchmark::DoNotOptimize(Value::read_binary(is));
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes.size()));
+}
+BENCHMARK(BM_BinaryStream_ReadIstream);
+
+static void BM_BinaryStream_ReadBuffer(benchmark::State& state)
+{
+    std::vector<char> bytes;
+    {
+        BinaryStreamWriter writer{ bytes };
+        writer.write(make_snapshot(entities));
+    }
+
+    for (auto _ : state)
+    {
+        BinaryStreamReader reader{ bytes };
+        Value value;
+        reader.read(value);
+        benchmark::DoNotOptimize(value);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes.size()));
+}
+BENCHMARK(BM_BinaryStream_ReadBuffer);
@@ -0,0 +1,119 @@
+#include <benchmark/benchmark.h>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "io/binary-value.hpp"
+
+namespace
+{
+    Value make_snapshot(std::size_t entities)
+    {
+        auto items = Value::array_t{ };
+        items.reserve(entities);
+        for (std::size_t i = 0; i < entities; ++i)
+        {
+            auto entity = Value::object_t{ };
+            entity.emplace("id", Value{ static_cast<uint32_t>(i) });
+            entity.emplace("name", Value{ "entity " + std::to_string(i) });
+            entity.emplace("x", Value{ static_cast<float>(i) * 0.25f });
+            entity.emplace("y", Value{ static_cast<double>(i) / 3.0 });
+            items.emplace_back(std::move(entity));
+        }
+
+        auto root = Value::object_t{ };
+        root.emplace("version", Value{ int32_t{ 3 } });
+        root.emplace("entities", Value{ std::move(items) });
+        return Value{ std::move(root) };
+    }
+
+    constexpr std::size_t entities = 1 << 12;
+}
+
+static void BM_Binary_Encode(benchmark::State& state)
+{
+    const auto snapshot = make_snapshot(entities);
+    std::vector<char> bytes;
+
+    for (auto _ : state)
+    {
+        BinaryDocument::encode(snapshot, bytes);
+        benchmark::DoNotOptimize(bytes.data());
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes.size()));
+}
+BENCHMARK(BM_Binary_Encode);
+
+static void BM_Binary_StreamWrite(benchmark::State& state)
+{
+    const auto snapshot = make_snapshot(entities);
+    std::size_t bytes = 0;
+
+    for (auto _ : state)
+    {
+        std::ostringstream os;
+        snapshot.write_binary(os);
+        bytes = os.str().size();
+        benchmark::DoNotOptimize(bytes);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+}
+BENCHMARK(BM_Binary_StreamWrite);
+
+// reading a few fields: open() checks the header and lookups touch only the nodes on the path
+static void BM_Binary_OpenAndFind(benchmark::State& state)
+{
+    std::vector<char> bytes;
+    BinaryDocument::encode(make_snapshot(entities), bytes);
+
+    for (auto _ : state)
+    {
+        BinaryDocument document;
+        document.open(bytes);
+        const auto root = document.root();
+        auto sum = static_cast<double>(root["version"].as<int32_t>());
+        sum += root["entities"][1000]["y"].as<double>();
+        benchmark::DoNotOptimize(sum);
+        benchmark::DoNotOptimize(root["entities"][4000]["name"].as_string());
+    }
+}
+BENCHMARK(BM_Binary_OpenAndFind);
+
+// the same reads through the stream format, which has to rebuild the whole tree first
+static void BM_Binary_StreamReadAndFind(benchmark::State& state)
+{
+    std::ostringstream os;
+    make_snapshot(entities).write_binary(os);
+    const auto bytes = os.str();
+
+    for (auto _ : state)
+    {
+        std::istringstream is{ bytes };
+        const auto root = Value::read_binary(is);
+        const auto & object = root.as<Value::object_t>();
+        const auto & items = object.at("entities").as<Value::array_t>();
+        auto sum = static_cast<double>(object.at("version").as<int32_t>());
+        sum += items[1000].as<Value::object_t>().at("y").as<double>();
+        benchmark::DoNotOptimize(sum);
+    }
+}
+BENCHMARK(BM_Binary_StreamReadAndFind);
+
+static void BM_Binary_ToValue(benchmark::State& state)
+{
+    std::vector<char> bytes;
+    BinaryDocument::encode(make_snapshot(entities), bytes);
+    BinaryDocument document;
+    document.open(bytes);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(document.root().to_value());
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes.size()));
+}
+BENCHMARK(BM_Binary_ToValue);
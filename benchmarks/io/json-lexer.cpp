@@ -0,0 +1,66 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include "io/json.hpp"
+
+namespace
+{
+    // pretty-printed telemetry-like records: indentation, keys, medium strings and numbers
+    std::string make_document(std::size_t records)
+    {
+        std::string json = "[\n";
+        for (std::size_t i = 0; i < records; ++i)
+        {
+            json += "    {\n";
+            json += "        \"id\": " + std::to_string(i) + ",\n";
+            json += "        \"name\": \"sensor-" + std::to_string(i % 97) + "\",\n";
+            json += "        \"message\": \"temperature reading within the expected range, \\\"nominal\\\"\",\n";
+            json += "        \"value\": " + std::to_string(static_cast<double>(i) * 0.25) + ",\n";
+            json += "        \"tags\": [\"alpha\", \"beta\", \"gamma\"]\n";
+            json += i + 1 < records ? "    },\n" : "    }\n";
+        }
+        json += "]\n";
+        return json;
+    }
+}
+
+static void BM_JsonLexer_Tokenize(benchmark::State& state)
+{
+    const auto json = make_document(static_cast<std::size_t>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        JsonLexer lexer{ json };
+        std::size_t tokens = 0;
+        while (lexer.next().type > TokenType::Error)
+        {
+            ++tokens;
+        }
+        benchmark::DoNotOptimize(tokens);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(json.size()));
+}
+BENCHMARK(BM_JsonLexer_Tokenize)->Arg(1 << 12);
+
+// the structural index alone, the part that depends on the vector unit
+static void BM_JsonScan_IndexBlocks(benchmark::State& state)
+{
+    const auto json = make_document(static_cast<std::size_t>(state.range(0)));
+    const auto end = json.data() + json.size();
+
+    for (auto _ : state)
+    {
+        json_detail::BlockIndexer indexer;
+        std::uint64_t tokens = 0;
+        for (auto p = json.data(); p < end; p += json_detail::block_size)
+        {
+            tokens += static_cast<std::uint64_t>(__builtin_popcountll(indexer.next(p, end).tokens));
+        }
+        benchmark::DoNotOptimize(tokens);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(json.size()));
+}
+BENCHMARK(BM_JsonScan_IndexBlocks)->Arg(1 << 12);
@@ -0,0 +1,67 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include "io/json-lines.hpp"
+
+namespace
+{
+    // a 64 MiB telemetry log, one record per line as Value writes them
+    const std::string & telemetry()
+    {
+        static const std::string text = []
+        {
+            std::string lines;
+            for (uint32_t i = 0; lines.size() < (std::size_t{ 64 } << 20); ++i)
+            {
+                auto record = Value::object_t{ };
+                record.emplace("id", Value{ i });
+                record.emplace("sensor", Value{ "imu-" + std::to_string(i % 17) });
+                record.emplace("t", Value{ static_cast<double>(i) * 0.001 });
+                record.emplace("accel", Value{ Value::array_t{ Value{ 0.25 }, Value{ -9.81 }, Value{ 0.5 } } });
+                lines += Value{ std::move(record) }.toString();
+                lines += '\n';
+            }
+            return lines;
+        }();
+        return text;
+    }
+}
+
+// the single-threaded baseline: one JsonParser over one line at a time
+static void BM_JsonLines_Serial(benchmark::State& state)
+{
+    const auto & text = telemetry();
+    ThreadPool pool{ 0 };
+    JsonLinesParser parser{ pool };
+
+    for (auto _ : state)
+    {
+        std::size_t records = 0;
+        parser.parse(text, [&](Value &&) { ++records; });
+        benchmark::DoNotOptimize(records);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+}
+BENCHMARK(BM_JsonLines_Serial)->Unit(benchmark::kMillisecond);
+
+// the argument is the number of pool workers, the caller parsing as well
+template <JsonLinesParser::Delivery D>
+static void BM_JsonLines_Parallel(benchmark::State& state)
+{
+    const auto & text = telemetry();
+    ThreadPool pool{ static_cast<std::size_t>(state.range(0)) };
+    JsonLinesParser parser{ pool };
+
+    for (auto _ : state)
+    {
+        std::size_t records = 0;
+        parser.parse(text, [&](Value &&) { ++records; }, D);
+        benchmark::DoNotOptimize(records);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+}
+BENCHMARK(BM_JsonLines_Parallel<JsonLinesParser::Delivery::InOrder>)->Name("BM_JsonLines_InOrder")->ArgName("workers")->RangeMultiplier(2)->Range(1, 16)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_JsonLines_Parallel<JsonLinesParser::Delivery::AsParsed>)->Name("BM_JsonLines_AsParsed")->ArgName("workers")->RangeMultiplier(2)->Range(1, 16)->UseRealTime()->Unit(benchmark::kMillisecond);
@@ -0,0 +1,113 @@
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "helpers/numbers.hpp"
+#include "io/json.hpp"
+
+namespace
+{
+    Value make_samples(std::size_t count)
+    {
+        std::mt19937 rng{ 7 };
+        std::uniform_real_distribution<double> real{ -1e6, 1e6 };
+
+        auto items = Value::array_t{ };
+        items.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            switch (i % 4)
+            {
+                case 0:  items.emplace_back(real(rng)); break;
+                case 1:  items.emplace_back(static_cast<float>(real(rng))); break;
+                case 2:  items.emplace_back(static_cast<int64_t>(rng()) << 20); break;
+                default: items.emplace_back(static_cast<uint32_t>(rng())); break;
+            }
+        }
+        return Value{ std::move(items) };
+    }
+
+    constexpr std::size_t samples = 1 << 12;
+}
+
+// the previous formatting path, for comparison: ostream << with its default 6 significant digits
+static void BM_Numbers_FormatOstream(benchmark::State& state)
+{
+    std::vector<double> values(samples);
+    std::mt19937 rng{ 7 };
+    std::uniform_real_distribution<double> real{ -1e6, 1e6 };
+    for (auto & value : values)
+    {
+        value = real(rng);
+    }
+
+    for (auto _ : state)
+    {
+        std::ostringstream os;
+        for (const auto value : values)
+        {
+            os << value << ',';
+        }
+        benchmark::DoNotOptimize(os.str());
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * samples));
+}
+BENCHMARK(BM_Numbers_FormatOstream);
+
+static void BM_Numbers_FormatShortest(benchmark::State& state)
+{
+    std::vector<double> values(samples);
+    std::mt19937 rng{ 7 };
+    std::uniform_real_distribution<double> real{ -1e6, 1e6 };
+    for (auto & value : values)
+    {
+        value = real(rng);
+    }
+
+    std::string out;
+    for (auto _ : state)
+    {
+        out.clear();
+        char buffer[num::max_chars];
+        for (const auto value : values)
+        {
+            out.append(buffer, num::format(buffer, value));
+            out += ',';
+        }
+        benchmark::DoNotOptimize(out.data());
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * samples));
+}
+BENCHMARK(BM_Numbers_FormatShortest);
+
+static void BM_Value_WriteJsonNumbers(benchmark::State& state)
+{
+    const auto value = make_samples(samples);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(value.toString());
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * samples));
+}
+BENCHMARK(BM_Value_WriteJsonNumbers);
+
+static void BM_JsonParser_TypedNumbers(benchmark::State& state)
+{
+    const auto json = make_samples(samples).toString();
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(JsonParser{}.parse(json));
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * samples));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(json.size()));
+}
+BENCHMARK(BM_JsonParser_TypedNumbers);
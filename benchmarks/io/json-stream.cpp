@@ -0,0 +1,82 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include "io/json-stream.hpp"
+
+namespace
+{
+    std::string make_records(std::size_t records)
+    {
+        std::string json = "[\n";
+        for (std::size_t i = 0; i < records; ++i)
+        {
+            json += "  {\"id\": " + std::to_string(i)
+                  + ", \"name\": \"sensor-" + std::to_string(i % 97)
+                  + "\", \"pose\": {\"x\": 1.25, \"y\": -3.5}, \"tags\": [\"alpha\", \"beta\"]}";
+            json += i + 1 < records ? ",\n" : "\n";
+        }
+        json += "]\n";
+        return json;
+    }
+
+    class CountingHandler : public IJsonHandler
+    {
+    public:
+        std::size_t events = 0;
+
+        bool beginObject() override { return ++events, true; }
+        bool endObject() override { return ++events, true; }
+        bool beginArray() override { return ++events, true; }
+        bool endArray() override { return ++events, true; }
+        bool key(std::string_view) override { return ++events, true; }
+        bool string(std::string_view) override { return ++events, true; }
+        bool number(std::string_view) override { return ++events, true; }
+        bool null() override { return ++events, true; }
+    };
+
+    // feeds the document in chunks of `chunk` bytes, as a socket or file reader would
+    void feed_chunked(JsonStreamParser & parser, const std::string & json, std::size_t chunk)
+    {
+        for (std::size_t offset = 0; offset < json.size(); offset += chunk)
+        {
+            parser.feed(std::string_view(json).substr(offset, chunk));
+        }
+        parser.finish();
+    }
+}
+
+static void BM_JsonStream_Events(benchmark::State& state)
+{
+    const auto json = make_records(1 << 13);
+    const auto chunk = static_cast<std::size_t>(state.range(0));
+
+    for (auto _ : state)
+    {
+        CountingHandler handler;
+        JsonStreamParser parser{ handler };
+        feed_chunked(parser, json, chunk);
+        benchmark::DoNotOptimize(handler.events);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(json.size()));
+}
+BENCHMARK(BM_JsonStream_Events)->Arg(4 << 10)->Arg(64 << 10);
+
+// builds Values for one small subtree per record and skips the rest
+static void BM_JsonStream_CollectPath(benchmark::State& state)
+{
+    const auto json = make_records(1 << 13);
+
+    for (auto _ : state)
+    {
+        std::size_t collected = 0;
+        JsonValueCollector collector("/*/pose", [&](Value &&) { ++collected; });
+        JsonStreamParser parser{ collector };
+        feed_chunked(parser, json, 64 << 10);
+        benchmark::DoNotOptimize(collected);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(json.size()));
+}
+BENCHMARK(BM_JsonStream_CollectPath);
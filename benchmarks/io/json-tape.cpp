@@ -0,0 +1,84 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include "core/arena-value.hpp"
+#include "io/json-stream.hpp"
+#include "io/json-tape.hpp"
+
+namespace
+{
+    std::string make_document(std::size_t records)
+    {
+        std::string json = "{\"meta\": {\"version\": 3, \"source\": \"bench\"}, \"records\": [";
+        for (std::size_t i = 0; i < records; ++i)
+        {
+            json += i ? "," : "";
+            json += "{\"id\":" + std::to_string(i) + ",\"name\":\"item " + std::to_string(i)
+                  + "\",\"pose\":{\"x\":1.5,\"y\":-2.25},\"tags\":[\"alpha\",\"beta\"]}";
+        }
+        return json + "], \"checksum\": 12345}";
+    }
+
+    constexpr std::size_t records = 1 << 12;
+}
+
+// the usual read: a handful of fields out of a large document
+static void BM_JsonTape_FindFields(benchmark::State& state)
+{
+    const auto json = make_document(records);
+
+    for (auto _ : state)
+    {
+        JsonTape tape;
+        tape.parse(json);
+        auto sum = tape.find("meta/version").as_int() + tape.find("checksum").as_int();
+        sum += static_cast<int64_t>(tape.find("records/100/pose/x").as_double());
+        benchmark::DoNotOptimize(sum);
+        benchmark::DoNotOptimize(tape.find("records/4000/name").raw());
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(json.size()));
+}
+BENCHMARK(BM_JsonTape_FindFields);
+
+static void BM_ArenaDocument_FindFields(benchmark::State& state)
+{
+    const auto json = make_document(records);
+
+    for (auto _ : state)
+    {
+        ArenaDocument document;
+        document.parse(json);
+        const auto & root = document.root();
+        auto sum = root.find("meta")->find("version")->as_int() + root.find("checksum")->as_int();
+        sum += static_cast<int64_t>((*root.find("records"))[100].find("pose")->find("x")->as_double());
+        benchmark::DoNotOptimize(sum);
+        benchmark::DoNotOptimize((*root.find("records"))[4000].find("name")->as_string());
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(json.size()));
+}
+BENCHMARK(BM_ArenaDocument_FindFields);
+
+static void BM_ValueTree_FindFields(benchmark::State& state)
+{
+    const auto json = make_document(records);
+
+    for (auto _ : state)
+    {
+        Value root;
+        JsonValueCollector collector("", [&](Value && value) { root = std::move(value); });
+        JsonStreamParser parser{ collector };
+        parser.parse(json);
+
+        const auto & object = root.as<Value::object_t>();
+        const auto & record = object.at("records").as<Value::array_t>()[100].as<Value::object_t>();
+        auto sum = object.at("meta").as<Value::object_t>().at("version").as<double>() + object.at("checksum").as<double>();
+        sum += record.at("pose").as<Value::object_t>().at("x").as<double>();
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(json.size()));
+}
+BENCHMARK(BM_ValueTree_FindFields);
@@ -0,0 +1,128 @@
+#include <benchmark/benchmark.h>
+
+#include <sstream>
+#include <string>
+
+#include "helpers/strings.hpp"
+#include "io/json-writer.hpp"
+
+namespace
+{
+    // a state snapshot: many small objects with short strings and a few numbers each
+    Value make_snapshot(std::size_t entities)
+    {
+        auto items = Value::array_t{ };
+        items.reserve(entities);
+        for (std::size_t i = 0; i < entities; ++i)
+        {
+            auto entity = Value::object_t{ };
+            entity.emplace("id", Value{ static_cast<uint32_t>(i) });
+            entity.emplace("name", Value{ "entity \"" + std::to_string(i) + "\"" });
+            entity.emplace("x", Value{ static_cast<float>(i) * 0.25f });
+            entity.emplace("y", Value{ static_cast<double>(i) / 3.0 });
+            entity.emplace("note", Value{ std::string{ "a longer description that needs no escaping at all" } });
+            items.emplace_back(std::move(entity));
+        }
+        return Value{ std::move(items) };
+    }
+
+    // the iostream writer this replaced, kept for comparison
+    void write_ostream(const Value & value, std::ostream & os)
+    {
+        const auto index = value.data().index();
+        std::visit([&](auto && arg)
+        {
+            using T = std::decay_t<decltype(arg)>;
+            if constexpr (std::is_same_v<T, std::monostate>)
+            {
+                os << "null";
+            }
+            else if constexpr (std::is_arithmetic_v<T>)
+            {
+                os << R"({ "type": ")" << value_type_names[index] << R"(", "value": )" << +arg << " }";
+            }
+            else if constexpr (std::is_same_v<T, std::string>)
+            {
+                os << "\"" << str::escape(arg) << "\"";
+            }
+            else if constexpr (std::is_same_v<T, Value::array_t>)
+            {
+                os << "[ ";
+                for (auto it = arg.begin(); it != arg.end(); ++it)
+                {
+                    if (it != arg.begin()) os << ", ";
+                    write_ostream(*it, os);
+                }
+                os << " ]";
+            }
+            else if constexpr (std::is_same_v<T, Value::object_t>)
+            {
+                os << "{ ";
+                for (auto it = arg.begin(); it != arg.end(); ++it)
+                {
+                    if (it != arg.begin()) os << ", ";
+                    os << "\"" << str::escape(it->first) << "\": ";
+                    write_ostream(it->second, os);
+                }
+                os << " }";
+            }
+        }, value.data());
+    }
+
+    constexpr std::size_t entities = 1 << 11;
+}
+
+static void BM_JsonWriter_Ostream(benchmark::State& state)
+{
+    const auto snapshot = make_snapshot(entities);
+    std::size_t bytes = 0;
+
+    for (auto _ : state)
+    {
+        std::ostringstream os;
+        write_ostream(snapshot, os);
+        bytes = os.str().size();
+        benchmark::DoNotOptimize(bytes);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+}
+BENCHMARK(BM_JsonWriter_Ostream);
+
+static void BM_JsonWriter_Buffer(benchmark::State& state)
+{
+    const auto snapshot = make_snapshot(entities);
+    JsonWriter writer;
+    std::size_t bytes = 0;
+
+    for (auto _ : state)
+    {
+        writer.clear();
+        writer.write(snapshot);
+        bytes = writer.size();
+        benchmark::DoNotOptimize(writer.view().data());
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+}
+BENCHMARK(BM_JsonWriter_Buffer);
+
+static void BM_JsonWriter_EscapeLongStrings(benchmark::State& state)
+{
+    std::string text;
+    for (int i = 0; i < 256; ++i)
+    {
+        text += "plain text runs with the occasional \"quote\" or tab\t";
+    }
+    JsonWriter writer;
+
+    for (auto _ : state)
+    {
+        writer.clear();
+        writer.writeString(text);
+        benchmark::DoNotOptimize(writer.view().data());
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+}
+BENCHMARK(BM_JsonWriter_EscapeLongStrings);
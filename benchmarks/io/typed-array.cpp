@@ -0,0 +1,133 @@
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "io/binary-stream.hpp"
+#include "io/json-writer.hpp"
+#include "io/json.hpp"
+
+namespace
+{
+    constexpr std::size_t samples = 1 << 20;
+
+    std::vector<float> make_signal()
+    {
+        std::vector<float> signal(samples);
+        for (std::size_t i = 0; i < samples; ++i)
+        {
+            signal[i] = static_cast<float>(i % 1000) * 0.125f;
+        }
+        return signal;
+    }
+
+    // the same signal as one Value per sample, the only form before typed arrays
+    Value make_boxed()
+    {
+        auto items = Value::array_t{ };
+        items.reserve(samples);
+        for (const auto sample : make_signal())
+        {
+            items.emplace_back(sample);
+        }
+        return Value{ std::move(items) };
+    }
+}
+
+static void BM_TypedArray_Build_Boxed(benchmark::State& state)
+{
+    const auto signal = make_signal();
+    for (auto _ : state)
+    {
+        auto items = Value::array_t{ };
+        items.reserve(signal.size());
+        for (const auto sample : signal)
+        {
+            items.emplace_back(sample);
+        }
+        benchmark::DoNotOptimize(items.data());
+    }
+    state.counters["bytes/sample"] = static_cast<double>(sizeof(Value));
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * samples));
+}
+BENCHMARK(BM_TypedArray_Build_Boxed);
+
+static void BM_TypedArray_Build_Typed(benchmark::State& state)
+{
+    const auto signal = make_signal();
+    for (auto _ : state)
+    {
+        auto value = Value{ signal };
+        benchmark::DoNotOptimize(value);
+    }
+    state.counters["bytes/sample"] = static_cast<double>(sizeof(float));
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * samples));
+}
+BENCHMARK(BM_TypedArray_Build_Typed);
+
+template <bool Typed>
+static void BM_TypedArray_WriteJson(benchmark::State& state)
+{
+    const auto value = Typed ? Value{ make_signal() } : make_boxed();
+    JsonWriter writer;
+    for (auto _ : state)
+    {
+        writer.clear();
+        writer.write(value);
+        benchmark::DoNotOptimize(writer.view().data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * writer.size()));
+}
+BENCHMARK(BM_TypedArray_WriteJson<false>)->Name("BM_TypedArray_WriteJson_Boxed");
+BENCHMARK(BM_TypedArray_WriteJson<true>)->Name("BM_TypedArray_WriteJson_Typed");
+
+template <bool Typed>
+static void BM_TypedArray_ParseJson(benchmark::State& state)
+{
+    const auto json = (Typed ? Value{ make_signal() } : make_boxed()).toString();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(JsonParser{ }.parse(json));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * json.size()));
+}
+BENCHMARK(BM_TypedArray_ParseJson<false>)->Name("BM_TypedArray_ParseJson_Boxed");
+BENCHMARK(BM_TypedArray_ParseJson<true>)->Name("BM_TypedArray_ParseJson_Typed");
+
+// the boxed signal goes out in Value::size_t chunks, the longest array the stream format packs
+template <bool Typed>
+static void BM_TypedArray_StreamRoundTrip(benchmark::State& state)
+{
+    auto value = Value{ make_signal() };
+    if constexpr (!Typed)
+    {
+        auto chunks = Value::array_t{ };
+        const auto & signal = value.as<std::vector<float>>();
+        for (std::size_t at = 0; at < signal.size(); at += 0xffff)
+        {
+            auto chunk = Value::array_t{ };
+            for (std::size_t i = at; i < std::min(signal.size(), at + 0xffff); ++i)
+            {
+                chunk.emplace_back(signal[i]);
+            }
+            chunks.emplace_back(std::move(chunk));
+        }
+        value = Value{ std::move(chunks) };
+    }
+
+    std::vector<char> bytes;
+    for (auto _ : state)
+    {
+        bytes.clear();
+        {
+            BinaryStreamWriter writer{ bytes };
+            writer.write(value);
+        }
+        BinaryStreamReader reader{ bytes };
+        Value out;
+        reader.read(out);
+        benchmark::DoNotOptimize(out);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes.size()));
+}
+BENCHMARK(BM_TypedArray_StreamRoundTrip<false>)->Name("BM_TypedArray_StreamRoundTrip_Boxed");
+BENCHMARK(BM_TypedArray_StreamRoundTrip<true>)->Name("BM_TypedArray_StreamRoundTrip_Typed");
@@ -0,0 +1,177 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "datasets.hpp"
+#include "io/json.hpp"
+
+// Whole-document throughput of each Value format over the datasets::document_sizes ladder,
+// in bytes of the serialized form per second.
+
+static void BM_JsonParser_Parse(benchmark::State& state)
+{
+    const auto & text = datasets::json_text(static_cast<std::size_t>(state.range(0)), static_cast<std::size_t>(state.range(1)));
+    JsonParser parser;
+
+    for (auto _ : state)
+    {
+        auto value = parser.parse(text);
+        benchmark::DoNotOptimize(value);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+}
+BENCHMARK(BM_JsonParser_Parse)->Apply(datasets::document_sizes)->Unit(benchmark::kMicrosecond);
+
+static void BM_Value_WriteJson(benchmark::State& state)
+{
+    const auto & document = datasets::document(static_cast<std::size_t>(state.range(0)), static_cast<std::size_t>(state.range(1)));
+    std::size_t bytes = 0;
+
+    for (auto _ : state)
+    {
+        std::ostringstream os;
+        document.write_json(os);
+        bytes = static_cast<std::size_t>(os.tellp());
+        benchmark::DoNotOptimize(bytes);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+}
+BENCHMARK(BM_Value_WriteJson)->Apply(datasets::document_sizes)->Unit(benchmark::kMicrosecond);
+
+static void BM_Value_ReadJson(benchmark::State& state)
+{
+    std::ostringstream os;
+    datasets::document(static_cast<std::size_t>(state.range(0)), static_cast<std::size_t>(state.range(1))).write_json(os);
+    const auto text = std::move(os).str();
+
+    for (auto _ : state)
+    {
+        std::istringstream is{ text };
+        auto value = Value::read_json(is);
+        benchmark::DoNotOptimize(value);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+}
+BENCHMARK(BM_Value_ReadJson)->Apply(datasets::document_sizes)->Unit(benchmark::kMicrosecond);
+
+static void BM_Value_WriteBinary(benchmark::State& state)
+{
+    const auto & document = datasets::document(static_cast<std::size_t>(state.range(0)), static_cast<std::size_t>(state.range(1)));
+    std::size_t bytes = 0;
+
+    for (auto _ : state)
+    {
+        std::ostringstream os;
+        document.write_binary(os);
+        bytes = static_cast<std::size_t>(os.tellp());
+        benchmark::DoNotOptimize(bytes);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+}
+BENCHMARK(BM_Value_WriteBinary)->Apply(datasets::document_sizes)->Unit(benchmark::kMicrosecond);
+
+static void BM_Value_ReadBinary(benchmark::State& state)
+{
+    std::ostringstream os;
+    datasets::document(static_cast<std::size_t>(state.range(0)), static_cast<std::size_t>(state.range(1))).write_binary(os);
+    const auto bytes = std::move(os).str();
+
+    for (auto _ : state)
+    {
+        std::istringstream is{ bytes };
+        auto value = Value::read_binary(is);
+        benchmark::DoNotOptimize(value);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes.size()));
+}
+BENCHMARK(BM_Value_ReadBinary)->Apply(datasets::document_sizes)->Unit(benchmark::kMicrosecond);
+
+// ---- From files: reading into a buffer first against parsing the mapping ----
+
+namespace
+{
+    // the document in the given format, written to a temporary file removed with the object
+    struct DocumentFile
+    {
+        std::string path;
+
+        DocumentFile(const benchmark::State & state, bool binary)
+            : path((std::filesystem::temp_directory_path() / "value-formats-bench").string() + (binary ? ".bin" : ".json"))
+        {
+            const auto & document = datasets::document(static_cast<std::size_t>(state.range(0)), static_cast<std::size_t>(state.range(1)));
+            std::ofstream os{ path, std::ios::binary };
+            binary ? document.write_binary(os) : document.write_json(os);
+        }
+
+        ~DocumentFile() { std::remove(path.c_str()); }
+
+        [[nodiscard]] int64_t size() const { return static_cast<int64_t>(std::filesystem::file_size(path)); }
+    };
+}
+
+static void BM_Value_ReadJsonFile_Stream(benchmark::State& state)
+{
+    const DocumentFile file{ state, false };
+
+    for (auto _ : state)
+    {
+        std::ifstream is{ file.path, std::ios::binary };
+        auto value = Value::read_json(is);
+        benchmark::DoNotOptimize(value);
+    }
+
+    state.SetBytesProcessed(state.iterations() * file.size());
+}
+BENCHMARK(BM_Value_ReadJsonFile_Stream)->Apply(datasets::document_sizes)->Unit(benchmark::kMicrosecond);
+
+static void BM_Value_LoadJsonFile_Mapped(benchmark::State& state)
+{
+    const DocumentFile file{ state, false };
+
+    for (auto _ : state)
+    {
+        auto value = Value::load_json(file.path);
+        benchmark::DoNotOptimize(value);
+    }
+
+    state.SetBytesProcessed(state.iterations() * file.size());
+}
+BENCHMARK(BM_Value_LoadJsonFile_Mapped)->Apply(datasets::document_sizes)->Unit(benchmark::kMicrosecond);
+
+static void BM_Value_ReadBinaryFile_Stream(benchmark::State& state)
+{
+    const DocumentFile file{ state, true };
+
+    for (auto _ : state)
+    {
+        std::ifstream is{ file.path, std::ios::binary };
+        auto value = Value::read_binary(is);
+        benchmark::DoNotOptimize(value);
+    }
+
+    state.SetBytesProcessed(state.iterations() * file.size());
+}
+BENCHMARK(BM_Value_ReadBinaryFile_Stream)->Apply(datasets::document_sizes)->Unit(benchmark::kMicrosecond);
+
+static void BM_Value_LoadBinaryFile_Mapped(benchmark::State& state)
+{
+    const DocumentFile file{ state, true };
+
+    for (auto _ : state)
+    {
+        auto value = Value::load_binary(file.path);
+        benchmark::DoNotOptimize(value);
+    }
+
+    state.SetBytesProcessed(state.iterations() * file.size());
+}
+BENCHMARK(BM_Value_LoadBinaryFile_Mapped)->Apply(datasets::document_sizes)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,147 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include "math/fast.hpp"
+#include "math/interpolation.hpp"
+
+using namespace math;
+using Quat = Quaternion<float>;
+
+namespace
+{
+    // an animation blend: two poses of unit rotations, one per joint
+    constexpr std::size_t joints = 1 << 15;
+
+    std::vector<Quat> make_pose(unsigned seed)
+    {
+        std::mt19937 rng{ seed };
+        std::normal_distribution<float> normal;
+        std::vector<Quat> pose(joints);
+        for (auto & q : pose)
+        {
+            q = Quat(normal(rng), normal(rng), normal(rng), normal(rng)).normalized();
+        }
+        return pose;
+    }
+
+    VectorSOA<4, float> to_soa(const std::vector<Quat> & pose)
+    {
+        VectorSOA<4, float> out(pose.size());
+        out.resize(pose.size());
+        for (std::size_t i = 0; i < pose.size(); ++i)
+        {
+            out.data(0)[i] = pose[i].x();
+            out.data(1)[i] = pose[i].y();
+            out.data(2)[i] = pose[i].z();
+            out.data(3)[i] = pose[i].w();
+        }
+        return out;
+    }
+}
+
+static void BM_Slerp_Exact(benchmark::State& state)
+{
+    const auto a = make_pose(1);
+    const auto b = make_pose(2);
+    std::vector<Quat> out(joints);
+
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < joints; ++i)
+        {
+            out[i] = slerp(a[i], b[i], 0.3f);
+        }
+        benchmark::DoNotOptimize(out.data());
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * joints));
+}
+BENCHMARK(BM_Slerp_Exact);
+
+static void BM_Slerp_Fast(benchmark::State& state)
+{
+    const auto a = make_pose(1);
+    const auto b = make_pose(2);
+    std::vector<Quat> out(joints);
+
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < joints; ++i)
+        {
+            out[i] = fast::slerp(a[i], b[i], 0.3f);
+        }
+        benchmark::DoNotOptimize(out.data());
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * joints));
+}
+BENCHMARK(BM_Slerp_Fast);
+
+static void BM_Slerp_FastSoa(benchmark::State& state)
+{
+    const auto a = to_soa(make_pose(1));
+    const auto b = to_soa(make_pose(2));
+    VectorSOA<4, float> out(joints);
+    out.resize(joints);
+
+    for (auto _ : state)
+    {
+        fast::slerp(out, a, b, 0.3f);
+        benchmark::DoNotOptimize(out.data(0));
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * joints));
+}
+BENCHMARK(BM_Slerp_FastSoa);
+
+static void BM_Nlerp_FastSoa(benchmark::State& state)
+{
+    const auto a = to_soa(make_pose(1));
+    const auto b = to_soa(make_pose(2));
+    VectorSOA<4, float> out(joints);
+    out.resize(joints);
+
+    for (auto _ : state)
+    {
+        fast::nlerp(out, a, b, 0.3f);
+        benchmark::DoNotOptimize(out.data(0));
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * joints));
+}
+BENCHMARK(BM_Nlerp_FastSoa);
+
+static void BM_Normalize_ExactSoa(benchmark::State& state)
+{
+    const auto a = to_soa(make_pose(1));
+    VectorSOA<4, float> out(joints);
+    out.resize(joints);
+
+    for (auto _ : state)
+    {
+        soa::normalize(out, a);
+        benchmark::DoNotOptimize(out.data(0));
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * joints));
+}
+BENCHMARK(BM_Normalize_ExactSoa);
+
+static void BM_Normalize_FastSoa(benchmark::State& state)
+{
+    const auto a = to_soa(make_pose(1));
+    VectorSOA<4, float> out(joints);
+    out.resize(joints);
+
+    for (auto _ : state)
+    {
+        fast::normalize(out, a);
+        benchmark::DoNotOptimize(out.data(0));
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * joints));
+}
+BENCHMARK(BM_Normalize_FastSoa);
@@ -0,0 +1,153 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <vector>
+
+#include "math/matrix.hpp"
+
+using namespace math;
+
+namespace
+{
+    // a skinning-style batch: one parent transform applied to many bone matrices
+    template <typename T>
+    std::vector<Matrix4x4<T>> make_bones(std::size_t count)
+    {
+        std::vector<Matrix4x4<T>> bones(count, Matrix4x4<T>::identity());
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const auto t = static_cast<T>(i) * T(0.01);
+            bones[i][0][1] = t;
+            bones[i][1][0] = -t;
+            bones[i][3] = Vector4<T>{ t, T(2) * t, T(3) * t, T(1) };
+        }
+        return bones;
+    }
+
+    // the column-by-column product the generic code falls back to
+    template <typename T>
+    Matrix4x4<T> scalar_mul(const Matrix4x4<T> & a, const Matrix4x4<T> & b)
+    {
+        Matrix4x4<T> out;
+        for (std::size_t c = 0; c < 4; ++c)
+        {
+            for (std::size_t r = 0; r < 4; ++r)
+            {
+                T sum{ };
+                for (std::size_t k = 0; k < 4; ++k)
+                {
+                    sum += a[k][r] * b[c][k];
+                }
+                out[c][r] = sum;
+            }
+        }
+        return out;
+    }
+
+    constexpr std::size_t bone_count = 1 << 10;
+}
+
+template <typename T>
+static void BM_Matrix4_Multiply(benchmark::State& state)
+{
+    const auto bones = make_bones<T>(bone_count);
+    auto parent = make_bones<T>(2)[1];
+    std::vector<Matrix4x4<T>> out(bone_count);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(parent);
+        for (std::size_t i = 0; i < bone_count; ++i)
+        {
+            out[i] = parent * bones[i];
+        }
+        benchmark::DoNotOptimize(out.data());
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * bone_count));
+}
+BENCHMARK(BM_Matrix4_Multiply<float>);
+BENCHMARK(BM_Matrix4_Multiply<double>);
+
+template <typename T>
+static void BM_Matrix4_MultiplyScalar(benchmark::State& state)
+{
+    const auto bones = make_bones<T>(bone_count);
+    auto parent = make_bones<T>(2)[1];
+    std::vector<Matrix4x4<T>> out(bone_count);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(parent);
+        for (std::size_t i = 0; i < bone_count; ++i)
+        {
+            out[i] = scalar_mul(parent, bones[i]);
+        }
+        benchmark::DoNotOptimize(out.data());
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * bone_count));
+}
+BENCHMARK(BM_Matrix4_MultiplyScalar<float>);
+BENCHMARK(BM_Matrix4_MultiplyScalar<double>);
+
+template <typename T>
+static void BM_Matrix4_TransformPoint(benchmark::State& state)
+{
+    const auto bones = make_bones<T>(bone_count);
+    const auto point = Vector4<T>{ T(1), T(2), T(3), T(1) };
+    std::vector<Vector4<T>> out(bone_count);
+
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < bone_count; ++i)
+        {
+            out[i] = bones[i] * point;
+        }
+        benchmark::DoNotOptimize(out.data());
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * bone_count));
+}
+BENCHMARK(BM_Matrix4_TransformPoint<float>);
+BENCHMARK(BM_Matrix4_TransformPoint<double>);
+
+template <typename T>
+static void BM_Matrix4_Inverse(benchmark::State& state)
+{
+    const auto bones = make_bones<T>(bone_count);
+    std::vector<Matrix4x4<T>> out(bone_count);
+
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < bone_count; ++i)
+        {
+            out[i] = bones[i].inverse();
+        }
+        benchmark::DoNotOptimize(out.data());
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * bone_count));
+}
+BENCHMARK(BM_Matrix4_Inverse<float>);
+BENCHMARK(BM_Matrix4_Inverse<double>);
+
+template <typename T>
+static void BM_Matrix4_Transpose(benchmark::State& state)
+{
+    const auto bones = make_bones<T>(bone_count);
+    std::vector<Matrix4x4<T>> out(bone_count);
+
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < bone_count; ++i)
+        {
+            out[i] = bones[i].transposed();
+        }
+        benchmark::DoNotOptimize(out.data());
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * bone_count));
+}
+BENCHMARK(BM_Matrix4_Transpose<float>);
+BENCHMARK(BM_Matrix4_Transpose<double>);
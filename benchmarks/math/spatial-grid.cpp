@@ -0,0 +1,140 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include "core/thread-pool.hpp"
+#include "math/spatial-grid.hpp"
+
+using namespace math;
+
+namespace
+{
+    // entities spread over a 200 m cube, each asking for its neighbours within 5 m every frame
+    constexpr float world = 200.0f;
+    constexpr float radius = 5.0f;
+
+    VectorSOA<3, float> make_world(std::size_t count)
+    {
+        std::mt19937 rng{ 1 };
+        std::uniform_real_distribution<float> coordinate{ 0.0f, world };
+        VectorSOA<3, float> points(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            points.emplace(coordinate(rng), coordinate(rng), coordinate(rng));
+        }
+        return points;
+    }
+
+    Vector3<float> at(const VectorSOA<3, float> & points, std::size_t i)
+    {
+        return Vector3<float>{ points.data(0)[i], points.data(1)[i], points.data(2)[i] };
+    }
+}
+
+// the O(n^2) sweep the grid replaces
+static void BM_Neighbours_BruteForce(benchmark::State& state)
+{
+    const auto count = static_cast<std::size_t>(state.range(0));
+    const auto points = make_world(count);
+    std::vector<Handle> out(count);
+
+    for (auto _ : state)
+    {
+        std::size_t total = 0;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const auto centre = at(points, i);
+            std::size_t found = 0;
+            for (std::size_t j = 0; j < count; ++j)
+            {
+                if ((at(points, j) - centre).squared_length() <= radius * radius)
+                {
+                    out[found++] = points.handles().get_handle(static_cast<uint32_t>(j));
+                }
+            }
+            total += found;
+        }
+        benchmark::DoNotOptimize(total);
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * count));
+}
+BENCHMARK(BM_Neighbours_BruteForce)->Arg(1 << 10)->Arg(1 << 13);
+
+static void BM_Neighbours_Grid(benchmark::State& state)
+{
+    const auto count = static_cast<std::size_t>(state.range(0));
+    const auto points = make_world(count);
+    SpatialHashGrid<float> grid{ radius };
+    grid.rebuild(points);
+    std::vector<Handle> out(count);
+
+    for (auto _ : state)
+    {
+        std::size_t total = 0;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            total += grid.query_radius(at(points, i), radius, out);
+        }
+        benchmark::DoNotOptimize(total);
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * count));
+}
+BENCHMARK(BM_Neighbours_Grid)->Arg(1 << 10)->Arg(1 << 13)->Arg(1 << 17);
+
+static void BM_Grid_RebuildSerial(benchmark::State& state)
+{
+    const auto points = make_world(static_cast<std::size_t>(state.range(0)));
+    SpatialHashGrid<float> grid{ radius };
+    ThreadPool pool{ 0 };
+
+    for (auto _ : state)
+    {
+        grid.rebuild(points, pool);
+        benchmark::DoNotOptimize(grid.size());
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * points.size()));
+}
+BENCHMARK(BM_Grid_RebuildSerial)->Arg(1 << 17)->Arg(1 << 20);
+
+static void BM_Grid_RebuildParallel(benchmark::State& state)
+{
+    const auto points = make_world(static_cast<std::size_t>(state.range(0)));
+    SpatialHashGrid<float> grid{ radius };
+
+    for (auto _ : state)
+    {
+        grid.rebuild(points);
+        benchmark::DoNotOptimize(grid.size());
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * points.size()));
+}
+BENCHMARK(BM_Grid_RebuildParallel)->Arg(1 << 17)->Arg(1 << 20);
+
+// one frame of small motion: most entities stay in their cell
+static void BM_Grid_UpdateAfterMotion(benchmark::State& state)
+{
+    auto points = make_world(static_cast<std::size_t>(state.range(0)));
+    SpatialHashGrid<float> grid{ radius };
+    grid.rebuild(points);
+    float step = 0.05f;
+
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < points.size(); ++i)
+        {
+            points.data(0)[i] += step;
+        }
+        step = -step;
+        grid.update(points);
+        benchmark::DoNotOptimize(grid.size());
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * points.size()));
+}
+BENCHMARK(BM_Grid_UpdateAfterMotion)->Arg(1 << 17)->Arg(1 << 20);
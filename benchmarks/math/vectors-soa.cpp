@@ -0,0 +1,284 @@
+#include <benchmark/benchmark.h>
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "datasets.hpp"
+#include "math/geometric.hpp"
+#include "math/vectors-soa-ops.hpp"
+
+using namespace math;
+
+namespace
+{
+    VectorSOA<3, float> make_soa(std::size_t count, float seed)
+    {
+        VectorSOA<3, float> out(count);
+        out.resize(count);
+        for (std::size_t c = 0; c < 3; ++c)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                out.data(c)[i] = seed + static_cast<float>(i % 1024) * 1e-3f + static_cast<float>(c);
+            }
+        }
+        return out;
+    }
+
+    std::vector<Vector3f> make_aos(std::size_t count, float seed)
+    {
+        std::vector<Vector3f> out(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const auto base = seed + static_cast<float>(i % 1024) * 1e-3f;
+            out[i] = Vector3f{ base, base + 1.0f, base + 2.0f };
+        }
+        return out;
+    }
+}
+
+// position += velocity * dt, AoS baseline
+static void BM_AoS_Integrate(benchmark::State& state)
+{
+    const auto count = static_cast<std::size_t>(state.range(0));
+    auto positions = make_aos(count, 1.0f);
+    const auto velocities = make_aos(count, 0.5f);
+
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            positions[i] += velocities[i] * 0.016f;
+        }
+        benchmark::DoNotOptimize(positions.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_AoS_Integrate)->Apply(datasets::entity_counts);
+
+// position += velocity * dt, one VectorView per element
+static void BM_SoA_Integrate_Views(benchmark::State& state)
+{
+    const auto count = static_cast<std::size_t>(state.range(0));
+    auto positions = make_soa(count, 1.0f);
+    auto velocities = make_soa(count, 0.5f);
+
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            auto v = velocities[i].as_vector() * 0.016f;
+            auto p = positions[i];
+            p.x() += v.x();
+            p.y() += v.y();
+            p.z() += v.z();
+        }
+        benchmark::DoNotOptimize(positions.data(0));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_SoA_Integrate_Views)->Apply(datasets::entity_counts);
+
+// position += velocity * dt, column-wise SIMD kernel
+static void BM_SoA_Integrate_Kernel(benchmark::State& state)
+{
+    const auto count = static_cast<std::size_t>(state.range(0));
+    auto positions = make_soa(count, 1.0f);
+    const auto velocities = make_soa(count, 0.5f);
+
+    for (auto _ : state)
+    {
+        soa::fma(positions, velocities, 0.016f, positions);
+        benchmark::DoNotOptimize(positions.data(0));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_SoA_Integrate_Kernel)->Apply(datasets::entity_counts);
+
+static void BM_SoA_Normalize_Kernel(benchmark::State& state)
+{
+    const auto count = static_cast<std::size_t>(state.range(0));
+    const auto source = make_soa(count, 1.0f);
+    auto out = make_soa(count, 0.0f);
+
+    for (auto _ : state)
+    {
+        soa::normalize(out, source);
+        benchmark::DoNotOptimize(out.data(0));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_SoA_Normalize_Kernel)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+
+// position += velocity * dt, chunked across a work-stealing pool; the argument is the total thread count
+static void BM_SoA_Integrate_Parallel(benchmark::State& state)
+{
+    constexpr std::size_t count = 1 << 22;
+    const auto threads = static_cast<std::size_t>(state.range(0));
+
+    // persistent pools, one per thread count, outlive the benchmark repetitions
+    static std::map<std::size_t, std::unique_ptr<ThreadPool>> pools;
+    auto & pool = pools[threads];
+    if (!pool)
+    {
+        pool = std::make_unique<ThreadPool>(threads - 1);
+    }
+
+    auto positions = make_soa(count, 1.0f);
+    const auto velocities = make_soa(count, 0.5f);
+
+    for (auto _ : state)
+    {
+        positions.for_each_chunk([&](std::size_t begin, std::size_t end) {
+            for (std::size_t c = 0; c < 3; ++c)
+            {
+                float * p = positions.data(c);
+                const float * v = velocities.data(c);
+                simd::for_each_batch<float>(end - begin, [&]<typename B>(std::type_identity<B>, std::size_t i) {
+                    fma(B::load_aligned(v + begin + i), B::broadcast(0.016f), B::load_aligned(p + begin + i)).store_aligned(p + begin + i);
+                });
+            }
+        }, 1 << 14, *pool);
+        benchmark::DoNotOptimize(positions.data(0));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(count));
+}
+BENCHMARK(BM_SoA_Integrate_Parallel)->RangeMultiplier(2)->Range(1, 32)->UseRealTime();
+
+namespace
+{
+    const Matrix4x4<float> frame_matrix{
+        Vector4f{ 0.0f, 1.0f, 0.0f, 0.0f },
+        Vector4f{ -1.0f, 0.0f, 0.0f, 0.0f },
+        Vector4f{ 0.0f, 0.0f, 2.0f, 0.0f },
+        Vector4f{ 3.0f, -4.0f, 5.0f, 1.0f }
+    };
+
+    const Quaternion<float> frame_rotation{ 0.0f, 0.0f, 0.70710678f, 0.70710678f };
+}
+
+// points under one matrix, one Matrix * Vector call per point
+static void BM_AoS_TransformPoints(benchmark::State& state)
+{
+    const auto count = static_cast<std::size_t>(state.range(0));
+    const auto points = make_aos(count, 1.0f);
+    std::vector<Vector3f> out(count);
+
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const auto& p = points[i];
+            const auto h = frame_matrix * Vector4f{ p.x(), p.y(), p.z(), 1.0f };
+            out[i] = Vector3f{ h.x(), h.y(), h.z() };
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_AoS_TransformPoints)->Arg(1 << 16)->Arg(1 << 21);
+
+template <soa::store_mode Mode>
+static void BM_SoA_TransformPoints(benchmark::State& state)
+{
+    const auto count = static_cast<std::size_t>(state.range(0));
+    const auto points = make_soa(count, 1.0f);
+    auto out = make_soa(count, 0.0f);
+
+    for (auto _ : state)
+    {
+        soa::transform(out, frame_matrix, points, Mode);
+        benchmark::DoNotOptimize(out.data(0));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_SoA_TransformPoints<soa::store_mode::cached>)->Name("BM_SoA_TransformPoints_Cached")->Arg(1 << 16)->Arg(1 << 21);
+BENCHMARK(BM_SoA_TransformPoints<soa::store_mode::streaming>)->Name("BM_SoA_TransformPoints_Streaming")->Arg(1 << 16)->Arg(1 << 21);
+
+static void BM_AoS_Rotate(benchmark::State& state)
+{
+    const auto count = static_cast<std::size_t>(state.range(0));
+    const auto points = make_aos(count, 1.0f);
+    std::vector<Vector3f> out(count);
+
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            out[i] = rotate(points[i], frame_rotation);
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_AoS_Rotate)->Arg(1 << 16)->Arg(1 << 21);
+
+template <soa::store_mode Mode>
+static void BM_SoA_Rotate(benchmark::State& state)
+{
+    const auto count = static_cast<std::size_t>(state.range(0));
+    const auto points = make_soa(count, 1.0f);
+    auto out = make_soa(count, 0.0f);
+
+    for (auto _ : state)
+    {
+        soa::rotate(out, frame_rotation, points, Mode);
+        benchmark::DoNotOptimize(out.data(0));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_SoA_Rotate<soa::store_mode::cached>)->Name("BM_SoA_Rotate_Cached")->Arg(1 << 16)->Arg(1 << 21);
+BENCHMARK(BM_SoA_Rotate<soa::store_mode::streaming>)->Name("BM_SoA_Rotate_Streaming")->Arg(1 << 16)->Arg(1 << 21);
+
+// a rotation per point, e.g. the orientations of a particle system
+static void BM_SoA_RotateEach(benchmark::State& state)
+{
+    const auto count = static_cast<std::size_t>(state.range(0));
+    const auto points = make_soa(count, 1.0f);
+    auto out = make_soa(count, 0.0f);
+    const std::vector<Quaternion<float>> rotations(count, frame_rotation);
+
+    for (auto _ : state)
+    {
+        soa::rotate(out, std::span<const Quaternion<float>>{ rotations }, points);
+        benchmark::DoNotOptimize(out.data(0));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_SoA_RotateEach)->Arg(1 << 16)->Arg(1 << 21);
+
+static void BM_SoA_RotateEach_Lanes(benchmark::State& state)
+{
+    const auto count = static_cast<std::size_t>(state.range(0));
+    const auto points = make_soa(count, 1.0f);
+    auto out = make_soa(count, 0.0f);
+    VectorSOA<4, float> rotations(count);
+    rotations.resize(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        rotations.data(0)[i] = frame_rotation.x();
+        rotations.data(1)[i] = frame_rotation.y();
+        rotations.data(2)[i] = frame_rotation.z();
+        rotations.data(3)[i] = frame_rotation.w();
+    }
+
+    for (auto _ : state)
+    {
+        soa::rotate(out, rotations, points);
+        benchmark::DoNotOptimize(out.data(0));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_SoA_RotateEach_Lanes)->Arg(1 << 16)->Arg(1 << 21);
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+// Standard-conforming allocator returning storage aligned to `Alignment` bytes (at least alignof(T)).
+template <typename T, std::size_t Alignment = 64>
+    requires (Alignment > 0 && (Alignment & (Alignment - 1)) == 0)
+class AlignedAllocator
+{
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using is_always_equal = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+
+    static constexpr std::size_t alignment = Alignment < alignof(T) ? alignof(T) : Alignment;
+
+    template <typename U>
+    struct rebind
+    {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    constexpr AlignedAllocator() noexcept = default;
+
+    template <typename U>
+    constexpr AlignedAllocator(const AlignedAllocator<U, Alignment> &) noexcept
+    { }
+
+    [[nodiscard]] T* allocate(std::size_t n)
+    {
+        if (n > std::numeric_limits<std::size_t>::max() / sizeof(T))
+        {
+            throw std::bad_array_new_length();
+        }
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{ alignment }));
+    }
+
+    void deallocate(T* ptr, std::size_t n) noexcept
+    {
+        ::operator delete(ptr, n * sizeof(T), std::align_val_t{ alignment });
+    }
+
+    template <typename U>
+    constexpr bool operator==(const AlignedAllocator<U, Alignment> &) const noexcept
+    {
+        return true;
+    }
+};
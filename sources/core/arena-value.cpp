@@ -0,0 +1,373 @@
+#include "arena-value.hpp"
+
+#include <charconv>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <unordered_set>
+#include <vector>
+
+#include "helpers/strings.hpp"
+#include "io/json-stream.hpp"
+
+constexpr std::string_view ARENA_MULTIPLE_ROOTS = "more than one top-level value";
+constexpr std::string_view ARENA_TOO_LARGE      = "string or container too large";
+
+// ---- ArenaValue ----
+
+int64_t ArenaValue::as_int() const noexcept
+{
+    switch (m_type)
+    {
+        case Type::Int:    return m_data.i;
+        case Type::Double: return static_cast<int64_t>(m_data.d);
+        default:           return 0;
+    }
+}
+
+double ArenaValue::as_double() const noexcept
+{
+    switch (m_type)
+    {
+        case Type::Int:    return static_cast<double>(m_data.i);
+        case Type::Double: return m_data.d;
+        default:           return 0.0;
+    }
+}
+
+std::string_view ArenaValue::as_string() const noexcept
+{
+    return m_type == Type::String ? std::string_view(m_data.string, m_size) : std::string_view{ };
+}
+
+std::span<const ArenaValue> ArenaValue::items() const noexcept
+{
+    return m_type == Type::Array ? std::span<const ArenaValue>(m_data.items, m_size) : std::span<const ArenaValue>{ };
+}
+
+std::span<const ArenaValue::Member> ArenaValue::members() const noexcept
+{
+    return m_type == Type::Object ? std::span<const Member>(m_data.members, m_size) : std::span<const Member>{ };
+}
+
+const ArenaValue & ArenaValue::operator[](size_t index) const
+{
+    if (m_type != Type::Array || index >= m_size)
+    {
+        throw std::invalid_argument("array index out of range");
+    }
+    return m_data.items[index];
+}
+
+const ArenaValue * ArenaValue::find(std::string_view key) const noexcept
+{
+    for (const auto & member : members())
+    {
+        // interned keys usually match by address; compare bytes for keys from elsewhere
+        if (member.key.size() == key.size()
+            && (member.key.data() == key.data() || std::memcmp(member.key.data(), key.data(), key.size()) == 0))
+        {
+            return &member.value;
+        }
+    }
+    return nullptr;
+}
+
+Value ArenaValue::to_value() const
+{
+    switch (m_type)
+    {
+        case Type::Null:   return {};
+        case Type::Int:    return Value{ m_data.i };
+        case Type::Double: return Value{ m_data.d };
+        case Type::String: return Value{ std::string(as_string()) };
+        case Type::Array:
+            {
+                auto array = Value::array_t{ };
+                array.reserve(m_size);
+                for (const auto & item : items())
+                {
+                    array.push_back(item.to_value());
+                }
+                return Value{ std::move(array) };
+            }
+        case Type::Object:
+            {
+                auto object = Value::object_t{ };
+                object.reserve(m_size);
+                for (const auto & member : members())
+                {
+                    object.insert_or_assign(std::string(member.key), member.value.to_value());
+                }
+                return Value{ std::move(object) };
+            }
+    }
+    return {};
+}
+
+// ---- ArenaBuilder ----
+
+// SAX handler assembling a document bottom-up: children collect on scratch stacks until their
+// container closes, then move into one contiguous arena block, so the arena never holds
+// abandoned partial arrays.
+class ArenaBuilder final : public IJsonHandler
+{
+public:
+    explicit ArenaBuilder(ArenaDocument & document)
+        : m_document(document)
+        , m_arena(document.arena())
+    { }
+
+    [[nodiscard]] std::string_view error() const noexcept { return m_error; }
+
+    bool beginObject() override { return open(true); }
+    bool beginArray() override { return open(false); }
+    bool endObject() override { return close(); }
+    bool endArray() override { return close(); }
+
+    bool key(std::string_view raw) override
+    {
+        if (raw.find('\\') == std::string_view::npos)
+        {
+            m_members.push_back({ m_document.intern(raw), { } });
+        }
+        else
+        {
+            m_scratch.resize(raw.size());
+            m_scratch.resize(str::unescape_to(raw, m_scratch.data()));
+            m_members.push_back({ m_document.intern(m_scratch), { } });
+        }
+        return true;
+    }
+
+    bool string(std::string_view raw) override
+    {
+        if (raw.size() > std::numeric_limits<uint32_t>::max())
+        {
+            return fail(ARENA_TOO_LARGE);
+        }
+
+        ArenaValue value;
+        value.m_type = ArenaValue::Type::String;
+        if (!raw.empty())
+        {
+            auto * out = static_cast<char *>(m_arena.allocate(raw.size(), 1));
+            value.m_size = raw.find('\\') == std::string_view::npos
+                ? (std::memcpy(out, raw.data(), raw.size()), static_cast<uint32_t>(raw.size()))
+                : static_cast<uint32_t>(str::unescape_to(raw, out));
+            value.m_data.string = out;
+        }
+        return add(value);
+    }
+
+    bool number(std::string_view text) override
+    {
+        ArenaValue value;
+        const auto begin = text.data();
+        const auto end = text.data() + text.size();
+
+        // integers stay exact unless they overflow 64 bits
+        if (text.find_first_of(".eE") == std::string_view::npos)
+        {
+            int64_t integer = 0;
+            const auto [ptr, error] = std::from_chars(begin, end, integer);
+            if (error == std::errc() && ptr == end)
+            {
+                value.m_type = ArenaValue::Type::Int;
+                value.m_data.i = integer;
+                return add(value);
+            }
+        }
+
+        double real = 0.0;
+        std::from_chars(begin, end, real);
+        value.m_type = ArenaValue::Type::Double;
+        value.m_data.d = real;
+        return add(value);
+    }
+
+    bool null() override
+    {
+        return add(ArenaValue{ });
+    }
+
+private:
+    struct Frame
+    {
+        bool object;
+        size_t start; // first child on the matching scratch stack
+    };
+
+    ArenaDocument & m_document;
+    std::pmr::memory_resource & m_arena;
+
+    std::vector<Frame> m_frames;
+    std::vector<ArenaValue> m_items;
+    std::vector<ArenaValue::Member> m_members;
+    std::string m_scratch;
+
+    bool m_done{ false };
+    std::string_view m_error;
+
+    bool open(bool object)
+    {
+        if (m_frames.empty() && m_done)
+        {
+            return fail(ARENA_MULTIPLE_ROOTS);
+        }
+        m_frames.push_back({ object, object ? m_members.size() : m_items.size() });
+        return true;
+    }
+
+    bool close()
+    {
+        const auto frame = m_frames.back();
+        m_frames.pop_back();
+
+        ArenaValue value;
+        value.m_type = frame.object ? ArenaValue::Type::Object : ArenaValue::Type::Array;
+        if (frame.object)
+        {
+            value.m_data.members = commit(m_members, frame.start, value.m_size);
+        }
+        else
+        {
+            value.m_data.items = commit(m_items, frame.start, value.m_size);
+        }
+
+        if (value.m_size == std::numeric_limits<uint32_t>::max())
+        {
+            return fail(ARENA_TOO_LARGE);
+        }
+        return add(value);
+    }
+
+    // moves the children above `start` into the arena and pops them off the scratch stack
+    template <typename T>
+    const T * commit(std::vector<T> & stack, size_t start, uint32_t & size)
+    {
+        const auto count = stack.size() - start;
+        if (count >= std::numeric_limits<uint32_t>::max())
+        {
+            size = std::numeric_limits<uint32_t>::max();
+            return nullptr;
+        }
+
+        size = static_cast<uint32_t>(count);
+        if (count == 0)
+        {
+            return nullptr;
+        }
+
+        auto * block = static_cast<T *>(m_arena.allocate(count * sizeof(T), alignof(T)));
+        std::memcpy(static_cast<void *>(block), stack.data() + start, count * sizeof(T));
+        stack.resize(start);
+        return block;
+    }
+
+    bool add(const ArenaValue & value)
+    {
+        if (m_frames.empty())
+        {
+            if (m_done)
+            {
+                return fail(ARENA_MULTIPLE_ROOTS);
+            }
+            m_document.m_root = value;
+            m_done = true;
+        }
+        else if (m_frames.back().object)
+        {
+            m_members.back().value = value;
+        }
+        else
+        {
+            m_items.push_back(value);
+        }
+        return true;
+    }
+
+    bool fail(std::string_view message)
+    {
+        m_error = message;
+        return false;
+    }
+};
+
+// ---- ArenaDocument ----
+
+struct ArenaDocument::Storage
+{
+    std::pmr::monotonic_buffer_resource arena;
+    std::pmr::unordered_set<std::string_view> keys; // views into the arena
+
+    Storage(size_t initial, std::pmr::memory_resource * upstream)
+        : arena(initial, upstream)
+        , keys(&arena)
+    { }
+};
+
+ArenaDocument::ArenaDocument(std::pmr::memory_resource * upstream)
+    : m_upstream(upstream)
+{
+    reset(0);
+}
+
+ArenaDocument::~ArenaDocument() = default;
+ArenaDocument::ArenaDocument(ArenaDocument &&) noexcept = default;
+ArenaDocument & ArenaDocument::operator=(ArenaDocument &&) noexcept = default;
+
+bool ArenaDocument::parse(std::string_view json)
+{
+    // nodes and unescaped strings rarely outgrow the text they came from
+    reset(json.size());
+
+    ArenaBuilder builder{ *this };
+    JsonStreamParser parser{ builder };
+    if (parser.parse(json))
+    {
+        return true;
+    }
+
+    const auto error = builder.error().empty() ? parser.error() : builder.error();
+    reset(0);
+    m_error = error;
+    return false;
+}
+
+void ArenaDocument::clear()
+{
+    reset(0);
+}
+
+std::string_view ArenaDocument::intern(std::string_view key)
+{
+    auto & keys = m_storage->keys;
+    if (const auto it = keys.find(key); it != keys.end())
+    {
+        return *it;
+    }
+
+    auto * copy = static_cast<char *>(m_storage->arena.allocate(key.size() > 0 ? key.size() : 1, 1));
+    std::memcpy(copy, key.data(), key.size());
+    return *keys.emplace(copy, key.size()).first;
+}
+
+size_t ArenaDocument::key_count() const noexcept
+{
+    return m_storage->keys.size();
+}
+
+std::pmr::memory_resource & ArenaDocument::arena() noexcept
+{
+    return m_storage->arena;
+}
+
+void ArenaDocument::reset(size_t hint)
+{
+    constexpr size_t minimum = 1024;
+    m_storage.reset();
+    m_storage = std::make_unique<Storage>(hint > minimum ? hint : minimum, m_upstream);
+    m_root = ArenaValue{ };
+    m_error = { };
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <span>
+#include <string_view>
+
+#include "value.hpp"
+
+class ArenaDocument;
+
+// Read-only JSON node living in an ArenaDocument. It is 16 bytes and trivially destructible:
+// strings, array items and object members are contiguous blocks in the document's arena, and
+// object keys are interned, so equal keys share one copy. Objects are flat arrays of members in
+// document order, which beats a hash map for the handful of keys typical objects have.
+class ArenaValue
+{
+public:
+    enum class Type : uint8_t { Null, Int, Double, String, Array, Object };
+
+    struct Member;
+
+    ArenaValue() noexcept = default;
+
+    [[nodiscard]] Type type() const noexcept { return m_type; }
+    [[nodiscard]] bool is_null() const noexcept { return m_type == Type::Null; }
+    [[nodiscard]] bool is_number() const noexcept { return m_type == Type::Int || m_type == Type::Double; }
+
+    [[nodiscard]] int64_t as_int() const noexcept;
+    [[nodiscard]] double as_double() const noexcept; // Int converts
+    [[nodiscard]] std::string_view as_string() const noexcept;
+
+    // items of an array, members of an object (empty otherwise)
+    [[nodiscard]] std::span<const ArenaValue> items() const noexcept;
+    [[nodiscard]] std::span<const Member> members() const noexcept;
+
+    // element count of an array or object, byte length of a string
+    [[nodiscard]] size_t size() const noexcept { return m_size; }
+
+    // array item; throws std::invalid_argument if this is not an array or the index is out of range
+    [[nodiscard]] const ArenaValue & operator[](size_t index) const;
+
+    // object member by key, nullptr if missing or if this is not an object
+    [[nodiscard]] const ArenaValue * find(std::string_view key) const noexcept;
+
+    // deep copy into the regular heap-allocated representation
+    [[nodiscard]] Value to_value() const;
+
+private:
+    friend class ArenaDocument;
+    friend class ArenaBuilder;
+
+    Type m_type{ Type::Null };
+    uint32_t m_size{ 0 };
+    union
+    {
+        int64_t i;
+        double d;
+        const char * string;
+        const ArenaValue * items;
+        const Member * members;
+    } m_data{ 0 };
+};
+
+struct ArenaValue::Member
+{
+    std::string_view key; // interned
+    ArenaValue value;
+};
+
+// Owns the memory of a parsed document. Nodes, strings and the key table are carved out of a
+// monotonic buffer sized from the input, so parsing costs a few large allocations instead of
+// one per string and container, and dropping the document frees them all at once.
+class ArenaDocument
+{
+public:
+    explicit ArenaDocument(std::pmr::memory_resource * upstream = std::pmr::get_default_resource());
+    ~ArenaDocument();
+
+    ArenaDocument(ArenaDocument &&) noexcept;
+    ArenaDocument & operator=(ArenaDocument &&) noexcept;
+
+    // replaces the contents, invalidating earlier values; on a syntax error returns false and
+    // leaves a null root
+    bool parse(std::string_view json);
+
+    void clear();
+
+    [[nodiscard]] const ArenaValue & root() const noexcept { return m_root; }
+    [[nodiscard]] std::string_view error() const noexcept { return m_error; }
+
+    // stable copy of `key` in the arena, shared by all equal keys
+    std::string_view intern(std::string_view key);
+
+    // distinct keys interned so far
+    [[nodiscard]] size_t key_count() const noexcept;
+
+private:
+    friend class ArenaBuilder;
+
+    struct Storage;
+
+    std::pmr::memory_resource * m_upstream;
+    std::unique_ptr<Storage> m_storage;
+    ArenaValue m_root;
+    std::string_view m_error;
+
+    [[nodiscard]] std::pmr::memory_resource & arena() noexcept;
+    void reset(size_t hint);
+};
@@ -0,0 +1,376 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// Bounded lock-free ring-buffer channels for streaming data between modules.
+//
+// try_push/try_pop and their batch forms never block and never enter the kernel, so MAX_RATE
+// modules can poll them every step. pop_wait() blocks on a futex through std::atomic::wait for
+// consumers that would rather sleep; producers only pay for the wake-up when someone waits.
+// close() wakes every waiter for shutdown; anything already queued can still be popped.
+namespace channel_detail
+{
+    inline constexpr std::size_t cache_line = 64;
+
+    inline std::size_t round_capacity(std::size_t capacity)
+    {
+        if (capacity == 0 || capacity > (std::size_t{ 1 } << (sizeof(std::size_t) * 8 - 2)))
+        {
+            throw std::invalid_argument("channel capacity out of range");
+        }
+
+        std::size_t rounded = 2;
+        while (rounded < capacity)
+        {
+            rounded <<= 1;
+        }
+        return rounded;
+    }
+
+    // Wakes consumers blocked in pop_wait(). The seq_cst fences on both sides order
+    // "publish data, then look for waiters" against "announce waiter, then look for data",
+    // so one of the two always sees the other.
+    class Waker
+    {
+        alignas(cache_line) std::atomic<std::uint32_t> m_epoch{ 0 };
+        std::atomic<std::uint32_t> m_waiters{ 0 };
+        std::atomic<bool> m_closed{ false };
+
+    public:
+        void notify() noexcept
+        {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (m_waiters.load(std::memory_order_relaxed) != 0)
+            {
+                m_epoch.fetch_add(1, std::memory_order_relaxed);
+                m_epoch.notify_all();
+            }
+        }
+
+        void close() noexcept
+        {
+            m_closed.store(true, std::memory_order_release);
+            m_epoch.fetch_add(1, std::memory_order_release);
+            m_epoch.notify_all();
+        }
+
+        [[nodiscard]] bool closed() const noexcept
+        {
+            return m_closed.load(std::memory_order_acquire);
+        }
+
+        // runs attempt() until it succeeds or the channel is closed and attempt() still fails
+        template <typename Attempt>
+        bool wait(Attempt && attempt)
+        {
+            while (true)
+            {
+                if (attempt())
+                {
+                    return true;
+                }
+
+                m_waiters.fetch_add(1, std::memory_order_relaxed);
+                const auto epoch = m_epoch.load(std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+
+                if (attempt())
+                {
+                    m_waiters.fetch_sub(1, std::memory_order_relaxed);
+                    return true;
+                }
+                if (closed())
+                {
+                    m_waiters.fetch_sub(1, std::memory_order_relaxed);
+                    return attempt();
+                }
+
+                m_epoch.wait(epoch, std::memory_order_relaxed);
+                m_waiters.fetch_sub(1, std::memory_order_relaxed);
+            }
+        }
+    };
+}
+
+// Single producer, single consumer. Each side keeps a cached copy of the other side's index
+// and only reloads it when the ring looks full (or empty), so the indices' cache lines stay
+// mostly unshared.
+template <typename T>
+    requires std::is_default_constructible_v<T> && std::is_move_assignable_v<T>
+class SpscChannel
+{
+    static constexpr auto cache_line = channel_detail::cache_line;
+
+    std::size_t          m_mask;
+    std::unique_ptr<T[]> m_buffer;
+
+    // consumer side
+    alignas(cache_line) std::atomic<std::size_t> m_head{ 0 };
+    std::size_t m_cachedTail{ 0 };
+
+    // producer side
+    alignas(cache_line) std::atomic<std::size_t> m_tail{ 0 };
+    std::size_t m_cachedHead{ 0 };
+
+    channel_detail::Waker m_waker;
+
+public:
+    explicit SpscChannel(std::size_t capacity)
+        : m_mask(channel_detail::round_capacity(capacity) - 1)
+        , m_buffer(std::make_unique<T[]>(m_mask + 1))
+    { }
+
+    SpscChannel(const SpscChannel &) = delete;
+    SpscChannel & operator=(const SpscChannel &) = delete;
+
+    [[nodiscard]] std::size_t capacity() const noexcept { return m_mask + 1; }
+
+    // approximate while the other side is active
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+    }
+
+    template <typename U>
+        requires std::is_assignable_v<T&, U&&>
+    bool try_push(U && value)
+    {
+        const auto tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_cachedHead > m_mask)
+        {
+            m_cachedHead = m_head.load(std::memory_order_acquire);
+            if (tail - m_cachedHead > m_mask)
+            {
+                return false;
+            }
+        }
+
+        m_buffer[tail & m_mask] = std::forward<U>(value);
+        m_tail.store(tail + 1, std::memory_order_release);
+        m_waker.notify();
+        return true;
+    }
+
+    // pushes as many leading values as fit, publishing them at once; returns how many
+    std::size_t push_n(std::span<const T> values)
+    {
+        const auto tail = m_tail.load(std::memory_order_relaxed);
+        if (capacity() - (tail - m_cachedHead) < values.size())
+        {
+            m_cachedHead = m_head.load(std::memory_order_acquire);
+        }
+
+        const auto free = capacity() - (tail - m_cachedHead);
+        const auto count = values.size() < free ? values.size() : free;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            m_buffer[(tail + i) & m_mask] = values[i];
+        }
+
+        if (count > 0)
+        {
+            m_tail.store(tail + count, std::memory_order_release);
+            m_waker.notify();
+        }
+        return count;
+    }
+
+    bool try_pop(T & out)
+    {
+        const auto head = m_head.load(std::memory_order_relaxed);
+        if (head == m_cachedTail)
+        {
+            m_cachedTail = m_tail.load(std::memory_order_acquire);
+            if (head == m_cachedTail)
+            {
+                return false;
+            }
+        }
+
+        out = std::move(m_buffer[head & m_mask]);
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // pops up to out.size() values; returns how many
+    std::size_t pop_n(std::span<T> out)
+    {
+        const auto head = m_head.load(std::memory_order_relaxed);
+        if (m_cachedTail - head < out.size())
+        {
+            m_cachedTail = m_tail.load(std::memory_order_acquire);
+        }
+
+        const auto available = m_cachedTail - head;
+        const auto count = out.size() < available ? out.size() : available;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            out[i] = std::move(m_buffer[(head + i) & m_mask]);
+        }
+
+        if (count > 0)
+        {
+            m_head.store(head + count, std::memory_order_release);
+        }
+        return count;
+    }
+
+    // blocks until a value arrives; false once the channel is closed and drained
+    bool pop_wait(T & out)
+    {
+        return m_waker.wait([&] { return try_pop(out); });
+    }
+
+    void close() noexcept { m_waker.close(); }
+    [[nodiscard]] bool closed() const noexcept { return m_waker.closed(); }
+};
+
+// Multiple producers, multiple consumers: Vyukov's bounded queue. Every cell carries a sequence
+// number telling whether it is ready to be written (== position) or read (== position + 1) for
+// the current lap, so producers and consumers only contend on their own counter.
+template <typename T>
+    requires std::is_default_constructible_v<T> && std::is_move_assignable_v<T>
+class MpmcChannel
+{
+    static constexpr auto cache_line = channel_detail::cache_line;
+
+    struct Cell
+    {
+        std::atomic<std::size_t> sequence;
+        T value;
+    };
+
+    std::size_t             m_mask;
+    std::unique_ptr<Cell[]> m_cells;
+
+    alignas(cache_line) std::atomic<std::size_t> m_enqueue{ 0 };
+    alignas(cache_line) std::atomic<std::size_t> m_dequeue{ 0 };
+
+    channel_detail::Waker m_waker;
+
+public:
+    explicit MpmcChannel(std::size_t capacity)
+        : m_mask(channel_detail::round_capacity(capacity) - 1)
+        , m_cells(std::make_unique<Cell[]>(m_mask + 1))
+    {
+        for (std::size_t i = 0; i <= m_mask; ++i)
+        {
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpmcChannel(const MpmcChannel &) = delete;
+    MpmcChannel & operator=(const MpmcChannel &) = delete;
+
+    [[nodiscard]] std::size_t capacity() const noexcept { return m_mask + 1; }
+
+    template <typename U>
+        requires std::is_assignable_v<T&, U&&>
+    bool try_push(U && value)
+    {
+        std::size_t position;
+        Cell * cell = claim(m_enqueue, 0, position);
+        if (cell == nullptr)
+        {
+            return false;
+        }
+
+        cell->value = std::forward<U>(value);
+        cell->sequence.store(position + 1, std::memory_order_release);
+        m_waker.notify();
+        return true;
+    }
+
+    // values are claimed one cell at a time, so concurrent producers may interleave
+    std::size_t push_n(std::span<const T> values)
+    {
+        std::size_t count = 0;
+        while (count < values.size())
+        {
+            std::size_t position;
+            Cell * cell = claim(m_enqueue, 0, position);
+            if (cell == nullptr)
+            {
+                break;
+            }
+            cell->value = values[count++];
+            cell->sequence.store(position + 1, std::memory_order_release);
+        }
+
+        if (count > 0)
+        {
+            m_waker.notify();
+        }
+        return count;
+    }
+
+    bool try_pop(T & out)
+    {
+        std::size_t position;
+        Cell * cell = claim(m_dequeue, 1, position);
+        if (cell == nullptr)
+        {
+            return false;
+        }
+
+        out = std::move(cell->value);
+        cell->sequence.store(position + m_mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    std::size_t pop_n(std::span<T> out)
+    {
+        std::size_t count = 0;
+        while (count < out.size() && try_pop(out[count]))
+        {
+            ++count;
+        }
+        return count;
+    }
+
+    bool pop_wait(T & out)
+    {
+        return m_waker.wait([&] { return try_pop(out); });
+    }
+
+    void close() noexcept { m_waker.close(); }
+    [[nodiscard]] bool closed() const noexcept { return m_waker.closed(); }
+
+private:
+    // Claims the cell at `counter` once its sequence equals position + lag (0 for producers,
+    // 1 for consumers), returning the claimed position through `position`.
+    Cell * claim(std::atomic<std::size_t> & counter, std::size_t lag, std::size_t & position) noexcept
+    {
+        position = counter.load(std::memory_order_relaxed);
+        while (true)
+        {
+            Cell * cell = &m_cells[position & m_mask];
+            const auto sequence = cell->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position + lag);
+
+            if (diff == 0)
+            {
+                if (counter.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    return cell;
+                }
+            }
+            else if (diff < 0)
+            {
+                // full for producers, empty for consumers
+                return nullptr;
+            }
+            else
+            {
+                position = counter.load(std::memory_order_relaxed);
+            }
+        }
+    }
+};
@@ -0,0 +1,140 @@
+#include "concurrent-handle.hpp"
+
+#include <stdexcept>
+
+ConcurrentHandleRegister::ConcurrentHandleRegister(std::size_t handleCapacity)
+{
+    // invalid_id itself can never be handed out
+    if (handleCapacity >= static_cast<std::size_t>(invalid_id))
+    {
+        throw std::invalid_argument("handleCapacity exceeds uint32_t range");
+    }
+
+    m_capacity = handleCapacity;
+    m_slots = std::make_unique<Slot[]>(handleCapacity);
+}
+
+Handle ConcurrentHandleRegister::insert(uint32_t index)
+{
+    if (index == invalid_index)
+    {
+        return { };
+    }
+
+    const auto id = acquire_id();
+    if (id == invalid_id)
+    {
+        return { };
+    }
+
+    // the id is exclusively ours until it becomes visible through the returned handle
+    auto & state = m_slots[id].state;
+    const auto generation = high(state.load(std::memory_order_relaxed));
+    state.store(pack(generation, index), std::memory_order_release);
+
+    return Handle{ id, generation };
+}
+
+bool ConcurrentHandleRegister::update(Handle handle, uint32_t index)
+{
+    if (handle.id >= m_capacity || index == invalid_index)
+    {
+        return false;
+    }
+
+    auto & state = m_slots[handle.id].state;
+    auto current = state.load(std::memory_order_acquire);
+    do
+    {
+        if (high(current) != handle.generation || low(current) == invalid_index)
+        {
+            return false;
+        }
+    }
+    while (!state.compare_exchange_weak(current, pack(handle.generation, index),
+                                        std::memory_order_acq_rel, std::memory_order_acquire));
+
+    return true;
+}
+
+void ConcurrentHandleRegister::erase(Handle handle)
+{
+    if (handle.id >= m_capacity)
+    {
+        // do nothing
+        return;
+    }
+
+    // bumping the generation invalidates every copy of the handle at once; only the thread
+    // whose exchange succeeds returns the id to the free-list
+    auto & state = m_slots[handle.id].state;
+    auto current = state.load(std::memory_order_acquire);
+    do
+    {
+        if (high(current) != handle.generation || low(current) == invalid_index)
+        {
+            return;
+        }
+    }
+    while (!state.compare_exchange_weak(current, pack(handle.generation + 1u, invalid_index),
+                                        std::memory_order_acq_rel, std::memory_order_acquire));
+
+    release_id(handle.id);
+}
+
+bool ConcurrentHandleRegister::is_valid(Handle handle) const noexcept
+{
+    return get_index(handle) != invalid_index;
+}
+
+uint32_t ConcurrentHandleRegister::get_index(Handle handle) const noexcept
+{
+    if (handle.id >= m_capacity)
+    {
+        return invalid_index;
+    }
+
+    const auto current = m_slots[handle.id].state.load(std::memory_order_acquire);
+    return high(current) == handle.generation ? low(current) : invalid_index;
+}
+
+uint32_t ConcurrentHandleRegister::acquire_id() noexcept
+{
+    // reuse a freed id first; the tag changes on every pop so a head that was popped and
+    // pushed back in between cannot be mistaken for the one we read
+    auto head = m_freeHead.load(std::memory_order_acquire);
+    while (low(head) != invalid_id)
+    {
+        const auto id = low(head);
+        const auto next = m_slots[id].next.load(std::memory_order_relaxed);
+        if (m_freeHead.compare_exchange_weak(head, pack(high(head) + 1u, next),
+                                             std::memory_order_acq_rel, std::memory_order_acquire))
+        {
+            return id;
+        }
+    }
+
+    // otherwise, hand out a new id while any remain
+    auto id = m_nextId.load(std::memory_order_relaxed);
+    do
+    {
+        if (id >= m_capacity)
+        {
+            return invalid_id;
+        }
+    }
+    while (!m_nextId.compare_exchange_weak(id, id + 1u, std::memory_order_relaxed));
+
+    return id;
+}
+
+void ConcurrentHandleRegister::release_id(uint32_t id) noexcept
+{
+    auto head = m_freeHead.load(std::memory_order_relaxed);
+    do
+    {
+        m_slots[id].next.store(low(head), std::memory_order_relaxed);
+    }
+    while (!m_freeHead.compare_exchange_weak(head, pack(high(head) + 1u, id),
+                                             std::memory_order_release, std::memory_order_relaxed));
+}
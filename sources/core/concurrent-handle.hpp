@@ -0,0 +1,69 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+
+#include "handle.hpp"
+
+// Thread-safe counterpart of HandleRegister with the same Handle/generation semantics.
+// Each id owns one slot packing (generation, index) into a single atomic word, so is_valid()
+// and get_index() are one atomic load (wait-free). Freed ids go on a lock-free Treiber stack
+// whose head carries a tag; together with the generation bump on erase this keeps both the
+// free-list and stale handles ABA-safe.
+//
+// The id capacity is fixed at construction: slots never move, which is what lets readers
+// run without locks. Unlike HandleRegister there is no index -> id reverse map, so callers
+// are responsible for not mapping two live handles to the same index.
+class ConcurrentHandleRegister
+{
+public:
+    static constexpr auto invalid_id = HandleRegister::invalid_id;
+    static constexpr auto invalid_index = HandleRegister::invalid_index;
+
+    explicit ConcurrentHandleRegister(std::size_t handleCapacity);
+
+    ConcurrentHandleRegister(const ConcurrentHandleRegister &) = delete;
+    ConcurrentHandleRegister & operator=(const ConcurrentHandleRegister &) = delete;
+
+    // returns an invalid handle once every id is in use
+    Handle insert(uint32_t index);
+    bool update(Handle handle, uint32_t index);
+    void erase(Handle handle);
+
+    [[nodiscard]] bool is_valid(Handle handle) const noexcept;
+    [[nodiscard]] uint32_t get_index(Handle handle) const noexcept;
+
+    [[nodiscard]] std::size_t capacity() const noexcept { return m_capacity; }
+
+private:
+    struct Slot
+    {
+        // generation in the high half, index in the low half
+        std::atomic<std::uint64_t> state{ pack(0, invalid_index) };
+
+        // next free id while the slot sits on the free-list
+        std::atomic<std::uint32_t> next{ invalid_id };
+    };
+
+    static constexpr std::uint64_t pack(std::uint32_t high, std::uint32_t low) noexcept
+    {
+        return (static_cast<std::uint64_t>(high) << 32) | low;
+    }
+
+    static constexpr std::uint32_t high(std::uint64_t word) noexcept { return static_cast<std::uint32_t>(word >> 32); }
+    static constexpr std::uint32_t low(std::uint64_t word) noexcept { return static_cast<std::uint32_t>(word); }
+
+    uint32_t acquire_id() noexcept;
+    void release_id(uint32_t id) noexcept;
+
+    std::size_t m_capacity{ 0 };
+    std::unique_ptr<Slot[]> m_slots;
+
+    // free-list head: ABA tag in the high half, id in the low half
+    alignas(64) std::atomic<std::uint64_t> m_freeHead{ pack(0, invalid_id) };
+
+    // first id never handed out yet
+    alignas(64) std::atomic<std::uint32_t> m_nextId{ 0 };
+};
@@ -1,6 +1,7 @@
 #include "handle.hpp"
 
 #include <stdexcept>
+#include <utility>
 
 namespace
 {
@@ -11,53 +12,102 @@ namespace
             container.resize(n, fill);
         }
     }
+
+    // how many handles ahead resolve() prefetches
+    constexpr std::size_t prefetch_distance = 8;
+
+    inline void prefetch(const void * address) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(address);
+#else
+        (void)address;
+#endif
+    }
+}
+
+HandleRegister::HandleRegister(HandleRegister && other) noexcept
+    : m_slots(std::move(other.m_slots))
+    , m_indexToId(std::move(other.m_indexToId))
+    , m_freeHead(std::exchange(other.m_freeHead, free_list_end))
+{
+    other.m_slots.clear();
+    other.m_indexToId.clear();
+}
+
+HandleRegister & HandleRegister::operator=(HandleRegister && other) noexcept
+{
+    if (this != &other)
+    {
+        m_slots = std::move(other.m_slots);
+        m_indexToId = std::move(other.m_indexToId);
+        m_freeHead = std::exchange(other.m_freeHead, free_list_end);
+        other.m_slots.clear();
+        other.m_indexToId.clear();
+    }
+    return *this;
 }
 
 void HandleRegister::reserve(std::size_t handleCapacity, std::size_t indexCapacity)
 {
-    if (handleCapacity > static_cast<std::size_t>(std::numeric_limits<std::uint32_t>::max()))
+    if (handleCapacity > static_cast<std::size_t>(max_capacity))
     {
-        throw std::invalid_argument("handleCapacity exceeds uint32_t range");
+        throw std::invalid_argument("handleCapacity exceeds HandleRegister::max_capacity");
     }
 
-    if (indexCapacity > static_cast<std::size_t>(std::numeric_limits<std::uint32_t>::max()))
+    if (indexCapacity > static_cast<std::size_t>(max_capacity))
     {
-        throw std::invalid_argument("indexCapacity exceeds uint32_t range");
+        throw std::invalid_argument("indexCapacity exceeds HandleRegister::max_capacity");
     }
 
-    m_idToIndex.reserve(handleCapacity);
-    m_generations.reserve(handleCapacity);
-    m_freeIds.reserve(handleCapacity);
+    m_slots.reserve(handleCapacity);
     m_indexToId.reserve(indexCapacity);
 }
 
 void HandleRegister::resize(std::size_t handleCapacity, std::size_t indexCapacity)
 {
-    if (handleCapacity > static_cast<std::size_t>(std::numeric_limits<std::uint32_t>::max()))
+    if (handleCapacity > static_cast<std::size_t>(max_capacity))
     {
-        throw std::invalid_argument("handleCapacity exceeds uint32_t range");
+        throw std::invalid_argument("handleCapacity exceeds HandleRegister::max_capacity");
     }
 
-    if (indexCapacity > static_cast<std::size_t>(std::numeric_limits<std::uint32_t>::max()))
+    if (indexCapacity > static_cast<std::size_t>(max_capacity))
     {
-        throw std::invalid_argument("indexCapacity exceeds uint32_t range");
+        throw std::invalid_argument("indexCapacity exceeds HandleRegister::max_capacity");
     }
 
-    if (handleCapacity < m_freeIds.size())
+    // live ids past the new handle capacity disappear together with their reverse mapping
+    for (std::size_t id = handleCapacity; id < m_slots.size(); ++id)
     {
-        std::erase_if(m_freeIds, [=](std::uint32_t id) {
-            return id >= handleCapacity;
-        });
+        if (!is_free(m_slots[id]))
+        {
+            m_indexToId[index_of(m_slots[id])] = invalid_id;
+        }
+    }
+
+    m_slots.resize(handleCapacity, pack(0, free_flag | free_list_end));
+
+    // live ids whose index falls past the new index capacity are erased
+    for (auto & slot : m_slots)
+    {
+        if (!is_free(slot) && index_of(slot) >= indexCapacity)
+        {
+            slot = pack(generation_of(slot) + 1u, free_flag | free_list_end);
+        }
     }
 
-    m_idToIndex.resize(handleCapacity, invalid_index);
-    m_generations.resize(handleCapacity, 0);
     m_indexToId.resize(indexCapacity, invalid_id);
-    m_freeIds.resize(handleCapacity);
+
+    rebuild_free_list();
 }
 
 Handle HandleRegister::insert(uint32_t index)
 {
+    if (index >= max_capacity)
+    {
+        throw std::invalid_argument("index exceeds HandleRegister::max_capacity");
+    }
+
     ensure_size(m_indexToId, static_cast<std::size_t>(index) + 1u, invalid_id);
 
     // refuse to create new handles for already existing indices
@@ -66,40 +116,58 @@ Handle HandleRegister::insert(uint32_t index)
         return { };
     }
 
-    // if at least one valid id is available
-    uint32_t id = invalid_id;
-    if (!m_freeIds.empty())
+    const auto id = acquire_id();
+    const auto generation = generation_of(m_slots[id]);
+
+    m_indexToId[index] = id;
+    m_slots[id] = pack(generation, index);
+
+    return Handle{ id, generation };
+}
+
+void HandleRegister::insert(uint32_t firstIndex, std::span<Handle> out)
+{
+    if (out.empty())
     {
-        while (id >= m_generations.size() || id >= m_idToIndex.size())
-        {
-            id = m_freeIds.back();
-            m_freeIds.pop_back();
-        }
+        return;
     }
 
-    // otherwise, we need to use a new id
-    if (id == invalid_id)
+    if (static_cast<std::size_t>(firstIndex) + out.size() > static_cast<std::size_t>(max_capacity))
     {
-        id = static_cast<uint32_t>(m_generations.size());
-        m_idToIndex.push_back(invalid_index);
-        m_generations.push_back(0);
+        throw std::invalid_argument("index range exceeds HandleRegister::max_capacity");
     }
 
-    m_indexToId[index] = id;
-    m_idToIndex[id] = index;
+    ensure_size(m_indexToId, static_cast<std::size_t>(firstIndex) + out.size(), invalid_id);
+
+    for (std::size_t i = 0; i < out.size(); ++i)
+    {
+        const auto index = static_cast<uint32_t>(firstIndex + i);
 
-    return Handle{ id, m_generations[id] };
+        // refuse to create new handles for already existing indices
+        if (m_indexToId[index] != invalid_id)
+        {
+            out[i] = { };
+            continue;
+        }
+
+        const auto id = acquire_id();
+        const auto generation = generation_of(m_slots[id]);
+
+        m_indexToId[index] = id;
+        m_slots[id] = pack(generation, index);
+        out[i] = Handle{ id, generation };
+    }
 }
 
 bool HandleRegister::update(Handle handle, uint32_t index)
 {
-    if (!is_valid(handle))
+    if (!is_valid(handle) || index >= max_capacity)
     {
         return false;
     }
 
     const auto id = handle.id;
-    const auto oldIndex = m_idToIndex[id];
+    const auto oldIndex = index_of(m_slots[id]);
 
     ensure_size(m_indexToId, static_cast<std::size_t>(index) + 1u, invalid_id);
 
@@ -109,13 +177,10 @@ bool HandleRegister::update(Handle handle, uint32_t index)
         return false;
     }
 
-    // avoid clearing the old reverse mapping if we don't own it
-    if (oldIndex != invalid_index && oldIndex < m_indexToId.size() && m_indexToId[oldIndex] == id)
-    {
-        m_indexToId[oldIndex] = invalid_id;
-    }
+    // a valid handle always owns its reverse mapping
+    m_indexToId[oldIndex] = invalid_id;
 
-    m_idToIndex[id] = index;
+    m_slots[id] = pack(handle.generation, index);
     m_indexToId[index] = id;
 
     return true;
@@ -130,47 +195,100 @@ void HandleRegister::erase(Handle handle)
     }
 
     const auto id = handle.id;
-    const auto index = m_idToIndex[id];
 
-    // avoid clearing reverse mapping if we don't own it
-    if (index != invalid_index && index < m_indexToId.size() && m_indexToId[index] == id)
+    // a valid handle always owns its reverse mapping
+    m_indexToId[index_of(m_slots[id])] = invalid_id;
+
+    release_id(id, handle.generation + 1u);
+}
+
+bool HandleRegister::is_valid(Handle handle) const noexcept
+{
+    return get_index(handle) != invalid_index;
+}
+
+uint32_t HandleRegister::get_index(Handle handle) const noexcept
+{
+    // invalid_id is never below the slot count, so this also rejects default handles
+    if (handle.id >= m_slots.size())
     {
-        m_indexToId[index] = invalid_id;
+        return invalid_index;
     }
 
-    m_idToIndex[id] = invalid_index;
-    m_freeIds.push_back(id);
-    m_generations[id]++;
+    // live means same generation and a clear free_flag, compared as one 33-bit prefix;
+    // resize() keeps live indices in range
+    const auto slot = m_slots[handle.id];
+    const bool live = (slot >> 31) == (static_cast<std::uint64_t>(handle.generation) << 1);
+    return live ? index_of(slot) : invalid_index;
 }
 
-bool HandleRegister::is_valid(Handle handle) const noexcept
+Handle HandleRegister::get_handle(uint32_t index) const noexcept
 {
-    const auto id = handle.id;
-    if (id == invalid_id
-     || id >= m_idToIndex.size()
-     || id >= m_generations.size()
-     || m_generations[id] != handle.generation)
+    if (index >= m_indexToId.size())
     {
-        return false;
+        return { };
     }
 
-    const auto index = m_idToIndex[id];
-    if (index == invalid_index
-     || index >= m_indexToId.size()
-     || m_indexToId[index] != id)
+    const auto id = m_indexToId[index];
+    if (id == invalid_id)
     {
-        return false;
+        return { };
     }
 
-    return true;
+    return Handle{ id, generation_of(m_slots[id]) };
 }
 
-uint32_t HandleRegister::get_index(Handle handle) const noexcept
+void HandleRegister::resolve(std::span<const Handle> handles, std::span<uint32_t> out) const noexcept
 {
-    if (!is_valid(handle))
+    const auto count = handles.size() < out.size() ? handles.size() : out.size();
+    const auto slots = m_slots.size();
+
+    for (std::size_t i = 0; i < count; ++i)
     {
-        return invalid_index;
+        if (i + prefetch_distance < count && handles[i + prefetch_distance].id < slots)
+        {
+            prefetch(&m_slots[handles[i + prefetch_distance].id]);
+        }
+
+        out[i] = get_index(handles[i]);
+    }
+}
+
+uint32_t HandleRegister::acquire_id()
+{
+    // pop the free-list, free_list_end is past any valid id
+    if (m_freeHead < m_slots.size())
+    {
+        const auto id = m_freeHead;
+        m_freeHead = next_free_of(m_slots[id]);
+        return id;
+    }
+
+    // otherwise, we need to use a new id
+    if (m_slots.size() >= max_capacity)
+    {
+        throw std::length_error("HandleRegister ran out of ids");
     }
 
-    return m_idToIndex[handle.id];
+    m_slots.push_back(pack(0, free_flag | free_list_end));
+    return static_cast<uint32_t>(m_slots.size() - 1);
+}
+
+void HandleRegister::release_id(uint32_t id, uint32_t generation) noexcept
+{
+    m_slots[id] = pack(generation, free_flag | m_freeHead);
+    m_freeHead = id;
+}
+
+void HandleRegister::rebuild_free_list() noexcept
+{
+    // relink from the top so the lowest free ids are handed out first
+    m_freeHead = free_list_end;
+    for (std::size_t id = m_slots.size(); id-- > 0;)
+    {
+        if (is_free(m_slots[id]))
+        {
+            release_id(static_cast<uint32_t>(id), generation_of(m_slots[id]));
+        }
+    }
 }
@@ -1,8 +1,9 @@
 #pragma once
 
 #include <cstdint>
+#include <limits>
+#include <span>
 #include <vector>
-#include <numeric>
 
 class HandleRegister;
 
@@ -25,19 +26,58 @@ public:
     static constexpr auto invalid_id = std::numeric_limits<std::uint32_t>::max();
     static constexpr auto invalid_index = std::numeric_limits<std::uint32_t>::max();
 
+    // ids and indices are 31-bit: the top bit of a slot's low half marks it as free
+    static constexpr std::uint32_t max_capacity = 0x7fffffffu;
+
+    HandleRegister() = default;
+    HandleRegister(const HandleRegister &) = default;
+    HandleRegister & operator=(const HandleRegister &) = default;
+
+    // a moved-from register is empty and reusable
+    HandleRegister(HandleRegister && other) noexcept;
+    HandleRegister & operator=(HandleRegister && other) noexcept;
+
     void reserve(std::size_t handleCapacity, std::size_t indexCapacity);
     void resize(std::size_t handleCapacity, std::size_t indexCapacity);
 
     Handle insert(uint32_t index);
+    void insert(uint32_t firstIndex, std::span<Handle> out);
     bool update(Handle handle, uint32_t index);
     void erase(Handle handle);
 
     [[nodiscard]] bool is_valid(Handle handle) const noexcept;
     [[nodiscard]] uint32_t get_index(Handle handle) const noexcept;
+    [[nodiscard]] Handle get_handle(uint32_t index) const noexcept;
+
+    // batched get_index, prefetching the slots of handles a few entries ahead;
+    // out must be at least as long as handles
+    void resolve(std::span<const Handle> handles, std::span<uint32_t> out) const noexcept;
+
+    // number of id slots in use or on the free-list; bounded by the peak number of live handles
+    [[nodiscard]] std::size_t handle_capacity() const noexcept { return m_slots.size(); }
 
 private:
-    std::vector<uint32_t> m_idToIndex;
+    // One record per id, generation in the high half and index in the low half, so validating
+    // a handle touches a single cache line. A free slot sets free_flag and stores the next free
+    // id instead of an index, threading the free-list through the table itself.
+    static constexpr std::uint32_t free_flag = 0x80000000u;
+    static constexpr std::uint32_t free_list_end = max_capacity;
+
+    static constexpr std::uint64_t pack(std::uint32_t generation, std::uint32_t low) noexcept
+    {
+        return (static_cast<std::uint64_t>(generation) << 32) | low;
+    }
+
+    static constexpr std::uint32_t generation_of(std::uint64_t slot) noexcept { return static_cast<std::uint32_t>(slot >> 32); }
+    static constexpr std::uint32_t index_of(std::uint64_t slot) noexcept { return static_cast<std::uint32_t>(slot); }
+    static constexpr std::uint32_t next_free_of(std::uint64_t slot) noexcept { return index_of(slot) & ~free_flag; }
+    static constexpr bool is_free(std::uint64_t slot) noexcept { return (index_of(slot) & free_flag) != 0; }
+
+    uint32_t acquire_id();
+    void release_id(uint32_t id, uint32_t generation) noexcept;
+    void rebuild_free_list() noexcept;
+
+    std::vector<uint64_t> m_slots;
     std::vector<uint32_t> m_indexToId;
-    std::vector<uint32_t> m_generations;
-    std::vector<uint32_t> m_freeIds;
+    uint32_t m_freeHead{ free_list_end };
 };
@@ -0,0 +1,101 @@
+#include "histogram.hpp"
+
+#include <bit>
+
+void LatencyHistogram::record(std::uint64_t value) noexcept
+{
+    m_buckets[bucket_of(value)].fetch_add(1, std::memory_order_relaxed);
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    m_sum.fetch_add(value, std::memory_order_relaxed);
+
+    auto current = m_min.load(std::memory_order_relaxed);
+    while (value < current && !m_min.compare_exchange_weak(current, value, std::memory_order_relaxed))
+    {
+    }
+
+    current = m_max.load(std::memory_order_relaxed);
+    while (value > current && !m_max.compare_exchange_weak(current, value, std::memory_order_relaxed))
+    {
+    }
+}
+
+void LatencyHistogram::reset() noexcept
+{
+    for (auto & bucket : m_buckets)
+    {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    m_count.store(0, std::memory_order_relaxed);
+    m_sum.store(0, std::memory_order_relaxed);
+    m_min.store(UINT64_MAX, std::memory_order_relaxed);
+    m_max.store(0, std::memory_order_relaxed);
+}
+
+std::uint64_t LatencyHistogram::min() const noexcept
+{
+    const auto value = m_min.load(std::memory_order_relaxed);
+    return value == UINT64_MAX ? 0 : value;
+}
+
+std::uint64_t LatencyHistogram::mean() const noexcept
+{
+    const auto n = count();
+    return n > 0 ? m_sum.load(std::memory_order_relaxed) / n : 0;
+}
+
+std::uint64_t LatencyHistogram::percentile(double quantile) const noexcept
+{
+    const auto n = count();
+    if (n == 0)
+    {
+        return 0;
+    }
+
+    quantile = quantile < 0.0 ? 0.0 : (quantile > 1.0 ? 1.0 : quantile);
+    auto target = static_cast<std::uint64_t>(quantile * static_cast<double>(n) + 0.5);
+    target = target > 0 ? target : 1;
+
+    std::uint64_t seen = 0;
+    for (std::size_t bucket = 0; bucket < bucket_count; ++bucket)
+    {
+        seen += m_buckets[bucket].load(std::memory_order_relaxed);
+        if (seen >= target)
+        {
+            // never report beyond what was actually recorded
+            const auto bound = upper_bound_of(bucket);
+            return bound < max() ? bound : max();
+        }
+    }
+    return max();
+}
+
+std::size_t LatencyHistogram::bucket_of(std::uint64_t value) noexcept
+{
+    // values below one full sub-bucket range map one to one
+    if (value < sub_buckets)
+    {
+        return static_cast<std::size_t>(value);
+    }
+
+    const auto msb = static_cast<std::size_t>(std::bit_width(value)) - 1;
+    if (msb >= max_bits)
+    {
+        return bucket_count - 1;
+    }
+
+    const auto shift = msb - sub_bucket_bits;
+    const auto sub = static_cast<std::size_t>(value >> shift) & (sub_buckets - 1);
+    return (shift + 1) * sub_buckets + sub;
+}
+
+std::uint64_t LatencyHistogram::upper_bound_of(std::size_t bucket) noexcept
+{
+    if (bucket < sub_buckets)
+    {
+        return bucket;
+    }
+
+    const auto shift = bucket / sub_buckets - 1;
+    const auto sub = bucket % sub_buckets;
+    return (((sub_buckets + sub) << shift) | ((std::uint64_t{ 1 } << shift) - 1));
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Log-linear latency histogram in the spirit of HDR histograms: each power of two is cut into
+// 16 linear sub-buckets, so any recorded value is reported within ~6%, from 1ns up to ~18 min.
+// record() is a handful of relaxed atomic increments and may run concurrently with readers;
+// readers see a slightly torn but never corrupt view.
+class LatencyHistogram
+{
+public:
+    static constexpr std::size_t sub_bucket_bits = 4;
+    static constexpr std::size_t sub_buckets = std::size_t{ 1 } << sub_bucket_bits;
+    static constexpr std::size_t max_bits = 40;
+    static constexpr std::size_t bucket_count = (max_bits - sub_bucket_bits + 1) * sub_buckets;
+
+    void record(std::uint64_t value) noexcept;
+    void reset() noexcept;
+
+    [[nodiscard]] std::uint64_t count() const noexcept { return m_count.load(std::memory_order_relaxed); }
+    [[nodiscard]] std::uint64_t min() const noexcept;
+    [[nodiscard]] std::uint64_t max() const noexcept { return m_max.load(std::memory_order_relaxed); }
+    [[nodiscard]] std::uint64_t mean() const noexcept;
+
+    // smallest value v such that at least `quantile` (0..1) of the samples are <= v,
+    // rounded up to its bucket's upper bound
+    [[nodiscard]] std::uint64_t percentile(double quantile) const noexcept;
+
+    [[nodiscard]] static std::size_t bucket_of(std::uint64_t value) noexcept;
+    [[nodiscard]] static std::uint64_t upper_bound_of(std::size_t bucket) noexcept;
+
+private:
+    std::array<std::atomic<std::uint64_t>, bucket_count> m_buckets{};
+    std::atomic<std::uint64_t> m_count{ 0 };
+    std::atomic<std::uint64_t> m_sum{ 0 };
+    std::atomic<std::uint64_t> m_min{ UINT64_MAX };
+    std::atomic<std::uint64_t> m_max{ 0 };
+};
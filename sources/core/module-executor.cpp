@@ -0,0 +1,182 @@
+#include "module-executor.hpp"
+
+#include <algorithm>
+#include <optional>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "module.hpp"
+
+namespace
+{
+    template <typename Entry>
+    bool later(const Entry & a, const Entry & b) noexcept
+    {
+        // std heap functions keep the "largest" first, so the latest entry compares smallest
+        return a.due != b.due ? a.due > b.due : a.sequence > b.sequence;
+    }
+
+    void pin_current_thread(std::size_t cpu)
+    {
+#if defined(__linux__)
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(static_cast<int>(cpu), &set);
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+        (void)cpu;
+#endif
+    }
+}
+
+ModuleExecutor::ModuleExecutor(std::size_t workerCount, bool pinWorkers)
+{
+    workerCount = workerCount > 0 ? workerCount : 1;
+    m_threads.reserve(workerCount);
+    for (std::size_t i = 0; i < workerCount; ++i)
+    {
+        m_threads.emplace_back(&ModuleExecutor::worker_loop, this, i, pinWorkers);
+    }
+}
+
+ModuleExecutor::~ModuleExecutor()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_workCv.notify_all();
+
+    for (auto & thread : m_threads)
+    {
+        if (thread.joinable())
+        {
+            thread.join();
+        }
+    }
+}
+
+std::size_t ModuleExecutor::default_worker_count() noexcept
+{
+    const auto hardware = std::thread::hardware_concurrency();
+    return hardware > 0 ? hardware : 1;
+}
+
+void ModuleExecutor::attach(IModule & module)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_modules.try_emplace(&module);
+}
+
+void ModuleExecutor::detach(IModule & module)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    auto it = m_modules.find(&module);
+    if (it == m_modules.end())
+    {
+        return;
+    }
+
+    // a step in flight may still requeue the module, so only drop its entries afterwards
+    m_idleCv.wait(lock, [&] { return !it->second.running; });
+
+    std::erase_if(m_heap, [&](const Entry & entry) { return entry.module == &module; });
+    std::make_heap(m_heap.begin(), m_heap.end(), later<Entry>);
+    m_modules.erase(it);
+}
+
+void ModuleExecutor::submit(IModule & module)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_modules.find(&module);
+    if (it == m_modules.end())
+    {
+        return;
+    }
+
+    auto & registration = it->second;
+    if (registration.active)
+    {
+        // the worker holding it re-checks the flag before letting it go idle
+        registration.wake = true;
+        return;
+    }
+
+    registration.active = true;
+    push(module, clock::now());
+}
+
+void ModuleExecutor::push(IModule & module, clock::time_point due)
+{
+    m_heap.push_back(Entry{ due, m_sequence++, &module });
+    std::push_heap(m_heap.begin(), m_heap.end(), later<Entry>);
+    m_workCv.notify_one();
+}
+
+void ModuleExecutor::worker_loop(std::size_t self, bool pin)
+{
+    if (pin)
+    {
+        pin_current_thread(self % default_worker_count());
+    }
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (!m_stopping)
+    {
+        if (m_heap.empty())
+        {
+            m_workCv.wait(lock);
+            continue;
+        }
+
+        const auto due = m_heap.front().due;
+        if (due > clock::now())
+        {
+            m_workCv.wait_until(lock, due);
+            continue;
+        }
+
+        std::pop_heap(m_heap.begin(), m_heap.end(), later<Entry>);
+        auto & module = *m_heap.back().module;
+        m_heap.pop_back();
+
+        // element references survive rehashing, and detach() waits for running to clear
+        auto & registration = m_modules[&module];
+        registration.running = true;
+        lock.unlock();
+
+        std::optional<clock::time_point> next;
+        {
+            std::unique_lock<std::mutex> moduleLock(module.m_mutex);
+            if (module.m_state == IModule::State::RUNNING)
+            {
+                next = module.runStep(moduleLock);
+                if (module.m_state != IModule::State::RUNNING)
+                {
+                    next.reset();
+                }
+            }
+        }
+
+        lock.lock();
+        registration.running = false;
+        if (next)
+        {
+            registration.wake = false;
+            push(module, *next);
+        }
+        else if (registration.wake)
+        {
+            registration.wake = false;
+            push(module, clock::now());
+        }
+        else
+        {
+            registration.active = false;
+        }
+        m_idleCv.notify_all();
+    }
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+class IModule;
+
+// Shared backend that runs many modules on a fixed set of worker threads instead of one thread
+// per module. Due steps sit in a min-heap ordered by deadline (FIFO among equal deadlines):
+// FIXED_RATE modules are queued at their next deadline, MAX_RATE modules are requeued at "now"
+// after every step so they take turns cooperatively. A module is queued or running at most
+// once at a time, so its steps never overlap.
+//
+// Modules opt in through IModule::setExecutor(); lifecycle calls behave as with a dedicated
+// thread. The executor must outlive the modules attached to it.
+class ModuleExecutor
+{
+public:
+    // pinWorkers binds worker i to CPU i modulo the hardware concurrency (Linux only)
+    explicit ModuleExecutor(std::size_t workerCount = default_worker_count(), bool pinWorkers = false);
+    ~ModuleExecutor();
+
+    ModuleExecutor(const ModuleExecutor &) = delete;
+    ModuleExecutor & operator=(const ModuleExecutor &) = delete;
+
+    [[nodiscard]] std::size_t size() const noexcept { return m_threads.size(); }
+
+    static std::size_t default_worker_count() noexcept;
+
+private:
+    friend class IModule;
+
+    using clock = std::chrono::steady_clock;
+
+    struct Entry
+    {
+        clock::time_point due;
+        std::uint64_t sequence;
+        IModule * module;
+    };
+
+    struct Registration
+    {
+        bool active{ false };  // queued or running
+        bool running{ false }; // a worker is inside its step
+        bool wake{ false };    // submitted again while active
+    };
+
+    std::vector<std::thread> m_threads;
+
+    std::mutex m_mutex;
+    std::condition_variable m_workCv;
+    std::condition_variable m_idleCv;
+    std::vector<Entry> m_heap;
+    std::unordered_map<IModule *, Registration> m_modules;
+    std::uint64_t m_sequence{ 0 };
+    bool m_stopping{ false };
+
+    void attach(IModule & module);
+    void detach(IModule & module);
+    void submit(IModule & module);
+
+    void push(IModule & module, clock::time_point due);
+    void worker_loop(std::size_t self, bool pin);
+};
@@ -0,0 +1,262 @@
+#include "module-graph.hpp"
+
+#include <chrono>
+#include <stdexcept>
+#include <utility>
+
+#include "module.hpp"
+
+namespace
+{
+    thread_local std::uint64_t tls_frame = 0;
+}
+
+ModuleGraph::ModuleGraph(std::size_t framesInFlight, ThreadPool & pool)
+    : m_framesInFlight(framesInFlight > 0 ? framesInFlight : 1)
+    , m_pool(pool)
+{ }
+
+ModuleGraph::~ModuleGraph()
+{
+    // hand the modules back to the regular backends
+    for (auto & node : m_nodes)
+    {
+        std::lock_guard<std::mutex> lock(node.module->m_mutex);
+        node.module->m_graphDriven = false;
+    }
+}
+
+void ModuleGraph::add(IModule & module)
+{
+    (void)index_of(module);
+}
+
+void ModuleGraph::connect(IModule & producer, IModule & consumer)
+{
+    const auto from = index_of(producer);
+    const auto to = index_of(consumer);
+
+    if (from == to || reaches(to, from))
+    {
+        throw std::invalid_argument("module dependency would create a cycle");
+    }
+
+    for (const auto existing : m_nodes[to].producers)
+    {
+        if (existing == from)
+        {
+            return;
+        }
+    }
+
+    m_nodes[to].producers.push_back(from);
+    m_nodes[from].consumers.push_back(to);
+}
+
+std::uint64_t ModuleGraph::currentFrame() noexcept
+{
+    return tls_frame;
+}
+
+std::size_t ModuleGraph::index_of(IModule & module)
+{
+    if (const auto it = m_indices.find(&module); it != m_indices.end())
+    {
+        return it->second;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(module.m_mutex);
+        if (module.m_state == IModule::State::RUNNING
+         || module.m_state == IModule::State::PAUSED
+         || module.m_executor != nullptr
+         || module.m_graphDriven)
+        {
+            throw std::invalid_argument("module is already driven by a thread, executor or graph");
+        }
+        module.m_graphDriven = true;
+    }
+
+    const auto index = m_nodes.size();
+    m_nodes.push_back(Node{ &module, { }, { }, m_frameEnd, false });
+    m_indices.emplace(&module, index);
+    return index;
+}
+
+bool ModuleGraph::reaches(std::size_t from, std::size_t to) const
+{
+    std::vector<std::size_t> pending{ from };
+    std::vector<bool> seen(m_nodes.size(), false);
+    while (!pending.empty())
+    {
+        const auto node = pending.back();
+        pending.pop_back();
+        if (node == to)
+        {
+            return true;
+        }
+        if (seen[node])
+        {
+            continue;
+        }
+        seen[node] = true;
+        pending.insert(pending.end(), m_nodes[node].consumers.begin(), m_nodes[node].consumers.end());
+    }
+    return false;
+}
+
+void ModuleGraph::runFrames(std::uint64_t count)
+{
+    if (count == 0 || m_nodes.empty())
+    {
+        m_frameEnd += count;
+        return;
+    }
+
+    const auto task = [this](std::size_t node) { run(node); };
+    ThreadPool::TaskGroup steps(m_pool, task);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_frameEnd += count;
+        m_error = nullptr;
+        m_steps = &steps;
+        for (std::size_t i = 0; i < m_nodes.size(); ++i)
+        {
+            enqueue_if_ready(i);
+        }
+    }
+
+    // every completed step spawns the steps it unblocks, so this returns once all frames are done
+    // or, after an error, once the steps already spawned have finished
+    steps.wait();
+    m_steps = nullptr;
+
+    if (m_error)
+    {
+        // frames left half done cannot be resumed
+        for (auto & node : m_nodes)
+        {
+            node.completed = m_frameEnd;
+            node.queued = false;
+        }
+        std::rethrow_exception(m_error);
+    }
+}
+
+bool ModuleGraph::is_ready(const Node & node) const noexcept
+{
+    const auto frame = node.completed;
+    if (node.queued || frame >= m_frameEnd)
+    {
+        return false;
+    }
+
+    // inputs of this frame are available
+    for (const auto producer : node.producers)
+    {
+        if (m_nodes[producer].completed <= frame)
+        {
+            return false;
+        }
+    }
+
+    // and no consumer still needs the output slot this frame will overwrite
+    for (const auto consumer : node.consumers)
+    {
+        if (m_nodes[consumer].completed + m_framesInFlight <= frame)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void ModuleGraph::enqueue_if_ready(std::size_t node)
+{
+    if (!m_error && is_ready(m_nodes[node]))
+    {
+        m_nodes[node].queued = true;
+        m_steps->spawn(node);
+    }
+}
+
+void ModuleGraph::run(std::size_t index)
+{
+    auto & node = m_nodes[index];
+    std::uint64_t frame = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_error)
+        {
+            return;
+        }
+        frame = node.completed;
+    }
+
+    std::exception_ptr error;
+    try
+    {
+        step(node, frame);
+    }
+    catch (...)
+    {
+        error = std::current_exception();
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (error)
+    {
+        if (!m_error)
+        {
+            m_error = error;
+        }
+        return;
+    }
+
+    node.queued = false;
+    ++node.completed;
+
+    // completing a frame can unblock the node itself, its consumers and its producers
+    enqueue_if_ready(index);
+    for (const auto consumer : node.consumers)
+    {
+        enqueue_if_ready(consumer);
+    }
+    for (const auto producer : node.producers)
+    {
+        enqueue_if_ready(producer);
+    }
+}
+
+void ModuleGraph::step(Node & node, std::uint64_t frame)
+{
+    auto & module = *node.module;
+
+    std::chrono::duration<double> dt{ 0.0 };
+    {
+        std::lock_guard<std::mutex> lock(module.m_mutex);
+        if (module.m_state != IModule::State::RUNNING)
+        {
+            // paused or stopped modules let the frame pass through
+            return;
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        dt = now - module.m_schedule.previousStep;
+        module.m_schedule.previousStep = now;
+    }
+
+    // a step running parallel_for may run another node's step on this thread in the meantime
+    const auto outer = std::exchange(tls_frame, frame);
+    try
+    {
+        module.timedStep(dt);
+    }
+    catch (...)
+    {
+        tls_frame = outer;
+        throw;
+    }
+    tls_frame = outer;
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "thread-pool.hpp"
+
+class IModule;
+
+// Runs a set of modules as a dependency graph, one step per module per frame, on a ThreadPool.
+// connect(producer, consumer) orders consumer's frame f after producer's frame f; modules with
+// no path between them run in parallel. Every step is one pool task, spawned once its inputs are
+// ready, so no pool thread ever waits for the graph and steps may run parallel_for on the same
+// pool themselves.
+//
+// Frames are pipelined: a module may run ahead of its consumers by up to framesInFlight - 1
+// frames, so e.g. the input stage of frame N + 1 overlaps the simulation of frame N. With more
+// than one frame in flight a producer must keep one output slot per in-flight frame, picked with
+// currentFrame() % framesInFlight(); with framesInFlight == 1 a module waits until its consumers
+// have finished the previous frame.
+//
+// Added modules are driven by the graph instead of a thread or executor: start(), pause() and
+// stop() keep their meaning, and only RUNNING modules step (others pass their frames through).
+// The graph must not be changed while runFrames() is executing.
+class ModuleGraph
+{
+public:
+    explicit ModuleGraph(std::size_t framesInFlight = 2, ThreadPool & pool = ThreadPool::global());
+    ~ModuleGraph();
+
+    ModuleGraph(const ModuleGraph &) = delete;
+    ModuleGraph & operator=(const ModuleGraph &) = delete;
+
+    // throws std::invalid_argument for modules that are started or bound to an executor
+    void add(IModule & module);
+
+    // consumer reads producer's output; adds either module when needed and throws
+    // std::invalid_argument if the edge would close a cycle
+    void connect(IModule & producer, IModule & consumer);
+
+    // blocks until `count` more frames have completed on every module; the first exception
+    // thrown by a step is rethrown once in-flight steps have finished
+    void runFrames(std::uint64_t count);
+    void runFrame() { runFrames(1); }
+
+    // frames completed by every module so far
+    [[nodiscard]] std::uint64_t frame() const noexcept { return m_frameEnd; }
+    [[nodiscard]] std::size_t framesInFlight() const noexcept { return m_framesInFlight; }
+
+    // frame being stepped on the calling thread, valid inside IModule::step()
+    static std::uint64_t currentFrame() noexcept;
+
+private:
+    struct Node
+    {
+        IModule * module;
+        std::vector<std::size_t> producers;
+        std::vector<std::size_t> consumers;
+        std::uint64_t completed{ 0 }; // also the next frame to run
+        bool queued{ false };
+    };
+
+    std::size_t m_framesInFlight;
+    ThreadPool & m_pool;
+
+    std::vector<Node> m_nodes;
+    std::unordered_map<IModule *, std::size_t> m_indices;
+
+    // frame scheduling, guarded by m_mutex
+    std::mutex m_mutex;
+    ThreadPool::TaskGroup * m_steps{ nullptr }; // during runFrames()
+    std::uint64_t m_frameEnd{ 0 };
+    std::exception_ptr m_error;
+
+    std::size_t index_of(IModule & module);
+    [[nodiscard]] bool reaches(std::size_t from, std::size_t to) const;
+
+    [[nodiscard]] bool is_ready(const Node & node) const noexcept;
+    void enqueue_if_ready(std::size_t node);
+    void run(std::size_t node);
+    void step(Node & node, std::uint64_t frame);
+};
@@ -1,5 +1,16 @@
 #include "module.hpp"
 
+#include "module-executor.hpp"
+#include "trace.hpp"
+
+namespace
+{
+    std::int64_t nanoseconds_since_epoch(std::chrono::steady_clock::time_point time)
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+    }
+}
+
 IModule::IModule(ExecutionMode mode, double frequencyHz)
     : m_state{ State::CREATED }
     , m_mode{ mode }
@@ -9,6 +20,10 @@ IModule::IModule(ExecutionMode mode, double frequencyHz)
 IModule::~IModule()
 {
     this->stop();
+    if (m_executor != nullptr)
+    {
+        m_executor->detach(*this);
+    }
     if (m_thread.joinable())
     {
         m_thread.join();
@@ -81,8 +96,31 @@ bool IModule::start()
             if (onStart())
             {
                 m_state = State::RUNNING;
-                if (!m_thread.joinable())
+                m_schedule.previousStep = std::chrono::steady_clock::now();
+                m_schedule.rebase = true;
+
+                if (m_graphDriven)
                 {
+                    return true;
+                }
+
+                if (m_executor != nullptr)
+                {
+                    auto * executor = m_executor;
+                    lock.unlock();
+                    executor->submit(*this);
+                    return true;
+                }
+
+                // a thread left over from a previous run that was stopped and reset has exited
+                // its loop once m_threadActive is cleared, so it can be joined under the lock
+                if (!m_threadActive)
+                {
+                    if (m_thread.joinable())
+                    {
+                        m_thread.join();
+                    }
+                    m_threadActive = true;
                     m_thread = std::thread(&IModule::run, this);
                 }
                 lock.unlock();
@@ -96,6 +134,23 @@ bool IModule::start()
             if (onResume())
             {
                 m_state = State::RUNNING;
+                m_schedule.rebase = true;
+                m_pausedNs.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - m_pausedSince).count(), std::memory_order_relaxed);
+
+                if (m_graphDriven)
+                {
+                    return true;
+                }
+
+                if (m_executor != nullptr)
+                {
+                    auto * executor = m_executor;
+                    lock.unlock();
+                    executor->submit(*this);
+                    return true;
+                }
+
                 lock.unlock();
                 m_cv.notify_all();
                 return true;
@@ -153,7 +208,8 @@ bool IModule::pause() {
         {
             if (onPause())
             {
-                m_state = State::STOPPED;
+                m_state = State::PAUSED;
+                m_pausedSince = std::chrono::steady_clock::now();
                 return true;
             }
             return false;
@@ -204,6 +260,133 @@ void IModule::setExecutionMode(ExecutionMode mode, double frequencyHz)
     m_frequencyHz = frequencyHz;
 }
 
+bool IModule::setExecutor(ModuleExecutor * executor)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_state == State::RUNNING || m_state == State::PAUSED || m_graphDriven)
+    {
+        return false;
+    }
+
+    if (executor == m_executor)
+    {
+        return true;
+    }
+
+    auto * previous = m_executor;
+    m_executor = executor;
+    lock.unlock();
+
+    if (previous != nullptr)
+    {
+        previous->detach(*this);
+    }
+    if (executor != nullptr)
+    {
+        executor->attach(*this);
+    }
+    return true;
+}
+
+void IModule::setOverrunPolicy(OverrunPolicy policy)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_overrunPolicy = policy;
+}
+
+void IModule::setSpinWindow(std::chrono::nanoseconds spinWindow)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_spinWindow = spinWindow > std::chrono::nanoseconds::zero() ? spinWindow : std::chrono::nanoseconds::zero();
+}
+
+IModule::TimingStats IModule::timingStats() const
+{
+    TimingStats stats;
+    stats.steps = m_stats.steps.load(std::memory_order_relaxed);
+    stats.overruns = m_stats.overruns.load(std::memory_order_relaxed);
+    stats.skippedTicks = m_stats.skippedTicks.load(std::memory_order_relaxed);
+    stats.maxJitter = std::chrono::nanoseconds(m_stats.maxJitterNs.load(std::memory_order_relaxed));
+    stats.totalJitter = std::chrono::nanoseconds(m_stats.totalJitterNs.load(std::memory_order_relaxed));
+    return stats;
+}
+
+void IModule::setName(std::string_view name)
+{
+    m_traceName = trace::intern(name);
+}
+
+IModule::StepStats IModule::stepStats() const
+{
+    StepStats stats;
+    stats.steps = m_stepHistogram.count();
+    stats.overruns = m_stats.overruns.load(std::memory_order_relaxed);
+    stats.minStep = std::chrono::nanoseconds(m_stepHistogram.min());
+    stats.meanStep = std::chrono::nanoseconds(m_stepHistogram.mean());
+    stats.p99Step = std::chrono::nanoseconds(m_stepHistogram.percentile(0.99));
+    stats.maxStep = std::chrono::nanoseconds(m_stepHistogram.max());
+    stats.pausedTime = std::chrono::nanoseconds(m_pausedNs.load(std::memory_order_relaxed));
+    stats.waitTime = std::chrono::nanoseconds(m_waitNs.load(std::memory_order_relaxed));
+
+    const auto first = m_firstStepNs.load(std::memory_order_relaxed);
+    const auto last = m_lastStepNs.load(std::memory_order_relaxed);
+    const auto active = last - first - stats.pausedTime.count();
+    if (first >= 0 && stats.steps > 1 && active > 0)
+    {
+        stats.achievedHz = static_cast<double>(stats.steps - 1) * 1e9 / static_cast<double>(active);
+    }
+    return stats;
+}
+
+void IModule::resetTimingStats()
+{
+    m_stepHistogram.reset();
+    m_firstStepNs.store(-1, std::memory_order_relaxed);
+    m_lastStepNs.store(-1, std::memory_order_relaxed);
+    m_pausedNs.store(0, std::memory_order_relaxed);
+    m_waitNs.store(0, std::memory_order_relaxed);
+
+    m_stats.steps.store(0, std::memory_order_relaxed);
+    m_stats.overruns.store(0, std::memory_order_relaxed);
+    m_stats.skippedTicks.store(0, std::memory_order_relaxed);
+    m_stats.maxJitterNs.store(0, std::memory_order_relaxed);
+    m_stats.totalJitterNs.store(0, std::memory_order_relaxed);
+}
+
+void IModule::timedStep(std::chrono::duration<double> dt)
+{
+    const auto begin = std::chrono::steady_clock::now();
+    step(dt);
+    const auto end = std::chrono::steady_clock::now();
+
+    m_stepHistogram.record(static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count()));
+
+    // only the thread currently stepping the module writes these
+    const auto beginNs = nanoseconds_since_epoch(begin);
+    if (m_firstStepNs.load(std::memory_order_relaxed) < 0)
+    {
+        m_firstStepNs.store(beginNs, std::memory_order_relaxed);
+    }
+    m_lastStepNs.store(beginNs, std::memory_order_relaxed);
+
+    if (trace::enabled())
+    {
+        trace::record(m_traceName, "module", begin, end);
+    }
+}
+
+void IModule::recordJitter(std::chrono::steady_clock::duration lateness)
+{
+    // only the run thread writes, so plain load/store pairs are enough
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(lateness).count();
+    m_stats.steps.store(m_stats.steps.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    m_stats.totalJitterNs.store(m_stats.totalJitterNs.load(std::memory_order_relaxed) + ns, std::memory_order_relaxed);
+    if (ns > m_stats.maxJitterNs.load(std::memory_order_relaxed))
+    {
+        m_stats.maxJitterNs.store(ns, std::memory_order_relaxed);
+    }
+}
+
 bool IModule::onInit()
 {
     // do nothing
@@ -250,15 +433,6 @@ void IModule::run()
 {
     std::unique_lock<std::mutex> lock(m_mutex);
 
-    auto getPeriod = [this]() -> std::chrono::duration<double>
-    {
-        return (m_mode == ExecutionMode::FIXED_RATE && m_frequencyHz > 0.0)
-               ? std::chrono::duration<double>(1.0 / m_frequencyHz)
-               : std::chrono::duration<double>::zero();
-    };
-
-    auto previousIterationTimestamp = std::chrono::steady_clock::now();
-
     while (true)
     {
         // Wait until RUNNING or STOPPED
@@ -272,52 +446,141 @@ void IModule::run()
             break;
         }
 
-        auto now = std::chrono::steady_clock::now();
-        auto dt = std::chrono::duration<double>(now - previousIterationTimestamp);
-        previousIterationTimestamp = now;
-
-        auto mode = m_mode;
-        auto period = getPeriod();
-        lock.unlock();
-
-        if (mode == ExecutionMode::ONCE)
+        const auto next = runStep(lock);
+        if (!next)
         {
-            step(dt);
-            lock.lock();
-            m_state = State::STOPPED;
             break;
         }
 
-        if (mode == ExecutionMode::MAX_RATE)
+        if (m_state != State::RUNNING) // If paused or stopped, loop up and wait/exit
         {
-            step(dt);
-            lock.lock();
             continue;
         }
 
-        if (mode == ExecutionMode::FIXED_RATE)
+        // Sleep but allow interruption by pause/stop or mode change
+        const auto waitBegin = std::chrono::steady_clock::now();
+        const auto spinWindow = m_spinWindow;
+        const bool interrupted = m_cv.wait_until(lock, *next - spinWindow, [this] {
+            return m_state != State::RUNNING;
+        });
+
+        if (!interrupted && spinWindow > std::chrono::nanoseconds::zero())
         {
-            // execute current step
-            auto startTimestamp = std::chrono::steady_clock::now();
-            step(dt);
-            auto currentStepDuration = std::chrono::steady_clock::now() - startTimestamp;
+            // the last stretch is spun: waking from a sleep is far less precise
+            lock.unlock();
+            while (std::chrono::steady_clock::now() < *next)
+            {
+            }
+            lock.lock();
+        }
 
+        m_waitNs.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - waitBegin).count(), std::memory_order_relaxed);
+    }
 
-            lock.lock();
-            if (m_state != State::RUNNING) // If paused or stopped, loop up and wait/exit
+    m_threadActive = false;
+}
+
+std::optional<std::chrono::steady_clock::time_point> IModule::runStep(std::unique_lock<std::mutex> & lock)
+{
+    using clock = std::chrono::steady_clock;
+
+    auto getPeriod = [this]() -> std::chrono::duration<double>
+    {
+        return (m_mode == ExecutionMode::FIXED_RATE && m_frequencyHz > 0.0)
+               ? std::chrono::duration<double>(1.0 / m_frequencyHz)
+               : std::chrono::duration<double>::zero();
+    };
+
+    // FIXED_RATE deadlines are origin + tick * period, computed from scratch every time so
+    // neither rounding nor step durations accumulate into drift
+    auto & schedule = m_schedule;
+    auto deadline = [&schedule](std::chrono::duration<double> period, std::uint64_t k)
+    {
+        return schedule.origin + std::chrono::duration_cast<clock::duration>(period * static_cast<double>(k));
+    };
+
+    auto now = clock::now();
+    auto dt = std::chrono::duration<double>(now - schedule.previousStep);
+    schedule.previousStep = now;
+
+    auto mode = m_mode;
+    auto period = getPeriod();
+    auto policy = m_overrunPolicy;
+
+    if (mode == ExecutionMode::ONCE)
+    {
+        lock.unlock();
+        timedStep(dt);
+        lock.lock();
+        m_state = State::STOPPED;
+        return std::nullopt;
+    }
+
+    if (mode == ExecutionMode::MAX_RATE)
+    {
+        lock.unlock();
+        timedStep(dt);
+        lock.lock();
+        schedule.rebase = true;
+        return clock::now();
+    }
+
+    // restart the grid on the first step, after a pause and whenever the rate changes; the
+    // schedule is only touched under the lock, start() rebases it too
+    if (schedule.rebase || period != schedule.lastPeriod)
+    {
+        schedule.origin = now;
+        schedule.tick = 0;
+        schedule.rebase = false;
+        schedule.lastPeriod = period;
+    }
+    const auto due = deadline(period, schedule.tick);
+    lock.unlock();
+
+    recordJitter(now - due);
+
+    // execute current step
+    timedStep(dt);
+    const auto finished = clock::now();
+
+    lock.lock();
+    if (m_state != State::RUNNING || period <= std::chrono::duration<double>::zero())
+    {
+        schedule.rebase = m_state != State::RUNNING;
+        return finished;
+    }
+
+    ++schedule.tick;
+    if (finished > deadline(period, schedule.tick))
+    {
+        m_stats.overruns.fetch_add(1, std::memory_order_relaxed);
+
+        switch (policy)
+        {
+            case OverrunPolicy::SKIP:
             {
-                continue;
+                // first tick still ahead of us
+                const auto elapsed = std::chrono::duration<double>(finished - schedule.origin);
+                auto next = static_cast<std::uint64_t>(elapsed / period) + 1;
+                next = next > schedule.tick ? next : schedule.tick;
+                m_stats.skippedTicks.fetch_add(next - schedule.tick, std::memory_order_relaxed);
+                schedule.tick = next;
+                break;
             }
-
-            auto sleepTime = period - currentStepDuration;
-            if (sleepTime > std::chrono::duration<double>::zero())
+            case OverrunPolicy::CATCH_UP:
             {
-                // Sleep but allow interruption by pause/stop or mode change
-                m_cv.wait_for(lock, sleepTime, [this] {
-                    return m_state != State::RUNNING;
-                });
+                // the next deadline is already due, run it without waiting
+                break;
+            }
+            case OverrunPolicy::STRETCH:
+            {
+                schedule.origin = finished;
+                schedule.tick = 0;
+                break;
             }
         }
     }
-}
 
+    return deadline(period, schedule.tick);
+}
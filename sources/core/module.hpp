@@ -1,9 +1,18 @@
 #pragma once
 
+#include <atomic>
 #include <thread>
 #include <condition_variable>
 #include <mutex>
 #include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+#include "histogram.hpp"
+
+class ModuleExecutor;
+class ModuleGraph;
 
 class IModule {
 public:
@@ -13,6 +22,40 @@ public:
         MAX_RATE
     };
 
+    // what FIXED_RATE does when a step ends past the next deadline
+    enum class OverrunPolicy {
+        SKIP,     // drop the missed ticks and resume on the original grid
+        CATCH_UP, // run the missed ticks back to back until on schedule again
+        STRETCH   // start the next step right away and shift the grid to it
+    };
+
+    // FIXED_RATE timing counters; jitter is how late a step started against its deadline
+    struct TimingStats {
+        std::uint64_t steps{ 0 };
+        std::uint64_t overruns{ 0 };
+        std::uint64_t skippedTicks{ 0 };
+        std::chrono::nanoseconds maxJitter{ 0 };
+        std::chrono::nanoseconds totalJitter{ 0 };
+
+        [[nodiscard]] std::chrono::nanoseconds meanJitter() const
+        {
+            return steps > 0 ? totalJitter / static_cast<std::int64_t>(steps) : std::chrono::nanoseconds{ 0 };
+        }
+    };
+
+    // always-on per-step counters, whatever the execution mode or backend
+    struct StepStats {
+        std::uint64_t steps{ 0 };
+        std::uint64_t overruns{ 0 };
+        std::chrono::nanoseconds minStep{ 0 };
+        std::chrono::nanoseconds meanStep{ 0 };
+        std::chrono::nanoseconds p99Step{ 0 };
+        std::chrono::nanoseconds maxStep{ 0 };
+        std::chrono::nanoseconds pausedTime{ 0 }; // spent PAUSED
+        std::chrono::nanoseconds waitTime{ 0 };   // a dedicated thread spent waiting for deadlines
+        double achievedHz{ 0.0 };                 // between the first and last step, pauses excluded
+    };
+
 private:
     enum class State {
         CREATED,
@@ -25,11 +68,44 @@ private:
     State m_state;
     ExecutionMode m_mode;
     double m_frequencyHz; // when running in fixed rate mode
+    OverrunPolicy m_overrunPolicy{ OverrunPolicy::SKIP };
+    std::chrono::nanoseconds m_spinWindow{ 0 }; // busy-wait this long before each deadline
+
+    struct AtomicTimingStats {
+        std::atomic<std::uint64_t> steps{ 0 };
+        std::atomic<std::uint64_t> overruns{ 0 };
+        std::atomic<std::uint64_t> skippedTicks{ 0 };
+        std::atomic<std::int64_t> maxJitterNs{ 0 };
+        std::atomic<std::int64_t> totalJitterNs{ 0 };
+    } m_stats;
+
+    LatencyHistogram m_stepHistogram;
+    std::atomic<std::int64_t> m_firstStepNs{ -1 };
+    std::atomic<std::int64_t> m_lastStepNs{ -1 };
+    std::atomic<std::int64_t> m_pausedNs{ 0 };
+    std::atomic<std::int64_t> m_waitNs{ 0 };
+    std::chrono::steady_clock::time_point m_pausedSince{};
+    const char * m_traceName{ "module" };
+
+    // FIXED_RATE deadline grid, owned by whichever backend runs the steps
+    struct Schedule {
+        std::chrono::steady_clock::time_point previousStep{};
+        std::chrono::steady_clock::time_point origin{};
+        std::uint64_t tick{ 0 };
+        bool rebase{ true };
+        std::chrono::duration<double> lastPeriod{ 0.0 };
+    } m_schedule;
 
     std::thread m_thread;
+    bool m_threadActive{ false };
+    ModuleExecutor * m_executor{ nullptr };
+    bool m_graphDriven{ false }; // steps come from a ModuleGraph, start() only flips the state
     std::mutex m_mutex;
     std::condition_variable m_cv;
 
+    friend class ModuleExecutor;
+    friend class ModuleGraph;
+
 public:
     explicit IModule(ExecutionMode mode = ExecutionMode::ONCE, double frequencyHz = 0.0);
     virtual ~IModule();
@@ -45,6 +121,27 @@ public:
 
     void setExecutionMode(ExecutionMode mode, double frequencyHz = 0.0);
 
+    // Runs the module on a shared executor instead of its own thread; nullptr goes back to a
+    // dedicated thread. Only possible while not started, i.e. before start() or after stop(),
+    // and not for modules driven by a ModuleGraph; returns false when it is not.
+    bool setExecutor(ModuleExecutor * executor);
+    void setOverrunPolicy(OverrunPolicy policy);
+
+    // Hybrid wait: sleep until spinWindow before each deadline, then spin. Spinning trades one
+    // core for wake-up jitter well below the OS timer slack; zero (the default) only sleeps.
+    void setSpinWindow(std::chrono::nanoseconds spinWindow);
+
+    // label used for trace events
+    void setName(std::string_view name);
+    [[nodiscard]] const char * name() const noexcept { return m_traceName; }
+
+    [[nodiscard]] TimingStats timingStats() const;
+    [[nodiscard]] StepStats stepStats() const;
+    [[nodiscard]] const LatencyHistogram & stepHistogram() const noexcept { return m_stepHistogram; }
+
+    // clears both timing and step statistics
+    void resetTimingStats();
+
 protected:
     virtual bool onInit();
     virtual bool onRelease();
@@ -58,4 +155,12 @@ protected:
 
 private:
     void run();
+
+    // Runs one step; called with the lock held, which is released around step() itself.
+    // Returns when the next step is due, or nullopt once the module is done (ONCE).
+    std::optional<std::chrono::steady_clock::time_point> runStep(std::unique_lock<std::mutex> & lock);
+    void recordJitter(std::chrono::steady_clock::duration lateness);
+
+    // step() plus its latency sample and, when tracing, a trace event
+    void timedStep(std::chrono::duration<double> dt);
 };
\ No newline at end of file
@@ -0,0 +1,351 @@
+#include "shared-value.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+
+namespace
+{
+    // pops the next "/"-separated segment off `path`, with "~1" and "~0" unescaped
+    std::string next_segment(std::string_view & path)
+    {
+        const auto end = path.find('/');
+        const auto raw = path.substr(0, end);
+        path.remove_prefix(end == std::string_view::npos ? path.size() : end + 1);
+
+        std::string segment;
+        segment.reserve(raw.size());
+        for (size_t i = 0; i < raw.size(); ++i)
+        {
+            if (raw[i] == '~' && i + 1 < raw.size() && (raw[i + 1] == '0' || raw[i + 1] == '1'))
+            {
+                segment += raw[++i] == '0' ? '~' : '/';
+            }
+            else
+            {
+                segment += raw[i];
+            }
+        }
+        return segment;
+    }
+
+    bool parse_index(std::string_view text, size_t & index) noexcept
+    {
+        const auto * end = text.data() + text.size();
+        const auto result = std::from_chars(text.data(), end, index);
+        return !text.empty() && result.ec == std::errc{ } && result.ptr == end;
+    }
+
+    template <typename Members>
+    auto find_member(Members & members, std::string_view key)
+    {
+        return std::lower_bound(members.begin(), members.end(), key,
+                                [](const auto & member, std::string_view k) { return member.first < k; });
+    }
+}
+
+SharedValue::SharedValue(Value value)
+{
+    if (value.empty())
+    {
+        return;
+    }
+
+    if (value.is<Value::array_t>())
+    {
+        items_t items;
+        auto & source = value.as<Value::array_t>();
+        items.reserve(source.size());
+        for (auto & item : source)
+        {
+            items.emplace_back(std::move(item));
+        }
+        m_node = std::make_shared<Node>(Node{ std::move(items) });
+    }
+    else if (value.is<Value::object_t>())
+    {
+        members_t members;
+        auto & source = value.as<Value::object_t>();
+        members.reserve(source.size());
+        for (auto & [key, member] : source)
+        {
+            members.emplace_back(key, SharedValue{ std::move(member) });
+        }
+        std::sort(members.begin(), members.end(), [](const auto & a, const auto & b) { return a.first < b.first; });
+        m_node = std::make_shared<Node>(Node{ std::move(members) });
+    }
+    else
+    {
+        m_node = std::make_shared<Node>(Node{ std::move(value) });
+    }
+}
+
+Value SharedValue::to_value() const
+{
+    if (const auto * list = items())
+    {
+        Value::array_t out;
+        out.reserve(list->size());
+        for (const auto & item : *list)
+        {
+            out.push_back(item.to_value());
+        }
+        return Value{ std::move(out) };
+    }
+    if (const auto * map = members())
+    {
+        Value::object_t out;
+        out.reserve(map->size());
+        for (const auto & [key, member] : *map)
+        {
+            out.emplace(key, member.to_value());
+        }
+        return Value{ std::move(out) };
+    }
+    const auto * value = leaf();
+    return value != nullptr ? *value : Value{ };
+}
+
+bool SharedValue::empty() const noexcept
+{
+    const auto * value = leaf();
+    return m_node == nullptr || (value != nullptr && value->empty());
+}
+
+bool SharedValue::is_array() const noexcept
+{
+    return items() != nullptr;
+}
+
+bool SharedValue::is_object() const noexcept
+{
+    return members() != nullptr;
+}
+
+size_t SharedValue::size() const noexcept
+{
+    if (const auto * list = items())
+    {
+        return list->size();
+    }
+    const auto * map = members();
+    return map != nullptr ? map->size() : 0;
+}
+
+SharedValue SharedValue::operator[](size_t index) const
+{
+    const auto * list = items();
+    return list != nullptr && index < list->size() ? (*list)[index] : SharedValue{ };
+}
+
+SharedValue SharedValue::operator[](std::string_view key) const
+{
+    const auto * map = members();
+    if (map == nullptr)
+    {
+        return { };
+    }
+    const auto it = find_member(*map, key);
+    return it != map->end() && it->first == key ? it->second : SharedValue{ };
+}
+
+std::string_view SharedValue::key(size_t index) const noexcept
+{
+    const auto * map = members();
+    return map != nullptr && index < map->size() ? std::string_view{ (*map)[index].first } : std::string_view{ };
+}
+
+SharedValue SharedValue::member(size_t index) const
+{
+    const auto * map = members();
+    return map != nullptr && index < map->size() ? (*map)[index].second : SharedValue{ };
+}
+
+SharedValue SharedValue::find(std::string_view path) const
+{
+    // walks raw pointers and copies only the result, so a lookup costs one increment
+    const SharedValue * current = this;
+    while (!path.empty())
+    {
+        const auto segment = next_segment(path);
+        if (const auto * list = current->items())
+        {
+            size_t index = 0;
+            if (!parse_index(segment, index) || index >= list->size())
+            {
+                return { };
+            }
+            current = &(*list)[index];
+        }
+        else if (const auto * map = current->members())
+        {
+            const auto it = find_member(*map, segment);
+            if (it == map->end() || it->first != segment)
+            {
+                return { };
+            }
+            current = &it->second;
+        }
+        else
+        {
+            return { };
+        }
+    }
+    return *current;
+}
+
+bool SharedValue::set(std::string_view path, SharedValue value)
+{
+    // check the whole path first, so a failure leaves the tree as it was
+    {
+        const SharedValue * current = this;
+        auto rest = path;
+        while (!rest.empty() && current != nullptr)
+        {
+            const auto segment = next_segment(rest);
+            if (const auto * list = current->items())
+            {
+                size_t index = 0;
+                if (!parse_index(segment, index) || index > list->size() || (index == list->size() && !rest.empty()))
+                {
+                    return false;
+                }
+                current = index < list->size() ? &(*list)[index] : nullptr;
+            }
+            else if (const auto * map = current->members())
+            {
+                const auto it = find_member(*map, segment);
+                current = it != map->end() && it->first == segment ? &it->second : nullptr;
+            }
+            else if (!current->empty())
+            {
+                return false;
+            }
+            else
+            {
+                current = nullptr; // null: created as an object, and so is everything below
+            }
+        }
+    }
+
+    descend(path) = std::move(value);
+    return true;
+}
+
+bool SharedValue::erase(std::string_view path)
+{
+    if (path.empty())
+    {
+        return false;
+    }
+
+    const auto split = path.rfind('/');
+    const auto parentPath = split == std::string_view::npos ? std::string_view{ } : path.substr(0, split);
+    auto last = path.substr(split == std::string_view::npos ? 0 : split + 1);
+    const auto segment = next_segment(last);
+
+    {
+        // scoped: the looked-up copy would otherwise count as a second owner of the parent
+        const auto parent = find(parentPath);
+        size_t index = 0;
+        if (const auto * list = parent.items())
+        {
+            if (!parse_index(segment, index) || index >= list->size())
+            {
+                return false;
+            }
+        }
+        else if (const auto * map = parent.members())
+        {
+            const auto it = find_member(*map, segment);
+            if (it == map->end() || it->first != segment)
+            {
+                return false;
+            }
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    auto & node = descend(parentPath).writable();
+    if (auto * list = std::get_if<items_t>(&node.data))
+    {
+        size_t index = 0;
+        parse_index(segment, index);
+        list->erase(list->begin() + static_cast<std::ptrdiff_t>(index));
+    }
+    else
+    {
+        auto & map = std::get<members_t>(node.data);
+        map.erase(find_member(map, segment));
+    }
+    return true;
+}
+
+const Value * SharedValue::leaf() const noexcept
+{
+    return m_node != nullptr ? std::get_if<Value>(&m_node->data) : nullptr;
+}
+
+const SharedValue::items_t * SharedValue::items() const noexcept
+{
+    return m_node != nullptr ? std::get_if<items_t>(&m_node->data) : nullptr;
+}
+
+const SharedValue::members_t * SharedValue::members() const noexcept
+{
+    return m_node != nullptr ? std::get_if<members_t>(&m_node->data) : nullptr;
+}
+
+SharedValue & SharedValue::descend(std::string_view path)
+{
+    SharedValue * slot = this;
+    while (!path.empty())
+    {
+        const auto segment = next_segment(path);
+        auto & node = slot->writable();
+        if (auto * list = std::get_if<items_t>(&node.data))
+        {
+            size_t index = 0;
+            parse_index(segment, index);
+            if (index == list->size())
+            {
+                list->emplace_back();
+            }
+            slot = &(*list)[index];
+        }
+        else
+        {
+            auto & map = std::get<members_t>(node.data);
+            auto it = find_member(map, segment);
+            if (it == map.end() || it->first != segment)
+            {
+                it = map.emplace(it, segment, SharedValue{ });
+            }
+            slot = &it->second;
+        }
+    }
+    return *slot;
+}
+
+SharedValue::Node & SharedValue::writable()
+{
+    if (m_node == nullptr || leaf() != nullptr)
+    {
+        m_node = std::make_shared<Node>(Node{ members_t{ } });
+    }
+    else if (m_node.use_count() > 1)
+    {
+        // a shallow copy: the children are shared, and copied in turn only if the path goes on
+        m_node = std::make_shared<Node>(*m_node);
+    }
+    else
+    {
+        // use_count() is a relaxed load: a thread that has just dropped its copy of the node
+        // released the count, and this fence orders its earlier reads before our writes
+        std::atomic_thread_fence(std::memory_order_acquire);
+    }
+    return *m_node;
+}
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "value.hpp"
+
+// Persistent counterpart of Value for state that is snapshotted much more often than it changes.
+// Containers are reference-counted nodes shared between copies, so copying a SharedValue is one
+// reference count increment however large the tree is. set() and erase() copy only the nodes
+// on the path to the change, and only those that another copy still shares; a tree owned by one
+// SharedValue is updated in place.
+//
+// Shared nodes are never modified, so copies can be read from any number of threads without
+// locks. Share a tree across threads by copying it, e.g. through an AtomicSharedValue, never by
+// reference to one SharedValue that is being written.
+//
+// Paths are "a/b/3" as for JsonRef::find: keys for objects, indices for arrays, with "~1" and
+// "~0" escaping '/' and '~' in keys. Lookups that miss give a null SharedValue.
+class SharedValue
+{
+public:
+    SharedValue() noexcept = default;
+
+    // converts the whole tree once; scalars, strings and typed arrays are kept as Values
+    explicit SharedValue(Value value);
+
+    [[nodiscard]] Value to_value() const;
+
+    [[nodiscard]] bool empty() const noexcept;
+    [[nodiscard]] bool is_array() const noexcept;
+    [[nodiscard]] bool is_object() const noexcept;
+
+    // the non-container alternatives, as Value::is / Value::as
+    template <typename T>
+        requires (!std::is_same_v<T, Value::array_t> && !std::is_same_v<T, Value::object_t>)
+    [[nodiscard]] bool is() const noexcept;
+
+    template <typename T>
+        requires (!std::is_same_v<T, Value::array_t> && !std::is_same_v<T, Value::object_t>)
+    [[nodiscard]] const T & as() const;
+
+    // items of an array or members of an object, which are kept in key order
+    [[nodiscard]] size_t size() const noexcept;
+    [[nodiscard]] SharedValue operator[](size_t index) const;
+    [[nodiscard]] SharedValue operator[](std::string_view key) const;
+    [[nodiscard]] std::string_view key(size_t index) const noexcept;
+    [[nodiscard]] SharedValue member(size_t index) const;
+
+    [[nodiscard]] SharedValue find(std::string_view path) const;
+
+    // Replaces the value at `path`, "" being the whole tree. Missing or null members on the way
+    // become objects; array indices must exist, except that the last may be the size to append.
+    // Returns false, changing nothing, if the path runs into a scalar or past an array's end.
+    bool set(std::string_view path, SharedValue value);
+    bool set(std::string_view path, Value value) { return set(path, SharedValue{ std::move(value) }); }
+
+    // removes the member or item at `path`; false if there is none
+    bool erase(std::string_view path);
+
+    // true if both are the same node: an unchanged subtree, found without comparing values
+    [[nodiscard]] bool same(const SharedValue & other) const noexcept { return m_node == other.m_node; }
+
+private:
+    friend class AtomicSharedValue;
+
+    struct Node;
+    using items_t = std::vector<SharedValue>;
+    using members_t = std::vector<std::pair<std::string, SharedValue>>; // sorted by key
+
+    std::shared_ptr<Node> m_node; // nullptr for null
+
+    explicit SharedValue(std::shared_ptr<Node> node) noexcept
+        : m_node(std::move(node))
+    { }
+
+    [[nodiscard]] const Value * leaf() const noexcept;
+    [[nodiscard]] const items_t * items() const noexcept;
+    [[nodiscard]] const members_t * members() const noexcept;
+
+    // this node, made an object if null and copied first if shared
+    Node & writable();
+
+    // the slot at a path that set() or erase() has checked, making every node on the way
+    // writable and creating what is missing
+    SharedValue & descend(std::string_view path);
+};
+
+struct SharedValue::Node
+{
+    std::variant<Value, items_t, members_t> data;
+};
+
+template <typename T>
+    requires (!std::is_same_v<T, Value::array_t> && !std::is_same_v<T, Value::object_t>)
+bool SharedValue::is() const noexcept
+{
+    if constexpr (std::is_same_v<T, std::monostate>)
+    {
+        return empty();
+    }
+    else
+    {
+        const auto * value = leaf();
+        return value != nullptr && value->is<T>();
+    }
+}
+
+template <typename T>
+    requires (!std::is_same_v<T, Value::array_t> && !std::is_same_v<T, Value::object_t>)
+const T & SharedValue::as() const
+{
+    const auto * value = leaf();
+    if (value == nullptr)
+    {
+        throw std::bad_variant_access{ };
+    }
+    return value->as<T>();
+}
+
+// The current version of a SharedValue published between threads: writers store() a new tree,
+// readers load() a snapshot that stays consistent however long they hold it. Both only hold the
+// lock for a reference count update (std::atomic<std::shared_ptr> is a lock inside as well, and
+// missing from some standard libraries); reading the loaded tree takes none.
+class AtomicSharedValue
+{
+public:
+    AtomicSharedValue() noexcept = default;
+    explicit AtomicSharedValue(SharedValue value) noexcept
+        : m_node(std::move(value.m_node))
+    { }
+
+    AtomicSharedValue(const AtomicSharedValue &) = delete;
+    AtomicSharedValue & operator=(const AtomicSharedValue &) = delete;
+
+    [[nodiscard]] SharedValue load() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return SharedValue{ m_node };
+    }
+
+    void store(SharedValue value)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_node.swap(value.m_node);
+        }
+        // the previous version, if this was its last owner, is freed outside the lock
+    }
+
+private:
+    mutable std::mutex m_mutex;
+    std::shared_ptr<SharedValue::Node> m_node;
+};
@@ -0,0 +1,209 @@
+#include "thread-pool.hpp"
+
+#include <utility>
+
+namespace
+{
+    // index of the pool queue owned by the current thread, when it is a worker
+    thread_local const void * tls_pool = nullptr;
+    thread_local std::size_t tls_queue = 0;
+}
+
+ThreadPool::ThreadPool(std::size_t workerCount)
+{
+    m_queues.reserve(workerCount);
+    for (std::size_t i = 0; i < workerCount; ++i)
+    {
+        m_queues.push_back(std::make_unique<Queue>());
+    }
+
+    m_threads.reserve(workerCount);
+    for (std::size_t i = 0; i < workerCount; ++i)
+    {
+        m_threads.emplace_back(&ThreadPool::worker_loop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_stopping.store(true, std::memory_order_release);
+    }
+    m_sleepCv.notify_all();
+
+    for (auto & thread : m_threads)
+    {
+        if (thread.joinable())
+        {
+            thread.join();
+        }
+    }
+}
+
+ThreadPool & ThreadPool::global()
+{
+    static ThreadPool pool;
+    return pool;
+}
+
+std::size_t ThreadPool::default_worker_count() noexcept
+{
+    const auto hardware = std::thread::hardware_concurrency();
+    return hardware > 1 ? hardware - 1 : 0;
+}
+
+void ThreadPool::run_job(Job & job, std::size_t count, std::size_t chunk)
+{
+    const auto chunks = (count + chunk - 1) / chunk;
+    job.remaining.store(chunks, std::memory_order_relaxed);
+
+    // a worker submitting a nested job keeps the first chunk on its own deque
+    const auto first = (tls_pool == this) ? tls_queue : 0;
+    for (std::size_t i = 0; i < chunks; ++i)
+    {
+        const auto begin = i * chunk;
+        const auto end = begin + chunk < count ? begin + chunk : count;
+        push((first + i) % m_queues.size(), Task{ &job, begin, end });
+    }
+
+    help(job);
+}
+
+void ThreadPool::help(Job & job)
+{
+    // run tasks, this job's or any other's, until every task of this job has completed
+    Task task{};
+    while (job.remaining.load(std::memory_order_acquire) > 0)
+    {
+        if (m_queues.empty())
+        {
+            // no workers: the spawned tasks wait in the job's own list
+            task = Task{ &job, job.inlined.back(), 0 };
+            job.inlined.pop_back();
+            execute(task);
+        }
+        else if (try_pop((tls_pool == this) ? tls_queue : 0, task))
+        {
+            execute(task);
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    if (job.error)
+    {
+        auto error = std::exchange(job.error, nullptr);
+        std::rethrow_exception(error);
+    }
+}
+
+void ThreadPool::spawn(Job & job, std::size_t index)
+{
+    // counted before the task can run, and a running task spawns before its own count drops,
+    // so the job cannot look finished while tasks are still being added
+    job.remaining.fetch_add(1, std::memory_order_relaxed);
+    if (m_queues.empty())
+    {
+        job.inlined.push_back(index);
+        return;
+    }
+
+    // a worker keeps what it spawns on its own deque, where it is popped first and hot in cache
+    const auto queue = (tls_pool == this) ? tls_queue : m_nextQueue.fetch_add(1, std::memory_order_relaxed) % m_queues.size();
+    push(queue, Task{ &job, index, index + 1 });
+}
+
+void ThreadPool::push(std::size_t queue, Task task)
+{
+    // counted before it becomes visible, so a concurrent pop never underflows the counter
+    m_pending.fetch_add(1, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(m_queues[queue]->mutex);
+        m_queues[queue]->tasks.push_back(task);
+    }
+
+    // taking the sleep mutex orders this push before any worker's predicate check
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+    }
+    m_sleepCv.notify_one();
+}
+
+bool ThreadPool::try_pop(std::size_t self, Task & task)
+{
+    // own deque first, newest task (hot in cache)
+    {
+        auto & own = *m_queues[self];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty())
+        {
+            task = own.tasks.back();
+            own.tasks.pop_back();
+            m_pending.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    // then steal the oldest task of another worker
+    for (std::size_t offset = 1; offset < m_queues.size(); ++offset)
+    {
+        auto & victim = *m_queues[(self + offset) % m_queues.size()];
+        std::unique_lock<std::mutex> lock(victim.mutex, std::try_to_lock);
+        if (lock.owns_lock() && !victim.tasks.empty())
+        {
+            task = victim.tasks.front();
+            victim.tasks.pop_front();
+            m_pending.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void ThreadPool::execute(const Task & task) noexcept
+{
+    auto & job = *task.job;
+    try
+    {
+        job.invoke(job.fn, task.begin, task.end);
+    }
+    catch (...)
+    {
+        std::lock_guard<std::mutex> lock(job.errorMutex);
+        if (!job.error)
+        {
+            job.error = std::current_exception();
+        }
+    }
+    job.remaining.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+void ThreadPool::worker_loop(std::size_t self)
+{
+    tls_pool = this;
+    tls_queue = self;
+
+    Task task{};
+    while (true)
+    {
+        if (try_pop(self, task))
+        {
+            execute(task);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_sleepCv.wait(lock, [this] {
+            return m_stopping.load(std::memory_order_acquire) || m_pending.load(std::memory_order_acquire) > 0;
+        });
+
+        if (m_stopping.load(std::memory_order_acquire))
+        {
+            break;
+        }
+    }
+}
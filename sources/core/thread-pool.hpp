@@ -0,0 +1,156 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Persistent pool of worker threads with one task deque per worker and work stealing.
+// A worker pops its own deque from the back and steals from the front of the others.
+// parallel_for() and TaskGroup::wait() block the caller, which runs tasks too, so nested calls
+// cannot deadlock as long as tasks never wait for anything else (a lock held across a nested
+// call, or another task to finish): a caller may be running any pool task while it waits.
+class ThreadPool
+{
+public:
+    explicit ThreadPool(std::size_t workerCount = default_worker_count());
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool & operator=(const ThreadPool &) = delete;
+
+    // number of worker threads; parallel_for runs on size() + 1 threads counting the caller
+    [[nodiscard]] std::size_t size() const noexcept { return m_threads.size(); }
+
+    // Splits [0, count) into contiguous chunks of at least `grain` elements whose boundaries are
+    // multiples of `alignment`, and invokes fn(begin, end) for each, concurrently (fn is called
+    // through a const reference). The first exception thrown by fn is rethrown once every chunk
+    // has finished.
+    template <typename Fn>
+    void parallel_for(std::size_t count, std::size_t grain, std::size_t alignment, Fn && fn);
+
+    template <typename Fn>
+    void parallel_for(std::size_t count, std::size_t grain, Fn && fn)
+    {
+        parallel_for(count, grain, 1, std::forward<Fn>(fn));
+    }
+
+    class TaskGroup;
+
+    // process-wide pool sized to the hardware
+    static ThreadPool & global();
+    static std::size_t default_worker_count() noexcept;
+
+private:
+    struct Job
+    {
+        void (*invoke)(const void * fn, std::size_t begin, std::size_t end);
+        const void * fn;
+        std::atomic<std::size_t> remaining{ 0 };
+        std::mutex errorMutex;
+        std::exception_ptr error;
+        std::vector<std::size_t> inlined; // tasks spawned on a pool without workers
+    };
+
+    struct Task
+    {
+        Job * job;
+        std::size_t begin;
+        std::size_t end;
+    };
+
+    struct alignas(64) Queue
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> m_queues;
+    std::vector<std::thread> m_threads;
+
+    std::atomic<std::size_t> m_pending{ 0 };
+    std::atomic<std::size_t> m_nextQueue{ 0 }; // spreads tasks spawned from outside the pool
+    std::atomic<bool> m_stopping{ false };
+    std::mutex m_sleepMutex;
+    std::condition_variable m_sleepCv;
+
+    void worker_loop(std::size_t self);
+    void run_job(Job & job, std::size_t count, std::size_t chunk);
+    void help(Job & job);
+    void spawn(Job & job, std::size_t index);
+
+    void push(std::size_t queue, Task task);
+    bool try_pop(std::size_t self, Task & task);
+    static void execute(const Task & task) noexcept;
+};
+
+// Tasks that may spawn more tasks as they run, e.g. graph nodes whose completion releases their
+// successors: fn(index) is called once per spawn(index), on any pool thread and concurrently,
+// and may itself spawn(). wait() runs tasks on the caller until every spawned one has finished,
+// then rethrows the first exception fn threw. Without worker threads the tasks run in wait().
+class ThreadPool::TaskGroup
+{
+public:
+    // fn (called through a const reference) must outlive the group
+    template <typename Fn>
+    TaskGroup(ThreadPool & pool, const Fn & fn) noexcept
+        : m_pool(pool)
+    {
+        m_job.fn = static_cast<const void *>(std::addressof(fn));
+        m_job.invoke = [](const void * f, std::size_t index, std::size_t)
+        {
+            (*static_cast<const Fn *>(f))(index);
+        };
+    }
+
+    TaskGroup(const TaskGroup &) = delete;
+    TaskGroup & operator=(const TaskGroup &) = delete;
+
+    void spawn(std::size_t index) { m_pool.spawn(m_job, index); }
+    void wait() { m_pool.help(m_job); }
+
+private:
+    ThreadPool & m_pool;
+    Job m_job;
+};
+
+template <typename Fn>
+void ThreadPool::parallel_for(std::size_t count, std::size_t grain, std::size_t alignment, Fn && fn)
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    alignment = alignment > 0 ? alignment : 1;
+    grain = grain > 0 ? grain : 1;
+
+    // aim for a few chunks per thread so stealing can balance uneven work
+    const auto threads = size() + 1;
+    auto chunk = (count + threads * 4 - 1) / (threads * 4);
+    chunk = chunk > grain ? chunk : grain;
+    chunk = (chunk + alignment - 1) / alignment * alignment;
+
+    if (chunk >= count || m_threads.empty())
+    {
+        fn(std::size_t{ 0 }, count);
+        return;
+    }
+
+    using fn_t = std::remove_reference_t<Fn>;
+
+    Job job;
+    job.fn = static_cast<const void *>(std::addressof(fn));
+    job.invoke = [](const void * f, std::size_t begin, std::size_t end)
+    {
+        (*static_cast<const fn_t *>(f))(begin, end);
+    };
+
+    run_job(job, count, chunk);
+}
@@ -0,0 +1,218 @@
+#include "trace.hpp"
+
+#include <atomic>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "helpers/strings.hpp"
+
+namespace
+{
+    struct Event
+    {
+        const char * name;
+        const char * category;
+        std::int64_t begin; // ns since the trace epoch
+        std::int64_t duration;
+    };
+
+    // the generation of the last clear() in the high half, the events recorded since in the low
+    // half: one word, so an export never pairs a count with the wrong generation's events
+    constexpr std::uint64_t pack(std::uint32_t generation, std::size_t count) noexcept
+    {
+        return (std::uint64_t{ generation } << 32) | count;
+    }
+
+    struct ThreadBuffer
+    {
+        std::unique_ptr<Event[]> events{ std::make_unique<Event[]>(trace::thread_capacity) };
+        std::atomic<std::uint64_t> state{ 0 };
+        std::uint32_t thread{ 0 };
+    };
+
+    struct Registry
+    {
+        std::mutex mutex;
+        std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+        std::vector<ThreadBuffer *> idle; // buffers of exited threads, events kept
+        std::unordered_set<std::string> names;
+        const trace::clock::time_point epoch{ trace::clock::now() };
+
+        // held by clear() and write_chrome_json(), never by recording threads
+        std::mutex exporting;
+    };
+
+    std::atomic<bool> g_enabled{ false };
+    std::atomic<std::uint32_t> g_generation{ 0 };
+    std::atomic<std::uint64_t> g_dropped{ 0 };
+
+    Registry & registry()
+    {
+        static Registry instance;
+        return instance;
+    }
+
+    // A thread takes the buffer of one that has exited before allocating a new one, so the
+    // number of buffers is bounded by the most threads ever recording at once. The events
+    // already in a reused buffer are kept (and exported under its tid) until the next clear().
+    ThreadBuffer * acquire_buffer()
+    {
+        auto & reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        if (!reg.idle.empty())
+        {
+            auto * buffer = reg.idle.back();
+            reg.idle.pop_back();
+            return buffer;
+        }
+
+        // room in `idle` for every buffer, so a thread that exits can always return its own
+        reg.idle.reserve(reg.buffers.size() + 1);
+        reg.buffers.reserve(reg.buffers.size() + 1);
+        auto & created = reg.buffers.emplace_back(std::make_unique<ThreadBuffer>());
+        created->thread = static_cast<std::uint32_t>(reg.buffers.size());
+        return created.get();
+    }
+
+    struct LocalBuffer
+    {
+        ThreadBuffer * buffer{ nullptr };
+
+        ~LocalBuffer()
+        {
+            if (buffer != nullptr)
+            {
+                auto & reg = registry();
+                std::lock_guard<std::mutex> lock(reg.mutex);
+                reg.idle.push_back(buffer);
+            }
+        }
+    };
+
+    // nullptr if the buffer cannot be allocated; the next event tries again
+    ThreadBuffer * local_buffer() noexcept
+    {
+        thread_local LocalBuffer local;
+        if (local.buffer == nullptr)
+        {
+            try
+            {
+                local.buffer = acquire_buffer();
+            }
+            catch (...)
+            {
+                return nullptr;
+            }
+        }
+        return local.buffer;
+    }
+}
+
+void trace::set_enabled(bool enabled) noexcept
+{
+    g_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool trace::enabled() noexcept
+{
+    return g_enabled.load(std::memory_order_relaxed);
+}
+
+void trace::record(const char * name, const char * category, clock::time_point begin, clock::time_point end) noexcept
+{
+    auto * buffer = local_buffer();
+    if (buffer == nullptr)
+    {
+        g_dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    // events from before the last clear() are dropped by starting over at the first slot
+    const auto generation = g_generation.load(std::memory_order_relaxed);
+    const auto state = buffer->state.load(std::memory_order_relaxed);
+    const auto index = static_cast<std::uint32_t>(state >> 32) == generation ? static_cast<std::size_t>(state & 0xffffffffu) : 0;
+    if (index >= thread_capacity)
+    {
+        g_dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    const auto epoch = registry().epoch;
+    buffer->events[index] = Event{
+        name,
+        category,
+        std::chrono::duration_cast<std::chrono::nanoseconds>(begin - epoch).count(),
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count()
+    };
+    buffer->state.store(pack(generation, index + 1), std::memory_order_release);
+}
+
+const char * trace::intern(std::string_view name)
+{
+    auto & reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    return reg.names.emplace(name).first->c_str();
+}
+
+void trace::write_chrome_json(std::ostream & out)
+{
+    auto & reg = registry();
+    std::lock_guard<std::mutex> exporting(reg.exporting);
+
+    // the generation cannot change while this is held, so no thread overwrites the events read
+    const auto generation = g_generation.load(std::memory_order_relaxed);
+    std::vector<const ThreadBuffer *> buffers;
+    {
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        buffers.reserve(reg.buffers.size());
+        for (const auto & buffer : reg.buffers)
+        {
+            buffers.push_back(buffer.get());
+        }
+    }
+
+    // chrome expects microseconds
+    const auto flags = out.flags();
+    out << std::fixed << std::setprecision(3);
+    out << "{\"traceEvents\":[";
+
+    bool first = true;
+    for (const auto & buffer : buffers)
+    {
+        const auto state = buffer->state.load(std::memory_order_acquire);
+        const auto count = static_cast<std::uint32_t>(state >> 32) == generation ? static_cast<std::size_t>(state & 0xffffffffu) : 0;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const auto & event = buffer->events[i];
+            out << (first ? "" : ",")
+                << "{\"name\":\"" << str::escape(event.name)
+                << "\",\"cat\":\"" << str::escape(event.category)
+                << "\",\"ph\":\"X\",\"ts\":" << static_cast<double>(event.begin) / 1000.0
+                << ",\"dur\":" << static_cast<double>(event.duration) / 1000.0
+                << ",\"pid\":1,\"tid\":" << buffer->thread << "}";
+            first = false;
+        }
+    }
+
+    out << "],\"displayTimeUnit\":\"ns\"}";
+    out.flags(flags);
+}
+
+void trace::clear()
+{
+    // Every buffer is emptied at once by moving to a new generation: its owner starts over on its
+    // next event, and an event recorded concurrently may be kept or dropped, but an event from
+    // before the clear is never exported again.
+    std::lock_guard<std::mutex> exporting(registry().exporting);
+    g_generation.fetch_add(1, std::memory_order_relaxed);
+    g_dropped.store(0, std::memory_order_relaxed);
+}
+
+std::uint64_t trace::dropped() noexcept
+{
+    return g_dropped.load(std::memory_order_relaxed);
+}
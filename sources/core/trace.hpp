@@ -0,0 +1,63 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+
+// Optional scoped trace events, exported as Chrome trace / Perfetto JSON.
+// Every thread appends to its own fixed-size buffer (single writer, published with one release
+// store), so recording takes no locks; a full buffer drops further events and counts them.
+// Buffers of exited threads are reused by new ones, so thread churn does not grow memory.
+// Tracing is off by default, and a disabled Scope costs one relaxed load.
+namespace trace
+{
+    using clock = std::chrono::steady_clock;
+
+    // events kept per thread until the next clear()
+    inline constexpr std::size_t thread_capacity = std::size_t{ 1 } << 14;
+
+    void set_enabled(bool enabled) noexcept;
+    [[nodiscard]] bool enabled() noexcept;
+
+    // name and category must outlive the export: string literals or intern()ed strings
+    void record(const char * name, const char * category, clock::time_point begin, clock::time_point end) noexcept;
+
+    // stable copy of a dynamic name, deduplicated; never freed
+    [[nodiscard]] const char * intern(std::string_view name);
+
+    // {"traceEvents": [...]} with one complete ("X") event per recorded scope
+    void write_chrome_json(std::ostream & out);
+
+    // drops recorded events; safe while other threads are recording
+    void clear();
+
+    [[nodiscard]] std::uint64_t dropped() noexcept;
+
+    class Scope
+    {
+    public:
+        explicit Scope(const char * name, const char * category = "scope") noexcept
+            : m_name(enabled() ? name : nullptr)
+            , m_category(category)
+            , m_begin(m_name != nullptr ? clock::now() : clock::time_point{})
+        { }
+
+        ~Scope()
+        {
+            if (m_name != nullptr)
+            {
+                record(m_name, m_category, m_begin, clock::now());
+            }
+        }
+
+        Scope(const Scope &) = delete;
+        Scope & operator=(const Scope &) = delete;
+
+    private:
+        const char * m_name;
+        const char * m_category;
+        clock::time_point m_begin;
+    };
+}
@@ -1,12 +1,22 @@
 #pragma once
 
+#include <array>
 #include <vector>
 #include <variant>
 #include <cstdint>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <unordered_map>
 
-#include "io/indentation.hpp"
+#include <iosfwd>
+
+// true for the packed std::vector<arithmetic> alternatives of Value::data_t
+template <typename T>
+inline constexpr bool is_typed_array_v = false;
+
+template <typename T>
+inline constexpr bool is_typed_array_v<std::vector<T>> = std::is_arithmetic_v<T>;
 
 class Value
 {
@@ -22,7 +32,12 @@ public:
         float, double,
         std::string,
         array_t,
-        object_t
+        object_t,
+        // typed arrays: packed items of one arithmetic type, in the order of the scalars above
+        std::vector<int32_t>, std::vector<uint32_t>,
+        std::vector<int64_t>, std::vector<uint64_t>,
+        std::vector<char>, std::vector<unsigned char>,
+        std::vector<float>, std::vector<double>
     >;
 
 private:
@@ -82,15 +97,48 @@ public:
         return std::get<T>(m_data);
     }
 
+    [[nodiscard]] const data_t & data() const noexcept { return m_data; }
+
     std::string toString() const;
 
     void write_json(std::ostream & os) const noexcept;
     void write_pretty_json(std::ostream & os, const std::string & indent = "  ") const noexcept;
-    static Value read_json(std::istream & is) noexcept;
+    static Value read_json(std::istream & is) noexcept; // null on syntax errors
 
     void write_binary(std::ostream & os) const noexcept;
     static Value read_binary(std::istream & is) noexcept;
 
-private:
-    void write_pretty_json_impl(std::ostream & os, Indentation & indentation) const noexcept;
+    // Parse straight from a read-only mapping of the file instead of a copy of it in memory, so
+    // loading a large snapshot needs room for the Value tree only; null if the file cannot be
+    // mapped or parsed. load_binary reads the write_binary format.
+    static Value load_json(const std::string & path) noexcept;
+    static Value load_binary(const std::string & path) noexcept;
 };
+
+// names used by the JSON { "type": ..., "value": ... } wrapper, indexed like Value::data_t
+inline constexpr std::array<std::string_view, std::variant_size_v<Value::data_t>> value_type_names
+{
+    "null",
+    "int32",
+    "uint32",
+    "int64",
+    "uint64",
+    "char",
+    "uchar",
+    "float",
+    "double",
+    "string",
+    "array",
+    "object",
+    "int32[]",
+    "uint32[]",
+    "int64[]",
+    "uint64[]",
+    "char[]",
+    "uchar[]",
+    "float[]",
+    "double[]"
+};
+
+// index of the first typed array alternative; its item type sits at (index - typed_array_offset)
+inline constexpr size_t typed_array_offset = 11;
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+// Locale-independent number conversion on top of std::from_chars / std::to_chars. Floats are
+// written in the shortest form that reads back to the same bits, and char / unsigned char are
+// treated as small integers rather than characters.
+namespace num
+{
+    // enough for any arithmetic type, including the shortest round-trip form of a double
+    inline constexpr std::size_t max_chars = 32;
+
+    template <typename T>
+    inline constexpr bool is_char_v = std::is_same_v<T, char> || std::is_same_v<T, signed char>
+                                   || std::is_same_v<T, unsigned char>;
+
+    // parses the whole of `text`; false on syntax errors, trailing characters or overflow
+    template <typename T>
+        requires std::is_arithmetic_v<T> && (!std::is_same_v<T, bool>)
+    bool parse(std::string_view text, T & out) noexcept
+    {
+        const auto * begin = text.data();
+        const auto * end = text.data() + text.size();
+
+        if constexpr (is_char_v<T>)
+        {
+            int wide = 0;
+            const auto [ptr, error] = std::from_chars(begin, end, wide);
+            if (error != std::errc() || ptr != end
+             || wide < std::numeric_limits<T>::min() || wide > std::numeric_limits<T>::max())
+            {
+                return false;
+            }
+            out = static_cast<T>(wide);
+            return true;
+        }
+        else
+        {
+            T value{ };
+            const auto [ptr, error] = std::from_chars(begin, end, value);
+            if (error != std::errc() || ptr != end)
+            {
+                return false;
+            }
+            out = value;
+            return true;
+        }
+    }
+
+    // writes `value` to out[0, max_chars) and returns the end; non-finite floats come out as
+    // "inf", "-inf" or "nan", which parse() accepts back
+    template <typename T>
+        requires std::is_arithmetic_v<T> && (!std::is_same_v<T, bool>)
+    char * format(char * out, T value) noexcept
+    {
+        if constexpr (is_char_v<T>)
+        {
+            return std::to_chars(out, out + max_chars, static_cast<int>(value)).ptr;
+        }
+        else
+        {
+            return std::to_chars(out, out + max_chars, value).ptr;
+        }
+    }
+}
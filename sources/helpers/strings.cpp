@@ -1,44 +1,170 @@
 #include "strings.hpp"
 
 #include <algorithm>
+#include <cstdint>
 
 namespace str::impl
 {
     static const std::locale loc = {};
+
+    // the code unit of the 4 hex digits at `p`, or -1
+    static int hex4(const char * p) noexcept
+    {
+        int unit = 0;
+        for (int i = 0; i < 4; ++i)
+        {
+            const auto c = p[i];
+            const int digit = c >= '0' && c <= '9' ? c - '0'
+                            : c >= 'a' && c <= 'f' ? c - 'a' + 10
+                            : c >= 'A' && c <= 'F' ? c - 'A' + 10
+                            : -1;
+            if (digit < 0)
+            {
+                return -1;
+            }
+            unit = unit * 16 + digit;
+        }
+        return unit;
+    }
+
+    static char * put_utf8(char * out, uint32_t code) noexcept
+    {
+        if (code < 0x80)
+        {
+            *out++ = static_cast<char>(code);
+        }
+        else if (code < 0x800)
+        {
+            *out++ = static_cast<char>(0xc0 | (code >> 6));
+            *out++ = static_cast<char>(0x80 | (code & 0x3f));
+        }
+        else if (code < 0x10000)
+        {
+            *out++ = static_cast<char>(0xe0 | (code >> 12));
+            *out++ = static_cast<char>(0x80 | ((code >> 6) & 0x3f));
+            *out++ = static_cast<char>(0x80 | (code & 0x3f));
+        }
+        else
+        {
+            *out++ = static_cast<char>(0xf0 | (code >> 18));
+            *out++ = static_cast<char>(0x80 | ((code >> 12) & 0x3f));
+            *out++ = static_cast<char>(0x80 | ((code >> 6) & 0x3f));
+            *out++ = static_cast<char>(0x80 | (code & 0x3f));
+        }
+        return out;
+    }
+
+    // decodes the \uXXXX escape whose 'u' is at sv[i], and a low surrogate escape after a high
+    // one, as UTF-8; lone surrogates become U+FFFD. On success `i` is left on the last digit.
+    // Never longer than its escapes (3 bytes for 6 chars, 4 for 12).
+    static char * unicode_escape(const std::string_view sv, unsigned & i, char * out) noexcept
+    {
+        const auto unit = i + 4 < sv.size() ? hex4(sv.data() + i + 1) : -1;
+        if (unit < 0)
+        {
+            *out++ = sv[i]; // not an escape after all: kept as the letter, as unknown escapes are
+            return out;
+        }
+        i += 4;
+
+        auto code = static_cast<uint32_t>(unit);
+        if (code >= 0xd800 && code < 0xdc00)
+        {
+            const auto low = i + 6 < sv.size() && sv[i + 1] == '\\' && sv[i + 2] == 'u' ? hex4(sv.data() + i + 3) : -1;
+            if (low >= 0xdc00 && low < 0xe000)
+            {
+                code = 0x10000 + ((code - 0xd800) << 10) + (static_cast<uint32_t>(low) - 0xdc00);
+                i += 6;
+            }
+            else
+            {
+                code = 0xfffd;
+            }
+        }
+        else if (code >= 0xdc00 && code < 0xe000)
+        {
+            code = 0xfffd;
+        }
+        return put_utf8(out, code);
+    }
 }
 
-std::string str::unescape(const std::string_view sv)
+size_t str::unescape_to(const std::string_view sv, char * out) noexcept
 {
-    std::string result;
-    result.reserve(sv.size());
-
+    const auto begin = out;
     for (auto i = 0u; i < sv.size(); ++i)
     {
         if (sv[i] == '\\' && (i + 1) < sv.size())
         {
             switch (sv[++i]) // skip escape
             {
-                case '"':  result += '"';   break;
-                case '\\': result += '\\';  break;
-                case '/':  result += '/';   break;
-                case 'b':  result += '\b';  break;
-                case 'f':  result += '\f';  break;
-                case 'n':  result += '\n';  break;
-                case 'r':  result += '\r';  break;
-                case 't':  result += '\t';  break;
-                default:   result += sv[i]; break;
+                case '"':  *out++ = '"';   break;
+                case '\\': *out++ = '\\';  break;
+                case '/':  *out++ = '/';   break;
+                case 'b':  *out++ = '\b';  break;
+                case 'f':  *out++ = '\f';  break;
+                case 'n':  *out++ = '\n';  break;
+                case 'r':  *out++ = '\r';  break;
+                case 't':  *out++ = '\t';  break;
+                case 'u':  out = impl::unicode_escape(sv, i, out); break;
+                default:   *out++ = sv[i]; break;
             }
         }
         else
         {
-            result += sv[i];
+            *out++ = sv[i];
         }
     }
+    return static_cast<size_t>(out - begin);
+}
 
+std::string str::unescape(const std::string_view sv)
+{
+    std::string result(sv.size(), '\0');
+    result.resize(unescape_to(sv, result.data()));
     result.shrink_to_fit();
     return result;
 }
 
+std::string str::escape(const std::string_view sv)
+{
+    static constexpr char hex[] = "0123456789abcdef";
+
+    std::string result;
+    result.reserve(sv.size());
+
+    for (const char c : sv)
+    {
+        switch (c)
+        {
+            case '"':  result += "\\\""; break;
+            case '\\': result += "\\\\"; break;
+            case '\b': result += "\\b";  break;
+            case '\f': result += "\\f";  break;
+            case '\n': result += "\\n";  break;
+            case '\r': result += "\\r";  break;
+            case '\t': result += "\\t";  break;
+            default:
+            {
+                const auto u = static_cast<unsigned char>(c);
+                if (u < 0x20)
+                {
+                    result += "\\u00";
+                    result += hex[u >> 4];
+                    result += hex[u & 0xf];
+                }
+                else
+                {
+                    result += c;
+                }
+                break;
+            }
+        }
+    }
+
+    return result;
+}
+
 std::string str::to_upper(const std::string_view sv)
 {
     std::string result{ sv };
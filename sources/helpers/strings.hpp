@@ -1,11 +1,15 @@
 #pragma once
 
+#include <cstddef>
 #include <string>
+#include <string_view>
 #include <locale>
 
 namespace str
 {
     std::string unescape(std::string_view sv);
+    size_t unescape_to(std::string_view sv, char * out) noexcept; // writes at most sv.size() chars, returns the count
+    std::string escape(std::string_view sv); // JSON string escaping, inverse of unescape
     std::string to_upper(std::string_view sv);
     std::string to_lower(std::string_view sv);
 }
@@ -0,0 +1,525 @@
+#include "binary-stream.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <istream>
+#include <ostream>
+
+#include <unistd.h>
+
+constexpr std::string_view STREAM_TRUNCATED    = "binary value is truncated";
+constexpr std::string_view STREAM_UNKNOWN_TYPE = "binary value has an unknown type tag";
+constexpr std::string_view STREAM_READ_FAILED  = "cannot read the binary value input";
+
+using binary_stream_detail::packed_array;
+using binary_stream_detail::typed_array;
+
+namespace
+{
+    // index of the arithmetic alternative shared by every item, 0 if there is none
+    size_t packed_type(const Value::array_t & items) noexcept
+    {
+        if (items.empty())
+        {
+            return 0;
+        }
+
+        const auto type = items.front().data().index();
+        if (type == 0 || type > 8) // int32 through double
+        {
+            return 0;
+        }
+        for (const auto & item : items)
+        {
+            if (item.data().index() != type)
+            {
+                return 0;
+            }
+        }
+        return type;
+    }
+}
+
+// ---- BinaryStreamWriter ----
+
+BinaryStreamWriter::BinaryStreamWriter(std::ostream & os, size_t bufferSize)
+    : m_buffer(m_storage)
+    , m_os(&os)
+    , m_limit(bufferSize > 0 ? bufferSize : 1)
+{
+    m_storage.reserve(m_limit);
+}
+
+BinaryStreamWriter::BinaryStreamWriter(int fd, size_t bufferSize)
+    : m_buffer(m_storage)
+    , m_fd(fd)
+    , m_limit(bufferSize > 0 ? bufferSize : 1)
+{
+    m_storage.reserve(m_limit);
+}
+
+BinaryStreamWriter::BinaryStreamWriter(std::vector<char> & out) noexcept
+    : m_buffer(out)
+{ }
+
+BinaryStreamWriter::~BinaryStreamWriter()
+{
+    flush();
+}
+
+bool BinaryStreamWriter::flush()
+{
+    if (m_limit == 0)
+    {
+        return true;
+    }
+
+    if (!m_failed && !m_buffer.empty())
+    {
+        m_failed = !drain(m_buffer.data(), m_buffer.size());
+    }
+    m_buffer.clear();
+    return !m_failed;
+}
+
+bool BinaryStreamWriter::drain(const char * data, size_t count)
+{
+    if (m_os != nullptr)
+    {
+        m_os->write(data, static_cast<std::streamsize>(count));
+        return m_os->good();
+    }
+
+    while (count > 0)
+    {
+        const auto written = ::write(m_fd, data, count);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return false;
+        }
+        data += written;
+        count -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+char * BinaryStreamWriter::extend(size_t count)
+{
+    // blocks larger than the buffer go out on their own at the next flush
+    if (m_limit != 0 && m_buffer.size() + count > m_limit)
+    {
+        flush();
+    }
+
+    const auto at = m_buffer.size();
+    m_buffer.resize(at + count);
+    return m_buffer.data() + at;
+}
+
+void BinaryStreamWriter::append(const void * data, size_t count)
+{
+    if (count == 0)
+    {
+        return; // empty strings and arrays may have no data() to copy from
+    }
+    std::memcpy(extend(count), data, count);
+}
+
+void BinaryStreamWriter::write(const Value & value)
+{
+    const auto type = static_cast<uint8_t>(value.data().index());
+
+    std::visit([this, type](auto && arg)
+    {
+        using T = std::decay_t<decltype(arg)>;
+
+        if constexpr (std::is_same_v<T, std::monostate>)
+        {
+            append(&type, sizeof(type));
+        }
+        else if constexpr (std::is_arithmetic_v<T>)
+        {
+            append(&type, sizeof(type));
+            append(&arg, sizeof(T));
+        }
+        else if constexpr (is_typed_array_v<T>)
+        {
+            // the count is truncated to uint32; only that many items follow
+            const auto itemType = static_cast<uint8_t>(type - typed_array_offset);
+            const auto size = static_cast<uint32_t>(arg.size());
+            append(&typed_array, sizeof(typed_array));
+            append(&itemType, sizeof(itemType));
+            append(&size, sizeof(size));
+            append(arg.data(), size_t{ size } * sizeof(typename T::value_type));
+        }
+        else if constexpr (std::is_same_v<T, std::string>)
+        {
+            const auto size = static_cast<Value::size_t>(arg.size());
+            append(&type, sizeof(type));
+            append(&size, sizeof(size));
+            append(arg.data(), size);
+        }
+        else if constexpr (std::is_same_v<T, Value::array_t>)
+        {
+            // the count is truncated to Value::size_t; only that many items follow
+            const auto size = static_cast<Value::size_t>(arg.size());
+
+            if (const auto itemType = static_cast<uint8_t>(packed_type(arg)); itemType != 0 && size > 0)
+            {
+                append(&packed_array, sizeof(packed_array));
+                append(&itemType, sizeof(itemType));
+                append(&size, sizeof(size));
+                std::visit([&](auto && first)
+                {
+                    using Item = std::decay_t<decltype(first)>;
+                    if constexpr (std::is_arithmetic_v<Item>)
+                    {
+                        // gathered into one block, so the reader gets them with one bulk read
+                        auto * block = extend(size_t{ size } * sizeof(Item));
+                        for (size_t i = 0; i < size; ++i)
+                        {
+                            std::memcpy(block + i * sizeof(Item), &arg[i].template as<Item>(), sizeof(Item));
+                        }
+                    }
+                }, arg.front().data());
+                return;
+            }
+
+            append(&type, sizeof(type));
+            append(&size, sizeof(size));
+            for (size_t i = 0; i < size; ++i)
+            {
+                write(arg[i]);
+            }
+        }
+        else if constexpr (std::is_same_v<T, Value::object_t>)
+        {
+            const auto size = static_cast<Value::size_t>(arg.size());
+            append(&type, sizeof(type));
+            append(&size, sizeof(size));
+
+            auto it = arg.begin();
+            for (size_t i = 0; i < size; ++i, ++it)
+            {
+                const auto keySize = static_cast<Value::size_t>(it->first.size());
+                append(&keySize, sizeof(keySize));
+                append(it->first.data(), keySize);
+                write(it->second);
+            }
+        }
+    }, value.data());
+}
+
+// ---- BinaryStreamReader ----
+
+BinaryStreamReader::BinaryStreamReader(std::span<const char> bytes) noexcept
+    : m_pos(bytes.data())
+    , m_end(bytes.data() + bytes.size())
+{ }
+
+BinaryStreamReader::BinaryStreamReader(int fd, size_t bufferSize)
+    : m_buffer(bufferSize > 0 ? bufferSize : 1)
+    , m_pos(m_buffer.data())
+    , m_end(m_buffer.data())
+    , m_fd(fd)
+{ }
+
+BinaryStreamReader::BinaryStreamReader(std::istream & is)
+    : m_is(&is)
+{ }
+
+const char * BinaryStreamReader::take(size_t count)
+{
+    static constexpr char nothing = '\0';
+    if (count == 0)
+    {
+        return &nothing; // empty strings and keys, before any buffer exists
+    }
+
+    if (static_cast<size_t>(m_end - m_pos) >= count)
+    {
+        const auto * p = m_pos;
+        m_pos += count;
+        return p;
+    }
+    return refill(count);
+}
+
+const char * BinaryStreamReader::refill(size_t count)
+{
+    if (m_is != nullptr)
+    {
+        // exactly what is asked for, so nothing past the value leaves the stream
+        if (!m_is->good())
+        {
+            return nullptr;
+        }
+        if (m_buffer.size() < count)
+        {
+            m_buffer.resize(count);
+        }
+        const auto read = m_is->rdbuf()->sgetn(m_buffer.data(), static_cast<std::streamsize>(count));
+        if (read != static_cast<std::streamsize>(count))
+        {
+            m_is->setstate(std::ios::eofbit | std::ios::failbit);
+            m_pos = m_end = nullptr;
+            return nullptr;
+        }
+        m_pos = m_end = m_buffer.data() + count;
+        return m_buffer.data();
+    }
+
+    if (m_fd < 0)
+    {
+        m_pos = m_end;
+        return nullptr;
+    }
+
+    // keep the unread tail at the front, growing the buffer for requests larger than it
+    const auto leftover = static_cast<size_t>(m_end - m_pos);
+    if (m_buffer.size() < count)
+    {
+        std::vector<char> larger(count > 2 * m_buffer.size() ? count : 2 * m_buffer.size());
+        std::memcpy(larger.data(), m_pos, leftover);
+        m_buffer.swap(larger);
+    }
+    else
+    {
+        std::memmove(m_buffer.data(), m_pos, leftover);
+    }
+
+    auto filled = leftover;
+    while (filled < count)
+    {
+        const auto got = ::read(m_fd, m_buffer.data() + filled, m_buffer.size() - filled);
+        if (got < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (got <= 0)
+        {
+            if (got < 0)
+            {
+                m_error = STREAM_READ_FAILED;
+            }
+            m_pos = m_buffer.data();
+            m_end = m_buffer.data() + filled;
+            return nullptr;
+        }
+        filled += static_cast<size_t>(got);
+    }
+
+    m_pos = m_buffer.data() + count;
+    m_end = m_buffer.data() + filled;
+    return m_buffer.data();
+}
+
+template <typename T>
+bool BinaryStreamReader::scalar(T & out)
+{
+    const auto * p = take(sizeof(T));
+    if (p == nullptr)
+    {
+        return false;
+    }
+    std::memcpy(&out, p, sizeof(T));
+    return true;
+}
+
+bool BinaryStreamReader::read(Value & out)
+{
+    m_error = { };
+
+    uint8_t type = 0;
+    if (!scalar(type))
+    {
+        return false; // a clean end, unless the input itself failed
+    }
+
+    if (!value(out, type))
+    {
+        if (m_error.empty())
+        {
+            m_error = STREAM_TRUNCATED;
+        }
+        out = Value{ };
+        return false;
+    }
+    return true;
+}
+
+bool BinaryStreamReader::value(Value & out, uint8_t type)
+{
+    const auto number = [&]<typename T>(T value) {
+        if (!scalar(value))
+        {
+            return false;
+        }
+        out = value;
+        return true;
+    };
+
+    switch (type)
+    {
+        case 0: out = Value{ }; return true;
+        case 1: return number(int32_t{ });
+        case 2: return number(uint32_t{ });
+        case 3: return number(int64_t{ });
+        case 4: return number(uint64_t{ });
+        case 5: return number(char{ });
+        case 6: return number(static_cast<unsigned char>(0));
+        case 7: return number(0.0f);
+        case 8: return number(0.0);
+        case 9:
+        {
+            Value::size_t size = 0;
+            const char * p = nullptr;
+            if (!scalar(size) || (p = take(size)) == nullptr)
+            {
+                return false;
+            }
+            out = std::string{ p, size };
+            return true;
+        }
+        case 10:
+        {
+            Value::size_t size = 0;
+            if (!scalar(size))
+            {
+                return false;
+            }
+
+            auto items = Value::array_t{ };
+            items.reserve(size);
+            for (size_t i = 0; i < size; ++i)
+            {
+                uint8_t itemType = 0;
+                if (!scalar(itemType) || !value(items.emplace_back(), itemType))
+                {
+                    return false;
+                }
+            }
+            out = std::move(items);
+            return true;
+        }
+        case 11:
+        {
+            Value::size_t size = 0;
+            if (!scalar(size))
+            {
+                return false;
+            }
+
+            auto members = Value::object_t{ };
+            members.reserve(size);
+            for (size_t i = 0; i < size; ++i)
+            {
+                Value::size_t keySize = 0;
+                const char * p = nullptr;
+                if (!scalar(keySize) || (p = take(keySize)) == nullptr)
+                {
+                    return false;
+                }
+                std::string key{ p, keySize };
+
+                uint8_t memberType = 0;
+                Value member;
+                if (!scalar(memberType) || !value(member, memberType))
+                {
+                    return false;
+                }
+                members.insert_or_assign(std::move(key), std::move(member));
+            }
+            out = std::move(members);
+            return true;
+        }
+        case packed_array:
+        {
+            uint8_t itemType = 0;
+            Value::size_t size = 0;
+            if (!scalar(itemType) || !scalar(size))
+            {
+                return false;
+            }
+
+            const auto unpack = [&]<typename T>(T) {
+                const auto * p = take(size_t{ size } * sizeof(T));
+                if (p == nullptr)
+                {
+                    return false;
+                }
+
+                auto items = Value::array_t{ };
+                items.reserve(size);
+                for (size_t i = 0; i < size; ++i)
+                {
+                    T item;
+                    std::memcpy(&item, p + i * sizeof(T), sizeof(T));
+                    items.emplace_back(item);
+                }
+                out = std::move(items);
+                return true;
+            };
+
+            switch (itemType)
+            {
+                case 1: return unpack(int32_t{ });
+                case 2: return unpack(uint32_t{ });
+                case 3: return unpack(int64_t{ });
+                case 4: return unpack(uint64_t{ });
+                case 5: return unpack(char{ });
+                case 6: return unpack(static_cast<unsigned char>(0));
+                case 7: return unpack(0.0f);
+                case 8: return unpack(0.0);
+                default: m_error = STREAM_UNKNOWN_TYPE; return false;
+            }
+        }
+        case typed_array:
+        {
+            uint8_t itemType = 0;
+            uint32_t size = 0;
+            if (!scalar(itemType) || !scalar(size))
+            {
+                return false;
+            }
+
+            const auto unpack = [&]<typename T>(std::vector<T> items) {
+                // pulled in slices so a damaged count cannot ask for gigabytes up front
+                constexpr size_t slice = binary_stream_detail::buffer_size / sizeof(T);
+                for (size_t done = 0; done < size; )
+                {
+                    const auto n = std::min<size_t>(slice, size - done);
+                    const auto * p = take(n * sizeof(T));
+                    if (p == nullptr)
+                    {
+                        return false;
+                    }
+                    items.resize(done + n);
+                    std::memcpy(items.data() + done, p, n * sizeof(T));
+                    done += n;
+                }
+                out = std::move(items);
+                return true;
+            };
+
+            switch (itemType)
+            {
+                case 1: return unpack(std::vector<int32_t>{ });
+                case 2: return unpack(std::vector<uint32_t>{ });
+                case 3: return unpack(std::vector<int64_t>{ });
+                case 4: return unpack(std::vector<uint64_t>{ });
+                case 5: return unpack(std::vector<char>{ });
+                case 6: return unpack(std::vector<unsigned char>{ });
+                case 7: return unpack(std::vector<float>{ });
+                case 8: return unpack(std::vector<double>{ });
+                default: m_error = STREAM_UNKNOWN_TYPE; return false;
+            }
+        }
+        default: m_error = STREAM_UNKNOWN_TYPE; return false;
+    }
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "core/value.hpp"
+
+// Buffered codec for the stream format of Value::write_binary / read_binary: a type byte (the
+// Value::data_t index), then the scalar, or a Value::size_t length followed by the bytes, items
+// or key/value pairs. Arrays whose items are all of one arithmetic type, and typed arrays, are
+// written under extra tags as one packed block:
+//
+//   uint8 packed_array, uint8 item type, Value::size_t count, count values back to back
+//   uint8 typed_array,  uint8 item type, uint32 count,        count values back to back
+//
+// The first reads back as an array_t, the second as the typed array it came from; typed arrays
+// take a wider count since they are meant for long signals. The tags predate the typed array
+// alternatives and keep their values, so they overlap those indices but no data_t tag is ever
+// written for a typed array. Readers accept every array form, so files from older writers
+// still load.
+namespace binary_stream_detail
+{
+    inline constexpr uint8_t packed_array = 12;
+    inline constexpr uint8_t typed_array = 13;
+    inline constexpr size_t buffer_size = 64 * 1024;
+}
+
+// Collects encoded values in one buffer and hands it to the sink a buffer-full at a time;
+// destruction flushes. Writing into a caller's vector appends to it and never flushes.
+class BinaryStreamWriter
+{
+public:
+    explicit BinaryStreamWriter(std::ostream & os, size_t bufferSize = binary_stream_detail::buffer_size);
+    explicit BinaryStreamWriter(int fd, size_t bufferSize = binary_stream_detail::buffer_size);
+    explicit BinaryStreamWriter(std::vector<char> & out) noexcept;
+    ~BinaryStreamWriter();
+
+    BinaryStreamWriter(const BinaryStreamWriter &) = delete;
+    BinaryStreamWriter & operator=(const BinaryStreamWriter &) = delete;
+
+    void write(const Value & value);
+
+    // false once the sink has failed; later writes are dropped
+    bool flush();
+    [[nodiscard]] bool failed() const noexcept { return m_failed; }
+
+private:
+    std::vector<char> m_storage;
+    std::vector<char> & m_buffer; // m_storage, or the caller's vector
+    std::ostream * m_os{ nullptr };
+    int m_fd{ -1 };
+    size_t m_limit{ 0 };          // flush threshold, 0 when appending to a caller's vector
+    bool m_failed{ false };
+
+    char * extend(size_t count);
+    void append(const void * data, size_t count);
+    bool drain(const char * data, size_t count);
+};
+
+// Decodes values one after another. A span is read in place; a file descriptor is read ahead a
+// buffer at a time; an istream is read exactly as far as each value reaches, so the stream is
+// left positioned after it, but still with one bulk read per string and packed array.
+class BinaryStreamReader
+{
+public:
+    explicit BinaryStreamReader(std::span<const char> bytes) noexcept;
+    explicit BinaryStreamReader(int fd, size_t bufferSize = binary_stream_detail::buffer_size);
+    explicit BinaryStreamReader(std::istream & is);
+
+    BinaryStreamReader(const BinaryStreamReader &) = delete;
+    BinaryStreamReader & operator=(const BinaryStreamReader &) = delete;
+
+    // the next value; false at the end of the input or on a damaged value (see error())
+    bool read(Value & out);
+
+    [[nodiscard]] std::string_view error() const noexcept { return m_error; }
+
+private:
+    std::vector<char> m_buffer;
+    const char * m_pos{ nullptr };
+    const char * m_end{ nullptr };
+    std::istream * m_is{ nullptr };
+    int m_fd{ -1 };
+    std::string_view m_error;
+
+    // `count` contiguous bytes, valid until the next call; nullptr at the end of the input
+    const char * take(size_t count);
+    const char * refill(size_t count);
+
+    template <typename T>
+    bool scalar(T & out);
+
+    bool value(Value & out, uint8_t type);
+};
@@ -0,0 +1,456 @@
+#include "binary-value.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <fstream>
+#include <limits>
+
+constexpr std::string_view BINARY_TOO_SMALL   = "not a binary value file: too small";
+constexpr std::string_view BINARY_BAD_MAGIC   = "not a binary value file: bad magic";
+constexpr std::string_view BINARY_NEWER       = "binary value file has an unsupported version";
+constexpr std::string_view BINARY_BAD_SIZE    = "binary value file is truncated or has a bad size";
+constexpr std::string_view BINARY_BAD_ROOT    = "binary value file has a bad root offset";
+constexpr std::string_view BINARY_BIG_ENDIAN  = "binary value files need a little-endian host";
+
+using binary_detail::index_of;
+using binary_detail::load_u32;
+using binary_detail::member_size;
+using binary_detail::node_size;
+
+namespace
+{
+    constexpr auto max_size = std::numeric_limits<uint32_t>::max();
+
+    // item widths of the typed array alternatives, int32[] through double[]
+    constexpr size_t item_sizes[] = { 4, 4, 8, 8, 1, 1, 4, 8 };
+
+    // Appends nodes depth-first, parents before children, so a container's table is reserved
+    // first and patched as its children are written.
+    class Encoder
+    {
+    public:
+        explicit Encoder(std::vector<char> & out)
+            : m_out(out)
+        { }
+
+        [[nodiscard]] bool failed() const noexcept { return m_failed; }
+
+        // zero-filled room for `bytes` at the next multiple of `align`; its offset
+        uint32_t reserve(size_t bytes, size_t align)
+        {
+            const auto offset = (m_out.size() + align - 1) & ~(align - 1);
+            if (m_failed || offset > max_size || bytes > max_size - offset)
+            {
+                m_failed = true;
+                return 0;
+            }
+            m_out.resize(offset + bytes);
+            return static_cast<uint32_t>(offset);
+        }
+
+        void store(size_t offset, uint32_t value)
+        {
+            if (!m_failed)
+            {
+                std::memcpy(m_out.data() + offset, &value, sizeof(value));
+            }
+        }
+
+        uint32_t node(const Value & value)
+        {
+            const auto & data = value.data();
+            return std::visit([&](auto && arg) -> uint32_t
+            {
+                using T = std::decay_t<decltype(arg)>;
+
+                if constexpr (std::is_same_v<T, std::monostate>)
+                {
+                    return open(data.index(), 0, 0);
+                }
+                else if constexpr (std::is_arithmetic_v<T>)
+                {
+                    const auto offset = open(data.index(), 0, sizeof(uint64_t));
+                    copy(offset + node_size, &arg, sizeof(T));
+                    return offset;
+                }
+                else if constexpr (is_typed_array_v<T>)
+                {
+                    const auto bytes = arg.size() * sizeof(typename T::value_type);
+                    const auto offset = open(data.index(), arg.size(), bytes);
+                    copy(offset + node_size, arg.data(), bytes);
+                    return offset;
+                }
+                else if constexpr (std::is_same_v<T, std::string>)
+                {
+                    const auto offset = open(data.index(), arg.size(), arg.size() + 1);
+                    copy(offset + node_size, arg.data(), arg.size());
+                    return offset;
+                }
+                else if constexpr (std::is_same_v<T, Value::array_t>)
+                {
+                    const auto offset = open(data.index(), arg.size(), arg.size() * sizeof(uint32_t));
+                    for (size_t i = 0; i < arg.size() && !m_failed; ++i)
+                    {
+                        const auto item = node(arg[i]);
+                        store(offset + node_size + i * sizeof(uint32_t), item);
+                    }
+                    return offset;
+                }
+                else if constexpr (std::is_same_v<T, Value::object_t>)
+                {
+                    std::vector<const Value::object_t::value_type *> members;
+                    members.reserve(arg.size());
+                    for (const auto & member : arg)
+                    {
+                        members.push_back(&member);
+                    }
+                    std::sort(members.begin(), members.end(), [](auto * a, auto * b) { return a->first < b->first; });
+
+                    const auto offset = open(data.index(), members.size(), members.size() * member_size);
+                    for (size_t i = 0; i < members.size() && !m_failed; ++i)
+                    {
+                        const auto & key = members[i]->first;
+                        const auto entry = offset + node_size + i * member_size;
+                        if (key.size() > max_size)
+                        {
+                            m_failed = true;
+                            break;
+                        }
+
+                        const auto keyOffset = reserve(key.size(), 1);
+                        copy(keyOffset, key.data(), key.size());
+                        store(entry, keyOffset);
+                        store(entry + 4, static_cast<uint32_t>(key.size()));
+
+                        const auto child = node(members[i]->second);
+                        store(entry + 8, child);
+                    }
+                    return offset;
+                }
+            }, data);
+        }
+
+    private:
+        std::vector<char> & m_out;
+        bool m_failed{ false };
+
+        // node header plus `payload` bytes
+        uint32_t open(size_t type, size_t count, size_t payload)
+        {
+            if (count > max_size)
+            {
+                m_failed = true;
+                return 0;
+            }
+
+            const auto offset = reserve(node_size + payload, node_size);
+            if (!m_failed)
+            {
+                m_out[offset] = static_cast<char>(type);
+                store(offset + 4, static_cast<uint32_t>(count));
+            }
+            return offset;
+        }
+
+        void copy(size_t offset, const void * data, size_t bytes)
+        {
+            if (!m_failed && bytes > 0)
+            {
+                std::memcpy(m_out.data() + offset, data, bytes);
+            }
+        }
+    };
+}
+
+// ---- BinaryRef ----
+
+BinaryRef::BinaryRef(const char * base, uint32_t size, uint32_t offset) noexcept
+{
+    // the node header and its whole payload must lie inside the document
+    if (base == nullptr || offset % node_size != 0)
+    {
+        return;
+    }
+
+    m_base = base;
+    m_size = size;
+    m_offset = offset;
+
+    auto valid = fits(offset, node_size);
+    if (valid)
+    {
+        const auto type = static_cast<uint8_t>(base[offset]);
+        const auto items = size_t{ count() };
+        size_t payload = 0;
+
+        if (type >= std::variant_size_v<Value::data_t>)
+        {
+            valid = false;
+        }
+        else if (type == index_of<std::string>)
+        {
+            payload = items + 1;
+        }
+        else if (type == index_of<Value::array_t>)
+        {
+            payload = items * sizeof(uint32_t);
+        }
+        else if (type == index_of<Value::object_t>)
+        {
+            payload = items * member_size;
+        }
+        else if (type > typed_array_offset)
+        {
+            payload = items * item_sizes[type - typed_array_offset - 1];
+        }
+        else if (type != 0)
+        {
+            payload = sizeof(uint64_t);
+        }
+
+        valid = valid && fits(offset + node_size, payload);
+    }
+
+    if (!valid)
+    {
+        m_base = nullptr;
+        m_size = 0;
+        m_offset = 0;
+    }
+}
+
+size_t BinaryRef::type() const noexcept
+{
+    return valid() ? static_cast<uint8_t>(m_base[m_offset]) : 0;
+}
+
+std::string_view BinaryRef::as_string() const noexcept
+{
+    return is_string() ? std::string_view{ m_base + m_offset + node_size, count() } : std::string_view{ };
+}
+
+size_t BinaryRef::size() const noexcept
+{
+    return is_string() || is_array() || is_object() || is_typed_array() ? count() : 0;
+}
+
+BinaryRef BinaryRef::operator[](size_t index) const noexcept
+{
+    if (!is_array() || index >= count())
+    {
+        return { };
+    }
+    return at(load_u32(m_base + m_offset + node_size + index * sizeof(uint32_t)));
+}
+
+std::string_view BinaryRef::key(size_t index) const noexcept
+{
+    if (!is_object() || index >= count())
+    {
+        return { };
+    }
+
+    const auto * entry = m_base + m_offset + node_size + index * member_size;
+    const auto offset = load_u32(entry);
+    const auto length = load_u32(entry + 4);
+    return fits(offset, length) ? std::string_view{ m_base + offset, length } : std::string_view{ };
+}
+
+BinaryRef BinaryRef::member(size_t index) const noexcept
+{
+    if (!is_object() || index >= count())
+    {
+        return { };
+    }
+    return at(load_u32(m_base + m_offset + node_size + index * member_size + 8));
+}
+
+BinaryRef BinaryRef::find(std::string_view key) const noexcept
+{
+    if (!is_object())
+    {
+        return { };
+    }
+
+    size_t low = 0;
+    size_t high = count();
+    while (low < high)
+    {
+        const auto middle = low + (high - low) / 2;
+        const auto candidate = this->key(middle);
+        if (candidate == key)
+        {
+            return member(middle);
+        }
+        if (candidate < key)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    return { };
+}
+
+Value BinaryRef::to_value() const
+{
+    // copied rather than viewed, so unaligned documents convert too
+    const auto typed = [this]<typename T>(std::vector<T> items) {
+        items.resize(count());
+        if (!items.empty())
+        {
+            std::memcpy(items.data(), m_base + m_offset + node_size, items.size() * sizeof(T));
+        }
+        return Value{ std::move(items) };
+    };
+
+    switch (type())
+    {
+        case 1: return Value{ as<int32_t>() };
+        case 2: return Value{ as<uint32_t>() };
+        case 3: return Value{ as<int64_t>() };
+        case 4: return Value{ as<uint64_t>() };
+        case 5: return Value{ as<char>() };
+        case 6: return Value{ as<unsigned char>() };
+        case 7: return Value{ as<float>() };
+        case 8: return Value{ as<double>() };
+        case 9: return Value{ std::string{ as_string() } };
+        case 10:
+        {
+            auto items = Value::array_t{ };
+            items.reserve(size());
+            for (size_t i = 0; i < size(); ++i)
+            {
+                items.push_back((*this)[i].to_value());
+            }
+            return Value{ std::move(items) };
+        }
+        case 11:
+        {
+            auto members = Value::object_t{ };
+            members.reserve(size());
+            for (size_t i = 0; i < size(); ++i)
+            {
+                members.emplace(key(i), member(i).to_value());
+            }
+            return Value{ std::move(members) };
+        }
+        case 12: return typed(std::vector<int32_t>{ });
+        case 13: return typed(std::vector<uint32_t>{ });
+        case 14: return typed(std::vector<int64_t>{ });
+        case 15: return typed(std::vector<uint64_t>{ });
+        case 16: return typed(std::vector<char>{ });
+        case 17: return typed(std::vector<unsigned char>{ });
+        case 18: return typed(std::vector<float>{ });
+        case 19: return typed(std::vector<double>{ });
+        default: return { };
+    }
+}
+
+// ---- BinaryDocument ----
+
+bool BinaryDocument::encode(const Value & value, std::vector<char> & out)
+{
+    if constexpr (std::endian::native != std::endian::little)
+    {
+        return false;
+    }
+
+    out.clear();
+    out.resize(binary_detail::header_size);
+
+    Encoder encoder{ out };
+    const auto root = encoder.node(value);
+    if (encoder.failed())
+    {
+        out.clear();
+        return false;
+    }
+
+    const auto size = static_cast<uint64_t>(out.size());
+    std::memcpy(out.data(), binary_detail::magic, sizeof(binary_detail::magic));
+    std::memcpy(out.data() + 4, &binary_detail::version, sizeof(binary_detail::version));
+    std::memcpy(out.data() + 8, &root, sizeof(root));
+    std::memcpy(out.data() + 16, &size, sizeof(size));
+    return true;
+}
+
+bool BinaryDocument::save(const Value & value, const std::string & path)
+{
+    std::vector<char> bytes;
+    if (!encode(value, bytes))
+    {
+        return false;
+    }
+
+    std::ofstream file{ path, std::ios::binary | std::ios::trunc };
+    file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    return file.good();
+}
+
+bool BinaryDocument::open(std::span<const char> bytes)
+{
+    m_file.close();
+    return load(bytes);
+}
+
+bool BinaryDocument::open(const std::string & path)
+{
+    if (!m_file.open(path))
+    {
+        m_root = { };
+        m_error = m_file.error();
+        return false;
+    }
+    return load(m_file.bytes());
+}
+
+bool BinaryDocument::load(std::span<const char> bytes)
+{
+    m_root = { };
+    m_error = { };
+
+    if constexpr (std::endian::native != std::endian::little)
+    {
+        m_error = BINARY_BIG_ENDIAN;
+        return false;
+    }
+
+    if (bytes.size() < binary_detail::header_size)
+    {
+        m_error = BINARY_TOO_SMALL;
+        return false;
+    }
+    if (std::memcmp(bytes.data(), binary_detail::magic, sizeof(binary_detail::magic)) != 0)
+    {
+        m_error = BINARY_BAD_MAGIC;
+        return false;
+    }
+
+    uint16_t version;
+    uint64_t size;
+    std::memcpy(&version, bytes.data() + 4, sizeof(version));
+    std::memcpy(&size, bytes.data() + 16, sizeof(size));
+    if (version > binary_detail::version)
+    {
+        m_error = BINARY_NEWER;
+        return false;
+    }
+    if (size != bytes.size() || size > max_size)
+    {
+        m_error = BINARY_BAD_SIZE;
+        return false;
+    }
+
+    const auto root = BinaryRef{ bytes.data(), static_cast<uint32_t>(size), load_u32(bytes.data() + 8) };
+    if (!root.valid())
+    {
+        m_error = BINARY_BAD_ROOT;
+        return false;
+    }
+
+    m_root = root;
+    return true;
+}
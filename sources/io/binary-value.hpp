@@ -0,0 +1,181 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+#include "core/value.hpp"
+#include "mapped-file.hpp"
+
+// Versioned binary Value format, laid out so a file can be mapped and read in place.
+//
+//   header: "SBVF", uint16 version, uint16 flags (0), uint32 root offset, uint32 reserved,
+//           uint64 file size                                                       (24 bytes)
+//   node:   uint8 type (the Value::data_t index), 3 bytes padding, uint32 count, payload
+//     arithmetic  the value in its own width
+//     string      `count` bytes, then a NUL
+//     array       `count` uint32 node offsets
+//     object      `count` { uint32 key offset, uint32 key size, uint32 node offset } sorted by
+//                 key, then the key bytes
+//     typed array `count` items of its item type back to back                     (version 2)
+//
+// Offsets are from the start of the file and children come after their parents. Every node
+// starts on an 8-byte boundary and all integers are little-endian, so scalars can be loaded
+// straight from the mapping, and typed arrays read as spans over it. Files are limited to 4 GiB by the 32-bit offsets.
+namespace binary_detail
+{
+    inline constexpr char magic[4] = { 'S', 'B', 'V', 'F' };
+    inline constexpr uint16_t version = 2;
+    inline constexpr size_t header_size = 24;
+    inline constexpr size_t node_size = 8;
+    inline constexpr size_t member_size = 12;
+
+    template <typename T, typename Variant>
+    struct alternative_index;
+
+    template <typename T, typename... Ts>
+    struct alternative_index<T, std::variant<Ts...>>
+    {
+        static constexpr size_t value = [] {
+            size_t index = 0;
+            (void)((std::is_same_v<T, Ts> ? true : (++index, false)) || ...);
+            return index;
+        }();
+    };
+
+    // index of T among the alternatives of Value::data_t
+    template <typename T>
+    inline constexpr size_t index_of = alternative_index<T, Value::data_t>::value;
+
+    [[nodiscard]] inline uint32_t load_u32(const char * p) noexcept
+    {
+        uint32_t value;
+        std::memcpy(&value, p, sizeof(value));
+        return value;
+    }
+}
+
+class BinaryDocument;
+
+// Read-only view of one node of a BinaryDocument, two words wide. Navigation reads the offset
+// tables in place and never allocates; every offset is bounds-checked, so a damaged file yields
+// invalid refs instead of stray reads, and every query on an invalid ref returns an empty result.
+class BinaryRef
+{
+public:
+    BinaryRef() noexcept = default;
+
+    [[nodiscard]] bool valid() const noexcept { return m_base != nullptr; }
+    explicit operator bool() const noexcept { return valid(); }
+
+    // index into Value::data_t (and value_type_names); 0, null, when invalid
+    [[nodiscard]] size_t type() const noexcept;
+    [[nodiscard]] bool is_null() const noexcept { return type() == 0; }
+    [[nodiscard]] bool is_string() const noexcept { return type() == binary_detail::index_of<std::string>; }
+    [[nodiscard]] bool is_array() const noexcept { return type() == binary_detail::index_of<Value::array_t>; }
+    [[nodiscard]] bool is_object() const noexcept { return type() == binary_detail::index_of<Value::object_t>; }
+    [[nodiscard]] bool is_typed_array() const noexcept { return type() > typed_array_offset; }
+
+    template <typename T>
+        requires std::is_arithmetic_v<T>
+    [[nodiscard]] bool is() const noexcept { return type() == binary_detail::index_of<T>; }
+
+    // the stored value if it is a T, T{ } otherwise
+    template <typename T>
+        requires std::is_arithmetic_v<T>
+    [[nodiscard]] T as() const noexcept
+    {
+        T value{ };
+        if (is<T>())
+        {
+            std::memcpy(&value, m_base + m_offset + binary_detail::node_size, sizeof(T));
+        }
+        return value;
+    }
+
+    // the items of a std::vector<T> node, in place; empty for any other node, and when the
+    // document bytes are not aligned for T (mapped files and vectors always are)
+    template <typename T>
+        requires std::is_arithmetic_v<T>
+    [[nodiscard]] std::span<const T> items() const noexcept
+    {
+        if (type() != binary_detail::index_of<std::vector<T>>)
+        {
+            return { };
+        }
+        const auto * p = m_base + m_offset + binary_detail::node_size;
+        if (reinterpret_cast<uintptr_t>(p) % alignof(T) != 0)
+        {
+            return { };
+        }
+        return { reinterpret_cast<const T *>(p), count() };
+    }
+
+    // points into the document, NUL-terminated
+    [[nodiscard]] std::string_view as_string() const noexcept;
+
+    // items of an array or typed array, members of an object, bytes of a string
+    [[nodiscard]] size_t size() const noexcept;
+
+    [[nodiscard]] BinaryRef operator[](size_t index) const noexcept;
+    [[nodiscard]] BinaryRef operator[](std::string_view key) const noexcept { return find(key); }
+
+    // object member by key, a binary search over the sorted member table
+    [[nodiscard]] BinaryRef find(std::string_view key) const noexcept;
+
+    // i-th member of an object in key order, with its key
+    [[nodiscard]] std::string_view key(size_t index) const noexcept;
+    [[nodiscard]] BinaryRef member(size_t index) const noexcept;
+
+    // deep copy of this subtree
+    [[nodiscard]] Value to_value() const;
+
+private:
+    friend class BinaryDocument;
+
+    const char * m_base{ nullptr }; // start of the document
+    uint32_t m_offset{ 0 };
+    uint32_t m_size{ 0 };           // document size, for bounds checks
+
+    BinaryRef(const char * base, uint32_t size, uint32_t offset) noexcept;
+
+    [[nodiscard]] uint32_t count() const noexcept { return binary_detail::load_u32(m_base + m_offset + 4); }
+    // children always follow their parent, which also rules out cycles in damaged files
+    [[nodiscard]] BinaryRef at(uint32_t offset) const noexcept
+    {
+        return offset > m_offset ? BinaryRef{ m_base, m_size, offset } : BinaryRef{ };
+    }
+    [[nodiscard]] bool fits(size_t offset, size_t bytes) const noexcept { return offset <= m_size && bytes <= m_size - offset; }
+};
+
+// Holds (or maps) a document in the format above. open() only checks the header; nodes are
+// validated as they are visited, so opening a large file costs nothing up front.
+class BinaryDocument
+{
+public:
+    // serializes `value`; false if the result would exceed the 4 GiB the offsets can address
+    static bool encode(const Value & value, std::vector<char> & out);
+    static bool save(const Value & value, const std::string & path);
+
+    // views caller-owned bytes, which must outlive the document and its refs
+    bool open(std::span<const char> bytes);
+
+    // maps the file; refs stay valid until the next open() or the document's destruction
+    bool open(const std::string & path);
+
+    [[nodiscard]] BinaryRef root() const noexcept { return m_root; }
+    [[nodiscard]] std::string_view error() const noexcept { return m_error; }
+
+private:
+    MappedFile m_file;
+    BinaryRef m_root;
+    std::string_view m_error;
+
+    bool load(std::span<const char> bytes);
+};
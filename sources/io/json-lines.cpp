@@ -0,0 +1,156 @@
+#include "json-lines.hpp"
+
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+#include "json.hpp"
+#include "mapped-file.hpp"
+
+namespace
+{
+    // the first chunk of `text`: at least `size` bytes, up to and including the next newline
+    std::string_view next_chunk(std::string_view text, size_t size) noexcept
+    {
+        if (size >= text.size())
+        {
+            return text;
+        }
+        const auto * newline = static_cast<const char *>(std::memchr(text.data() + size - 1, '\n', text.size() - size + 1));
+        return newline != nullptr ? text.substr(0, static_cast<size_t>(newline - text.data()) + 1) : text;
+    }
+
+    void parse_chunk(std::string_view chunk, std::vector<Value> & out)
+    {
+        JsonParser parser;
+        while (!chunk.empty())
+        {
+            const auto end = chunk.find('\n');
+            auto line = chunk.substr(0, end);
+            chunk.remove_prefix(end == std::string_view::npos ? chunk.size() : end + 1);
+
+            while (!line.empty() && json_detail::is(line.front(), json_detail::WHITESPACE))
+            {
+                line.remove_prefix(1);
+            }
+            if (!line.empty())
+            {
+                out.push_back(parser.parse(line));
+            }
+        }
+    }
+
+    // Hands finished batches to the callback. In order, whichever thread finishes the next
+    // batch due also delivers every later one that is already done, so no thread ever waits for
+    // another to finish parsing; only one thread delivers at a time.
+    class BatchSink
+    {
+    public:
+        BatchSink(const JsonLinesParser::Callback & onRecord, std::vector<std::vector<Value>> & batches, bool inOrder)
+            : m_onRecord(onRecord)
+            , m_batches(batches)
+            , m_done(batches.size(), false)
+            , m_inOrder(inOrder)
+        { }
+
+        [[nodiscard]] size_t records() const noexcept { return m_records; }
+
+        void finished(size_t index)
+        {
+            std::unique_lock lock{ m_mutex };
+            if (!m_inOrder)
+            {
+                deliver(index);
+                return;
+            }
+
+            m_done[index] = true;
+            if (m_delivering)
+            {
+                return; // the current deliverer picks this batch up when it gets there
+            }
+            m_delivering = true;
+            while (m_next < m_done.size() && m_done[m_next])
+            {
+                const auto next = m_next++;
+                lock.unlock();
+                deliver(next);
+                lock.lock();
+            }
+            m_delivering = false;
+        }
+
+    private:
+        const JsonLinesParser::Callback & m_onRecord;
+        std::vector<std::vector<Value>> & m_batches;
+
+        std::mutex m_mutex;
+        std::vector<bool> m_done;
+        size_t m_next{ 0 };
+        bool m_delivering{ false };
+        bool m_inOrder;
+        size_t m_records{ 0 }; // only touched by the delivering thread
+
+        void deliver(size_t index)
+        {
+            auto & batch = m_batches[index];
+            for (auto & value : batch)
+            {
+                m_onRecord(std::move(value));
+            }
+            m_records += batch.size();
+            batch.clear(); // keeps its capacity for the next window
+        }
+    };
+}
+
+JsonLinesParser::JsonLinesParser(ThreadPool & pool, size_t chunkSize)
+    : m_pool(pool)
+    , m_chunkSize(chunkSize > 0 ? chunkSize : 1)
+{ }
+
+size_t JsonLinesParser::parse(std::string_view document, const Callback & onRecord, Delivery delivery)
+{
+    m_error = { };
+
+    // a window of a few chunks per thread is parsed at a time, which bounds the Values held
+    // back for in-order delivery however large the input is
+    const auto window = (m_pool.size() + 1) * 4;
+    std::vector<std::string_view> chunks;
+    std::vector<std::vector<Value>> batches(window);
+    chunks.reserve(window);
+
+    size_t records = 0;
+    while (!document.empty())
+    {
+        chunks.clear();
+        while (chunks.size() < window && !document.empty())
+        {
+            chunks.push_back(next_chunk(document, m_chunkSize));
+            document.remove_prefix(chunks.back().size());
+        }
+
+        BatchSink sink{ onRecord, batches, delivery == Delivery::InOrder };
+        m_pool.parallel_for(chunks.size(), 1, [&](size_t begin, size_t end)
+        {
+            for (auto i = begin; i < end; ++i)
+            {
+                parse_chunk(chunks[i], batches[i]);
+                sink.finished(i);
+            }
+        });
+        records += sink.records();
+    }
+    return records;
+}
+
+size_t JsonLinesParser::parseFile(const std::string & path, const Callback & onRecord, Delivery delivery)
+{
+    MappedFile file;
+    if (!file.open(path, MappedFile::Access::sequential))
+    {
+        m_error = file.error();
+        return 0;
+    }
+    return parse(file.view(), onRecord, delivery);
+}
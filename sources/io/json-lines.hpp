@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+#include "core/thread-pool.hpp"
+#include "core/value.hpp"
+
+namespace json_lines_detail
+{
+    // bytes per parse task, extended to the next newline; big enough that splitting and
+    // hand-off cost nothing next to parsing, small enough to balance across threads
+    inline constexpr size_t chunk_size = size_t{ 1 } << 20;
+}
+
+// Parallel reader for newline-delimited JSON (JSON Lines): one value per line, as JsonParser
+// reads them, so Value's typed wrappers round-trip. A raw newline cannot occur inside a JSON
+// value, so the input is cut into chunks at line ends without lexing it, and the chunks are parsed
+// concurrently on a ThreadPool, each into its own batch of Values.
+//
+// Records reach the callback one at a time, never concurrently, but possibly on any pool thread.
+// Blank lines are skipped and "\r\n" line ends are accepted; a malformed line yields a null
+// Value, as JsonParser does.
+class JsonLinesParser
+{
+public:
+    using Callback = std::function<void(Value &&)>;
+
+    enum class Delivery : uint8_t
+    {
+        InOrder,  // records in input order; a finished chunk waits for the ones before it
+        AsParsed, // each chunk's records in order as soon as it is parsed, chunks in any order
+    };
+
+    explicit JsonLinesParser(ThreadPool & pool = ThreadPool::global(), size_t chunkSize = json_lines_detail::chunk_size);
+
+    // returns the number of records delivered
+    size_t parse(std::string_view document, const Callback & onRecord, Delivery delivery = Delivery::InOrder);
+
+    // maps the file for one sequential pass and parses it; 0 with error() set if it cannot be mapped
+    size_t parseFile(const std::string & path, const Callback & onRecord, Delivery delivery = Delivery::InOrder);
+
+    [[nodiscard]] std::string_view error() const noexcept { return m_error; }
+
+private:
+    ThreadPool & m_pool;
+    size_t m_chunkSize;
+    std::string_view m_error;
+};
@@ -0,0 +1,328 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#if !defined(JSON_SIMD_DISABLE)
+    #if defined(__AVX2__)
+        #include <immintrin.h>
+        #define JSON_SIMD_AVX2 1
+    #elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        #include <emmintrin.h>
+        #define JSON_SIMD_SSE2 1
+    #elif defined(__ARM_NEON) && defined(__aarch64__)
+        #include <arm_neon.h>
+        #define JSON_SIMD_NEON64 1
+    #endif
+#endif
+
+// Structural indexing for the JSON lexer, simdjson style: every 64-byte block is classified with
+// vector compares into one bitmask per character class (bit i = byte i), and a few bit tricks
+// turn those into the positions where tokens start. The lexer then walks tokens with a
+// count-trailing-zeros per token, and never looks at whitespace or string contents byte by byte.
+// The 256-entry table serves the remaining scalar paths in place of std::isspace/isdigit, which
+// are locale-dependent and accept more than JSON does.
+namespace json_detail
+{
+    inline constexpr std::size_t block_size = 64;
+
+    enum CharClass : std::uint8_t
+    {
+        WHITESPACE = 1 << 0, // ' ', \t, \n, \r
+        QUOTE      = 1 << 1,
+        BACKSLASH  = 1 << 2,
+        STRUCTURAL = 1 << 3, // { } [ ] : ,
+        DIGIT      = 1 << 4,
+        CONTROL    = 1 << 5, // below 0x20, must be escaped inside strings
+    };
+
+    inline constexpr std::array<std::uint8_t, 256> char_classes = [] {
+        std::array<std::uint8_t, 256> table{ };
+        for (const unsigned char c : { ' ', '\t', '\n', '\r' }) table[c] |= WHITESPACE;
+        for (const unsigned char c : { '{', '}', '[', ']', ':', ',' }) table[c] |= STRUCTURAL;
+        for (unsigned char c = '0'; c <= '9'; ++c) table[c] |= DIGIT;
+        table['"'] |= QUOTE;
+        table['\\'] |= BACKSLASH;
+        for (unsigned c = 0; c < 0x20; ++c) table[c] |= CONTROL;
+        return table;
+    }();
+
+    [[nodiscard]] constexpr bool is(char c, std::uint8_t classes) noexcept
+    {
+        return (char_classes[static_cast<unsigned char>(c)] & classes) != 0;
+    }
+
+    struct BlockMasks
+    {
+        std::uint64_t whitespace;
+        std::uint64_t quote;
+        std::uint64_t backslash;
+        std::uint64_t structural;
+    };
+
+    // classifies block_size bytes starting at p; all of them must be readable
+    [[nodiscard]] inline BlockMasks classify_block(const char * p) noexcept
+    {
+        BlockMasks masks{ };
+
+#if defined(JSON_SIMD_AVX2)
+        const auto space = _mm256_set1_epi8(' ');
+        const auto tab = _mm256_set1_epi8('\t');
+        const auto newline = _mm256_set1_epi8('\n');
+        const auto carriage = _mm256_set1_epi8('\r');
+        const auto quote = _mm256_set1_epi8('"');
+        const auto backslash = _mm256_set1_epi8('\\');
+        const auto open = _mm256_set1_epi8('{');
+        const auto close = _mm256_set1_epi8('}');
+        const auto comma = _mm256_set1_epi8(',');
+        const auto colon = _mm256_set1_epi8(':');
+        const auto fold = _mm256_set1_epi8(0x20);
+
+        for (std::size_t offset = 0; offset < block_size; offset += 32)
+        {
+            const auto bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + offset));
+            // '[' | 0x20 == '{' and ']' | 0x20 == '}'; ',' and ':' are compared unfolded, since
+            // folding would also match the control characters 0x0c and 0x1a
+            const auto folded = _mm256_or_si256(bytes, fold);
+
+            const auto whitespace = _mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpeq_epi8(bytes, space), _mm256_cmpeq_epi8(bytes, tab)),
+                _mm256_or_si256(_mm256_cmpeq_epi8(bytes, newline), _mm256_cmpeq_epi8(bytes, carriage)));
+            const auto structural = _mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpeq_epi8(folded, open), _mm256_cmpeq_epi8(folded, close)),
+                _mm256_or_si256(_mm256_cmpeq_epi8(bytes, comma), _mm256_cmpeq_epi8(bytes, colon)));
+
+            masks.whitespace |= std::uint64_t{ static_cast<std::uint32_t>(_mm256_movemask_epi8(whitespace)) } << offset;
+            masks.quote      |= std::uint64_t{ static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, quote))) } << offset;
+            masks.backslash  |= std::uint64_t{ static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, backslash))) } << offset;
+            masks.structural |= std::uint64_t{ static_cast<std::uint32_t>(_mm256_movemask_epi8(structural)) } << offset;
+        }
+#elif defined(JSON_SIMD_SSE2)
+        const auto space = _mm_set1_epi8(' ');
+        const auto tab = _mm_set1_epi8('\t');
+        const auto newline = _mm_set1_epi8('\n');
+        const auto carriage = _mm_set1_epi8('\r');
+        const auto quote = _mm_set1_epi8('"');
+        const auto backslash = _mm_set1_epi8('\\');
+        const auto open = _mm_set1_epi8('{');
+        const auto close = _mm_set1_epi8('}');
+        const auto comma = _mm_set1_epi8(',');
+        const auto colon = _mm_set1_epi8(':');
+        const auto fold = _mm_set1_epi8(0x20);
+
+        for (std::size_t offset = 0; offset < block_size; offset += 16)
+        {
+            const auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + offset));
+            const auto folded = _mm_or_si128(bytes, fold);
+
+            const auto whitespace = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(bytes, space), _mm_cmpeq_epi8(bytes, tab)),
+                _mm_or_si128(_mm_cmpeq_epi8(bytes, newline), _mm_cmpeq_epi8(bytes, carriage)));
+            const auto structural = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(folded, open), _mm_cmpeq_epi8(folded, close)),
+                _mm_or_si128(_mm_cmpeq_epi8(bytes, comma), _mm_cmpeq_epi8(bytes, colon)));
+
+            masks.whitespace |= std::uint64_t{ static_cast<std::uint16_t>(_mm_movemask_epi8(whitespace)) } << offset;
+            masks.quote      |= std::uint64_t{ static_cast<std::uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, quote))) } << offset;
+            masks.backslash  |= std::uint64_t{ static_cast<std::uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, backslash))) } << offset;
+            masks.structural |= std::uint64_t{ static_cast<std::uint16_t>(_mm_movemask_epi8(structural)) } << offset;
+        }
+#elif defined(JSON_SIMD_NEON64)
+        // NEON has no movemask: weight each lane by its bit and add neighbours pairwise
+        static constexpr std::uint8_t weights[16] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+        const auto weight = vld1q_u8(weights);
+        const auto bits = [&](uint8x16_t v0, uint8x16_t v1, uint8x16_t v2, uint8x16_t v3) {
+            auto sum0 = vpaddq_u8(vandq_u8(v0, weight), vandq_u8(v1, weight));
+            auto sum1 = vpaddq_u8(vandq_u8(v2, weight), vandq_u8(v3, weight));
+            sum0 = vpaddq_u8(sum0, sum1);
+            sum0 = vpaddq_u8(sum0, sum0);
+            return vgetq_lane_u64(vreinterpretq_u64_u8(sum0), 0);
+        };
+
+        uint8x16_t bytes[4];
+        for (std::size_t i = 0; i < 4; ++i)
+        {
+            bytes[i] = vld1q_u8(reinterpret_cast<const std::uint8_t *>(p + i * 16));
+        }
+
+        const auto eq = [](uint8x16_t v, char c) { return vceqq_u8(v, vdupq_n_u8(static_cast<std::uint8_t>(c))); };
+        const auto classify = [&](auto && predicate) {
+            return bits(predicate(bytes[0]), predicate(bytes[1]), predicate(bytes[2]), predicate(bytes[3]));
+        };
+
+        masks.whitespace = classify([&](uint8x16_t v) {
+            return vorrq_u8(vorrq_u8(eq(v, ' '), eq(v, '\t')), vorrq_u8(eq(v, '\n'), eq(v, '\r')));
+        });
+        masks.quote = classify([&](uint8x16_t v) { return eq(v, '"'); });
+        masks.backslash = classify([&](uint8x16_t v) { return eq(v, '\\'); });
+        masks.structural = classify([&](uint8x16_t v) {
+            const auto folded = vorrq_u8(v, vdupq_n_u8(0x20));
+            return vorrq_u8(vorrq_u8(eq(folded, '{'), eq(folded, '}')), vorrq_u8(eq(v, ','), eq(v, ':')));
+        });
+#else
+        for (std::size_t i = 0; i < block_size; ++i)
+        {
+            const auto classes = char_classes[static_cast<unsigned char>(p[i])];
+            masks.whitespace |= static_cast<std::uint64_t>((classes & WHITESPACE) != 0) << i;
+            masks.quote      |= static_cast<std::uint64_t>((classes & QUOTE) != 0) << i;
+            masks.backslash  |= static_cast<std::uint64_t>((classes & BACKSLASH) != 0) << i;
+            masks.structural |= static_cast<std::uint64_t>((classes & STRUCTURAL) != 0) << i;
+        }
+#endif
+
+        return masks;
+    }
+
+    // bit i set when an odd number of bits at or below i are set in `bits`
+    [[nodiscard]] constexpr std::uint64_t prefix_xor(std::uint64_t bits) noexcept
+    {
+        bits ^= bits << 1;
+        bits ^= bits << 2;
+        bits ^= bits << 4;
+        bits ^= bits << 8;
+        bits ^= bits << 16;
+        bits ^= bits << 32;
+        return bits;
+    }
+
+    // the bits of a block mask that lie at or after p
+    [[nodiscard]] inline std::uint64_t bits_from(const char * p, const char * block, std::uint64_t bits) noexcept
+    {
+        if (p <= block)
+        {
+            return bits;
+        }
+        const auto skipped = static_cast<std::size_t>(p - block);
+        return skipped < block_size ? bits & (~std::uint64_t{ 0 } << skipped) : 0;
+    }
+
+    // Where tokens start in one block, with strings already told apart from the rest.
+    struct BlockIndex
+    {
+        std::uint64_t tokens; // structural characters, opening quotes and the first byte of scalars
+        std::uint64_t quotes; // unescaped quotes, opening and closing
+    };
+
+    // Indexes consecutive blocks of one document. Escapes, open strings and scalars may cross a
+    // block boundary, so the indexer carries that state over and blocks must be fed in order.
+    class BlockIndexer
+    {
+        std::uint64_t m_escaped{ 0 };  // bit 0: the first byte of the next block is escaped
+        std::uint64_t m_inString{ 0 }; // all ones while a string is open across the boundary
+        std::uint64_t m_inScalar{ 0 }; // bit 0: the previous block ended inside a scalar
+
+    public:
+        // indexes min(block_size, end - p) bytes; a short tail is padded with whitespace
+        [[nodiscard]] BlockIndex next(const char * p, const char * end) noexcept
+        {
+            BlockMasks masks;
+            if (static_cast<std::size_t>(end - p) >= block_size)
+            {
+                masks = classify_block(p);
+            }
+            else
+            {
+                char padded[block_size];
+                std::size_t i = 0;
+                for (; p + i < end; ++i) padded[i] = p[i];
+                for (; i < block_size; ++i) padded[i] = ' ';
+                masks = classify_block(padded);
+            }
+
+            const auto quotes = masks.quote & ~escaped(masks.backslash);
+
+            // set from an opening quote up to (not including) its closing quote
+            const auto inString = prefix_xor(quotes) ^ m_inString;
+            m_inString = static_cast<std::uint64_t>(static_cast<std::int64_t>(inString) >> 63);
+
+            const auto scalar = ~(masks.whitespace | masks.structural | quotes | inString);
+            const auto scalarStarts = scalar & ~((scalar << 1) | m_inScalar);
+            m_inScalar = scalar >> 63;
+
+            return { (masks.structural & ~inString) | (quotes & inString) | scalarStarts, quotes };
+        }
+
+    private:
+        // Bytes preceded by an escaping backslash. Escapes are rare outside of text-heavy strings,
+        // so walking the backslashes one by one beats a branch-free version in practice.
+        [[nodiscard]] std::uint64_t escaped(std::uint64_t backslashes) noexcept
+        {
+            auto result = m_escaped;
+            m_escaped = 0;
+
+            // an escaped backslash escapes nothing
+            backslashes &= ~result;
+            while (backslashes != 0)
+            {
+                const auto bit = static_cast<unsigned>(std::countr_zero(backslashes));
+                if (bit == block_size - 1)
+                {
+                    m_escaped = 1;
+                    break;
+                }
+                result |= std::uint64_t{ 2 } << bit;
+                backslashes &= ~(std::uint64_t{ 3 } << bit);
+            }
+            return result;
+        }
+    };
+
+    // first byte in [p, end) that a JSON string cannot hold as is ('"', '\\' or a control
+    // character), or end; plain text is skipped a vector at a time
+    [[nodiscard]] inline const char * find_escape(const char * p, const char * end) noexcept
+    {
+#if defined(JSON_SIMD_AVX2)
+        const auto quote = _mm256_set1_epi8('"');
+        const auto backslash = _mm256_set1_epi8('\\');
+        const auto control = _mm256_set1_epi8(0x1f);
+        for (; end - p >= 32; p += 32)
+        {
+            const auto bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+            // bytes <= 0x1f are the ones left unchanged by an unsigned min with 0x1f
+            const auto special = _mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpeq_epi8(bytes, quote), _mm256_cmpeq_epi8(bytes, backslash)),
+                _mm256_cmpeq_epi8(_mm256_min_epu8(bytes, control), bytes));
+            const auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(special));
+            if (mask != 0)
+            {
+                return p + std::countr_zero(mask);
+            }
+        }
+#elif defined(JSON_SIMD_SSE2)
+        const auto quote = _mm_set1_epi8('"');
+        const auto backslash = _mm_set1_epi8('\\');
+        const auto control = _mm_set1_epi8(0x1f);
+        for (; end - p >= 16; p += 16)
+        {
+            const auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+            const auto special = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(bytes, quote), _mm_cmpeq_epi8(bytes, backslash)),
+                _mm_cmpeq_epi8(_mm_min_epu8(bytes, control), bytes));
+            const auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(special));
+            if (mask != 0)
+            {
+                return p + std::countr_zero(mask);
+            }
+        }
+#elif defined(JSON_SIMD_NEON64)
+        for (; end - p >= 16; p += 16)
+        {
+            const auto bytes = vld1q_u8(reinterpret_cast<const std::uint8_t *>(p));
+            const auto special = vorrq_u8(
+                vorrq_u8(vceqq_u8(bytes, vdupq_n_u8('"')), vceqq_u8(bytes, vdupq_n_u8('\\'))),
+                vcltq_u8(bytes, vdupq_n_u8(0x20)));
+            if (vmaxvq_u8(special) != 0)
+            {
+                break; // located by the scalar loop below
+            }
+        }
+#endif
+        while (p != end && !is(*p, QUOTE | BACKSLASH | CONTROL))
+        {
+            ++p;
+        }
+        return p;
+    }
+}
@@ -0,0 +1,464 @@
+#include "json-stream.hpp"
+
+#include <charconv>
+
+#include "helpers/strings.hpp"
+
+constexpr std::string_view STREAM_EXPECTED_VALUE = "expected a value";
+constexpr std::string_view STREAM_EXPECTED_KEY   = "expected a string key";
+constexpr std::string_view STREAM_EXPECTED_COLON = "expected ':'";
+constexpr std::string_view STREAM_EXPECTED_COMMA = "expected ',' or the end of the container";
+constexpr std::string_view STREAM_UNCLOSED       = "unexpected EOF inside a container";
+constexpr std::string_view STREAM_ABORTED        = "stopped by the handler";
+
+JsonStreamParser::JsonStreamParser(IJsonHandler & handler)
+    : m_handler(handler)
+{ }
+
+bool JsonStreamParser::feed(std::string_view chunk)
+{
+    if (failed())
+    {
+        return false;
+    }
+
+    if (!m_carry.empty())
+    {
+        // complete the cut-off token first, copying no more of the chunk than it needs
+        const auto needed = carryCompletion(chunk);
+        if (needed == std::string_view::npos)
+        {
+            m_carry.append(chunk);
+            return true;
+        }
+
+        m_carry.append(chunk.substr(0, needed));
+        const auto carry = std::move(m_carry);
+        m_carry.clear();
+        if (!lex(carry, true))
+        {
+            return false;
+        }
+        chunk.remove_prefix(needed);
+    }
+
+    return lex(chunk, false);
+}
+
+bool JsonStreamParser::finish()
+{
+    if (failed())
+    {
+        return false;
+    }
+
+    if (!m_carry.empty())
+    {
+        const auto carry = std::move(m_carry);
+        m_carry.clear();
+        if (!lex(carry, true))
+        {
+            return false;
+        }
+    }
+
+    if (!m_stack.empty() || m_expect != Expect::Value)
+    {
+        return fail(STREAM_UNCLOSED, m_offset);
+    }
+    return true;
+}
+
+bool JsonStreamParser::parse(std::string_view document)
+{
+    if (failed())
+    {
+        return false;
+    }
+    if (!m_carry.empty())
+    {
+        return feed(document) && finish();
+    }
+    return lex(document, true) && finish();
+}
+
+size_t JsonStreamParser::carryCompletion(std::string_view chunk) const noexcept
+{
+    size_t i = 0;
+    if (m_carry.front() == '"')
+    {
+        // an odd run of backslashes at the end of the carry escapes the chunk's first byte
+        size_t backslashes = 0;
+        for (auto it = m_carry.rbegin(); it + 1 != m_carry.rend() && *it == '\\'; ++it)
+        {
+            ++backslashes;
+        }
+        i = backslashes % 2;
+
+        while (i < chunk.size())
+        {
+            if (chunk[i] == '\\')
+            {
+                i += 2;
+            }
+            else if (chunk[i] == '"')
+            {
+                return i + 1;
+            }
+            else
+            {
+                ++i;
+            }
+        }
+        return std::string_view::npos;
+    }
+
+    // scalars run until whitespace, a structural character or a quote
+    while (i < chunk.size() && !json_detail::is(chunk[i], json_detail::WHITESPACE | json_detail::STRUCTURAL | json_detail::QUOTE))
+    {
+        ++i;
+    }
+    return i < chunk.size() ? i : std::string_view::npos;
+}
+
+bool JsonStreamParser::lex(std::string_view text, bool complete)
+{
+    JsonLexer lexer{ text };
+    while (true)
+    {
+        const auto token = lexer.next();
+        if (token.type == TokenType::Eof)
+        {
+            m_offset += text.size();
+            return true;
+        }
+
+        if (!complete)
+        {
+            // a token touching the end of the chunk may continue in the next one
+            const auto rest = text.substr(token.position);
+            const bool cut = token.type == TokenType::Error
+                ? rest.front() == '"' || std::string_view("null").starts_with(rest)
+                : (token.type == TokenType::Number || token.type == TokenType::Null) && token.text.size() == rest.size();
+            if (cut)
+            {
+                m_carry.assign(rest);
+                m_offset += token.position;
+                return true;
+            }
+        }
+
+        if (token.type == TokenType::Error)
+        {
+            return fail(token.text, m_offset + token.position);
+        }
+        if (!handle(token, m_offset + token.position))
+        {
+            return fail(STREAM_ABORTED, m_offset + token.position); // keeps a syntax error reported first
+        }
+    }
+}
+
+bool JsonStreamParser::handle(const Token & token, uint64_t offset)
+{
+    switch (m_expect)
+    {
+        case Expect::FirstValue:
+        case Expect::Value:
+            {
+                if (m_expect == Expect::FirstValue && token.type == TokenType::RBracket)
+                {
+                    m_stack.pop_back();
+                    completeValue();
+                    return m_handler.endArray();
+                }
+
+                switch (token.type)
+                {
+                    case TokenType::LBrace:
+                        m_stack.push_back(true);
+                        m_expect = Expect::FirstKey;
+                        return m_handler.beginObject();
+                    case TokenType::LBracket:
+                        m_stack.push_back(false);
+                        m_expect = Expect::FirstValue;
+                        return m_handler.beginArray();
+                    case TokenType::String: completeValue(); return m_handler.string(token.text);
+                    case TokenType::Number: completeValue(); return m_handler.number(token.text);
+                    case TokenType::Null:   completeValue(); return m_handler.null();
+                    default:                return fail(STREAM_EXPECTED_VALUE, offset);
+                }
+            }
+        case Expect::FirstKey:
+        case Expect::Key:
+            {
+                if (token.type == TokenType::String)
+                {
+                    m_expect = Expect::Colon;
+                    return m_handler.key(token.text);
+                }
+                if (m_expect == Expect::FirstKey && token.type == TokenType::RBrace)
+                {
+                    m_stack.pop_back();
+                    completeValue();
+                    return m_handler.endObject();
+                }
+                return fail(STREAM_EXPECTED_KEY, offset);
+            }
+        case Expect::Colon:
+            {
+                if (token.type != TokenType::Colon)
+                {
+                    return fail(STREAM_EXPECTED_COLON, offset);
+                }
+                m_expect = Expect::Value;
+                return true;
+            }
+        case Expect::ObjectNext:
+        case Expect::ArrayNext:
+            {
+                const auto object = m_expect == Expect::ObjectNext;
+                if (token.type == TokenType::Comma)
+                {
+                    m_expect = object ? Expect::Key : Expect::Value;
+                    return true;
+                }
+                if (token.type == (object ? TokenType::RBrace : TokenType::RBracket))
+                {
+                    m_stack.pop_back();
+                    completeValue();
+                    return object ? m_handler.endObject() : m_handler.endArray();
+                }
+                return fail(STREAM_EXPECTED_COMMA, offset);
+            }
+    }
+    return false;
+}
+
+void JsonStreamParser::completeValue() noexcept
+{
+    if (m_stack.empty())
+    {
+        m_expect = Expect::Value; // ready for the next top-level value
+    }
+    else
+    {
+        m_expect = m_stack.back() ? Expect::ObjectNext : Expect::ArrayNext;
+    }
+}
+
+bool JsonStreamParser::fail(std::string_view message, uint64_t offset)
+{
+    if (!failed())
+    {
+        m_error = message;
+        m_errorOffset = offset;
+    }
+    return false;
+}
+
+// ---- JsonValueCollector ----
+
+namespace
+{
+    // unescapes ~1 and ~0 in a JSON pointer segment
+    std::string pointer_segment(std::string_view raw)
+    {
+        std::string segment;
+        segment.reserve(raw.size());
+        for (size_t i = 0; i < raw.size(); ++i)
+        {
+            if (raw[i] == '~' && i + 1 < raw.size() && (raw[i + 1] == '0' || raw[i + 1] == '1'))
+            {
+                segment += raw[++i] == '0' ? '~' : '/';
+            }
+            else
+            {
+                segment += raw[i];
+            }
+        }
+        return segment;
+    }
+
+    bool matches_key(const std::string & segment, std::string_view raw)
+    {
+        if (segment == "*")
+        {
+            return true;
+        }
+        return raw.find('\\') == std::string_view::npos ? segment == raw : segment == str::unescape(raw);
+    }
+
+    bool matches_index(const std::string & segment, size_t index)
+    {
+        if (segment == "*")
+        {
+            return true;
+        }
+        size_t value = 0;
+        const auto [end, error] = std::from_chars(segment.data(), segment.data() + segment.size(), value);
+        return error == std::errc() && end == segment.data() + segment.size() && value == index;
+    }
+}
+
+JsonValueCollector::JsonValueCollector(std::string_view path, std::function<void(Value &&)> onValue)
+    : m_onValue(std::move(onValue))
+{
+    // "" is the root, "/a/b" has the segments "a" and "b"
+    while (!path.empty())
+    {
+        path.remove_prefix(1);
+        const auto end = path.find('/');
+        m_pattern.push_back(pointer_segment(path.substr(0, end)));
+        path.remove_prefix(end == std::string_view::npos ? path.size() : end);
+    }
+}
+
+bool JsonValueCollector::selectValue(bool & matches)
+{
+    // the value's path is one segment longer than its container's, taken from the current key
+    // or the array index
+    const auto depth = m_frames.size();
+    if (depth == 0)
+    {
+        matches = true;
+    }
+    else
+    {
+        auto & frame = m_frames.back();
+        if (frame.object)
+        {
+            matches = frame.childMatches;
+        }
+        else
+        {
+            const auto index = frame.index++;
+            matches = frame.matches && depth <= m_pattern.size() && matches_index(m_pattern[depth - 1], index);
+        }
+    }
+    return matches && depth == m_pattern.size();
+}
+
+bool JsonValueCollector::beginObject()
+{
+    bool matches = false;
+    if (!m_building.empty() || selectValue(matches))
+    {
+        beginContainer(Value::object());
+    }
+    else
+    {
+        m_frames.push_back(Frame{ true, matches, false });
+    }
+    return true;
+}
+
+bool JsonValueCollector::beginArray()
+{
+    bool matches = false;
+    if (!m_building.empty() || selectValue(matches))
+    {
+        beginContainer(Value::array());
+    }
+    else
+    {
+        m_frames.push_back(Frame{ false, matches, false });
+    }
+    return true;
+}
+
+bool JsonValueCollector::endObject()
+{
+    if (!m_building.empty())
+    {
+        endContainer();
+    }
+    else
+    {
+        m_frames.pop_back();
+    }
+    return true;
+}
+
+bool JsonValueCollector::endArray()
+{
+    return endObject();
+}
+
+bool JsonValueCollector::key(std::string_view raw)
+{
+    if (!m_building.empty())
+    {
+        m_keys.push_back(str::unescape(raw));
+        return true;
+    }
+
+    auto & frame = m_frames.back();
+    const auto depth = m_frames.size();
+    frame.childMatches = frame.matches && depth <= m_pattern.size() && matches_key(m_pattern[depth - 1], raw);
+    return true;
+}
+
+bool JsonValueCollector::string(std::string_view raw)
+{
+    bool matches = false;
+    if (!m_building.empty() || selectValue(matches))
+    {
+        add(Value{ str::unescape(raw) });
+    }
+    return true;
+}
+
+bool JsonValueCollector::number(std::string_view text)
+{
+    bool matches = false;
+    if (!m_building.empty() || selectValue(matches))
+    {
+        auto value = 0.0;
+        std::from_chars(text.data(), text.data() + text.size(), value);
+        add(Value{ value });
+    }
+    return true;
+}
+
+bool JsonValueCollector::null()
+{
+    bool matches = false;
+    if (!m_building.empty() || selectValue(matches))
+    {
+        add(Value{ });
+    }
+    return true;
+}
+
+void JsonValueCollector::beginContainer(Value container)
+{
+    m_building.push_back(std::move(container));
+}
+
+void JsonValueCollector::endContainer()
+{
+    auto done = std::move(m_building.back());
+    m_building.pop_back();
+    add(std::move(done));
+}
+
+void JsonValueCollector::add(Value value)
+{
+    if (m_building.empty())
+    {
+        m_onValue(std::move(value));
+        return;
+    }
+
+    auto & container = m_building.back();
+    if (container.is<Value::array_t>())
+    {
+        container.as<Value::array_t>().push_back(std::move(value));
+    }
+    else
+    {
+        container.as<Value::object_t>().insert_or_assign(std::move(m_keys.back()), std::move(value));
+        m_keys.pop_back();
+    }
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "core/value.hpp"
+#include "json.hpp"
+
+// SAX events emitted by JsonStreamParser. Strings, keys and numbers are passed as their raw
+// source text (escapes left in place, see str::unescape) and the views are only valid during the
+// call. Returning false stops the parser.
+class IJsonHandler
+{
+public:
+    virtual ~IJsonHandler() = default;
+
+    virtual bool beginObject() = 0;
+    virtual bool endObject() = 0;
+    virtual bool beginArray() = 0;
+    virtual bool endArray() = 0;
+    virtual bool key(std::string_view raw) = 0;
+    virtual bool string(std::string_view raw) = 0;
+    virtual bool number(std::string_view text) = 0;
+    virtual bool null() = 0;
+};
+
+// Resumable, push-based JSON parser: feed() the document in chunks of any size as they arrive,
+// then finish(). Nesting is tracked on an explicit stack, so deep documents don't recurse, and
+// only a token split across two chunks is ever copied. Several top-level values may follow each
+// other (e.g. newline-delimited JSON).
+//
+// After the first error every call returns false; error() and errorOffset() describe it.
+class JsonStreamParser
+{
+public:
+    explicit JsonStreamParser(IJsonHandler & handler);
+
+    bool feed(std::string_view chunk);
+
+    // the document ended: flushes a trailing scalar and checks that every container was closed
+    bool finish();
+
+    // feed() and finish() for a document that is already in memory; within it nothing is ever
+    // copied, so every view passed to the handler points into `document`
+    bool parse(std::string_view document);
+
+    [[nodiscard]] bool failed() const noexcept { return !m_error.empty(); }
+    [[nodiscard]] std::string_view error() const noexcept { return m_error; }
+    [[nodiscard]] uint64_t errorOffset() const noexcept { return m_errorOffset; }
+
+    // nesting depth of the current position
+    [[nodiscard]] size_t depth() const noexcept { return m_stack.size(); }
+
+private:
+    enum class Expect : uint8_t
+    {
+        Value, FirstValue, ArrayNext, // FirstValue: a value or ']'
+        FirstKey, Key, Colon, ObjectNext, // FirstKey: a key or '}'
+    };
+
+    IJsonHandler & m_handler;
+
+    std::vector<bool> m_stack; // true for objects
+    Expect m_expect{ Expect::Value };
+
+    std::string m_carry;   // a token cut off at the end of the previous chunk
+    uint64_t m_offset{ 0 }; // document offset of the next byte to lex
+
+    std::string_view m_error;
+    uint64_t m_errorOffset{ 0 };
+
+    [[nodiscard]] size_t carryCompletion(std::string_view chunk) const noexcept;
+    bool lex(std::string_view text, bool complete);
+    bool handle(const Token & token, uint64_t offset);
+    void completeValue() noexcept;
+    bool fail(std::string_view message, uint64_t offset);
+};
+
+// Handler that builds Values for the subtrees at one path and hands each to a callback, skipping
+// everything else without allocating. Paths are JSON pointers ("/items/0/name", "" for the whole
+// document) in which "*" matches any key or array index.
+class JsonValueCollector : public IJsonHandler
+{
+public:
+    JsonValueCollector(std::string_view path, std::function<void(Value &&)> onValue);
+
+    bool beginObject() override;
+    bool endObject() override;
+    bool beginArray() override;
+    bool endArray() override;
+    bool key(std::string_view raw) override;
+    bool string(std::string_view raw) override;
+    bool number(std::string_view text) override;
+    bool null() override;
+
+private:
+    struct Frame
+    {
+        bool object;
+        bool matches;       // the container's own path matches the pattern so far
+        bool childMatches;  // the path of the current member does as well
+        size_t index{ 0 };  // next array index
+    };
+
+    std::vector<std::string> m_pattern;
+    std::function<void(Value &&)> m_onValue;
+
+    std::vector<Frame> m_frames;
+
+    // subtree under construction: open containers and their pending keys
+    std::vector<Value> m_building;
+    std::vector<std::string> m_keys;
+
+    [[nodiscard]] bool selectValue(bool & matches);
+    void beginContainer(Value container);
+    void endContainer();
+    void add(Value value);
+};
@@ -0,0 +1,346 @@
+#include "json-tape.hpp"
+
+#include <charconv>
+#include <limits>
+
+#include "helpers/numbers.hpp"
+#include "helpers/strings.hpp"
+#include "json-stream.hpp"
+
+constexpr std::string_view TAPE_MULTIPLE_ROOTS = "more than one top-level value";
+constexpr std::string_view TAPE_TOO_LARGE      = "document too large";
+
+// ---- JsonTapeBuilder ----
+
+class JsonTapeBuilder final : public IJsonHandler
+{
+public:
+    explicit JsonTapeBuilder(std::vector<JsonTape::Entry> & entries)
+        : m_entries(entries)
+    { }
+
+    [[nodiscard]] std::string_view error() const noexcept { return m_error; }
+
+    bool beginObject() override { return open(TokenType::LBrace); }
+    bool beginArray() override { return open(TokenType::LBracket); }
+    bool endObject() override { return close(); }
+    bool endArray() override { return close(); }
+
+    bool key(std::string_view raw) override
+    {
+        ++m_open.back().count;
+        return push(TokenType::String, raw);
+    }
+
+    bool string(std::string_view raw) override { return value(TokenType::String, raw); }
+    bool number(std::string_view text) override { return value(TokenType::Number, text); }
+    bool null() override { return value(TokenType::Null, { }); }
+
+private:
+    struct Open
+    {
+        uint32_t index;
+        uint32_t count;
+        bool object;
+    };
+
+    std::vector<JsonTape::Entry> & m_entries;
+    std::vector<Open> m_open;
+    std::string_view m_error;
+
+    bool startValue()
+    {
+        if (m_open.empty())
+        {
+            if (!m_entries.empty())
+            {
+                m_error = TAPE_MULTIPLE_ROOTS;
+                return false;
+            }
+        }
+        else if (!m_open.back().object)
+        {
+            ++m_open.back().count;
+        }
+        return true;
+    }
+
+    bool push(TokenType type, std::string_view text)
+    {
+        if (m_entries.size() >= std::numeric_limits<uint32_t>::max() - 1)
+        {
+            m_error = TAPE_TOO_LARGE;
+            return false;
+        }
+        const auto index = static_cast<uint32_t>(m_entries.size());
+        m_entries.push_back({ text, index + 1, 0, type });
+        return true;
+    }
+
+    bool value(TokenType type, std::string_view text)
+    {
+        return startValue() && push(type, text);
+    }
+
+    bool open(TokenType type)
+    {
+        if (!value(type, { }))
+        {
+            return false;
+        }
+        m_open.push_back({ static_cast<uint32_t>(m_entries.size() - 1), 0, type == TokenType::LBrace });
+        return true;
+    }
+
+    bool close()
+    {
+        const auto open = m_open.back();
+        m_open.pop_back();
+
+        auto & entry = m_entries[open.index];
+        entry.end = static_cast<uint32_t>(m_entries.size());
+        entry.count = open.count;
+        return true;
+    }
+};
+
+// ---- JsonTape ----
+
+bool JsonTape::parse(std::string_view json)
+{
+    m_file.close();
+    return load(json);
+}
+
+bool JsonTape::open(const std::string & path)
+{
+    if (!m_file.open(path, MappedFile::Access::sequential))
+    {
+        m_entries.clear();
+        m_error = m_file.error();
+        return false;
+    }
+    return load(m_file.view());
+}
+
+bool JsonTape::load(std::string_view json)
+{
+    m_entries.clear();
+    m_error = { };
+
+    // a token per 4 bytes is a generous upper bound for typical documents
+    m_entries.reserve(json.size() / 4 + 1);
+
+    JsonTapeBuilder builder{ m_entries };
+    JsonStreamParser parser{ builder };
+    if (parser.parse(json))
+    {
+        return true;
+    }
+
+    m_error = builder.error().empty() ? parser.error() : builder.error();
+    m_entries.clear();
+    return false;
+}
+
+JsonRef JsonTape::root() const noexcept
+{
+    return m_entries.empty() ? JsonRef{ } : JsonRef{ this, 0 };
+}
+
+// ---- JsonRef ----
+
+namespace
+{
+    // a path segment, with ~1 and ~0 still escaped, against a key, with JSON escapes still in
+    bool segment_matches(std::string_view segment, std::string_view key)
+    {
+        if (segment.find('~') == std::string_view::npos && key.find('\\') == std::string_view::npos)
+        {
+            return segment == key;
+        }
+
+        std::string decoded;
+        decoded.reserve(segment.size());
+        for (size_t i = 0; i < segment.size(); ++i)
+        {
+            if (segment[i] == '~' && i + 1 < segment.size() && (segment[i + 1] == '0' || segment[i + 1] == '1'))
+            {
+                decoded += segment[++i] == '0' ? '~' : '/';
+            }
+            else
+            {
+                decoded += segment[i];
+            }
+        }
+        return decoded == str::unescape(key);
+    }
+}
+
+TokenType JsonRef::type() const noexcept
+{
+    return valid() ? m_tape->m_entries[m_index].type : TokenType::Eof;
+}
+
+std::string_view JsonRef::raw() const noexcept
+{
+    return valid() ? m_tape->m_entries[m_index].text : std::string_view{ };
+}
+
+std::string JsonRef::as_string() const
+{
+    return is_string() ? str::unescape(raw()) : std::string{ };
+}
+
+double JsonRef::as_double() const noexcept
+{
+    const auto text = is_number() ? raw() : std::string_view{ };
+    auto value = 0.0;
+    std::from_chars(text.data(), text.data() + text.size(), value);
+    return value;
+}
+
+int64_t JsonRef::as_int() const noexcept
+{
+    const auto text = is_number() ? raw() : std::string_view{ };
+    int64_t value = 0;
+    if (num::parse(text, value))
+    {
+        return value;
+    }
+
+    // fractions, exponents and integers past 64 bits go through the double, truncated and
+    // saturated: "1e3" is 1000, not the 1 before the 'e'
+    const auto real = as_double();
+    if (!(real > static_cast<double>(std::numeric_limits<int64_t>::min())))
+    {
+        return real < 0.0 ? std::numeric_limits<int64_t>::min() : 0; // also NaN
+    }
+    if (real >= static_cast<double>(std::numeric_limits<int64_t>::max()))
+    {
+        return std::numeric_limits<int64_t>::max();
+    }
+    return static_cast<int64_t>(real);
+}
+
+size_t JsonRef::size() const noexcept
+{
+    return is_object() || is_array() ? m_tape->m_entries[m_index].count : 0;
+}
+
+JsonRef JsonRef::find(std::string_view path) const
+{
+    if (!path.empty() && path.front() == '/')
+    {
+        path.remove_prefix(1);
+    }
+
+    auto current = *this;
+    while (current.valid() && !path.empty())
+    {
+        const auto end = path.find('/');
+        current = current.child(path.substr(0, end));
+        path.remove_prefix(end == std::string_view::npos ? path.size() : end + 1);
+    }
+    return current;
+}
+
+JsonRef JsonRef::operator[](std::string_view key) const
+{
+    if (!is_object())
+    {
+        return { };
+    }
+
+    const auto & entries = m_tape->m_entries;
+    for (auto i = m_index + 1; i < entries[m_index].end; i = entries[i + 1].end)
+    {
+        if (entries[i].text == key)
+        {
+            return { m_tape, i + 1 };
+        }
+        // keys with escapes only match once unescaped
+        if (entries[i].text.find('\\') != std::string_view::npos && str::unescape(entries[i].text) == key)
+        {
+            return { m_tape, i + 1 };
+        }
+    }
+    return { };
+}
+
+JsonRef JsonRef::operator[](size_t index) const
+{
+    if (!is_array() || index >= size())
+    {
+        return { };
+    }
+
+    const auto & entries = m_tape->m_entries;
+    auto i = m_index + 1;
+    for (; index > 0; --index)
+    {
+        i = entries[i].end;
+    }
+    return { m_tape, i };
+}
+
+JsonRef JsonRef::child(std::string_view segment) const
+{
+    if (is_array())
+    {
+        size_t index = 0;
+        const auto [end, error] = std::from_chars(segment.data(), segment.data() + segment.size(), index);
+        if (error != std::errc() || end != segment.data() + segment.size())
+        {
+            return { };
+        }
+        return (*this)[index];
+    }
+
+    if (!is_object())
+    {
+        return { };
+    }
+
+    const auto & entries = m_tape->m_entries;
+    for (auto i = m_index + 1; i < entries[m_index].end; i = entries[i + 1].end)
+    {
+        if (segment_matches(segment, entries[i].text))
+        {
+            return { m_tape, i + 1 };
+        }
+    }
+    return { };
+}
+
+Value JsonRef::to_value() const
+{
+    switch (type())
+    {
+        case TokenType::String: return Value{ as_string() };
+        case TokenType::Number: return Value{ as_double() };
+        case TokenType::LBracket:
+            {
+                auto array = Value::array_t{ };
+                array.reserve(size());
+                const auto & entries = m_tape->m_entries;
+                for (auto i = m_index + 1; i < entries[m_index].end; i = entries[i].end)
+                {
+                    array.push_back(JsonRef{ m_tape, i }.to_value());
+                }
+                return Value{ std::move(array) };
+            }
+        case TokenType::LBrace:
+            {
+                auto object = Value::object_t{ };
+                object.reserve(size());
+                const auto & entries = m_tape->m_entries;
+                for (auto i = m_index + 1; i < entries[m_index].end; i = entries[i + 1].end)
+                {
+                    object.insert_or_assign(str::unescape(entries[i].text), JsonRef{ m_tape, i + 1 }.to_value());
+                }
+                return Value{ std::move(object) };
+            }
+        default: return {};
+    }
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "core/value.hpp"
+#include "json.hpp"
+#include "mapped-file.hpp"
+
+class JsonTape;
+
+// Cursor to one value on a JsonTape. Cheap to copy; navigating and reading raw text never
+// allocates, and only the as_*() / to_value() calls convert anything. A failed lookup yields an
+// invalid ref, and every query on an invalid ref returns an empty result.
+class JsonRef
+{
+public:
+    JsonRef() noexcept = default;
+
+    [[nodiscard]] bool valid() const noexcept { return m_tape != nullptr; }
+    explicit operator bool() const noexcept { return valid(); }
+
+    // Null, String, Number, LBrace (object) or LBracket (array); Eof when invalid
+    [[nodiscard]] TokenType type() const noexcept;
+    [[nodiscard]] bool is_null() const noexcept { return type() == TokenType::Null; }
+    [[nodiscard]] bool is_string() const noexcept { return type() == TokenType::String; }
+    [[nodiscard]] bool is_number() const noexcept { return type() == TokenType::Number; }
+    [[nodiscard]] bool is_object() const noexcept { return type() == TokenType::LBrace; }
+    [[nodiscard]] bool is_array() const noexcept { return type() == TokenType::LBracket; }
+
+    // source text of a string (escapes left in place) or number
+    [[nodiscard]] std::string_view raw() const noexcept;
+
+    [[nodiscard]] std::string as_string() const;
+    [[nodiscard]] double as_double() const noexcept;
+    [[nodiscard]] int64_t as_int() const noexcept; // other numbers truncated, saturating
+
+    // members of an object or items of an array
+    [[nodiscard]] size_t size() const noexcept;
+
+    // "a/b/3": keys for objects, indices for arrays; "~1" and "~0" escape '/' and '~' in keys
+    [[nodiscard]] JsonRef find(std::string_view path) const;
+
+    [[nodiscard]] JsonRef operator[](std::string_view key) const;
+    [[nodiscard]] JsonRef operator[](size_t index) const;
+
+    // converts this subtree, and only this subtree, into a Value
+    [[nodiscard]] Value to_value() const;
+
+private:
+    friend class JsonTape;
+
+    const JsonTape * m_tape{ nullptr };
+    uint32_t m_index{ 0 };
+
+    JsonRef(const JsonTape * tape, uint32_t index) noexcept
+        : m_tape(tape)
+        , m_index(index)
+    { }
+
+    [[nodiscard]] JsonRef child(std::string_view segment) const;
+};
+
+// On-demand JSON access: parse() validates the document and records one tape entry per value
+// and key, each container knowing where it ends so lookups skip whole subtrees. The strings on
+// the tape are views into the source, which must outlive the tape.
+class JsonTape
+{
+public:
+    bool parse(std::string_view json);
+
+    // maps the file and parses it in place, so the tape's strings point into the mapping; refs
+    // stay valid until the next parse() or open(), or the tape's destruction
+    bool open(const std::string & path);
+
+    [[nodiscard]] JsonRef root() const noexcept;
+    [[nodiscard]] JsonRef find(std::string_view path) const { return root().find(path); }
+
+    [[nodiscard]] std::string_view error() const noexcept { return m_error; }
+
+    // entries recorded, for sizing and tests
+    [[nodiscard]] size_t size() const noexcept { return m_entries.size(); }
+
+private:
+    friend class JsonRef;
+    friend class JsonTapeBuilder;
+
+    struct Entry
+    {
+        std::string_view text; // strings and numbers
+        uint32_t end;          // index just past this value, subtree included (no closing entries)
+        uint32_t count;        // members or items of a container
+        TokenType type;        // object keys are String entries right after LBrace or a value
+    };
+
+    MappedFile m_file;
+    std::vector<Entry> m_entries;
+    std::string_view m_error;
+
+    bool load(std::string_view json);
+};
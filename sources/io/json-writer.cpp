@@ -0,0 +1,323 @@
+#include "json-writer.hpp"
+
+#include <cerrno>
+#include <cmath>
+#include <type_traits>
+#include <variant>
+
+#include <unistd.h>
+
+#include "helpers/numbers.hpp"
+#include "json-scan.hpp"
+
+JsonWriter::JsonWriter(std::span<char> buffer) noexcept
+    : m_data(buffer.data())
+    , m_capacity(buffer.size())
+    , m_spanSize(buffer.size())
+    , m_fixed(true)
+{ }
+
+char * JsonWriter::grow(size_t count)
+{
+    if (m_fixed)
+    {
+        // nothing more is written after the first miss, so the output stays a clean prefix
+        m_overflowed = true;
+        m_capacity = m_size;
+        return nullptr;
+    }
+
+    auto capacity = m_capacity < 256 ? size_t{ 256 } : m_capacity * 2;
+    while (capacity - m_size < count)
+    {
+        capacity *= 2;
+    }
+
+    m_storage.resize(capacity);
+    m_data = m_storage.data();
+    m_capacity = capacity;
+    return m_data + m_size;
+}
+
+void JsonWriter::clear() noexcept
+{
+    m_size = 0;
+    m_overflowed = false;
+    if (m_fixed)
+    {
+        m_capacity = m_spanSize;
+    }
+}
+
+bool JsonWriter::flush(std::ostream & os)
+{
+    const auto complete = !m_overflowed;
+    os.write(m_data, static_cast<std::streamsize>(m_size));
+    clear();
+    return complete && os.good();
+}
+
+bool JsonWriter::flush(int fd)
+{
+    auto complete = !m_overflowed;
+    const char * p = m_data;
+    auto remaining = m_size;
+    while (remaining > 0)
+    {
+        const auto written = ::write(fd, p, remaining);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            complete = false;
+            break;
+        }
+        p += written;
+        remaining -= static_cast<size_t>(written);
+    }
+    clear();
+    return complete;
+}
+
+void JsonWriter::writeString(std::string_view sv)
+{
+    static constexpr char hex[] = "0123456789abcdef";
+
+    put('"');
+
+    const char * p = sv.data();
+    const char * end = sv.data() + sv.size();
+    while (true)
+    {
+        const char * special = json_detail::find_escape(p, end);
+        append(p, static_cast<size_t>(special - p));
+        if (special == end)
+        {
+            break;
+        }
+
+        // same escapes as str::escape
+        switch (*special)
+        {
+            case '"':  append("\\\"", 2); break;
+            case '\\': append("\\\\", 2); break;
+            case '\b': append("\\b", 2);  break;
+            case '\f': append("\\f", 2);  break;
+            case '\n': append("\\n", 2);  break;
+            case '\r': append("\\r", 2);  break;
+            case '\t': append("\\t", 2);  break;
+            default:
+            {
+                const auto u = static_cast<unsigned char>(*special);
+                const char escaped[] = { '\\', 'u', '0', '0', hex[u >> 4], hex[u & 0xf] };
+                append(escaped, sizeof(escaped));
+                break;
+            }
+        }
+        p = special + 1;
+    }
+
+    put('"');
+}
+
+template <typename T>
+void JsonWriter::writeNumber(T value)
+{
+    // non-finite floats have no JSON literal; they go out as "inf" / "nan" strings
+    auto quoted = false;
+    if constexpr (std::is_floating_point_v<T>)
+    {
+        quoted = !std::isfinite(value);
+    }
+
+    const auto format = [&](char * out)
+    {
+        auto * p = out;
+        if (quoted) *p++ = '"';
+        p = num::format(p, value);
+        if (quoted) *p++ = '"';
+        return static_cast<size_t>(p - out);
+    };
+
+    if (m_fixed)
+    {
+        // a span may have room for the number but not for the longest one
+        char text[num::max_chars + 2];
+        append(text, format(text));
+    }
+    else if (auto * out = reserve(num::max_chars + 2))
+    {
+        m_size += format(out);
+    }
+}
+
+template <typename T>
+void JsonWriter::writeItems(const std::vector<T> & items)
+{
+    // the items share one type, so the loop formats numbers with no per-item dispatch
+    append("[ ");
+    for (size_t i = 0; i < items.size(); ++i)
+    {
+        if (i != 0)
+        {
+            append(", ");
+        }
+        writeNumber(items[i]);
+    }
+    append(" ]");
+}
+
+void JsonWriter::write(const Value & value)
+{
+    writeCompact(value);
+}
+
+void JsonWriter::writePretty(const Value & value, std::string_view indent)
+{
+    writePrettyImpl(value, indent, 0);
+}
+
+void JsonWriter::writeCompact(const Value & value)
+{
+    const auto index = value.data().index();
+
+    std::visit([this, index](auto && arg)
+    {
+        using T = std::decay_t<decltype(arg)>;
+
+        if constexpr (std::is_same_v<T, std::monostate>)
+        {
+            append("null");
+        }
+        else if constexpr (std::is_arithmetic_v<T>)
+        {
+            append(R"({ "type": ")");
+            append(value_type_names[index]);
+            append(R"(", "value": )");
+            writeNumber(arg);
+            append(" }");
+        }
+        else if constexpr (is_typed_array_v<T>)
+        {
+            append(R"({ "type": ")");
+            append(value_type_names[index]);
+            append(R"(", "value": )");
+            writeItems(arg);
+            append(" }");
+        }
+        else if constexpr (std::is_same_v<T, std::string>)
+        {
+            writeString(arg);
+        }
+        else if constexpr (std::is_same_v<T, Value::array_t>)
+        {
+            append("[ ");
+            for (auto it = arg.begin(); it != arg.end(); ++it)
+            {
+                if (it != arg.begin())
+                {
+                    append(", ");
+                }
+                writeCompact(*it);
+            }
+            append(" ]");
+        }
+        else if constexpr (std::is_same_v<T, Value::object_t>)
+        {
+            append("{ ");
+            for (auto it = arg.begin(); it != arg.end(); ++it)
+            {
+                if (it != arg.begin())
+                {
+                    append(", ");
+                }
+                writeString(it->first);
+                append(": ");
+                writeCompact(it->second);
+            }
+            append(" }");
+        }
+    }, value.data());
+}
+
+void JsonWriter::writeIndent(std::string_view indent, size_t level)
+{
+    for (size_t i = 0; i < level; ++i)
+    {
+        append(indent);
+    }
+}
+
+void JsonWriter::writePrettyImpl(const Value & value, std::string_view indent, size_t level)
+{
+    const auto index = value.data().index();
+
+    std::visit([this, index, indent, level](auto && arg)
+    {
+        using T = std::decay_t<decltype(arg)>;
+
+        if constexpr (std::is_same_v<T, std::monostate>)
+        {
+            append("null");
+        }
+        else if constexpr (std::is_arithmetic_v<T>)
+        {
+            append("{\n");
+            writeIndent(indent, level + 1);
+            append("\"type\": \"");
+            append(value_type_names[index]);
+            append("\",\n");
+            writeIndent(indent, level + 1);
+            append("\"value\": ");
+            writeNumber(arg);
+            append("\n }");
+        }
+        else if constexpr (is_typed_array_v<T>)
+        {
+            append("{\n");
+            writeIndent(indent, level + 1);
+            append("\"type\": \"");
+            append(value_type_names[index]);
+            append("\",\n");
+            writeIndent(indent, level + 1);
+            append("\"value\": ");
+            writeItems(arg);
+            append("\n }");
+        }
+        else if constexpr (std::is_same_v<T, std::string>)
+        {
+            writeString(arg);
+        }
+        else if constexpr (std::is_same_v<T, Value::array_t>)
+        {
+            append("[ ");
+            for (auto it = arg.begin(); it != arg.end(); ++it)
+            {
+                if (it != arg.begin())
+                {
+                    append(", ");
+                }
+                writePrettyImpl(*it, indent, level + 1);
+            }
+            append(" ]");
+        }
+        else if constexpr (std::is_same_v<T, Value::object_t>)
+        {
+            append("{ ");
+            for (auto it = arg.begin(); it != arg.end(); ++it)
+            {
+                if (it != arg.begin())
+                {
+                    append(",\n");
+                }
+                writeIndent(indent, level + 1);
+                writeString(it->first);
+                append(": ");
+                writePrettyImpl(it->second, indent, level + 1);
+            }
+            append(" }");
+        }
+    }, value.data());
+}
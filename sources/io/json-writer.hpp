@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include "core/value.hpp"
+
+// Serializes Values straight into one contiguous buffer: no stream sentries or locale lookups per
+// token, strings are copied in runs between the characters that need escaping, and the result is
+// handed to a stream or file descriptor with a single write.
+//
+// A default-constructed writer grows its own buffer and keeps the capacity across clear() and
+// flush(), so a writer reused for every snapshot stops allocating once it has seen the largest
+// one. A writer over a caller's span never allocates; output that does not fit is dropped and
+// overflowed() reports it.
+class JsonWriter
+{
+public:
+    JsonWriter() = default;
+    explicit JsonWriter(std::span<char> buffer) noexcept;
+
+    JsonWriter(const JsonWriter &) = delete;
+    JsonWriter & operator=(const JsonWriter &) = delete;
+
+    // appends the same text as Value::write_json / write_pretty_json
+    void write(const Value & value);
+    void writePretty(const Value & value, std::string_view indent = "  ");
+
+    // appends `sv` as a quoted, escaped JSON string
+    void writeString(std::string_view sv);
+
+    [[nodiscard]] std::string_view view() const noexcept { return { m_data, m_size }; }
+    [[nodiscard]] size_t size() const noexcept { return m_size; }
+    [[nodiscard]] bool overflowed() const noexcept { return m_overflowed; }
+
+    // forgets the contents, keeping the buffer
+    void clear() noexcept;
+
+    // write the contents in one call, then clear(); false if the output failed or
+    // the contents were truncated
+    bool flush(std::ostream & os);
+    bool flush(int fd);
+
+private:
+    std::string m_storage; // backs m_data unless writing into a caller's span
+    char * m_data{ nullptr };
+    size_t m_size{ 0 };
+    size_t m_capacity{ 0 };
+    size_t m_spanSize{ 0 };
+    bool m_fixed{ false }; // writing into a caller's span
+    bool m_overflowed{ false };
+
+    // room for `count` more bytes at the end, nullptr once a fixed buffer has run out
+    char * reserve(size_t count);
+    char * grow(size_t count);
+
+    void append(const char * data, size_t count);
+    void append(std::string_view sv) { append(sv.data(), sv.size()); }
+    void put(char c);
+
+    template <typename T>
+    void writeNumber(T value);
+    template <typename T>
+    void writeItems(const std::vector<T> & items);
+
+    void writeCompact(const Value & value);
+    void writePrettyImpl(const Value & value, std::string_view indent, size_t level);
+    void writeIndent(std::string_view indent, size_t level);
+};
+
+inline char * JsonWriter::reserve(size_t count)
+{
+    if (m_capacity - m_size >= count)
+    {
+        return m_data + m_size;
+    }
+    return grow(count);
+}
+
+inline void JsonWriter::append(const char * data, size_t count)
+{
+    if (auto * out = reserve(count))
+    {
+        std::char_traits<char>::copy(out, data, count);
+        m_size += count;
+    }
+}
+
+inline void JsonWriter::put(char c)
+{
+    if (auto * out = reserve(1))
+    {
+        *out = c;
+        ++m_size;
+    }
+}
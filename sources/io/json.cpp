@@ -1,121 +1,32 @@
 #include "json.hpp"
 
-#include <charconv>
-
+#include "helpers/numbers.hpp"
 #include "helpers/strings.hpp"
 
-constexpr std::string_view LEXER_UNEXPECTED_CHAR = "unexpected character";
-constexpr std::string_view LEXER_UNEXPECTED_EOF  = "unexpected EOF";
+namespace
+{
+    // int32 through double, the alternatives after null in Value::data_t
+    constexpr size_t arithmetic_types = 8;
+}
 
 JsonLexer::JsonLexer(std::string_view source)
     : m_ptr(source.data())
     , m_start(source.data())
     , m_end(source.data() + source.size())
-{ }
-
-Token JsonLexer::next() noexcept
+    , m_block(source.data())
 {
-    skipWhitespace();
-    if (m_ptr == m_end)
+    if (m_ptr != m_end)
     {
-        return { TokenType::Eof, {}, position() };
-    }
-
-    switch (const char c = *m_ptr)
-    {
-        case '{': ++m_ptr; return { TokenType::LBrace,   "{", position() - 1 };
-        case '}': ++m_ptr; return { TokenType::RBrace,   "}", position() - 1 };
-        case '[': ++m_ptr; return { TokenType::LBracket, "[", position() - 1 };
-        case ']': ++m_ptr; return { TokenType::RBracket, "]", position() - 1 };
-        case ':': ++m_ptr; return { TokenType::Colon,    ":", position() - 1 };
-        case ',': ++m_ptr; return { TokenType::Comma,    ",", position() - 1 };
-        case '"': return scanString();
-        case 'n':
-            {
-                if (remaining() >= 4 && std::string_view(m_ptr, 4) == "null")
-                {
-                    m_ptr += 4;
-                    return { TokenType::Null, "null", position() };
-                }
-                return { TokenType::Error, LEXER_UNEXPECTED_CHAR, position() };
-            }
-        default:
-            {
-                if (c == '-' || c == '.' || std::isdigit(c))
-                {
-                    return scanNumber();
-                }
-                return { TokenType::Error, LEXER_UNEXPECTED_CHAR, position() };
-            }
+        indexBlock(m_block);
     }
 }
 
-char JsonLexer::peek() noexcept
+void JsonLexer::indexBlock(const char * block) noexcept
 {
-    skipWhitespace();
-    return (m_ptr == m_end) ? '\0' : *m_ptr;
-}
-
-void JsonLexer::skipWhitespace() noexcept
-{
-    while (m_ptr < m_end && std::isspace(*m_ptr))
-    {
-        ++m_ptr;
-    }
-}
-
-Token JsonLexer::scanString() noexcept
-{
-    const auto start = ++m_ptr; // skip opening quote
-    while (m_ptr < m_end)
-    {
-        const char c = *m_ptr;
-        if (c == '"')
-        {
-            ++m_ptr; // consume closing quote
-            const auto length = m_ptr - start - 1;
-            return { TokenType::String, std::string_view(start, length), position() - length };
-        }
-        if (c == '\\')
-        {
-            ++m_ptr; // consume the escape mark
-            if (m_ptr < m_end)
-            {
-                ++m_ptr; // consume the escaped char
-            }
-        }
-        else
-        {
-            ++m_ptr; // consume char
-        }
-    }
-    return { TokenType::Error, LEXER_UNEXPECTED_EOF, position() }; // EOF reached before closing quote
-}
-
-Token JsonLexer::scanNumber() noexcept
-{
-    const auto start = m_ptr;
-    if (*m_ptr == '-')
-    {
-        ++m_ptr; // consume negative mark
-    }
-
-    while (m_ptr < m_end && std::isdigit(*m_ptr))
-    {
-        ++m_ptr; // consume digits
-    }
-
-    if (m_ptr < m_end && *m_ptr == '.')
-    {
-        ++m_ptr; // consume float mark
-        while (m_ptr < m_end && std::isdigit(*m_ptr))
-        {
-            ++m_ptr; // consume digits
-        }
-    }
-
-    const auto length = m_ptr - start;
-    return { TokenType::Number, std::string_view(start, length), position() - length };
+    const auto index = m_indexer.next(block, m_end);
+    m_block = block;
+    m_tokens = index.tokens;
+    m_quotes = index.quotes;
 }
 
 Value JsonParser::parse(std::string_view sv)
@@ -131,8 +42,11 @@ Value JsonParser::parse(std::string_view sv)
 
 Value JsonParser::parseRecursive(JsonLexer& lexer)
 {
-    const auto token = lexer.next();
+    return parseValue(lexer, lexer.next());
+}
 
+Value JsonParser::parseValue(JsonLexer& lexer, const Token& token)
+{
     switch (token.type)
     {
         case TokenType::Null:     return {};
@@ -142,13 +56,7 @@ Value JsonParser::parseRecursive(JsonLexer& lexer)
         case TokenType::Number:
         {
             auto value = 0.0;
-            const auto [_, error] = std::from_chars(
-                token.text.data(),
-                token.text.data() + token.text.size(),
-                value
-            );
-
-            if (error != std::errc())
+            if (!num::parse(token.text, value))
             {
                 return {}; // ERROR
             }
@@ -190,122 +98,153 @@ Value JsonParser::parseArray(JsonLexer& lexer)
 
 Value JsonParser::parseObject(JsonLexer& lexer)
 {
-    // if (lexer.peek() == '}') // quick escape
-    // {
-    //     lexer.next(); // consume closing brace
-    //     return Value::object();
-    // }
-    //
-    // auto obj = Value::object_t{ };
-    // while (true)
-    // {
-    //     Token keyToken = lexer.next();
-    //     if (keyToken.type != TokenType::String) return {}; // Expected string key
-    //
-    //     if (lexer.next().type != TokenType::Colon) return {};
-    //
-    //     // Optimization: Check for Arithmetic Wrapper Signature
-    //     // This is "efficient and maintainable" because it isolates the complex logic
-    //     // into a specific check rather than complicating the generic loop.
-    //     if (first && keyToken.payload == "type")
-    //     {
-    //         // Peek next token (the value of "type")
-    //         // We have to consume it to check it, but that's fine as we are committing to a path
-    //         Token typeValToken = lexer.next();
-    //
-    //         if (typeValToken.type == TokenType::String)
-    //         {
-    //             // Check if the type name is one of our known arithmetic types
-    //             int typeIdx = -1;
-    //             for (size_t i = 1; i < value_type_names.size(); ++i)
-    //             {
-    //                 if (value_type_names[i] == typeValToken.payload)
-    //                 {
-    //                     typeIdx = static_cast<int>(i);
-    //                     break;
-    //                 }
-    //             }
-    //
-    //             if (typeIdx != -1)
-    //             {
-    //                 // It IS an arithmetic wrapper
-    //                 return parse_arithmetic_wrapper(lexer, typeIdx);
-    //             }
-    //
-    //             // Not a wrapper, just a key named "type". Add to object.
-    //             obj.emplace("type", unescapeString(typeValToken.payload));
-    //         }
-    //         else
-    //         {
-    //             // Value of "type" wasn't a string, so definitely not our wrapper
-    //             // We need to parse whatever that value is recursively
-    //             // But we already consumed the token. We need to handle this edge case.
-    //             // Ideally we would 'putback' or recursively parse from token.
-    //             // For simplicity in this specific "type" string check,
-    //             // we can't easily recurse if we already consumed the token.
-    //             // However, in valid JSON "type" value usually is a string.
-    //             // If it's not, we just treat it as object.
-    //             // (Implementation simplified: assuming "type" value is string for now,
-    //             //  or you can refactor to peek token type before consuming)
-    //              return {}; // Error for this specific restricted implementation
-    //         }
-    //     }
-    //     else
-    //     {
-    //         obj.emplace(unescapeString(keyToken.payload), parse_recursive(lexer));
-    //     }
-    //
-    //     Token next = lexer.next();
-    //     if (next.type == TokenType::RBrace) break;
-    //     if (next.type != TokenType::Comma) return {};
-    // }
-    // return obj;
+    if (lexer.peek() == '}') // quick escape
+    {
+        lexer.next(); // consume closing brace
+        return Value::object();
+    }
+
+    auto obj = Value::object_t{ };
+    size_t wrapped = 0; // type index named by a leading "type" member, 0 if none
+    while (true)
+    {
+        const auto key = lexer.next();
+        if (key.type != TokenType::String || lexer.next().type != TokenType::Colon)
+        {
+            return {}; // ERROR
+        }
+
+        auto name = str::unescape(key.text);
+        const auto token = lexer.next();
+
+        Value value;
+        if (obj.empty() && token.type == TokenType::String && name == "type")
+        {
+            // arithmetic values are written as { "type": "<name>", "value": <number> }, typed
+            // arrays as { "type": "<name>[]", "value": [ <numbers> ] }
+            for (size_t i = 1; i <= arithmetic_types && wrapped == 0; ++i)
+            {
+                if (value_type_names[i] == token.text)
+                {
+                    wrapped = i;
+                }
+                else if (value_type_names[i + typed_array_offset] == token.text)
+                {
+                    wrapped = i + typed_array_offset;
+                }
+            }
+            value = Value{ str::unescape(token.text) };
+        }
+        else if (wrapped > typed_array_offset && obj.size() == 1 && name == "value" && token.type == TokenType::LBracket)
+        {
+            // the brackets are already open, so there is nothing to fall back to
+            value = parseTypedArray(lexer, wrapped);
+            if (value.empty())
+            {
+                return {}; // ERROR
+            }
+            if (lexer.peek() == '}')
+            {
+                lexer.next(); // consume closing brace
+                return value;
+            }
+        }
+        else if (wrapped != 0 && wrapped <= arithmetic_types && obj.size() == 1 && name == "value")
+        {
+            value = parseArithmeticWrapper(token, wrapped);
+            if (!value.empty() && lexer.peek() == '}')
+            {
+                lexer.next(); // consume closing brace
+                return value;
+            }
+            // the value doesn't fit the announced type or more members follow, so this is an
+            // ordinary object and its value an ordinary member
+            value = parseValue(lexer, token);
+        }
+        else
+        {
+            value = parseValue(lexer, token);
+        }
+
+        obj.insert_or_assign(std::move(name), std::move(value));
+
+        const auto next = lexer.next();
+        switch (next.type)
+        {
+            case TokenType::Comma: /* continue reading */ break;
+            case TokenType::RBrace: return Value{ std::move(obj) };
+            default: return {}; // ERROR
+        }
+    }
+}
+
+Value JsonParser::parseArithmeticWrapper(const Token& token, size_t typeIndex)
+{
+    // non-finite floats are written as strings, everything else as a plain number
+    if (token.type != TokenType::Number && token.type != TokenType::String)
+    {
+        return {};
+    }
 
-    return {};
+    const auto decode = [&token]<typename T>(T value) -> Value
+    {
+        return num::parse(token.text, value) ? Value{ value } : Value{ };
+    };
+
+    switch (typeIndex)
+    {
+        case 1: return decode(int32_t{ });
+        case 2: return decode(uint32_t{ });
+        case 3: return decode(int64_t{ });
+        case 4: return decode(uint64_t{ });
+        case 5: return decode(char{ });
+        case 6: return decode(static_cast<unsigned char>(0));
+        case 7: return decode(0.0f);
+        case 8: return decode(0.0);
+        default: return {};
+    }
 }
 
-Value JsonParser::parseArithmeticWrapper(JsonLexer& lexer)
+Value JsonParser::parseTypedArray(JsonLexer& lexer, size_t typeIndex)
 {
-    // // We already consumed { "type": "int32"
-    // // Expect: , "value": <number> }
-    //
-    // if (lexer.next().type != TokenType::Comma) return {};
-    //
-    // Token key = lexer.next();
-    // if (key.type != TokenType::String || key.payload != "value") return {};
-    //
-    // if (lexer.next().type != TokenType::Colon) return {};
-    //
-    // Token valToken = lexer.next();
-    // if (valToken.type != TokenType::Number) return {};
-    //
-    // Value result;
-    // const auto* start = valToken.payload.data();
-    // const auto* end = start + valToken.payload.size();
-    //
-    // // High-performance conversion using std::from_chars
-    // switch (type_index)
-    // {
-    // case 1: { int32_t v; std::from_chars(start, end, v); result = v; break; }
-    // case 2: { uint32_t v; std::from_chars(start, end, v); result = v; break; }
-    // case 3: { int64_t v; std::from_chars(start, end, v); result = v; break; }
-    // case 4: { uint64_t v; std::from_chars(start, end, v); result = v; break; }
-    // case 5: { int16_t v; std::from_chars(start, end, v); result = static_cast<char>(v); break; }
-    // case 6: { uint16_t v; std::from_chars(start, end, v); result = static_cast<unsigned char>(v); break; }
-    // case 7: {
-    //         char* e;
-    //         result = std::strtof(start, &e); // from_chars for float is C++17/20 partial support
-    //         break;
-    // }
-    // case 8: {
-    //         char* e;
-    //         result = std::strtod(start, &e);
-    //         break;
-    // }
-    // }
-    //
-    // if (lexer.next().type != TokenType::RBrace) return {};
-    // return result;
+    // straight into the packed vector, without a Value per item
+    const auto decode = [&lexer]<typename T>(std::vector<T> items) -> Value
+    {
+        if (lexer.peek() == ']') // quick escape
+        {
+            lexer.next(); // consume closing bracket
+            return Value{ std::move(items) };
+        }
+
+        while (true)
+        {
+            const auto token = lexer.next();
+            T item{ };
+            if ((token.type != TokenType::Number && token.type != TokenType::String) || !num::parse(token.text, item))
+            {
+                return {}; // ERROR
+            }
+            items.push_back(item);
 
-    return {};
+            switch (lexer.next().type)
+            {
+                case TokenType::Comma: /* continue reading */ break;
+                case TokenType::RBracket: return Value{ std::move(items) };
+                default: return {}; // ERROR
+            }
+        }
+    };
+
+    switch (typeIndex - typed_array_offset)
+    {
+        case 1: return decode(std::vector<int32_t>{ });
+        case 2: return decode(std::vector<uint32_t>{ });
+        case 3: return decode(std::vector<int64_t>{ });
+        case 4: return decode(std::vector<uint64_t>{ });
+        case 5: return decode(std::vector<char>{ });
+        case 6: return decode(std::vector<unsigned char>{ });
+        case 7: return decode(std::vector<float>{ });
+        case 8: return decode(std::vector<double>{ });
+        default: return {};
+    }
 }
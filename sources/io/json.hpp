@@ -1,9 +1,14 @@
 #pragma once
 
+#include <bit>
 #include <cstdint>
 #include <string_view>
 
 #include "core/value.hpp"
+#include "json-scan.hpp"
+
+inline constexpr std::string_view LEXER_UNEXPECTED_CHAR = "unexpected character";
+inline constexpr std::string_view LEXER_UNEXPECTED_EOF  = "unexpected EOF";
 
 enum class TokenType : uint8_t
 {
@@ -14,10 +19,12 @@ enum class TokenType : uint8_t
 struct Token
 {
     TokenType type;
-    std::string_view text;
-    size_t position;
+    std::string_view text; // points into the source, quotes excluded for strings
+    size_t position;       // offset of the token's first byte
 };
 
+// Zero-copy tokenizer. The source is indexed one 64-byte block at a time as tokens are requested
+// (see json-scan.hpp), so whitespace and string bodies are skipped with vector compares.
 class JsonLexer
 {
 private:
@@ -25,6 +32,12 @@ private:
     const char * const m_start;
     const char * const m_end;
 
+    // structural index of the block at m_block; bits below m_ptr are stale
+    const char * m_block;
+    uint64_t m_tokens{ 0 };
+    uint64_t m_quotes{ 0 };
+    json_detail::BlockIndexer m_indexer;
+
 public:
     explicit JsonLexer(std::string_view source);
 
@@ -35,12 +48,151 @@ private:
     size_t remaining() const { return static_cast<size_t>(m_end - m_ptr); }
     size_t position() const { return static_cast<size_t>(m_ptr - m_start); }
 
+    void indexBlock(const char * block) noexcept;
     void skipWhitespace() noexcept;
 
     Token scanString() noexcept;
     Token scanNumber() noexcept;
 };
 
+// the token loop is inline so that parsers in other translation units can fold it into theirs
+inline Token JsonLexer::next() noexcept
+{
+    skipWhitespace();
+    if (m_ptr == m_end)
+    {
+        return { TokenType::Eof, {}, position() };
+    }
+
+    switch (const char c = *m_ptr)
+    {
+        case '{': ++m_ptr; return { TokenType::LBrace,   "{", position() - 1 };
+        case '}': ++m_ptr; return { TokenType::RBrace,   "}", position() - 1 };
+        case '[': ++m_ptr; return { TokenType::LBracket, "[", position() - 1 };
+        case ']': ++m_ptr; return { TokenType::RBracket, "]", position() - 1 };
+        case ':': ++m_ptr; return { TokenType::Colon,    ":", position() - 1 };
+        case ',': ++m_ptr; return { TokenType::Comma,    ",", position() - 1 };
+        case '"': return scanString();
+        case 'n':
+            {
+                if (remaining() >= 4 && std::string_view(m_ptr, 4) == "null")
+                {
+                    m_ptr += 4;
+                    return { TokenType::Null, "null", position() - 4 };
+                }
+                return { TokenType::Error, LEXER_UNEXPECTED_CHAR, position() };
+            }
+        default:
+            {
+                if (c == '-' || c == '.' || json_detail::is(c, json_detail::DIGIT))
+                {
+                    return scanNumber();
+                }
+                return { TokenType::Error, LEXER_UNEXPECTED_CHAR, position() };
+            }
+    }
+}
+
+inline char JsonLexer::peek() noexcept
+{
+    skipWhitespace();
+    return (m_ptr == m_end) ? '\0' : *m_ptr;
+}
+
+inline void JsonLexer::skipWhitespace() noexcept
+{
+    // whatever follows a scalar that stopped early is not whitespace and must surface as an error,
+    // since the index only marks where scalar runs start
+    if (m_ptr == m_end || !json_detail::is(*m_ptr, json_detail::WHITESPACE))
+    {
+        return;
+    }
+
+    while (true)
+    {
+        m_tokens = json_detail::bits_from(m_ptr, m_block, m_tokens);
+        if (m_tokens != 0)
+        {
+            m_ptr = m_block + std::countr_zero(m_tokens);
+            return;
+        }
+
+        const auto next = m_block + json_detail::block_size;
+        if (next >= m_end)
+        {
+            m_ptr = m_end;
+            return;
+        }
+        indexBlock(next);
+    }
+}
+
+inline Token JsonLexer::scanString() noexcept
+{
+    const auto open = m_ptr;
+    while (true)
+    {
+        // the closing quote is the next unescaped quote, possibly some blocks ahead
+        const auto quotes = json_detail::bits_from(open + 1, m_block, m_quotes);
+        if (quotes != 0)
+        {
+            const auto close = m_block + std::countr_zero(quotes);
+            m_ptr = close + 1;
+            return {
+                TokenType::String,
+                std::string_view(open + 1, static_cast<size_t>(close - open - 1)),
+                static_cast<size_t>(open - m_start)
+            };
+        }
+
+        const auto next = m_block + json_detail::block_size;
+        if (next >= m_end)
+        {
+            m_ptr = m_end;
+            // EOF reached before closing quote; reported where the string opens
+            return { TokenType::Error, LEXER_UNEXPECTED_EOF, static_cast<size_t>(open - m_start) };
+        }
+        indexBlock(next);
+    }
+}
+
+inline Token JsonLexer::scanNumber() noexcept
+{
+    const auto start = m_ptr;
+    if (*m_ptr == '-')
+    {
+        ++m_ptr; // consume negative mark
+    }
+
+    const auto digits = [this] {
+        while (m_ptr < m_end && json_detail::is(*m_ptr, json_detail::DIGIT))
+        {
+            ++m_ptr; // consume digits
+        }
+    };
+
+    digits();
+
+    if (m_ptr < m_end && *m_ptr == '.')
+    {
+        ++m_ptr; // consume float mark
+        digits();
+    }
+
+    if (m_ptr < m_end && (*m_ptr == 'e' || *m_ptr == 'E'))
+    {
+        ++m_ptr; // consume exponent mark
+        if (m_ptr < m_end && (*m_ptr == '+' || *m_ptr == '-'))
+        {
+            ++m_ptr; // consume exponent sign
+        }
+        digits();
+    }
+
+    const auto length = static_cast<size_t>(m_ptr - start);
+    return { TokenType::Number, std::string_view(start, length), position() - length };
+}
+
 class JsonParser
 {
 public:
@@ -48,7 +200,15 @@ public:
 
 private:
     Value parseRecursive(JsonLexer & lexer);
+    Value parseValue(JsonLexer & lexer, const Token & token);
     Value parseArray(JsonLexer & lexer);
     Value parseObject(JsonLexer & lexer);
-    Value parseArithmeticWrapper(JsonLexer & lexer);
+
+    // decodes the "value" of a { "type": ..., "value": ... } wrapper into the alternative at
+    // typeIndex in Value::data_t; null if it does not fit that type
+    static Value parseArithmeticWrapper(const Token & token, size_t typeIndex);
+
+    // the items of a typed array wrapper, after its opening bracket; null if any item does not
+    // fit the item type
+    Value parseTypedArray(JsonLexer & lexer, size_t typeIndex);
 };
@@ -0,0 +1,109 @@
+#include "mapped-file.hpp"
+
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+constexpr std::string_view MAP_OPEN_FAILED = "cannot open file";
+constexpr std::string_view MAP_STAT_FAILED = "cannot stat file";
+constexpr std::string_view MAP_MMAP_FAILED = "cannot map file";
+
+namespace
+{
+    // hints only: a kernel that ignores or rejects them maps the file just the same
+    void advise(void * data, size_t size, MappedFile::Access access) noexcept
+    {
+        switch (access)
+        {
+            case MappedFile::Access::sequential: ::madvise(data, size, MADV_SEQUENTIAL); break;
+            case MappedFile::Access::random: ::madvise(data, size, MADV_RANDOM); break;
+            case MappedFile::Access::normal: break;
+        }
+#ifdef MADV_HUGEPAGE
+        if (size >= (size_t{ 2 } << 20))
+        {
+            ::madvise(data, size, MADV_HUGEPAGE);
+        }
+#endif
+    }
+}
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+MappedFile::MappedFile(MappedFile && other) noexcept
+    : m_data(std::exchange(other.m_data, nullptr))
+    , m_size(std::exchange(other.m_size, 0))
+    , m_open(std::exchange(other.m_open, false))
+    , m_error(other.m_error)
+{ }
+
+MappedFile & MappedFile::operator=(MappedFile && other) noexcept
+{
+    if (this != &other)
+    {
+        close();
+        m_data = std::exchange(other.m_data, nullptr);
+        m_size = std::exchange(other.m_size, 0);
+        m_open = std::exchange(other.m_open, false);
+        m_error = other.m_error;
+    }
+    return *this;
+}
+
+bool MappedFile::open(const std::string & path, Access access)
+{
+    close();
+    m_error = { };
+
+    const auto fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        m_error = MAP_OPEN_FAILED;
+        return false;
+    }
+
+    struct stat info{ };
+    if (::fstat(fd, &info) != 0)
+    {
+        ::close(fd);
+        m_error = MAP_STAT_FAILED;
+        return false;
+    }
+
+    // mmap rejects zero-length mappings, and an empty file needs none
+    if (info.st_size > 0)
+    {
+        auto * data = ::mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED)
+        {
+            ::close(fd);
+            m_error = MAP_MMAP_FAILED;
+            return false;
+        }
+        m_data = static_cast<const char *>(data);
+        m_size = static_cast<size_t>(info.st_size);
+        advise(data, m_size, access);
+    }
+
+    // the mapping keeps the file alive on its own
+    ::close(fd);
+    m_open = true;
+    return true;
+}
+
+void MappedFile::close() noexcept
+{
+    if (m_data != nullptr)
+    {
+        ::munmap(const_cast<char *>(m_data), m_size);
+    }
+    m_data = nullptr;
+    m_size = 0;
+    m_open = false;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+
+// Read-only memory mapping of a whole file. The bytes stay valid, at the same address, for as long
+// as the MappedFile (or whatever it was moved into) lives; pages are read in on first touch.
+class MappedFile
+{
+public:
+    // how the bytes will be read, passed on to the kernel's readahead; sequential suits parsers
+    // that make one pass from front to back, random suits lookups into a BinaryDocument
+    enum class Access : uint8_t { normal, sequential, random };
+
+    MappedFile() noexcept = default;
+    ~MappedFile();
+
+    MappedFile(MappedFile && other) noexcept;
+    MappedFile & operator=(MappedFile && other) noexcept;
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile & operator=(const MappedFile &) = delete;
+
+    // Replaces the current mapping; on failure returns false and leaves the file closed.
+    // Mappings of 2 MiB and more also ask for transparent huge pages, where the kernel and file
+    // system support them, to cut TLB misses when walking large files.
+    bool open(const std::string & path, Access access = Access::normal);
+    void close() noexcept;
+
+    [[nodiscard]] bool is_open() const noexcept { return m_open; }
+    [[nodiscard]] std::span<const char> bytes() const noexcept { return { m_data, m_size }; }
+    [[nodiscard]] std::string_view view() const noexcept { return { m_data, m_size }; }
+    [[nodiscard]] std::string_view error() const noexcept { return m_error; }
+
+private:
+    const char * m_data{ nullptr };
+    size_t m_size{ 0 };
+    bool m_open{ false }; // empty files are open without a mapping
+    std::string_view m_error;
+};
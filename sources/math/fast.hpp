@@ -0,0 +1,287 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <concepts>
+#include <span>
+#include <type_traits>
+
+#include "quaternion.hpp"
+#include "simd.hpp"
+#include "vectors-soa-ops.hpp"
+#include "vectors.hpp"
+
+// Opt-in approximations that trade a few ULPs for speed, for animation blending and other bulk
+// normalization; the exact versions stay the default everywhere else. Error bounds, checked by
+// tests/math/fast.cpp (angles are of the rotation between the result and math::slerp):
+//   rsqrt, normalized, normalize   relative error below 1e-6 for float, exact for double
+//   slerp                          within 1e-3 rad of math::slerp
+//   nlerp                          on the same arc as slerp, but up to 0.15 rad off it mid-blend
+// Unlike math::lerp / math::slerp, t is not clamped; use [0, 1].
+
+namespace math::fast
+{
+    // 1 / sqrt(x) for x > 0: the float hardware estimate plus one Newton-Raphson step (two on
+    // NEON, whose estimate is coarser); 1 / std::sqrt elsewhere
+    template <std::floating_point T>
+    [[nodiscard]] inline T rsqrt(T x) noexcept
+    {
+#if defined(MATH_SIMD_SSE2)
+        if constexpr (std::is_same_v<T, float>)
+        {
+            const auto y = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(x)));
+            return y * (1.5f - 0.5f * x * y * y);
+        }
+#elif defined(MATH_SIMD_NEON)
+        if constexpr (std::is_same_v<T, float>)
+        {
+            const auto v = vdup_n_f32(x);
+            auto y = vrsqrte_f32(v);
+            y = vmul_f32(y, vrsqrts_f32(vmul_f32(v, y), y));
+            y = vmul_f32(y, vrsqrts_f32(vmul_f32(v, y), y));
+            return vget_lane_f32(y, 0);
+        }
+#endif
+        return static_cast<T>(1) / std::sqrt(x);
+    }
+
+    // v / |v|, or zero when |v| is not above epsilon, as Vector::normalized
+    template <size_t N, std::floating_point T>
+    [[nodiscard]] inline Vector<N, T> normalized(const Vector<N, T> & v) noexcept
+    {
+        const auto sq = v.squared_length();
+        if (sq > epsilon_v<T> * epsilon_v<T>)
+        {
+            return v * rsqrt(sq);
+        }
+        return Vector<N, T>::zero;
+    }
+
+    // in place; vectors not longer than epsilon are left unchanged, as Vector::normalize
+    template <size_t N, std::floating_point T>
+    inline Vector<N, T> & normalize(Vector<N, T> & v) noexcept
+    {
+        const auto sq = v.squared_length();
+        if (sq > epsilon_v<T> * epsilon_v<T>)
+        {
+            v *= rsqrt(sq);
+        }
+        return v;
+    }
+
+    template <std::floating_point T>
+    [[nodiscard]] inline Quaternion<T> normalized(const Quaternion<T> & q) noexcept
+    {
+        return Quaternion<T>(normalized(q.vector()));
+    }
+
+    namespace detail
+    {
+        template <typename V, typename T>
+        inline V constant(T value) noexcept
+        {
+            if constexpr (std::is_floating_point_v<V>)
+            {
+                return static_cast<V>(value);
+            }
+            else
+            {
+                return V::broadcast(static_cast<typename V::value_type>(value));
+            }
+        }
+
+        // reshapes t so that nlerp with it follows slerp: a cubic in t, fitted over d = |a . b|
+        // (Kapoulkine, "Approximating slerp"). Works on scalars and simd batches alike.
+        template <typename V>
+        inline V slerp_t(V t, V d) noexcept
+        {
+            const auto a = constant<V>(1.0904) + d * (constant<V>(-3.2452) + d * (constant<V>(3.55645) - d * constant<V>(1.43519)));
+            const auto b = constant<V>(0.848013) + d * (constant<V>(-1.06021) + d * constant<V>(0.215638));
+            const auto centred = t - constant<V>(0.5);
+            const auto k = a * centred * centred + b;
+            return t + t * centred * (t - constant<V>(1)) * k;
+        }
+
+        // normalize(a * (1 - t) + sign(a . b) * b * t), returning the four blended components
+        template <bool Corrected, typename V>
+        inline std::array<V, 4> blend(const std::array<V, 4> & a, const std::array<V, 4> & b, V dot, V t) noexcept
+        {
+            const auto zero = constant<V>(0);
+            const auto one = constant<V>(1);
+
+            V negative, d;
+            if constexpr (std::is_floating_point_v<V>)
+            {
+                negative = dot < zero ? -one : one;
+            }
+            else
+            {
+                negative = select_gt(zero, dot, zero - one, one);
+            }
+            d = dot * negative;
+            if constexpr (Corrected)
+            {
+                t = slerp_t(t, d);
+            }
+
+            const auto ta = one - t;
+            const auto tb = t * negative;
+            std::array<V, 4> r;
+            for (size_t c = 0; c < 4; ++c)
+            {
+                r[c] = a[c] * ta + b[c] * tb;
+            }
+
+            // the blend of two unit quaternions on one hemisphere is at least 1/sqrt(2) long,
+            // but keep zero-filled SoA padding finite
+            const auto sq = r[0] * r[0] + r[1] * r[1] + r[2] * r[2] + r[3] * r[3];
+            V inv;
+            if constexpr (std::is_floating_point_v<V>)
+            {
+                inv = sq > zero ? rsqrt(sq) : zero;
+            }
+            else
+            {
+                inv = select_gt(sq, zero, rsqrt(sq), zero);
+            }
+            for (auto & component : r)
+            {
+                component = component * inv;
+            }
+            return r;
+        }
+
+        template <bool Corrected, std::floating_point T>
+        inline Quaternion<T> blend(const Quaternion<T> & a, const Quaternion<T> & b, T t) noexcept
+        {
+            const std::array<T, 4> qa{ a.x(), a.y(), a.z(), a.w() };
+            const std::array<T, 4> qb{ b.x(), b.y(), b.z(), b.w() };
+            const auto r = blend<Corrected>(qa, qb, a.vector().dot(b.vector()), t);
+            return Quaternion<T>(r[0], r[1], r[2], r[3]);
+        }
+    }
+
+    // normalized linear blend along the shorter arc, for unit a and b
+    template <std::floating_point T>
+    [[nodiscard]] inline Quaternion<T> nlerp(const Quaternion<T> & a, const Quaternion<T> & b, T t) noexcept
+    {
+        return detail::blend<false>(a, b, t);
+    }
+
+    // nlerp with t corrected towards constant angular speed; approximates math::slerp without
+    // acos / sin, for unit a and b
+    template <std::floating_point T>
+    [[nodiscard]] inline Quaternion<T> slerp(const Quaternion<T> & a, const Quaternion<T> & b, T t) noexcept
+    {
+        return detail::blend<true>(a, b, t);
+    }
+
+    // --- Batched over VectorSOA ---
+
+    // Same contract as math::soa: lanes (x, y, z, w) for quaternions, outputs sized by the caller
+    // and free to alias an input, whole padded lanes processed unless the output is larger than
+    // the input, whose elements past the input's size are then kept.
+
+    namespace detail
+    {
+        // t_at(std::type_identity<B>, i) gives the weights of the batch at i, for native and
+        // scalar batches alike
+        template <bool Corrected, typename T, typename Ao, typename Aa, typename Ab, typename TAt>
+        inline void blend_lanes(VectorSOA<4, T, Ao> & out, const VectorSOA<4, T, Aa> & a, const VectorSOA<4, T, Ab> & b,
+                                TAt && t_at, soa::store_mode mode) noexcept
+        {
+            assert(a.size() == b.size() && out.size() >= a.size());
+            const auto la = soa::detail::lanes(a, std::make_index_sequence<4>{});
+            const auto lb = soa::detail::lanes(b, std::make_index_sequence<4>{});
+            const auto lo = soa::detail::lanes(out, std::make_index_sequence<4>{});
+            soa::detail::with_store_mode(mode, [&]<bool Stream>(std::bool_constant<Stream>)
+            {
+                soa::detail::for_each_output_batch<T>(out.size(), a.size(), a.padded_size(), [&]<typename B>(std::type_identity<B>, std::size_t i)
+                {
+                    const std::array<B, 4> qa{
+                        B::load_aligned(la[0] + i), B::load_aligned(la[1] + i), B::load_aligned(la[2] + i), B::load_aligned(la[3] + i)
+                    };
+                    const std::array<B, 4> qb{
+                        B::load_aligned(lb[0] + i), B::load_aligned(lb[1] + i), B::load_aligned(lb[2] + i), B::load_aligned(lb[3] + i)
+                    };
+                    const auto dot = soa::detail::dot_at<B, 4, T>(la, lb, i);
+                    const auto r = blend<Corrected>(qa, qb, dot, t_at(std::type_identity<B>{ }, i));
+                    for (size_t c = 0; c < 4; ++c)
+                    {
+                        soa::detail::store_lane<Stream>(r[c], lo[c] + i);
+                    }
+                });
+            });
+        }
+    }
+
+    // out[i] = v[i] / |v[i]|; elements not longer than epsilon are copied unchanged, as soa::normalize
+    template <size_t N, typename T, typename Ao, typename Aa>
+        requires std::floating_point<T>
+    void normalize(VectorSOA<N, T, Ao> & out, const VectorSOA<N, T, Aa> & a) noexcept
+    {
+        assert(out.size() >= a.size());
+        const auto la = soa::detail::lanes(a, std::make_index_sequence<N>{});
+        const auto lo = soa::detail::lanes(out, std::make_index_sequence<N>{});
+        soa::detail::for_each_output_batch<T>(out.size(), a.size(), a.padded_size(), [&]<typename B>(std::type_identity<B>, std::size_t i)
+        {
+            const auto sq = soa::detail::dot_at<B, N, T>(la, la, i);
+            const auto eps = B::broadcast(epsilon_v<T> * epsilon_v<T>);
+            const auto inv = select_gt(sq, eps, rsqrt(sq), B::broadcast(static_cast<T>(1)));
+            for (size_t c = 0; c < N; ++c)
+            {
+                (B::load_aligned(la[c] + i) * inv).store_aligned(lo[c] + i);
+            }
+        });
+    }
+
+    template <size_t N, typename T, typename A>
+        requires std::floating_point<T>
+    void normalize(VectorSOA<N, T, A> & inout) noexcept
+    {
+        normalize(inout, inout);
+    }
+
+    // out[i] = nlerp(a[i], b[i], t)
+    template <typename T, typename Ao, typename Aa, typename Ab>
+        requires std::floating_point<T>
+    void nlerp(VectorSOA<4, T, Ao> & out, const VectorSOA<4, T, Aa> & a, const VectorSOA<4, T, Ab> & b, T t,
+               soa::store_mode mode = soa::store_mode::cached) noexcept
+    {
+        detail::blend_lanes<false>(out, a, b, [t]<typename B>(std::type_identity<B>, std::size_t) { return B::broadcast(t); }, mode);
+    }
+
+    // out[i] = slerp(a[i], b[i], t), one blend weight for every element
+    template <typename T, typename Ao, typename Aa, typename Ab>
+        requires std::floating_point<T>
+    void slerp(VectorSOA<4, T, Ao> & out, const VectorSOA<4, T, Aa> & a, const VectorSOA<4, T, Ab> & b, T t,
+               soa::store_mode mode = soa::store_mode::cached) noexcept
+    {
+        detail::blend_lanes<true>(out, a, b, [t]<typename B>(std::type_identity<B>, std::size_t) { return B::broadcast(t); }, mode);
+    }
+
+    // out[i] = slerp(a[i], b[i], t[i]), a blend weight per element; t.size() >= a.size()
+    template <typename T, typename Ao, typename Aa, typename Ab>
+        requires std::floating_point<T>
+    void slerp(VectorSOA<4, T, Ao> & out, const VectorSOA<4, T, Aa> & a, const VectorSOA<4, T, Ab> & b, std::span<const T> t,
+               soa::store_mode mode = soa::store_mode::cached) noexcept
+    {
+        assert(t.size() >= a.size());
+        const auto t_at = [t]<typename B>(std::type_identity<B>, std::size_t i)
+        {
+            if (i + B::width <= t.size())
+            {
+                return B::load(t.data() + i);
+            }
+
+            // the last batch runs into the padding, which t does not cover
+            alignas(64) std::array<T, B::width> tail{ };
+            for (size_t k = 0; i + k < t.size(); ++k)
+            {
+                tail[k] = t[i + k];
+            }
+            return B::load_aligned(tail.data());
+        };
+        detail::blend_lanes<true>(out, a, b, t_at, mode);
+    }
+}
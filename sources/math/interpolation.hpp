@@ -16,16 +16,16 @@ namespace math
     template <typename T>
     constexpr Quaternion<T> slerp(const Quaternion<T>& a, const Quaternion<T>& b, T t)
     {
-        T dot = a.v.dot(b.v);
+        T dot = a.vector().dot(b.vector());
 
-        Quaternion<T> target = b;
+        Vector4<T> target = b.vector();
         if (dot < static_cast<T>(0)) {
             dot = -dot;
-            target.v = -b.v;
+            target = -target;
         }
 
         if (dot > static_cast<T>(0.9995)) {
-            return Quaternion<T>(lerp(a.v, target.v, t)).normalized();
+            return Quaternion<T>(lerp(a.vector(), target, t)).normalized();
         }
 
         T theta_0 = std::acos(dot);
@@ -36,7 +36,7 @@ namespace math
         T s0 = std::cos(theta) - dot * sin_theta / sin_theta_0;
         T s1 = sin_theta / sin_theta_0;
 
-        return Quaternion<T>(a.v * s0 + target.v * s1).normalized();
+        return Quaternion<T>(a.vector() * s0 + target * s1).normalized();
     }
 
     template <typename T, size_t N>
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <concepts>
 #include <utility>
 #include <type_traits>
 
@@ -53,6 +54,16 @@ namespace math
 
         [[nodiscard]] constexpr Vector<Rows, T> operator*(const Vector<Cols, T>& vec) const noexcept
         {
+            if constexpr (is_simd4)
+            {
+                if (!std::is_constant_evaluated())
+                {
+                    Vector<Rows, T> result;
+                    simd4::kernels<T>::mat_vec(data(), vec.data(), result.data());
+                    return result;
+                }
+            }
+
             if constexpr (Cols <= K_UNROLL_THRESHOLD)
             {
                 return multiply_vec_impl(vec, std::make_index_sequence<Cols>{});
@@ -72,6 +83,15 @@ namespace math
         [[nodiscard]] constexpr Matrix<Rows, OtherCols, T> operator*(const Matrix<Cols, OtherCols, T> & other) const noexcept
         {
             Matrix<Rows, OtherCols, T> result;
+            if constexpr (is_simd4 && OtherCols == 4)
+            {
+                if (!std::is_constant_evaluated())
+                {
+                    simd4::kernels<T>::mat_mul(data(), other.data(), result.data());
+                    return result;
+                }
+            }
+
             for (std::size_t i = 0; i < OtherCols; ++i)
             {
                 result[i] = (*this) * other[i];
@@ -150,6 +170,15 @@ namespace math
         [[nodiscard]] constexpr Matrix<Cols, Rows, T> transposed() const noexcept
         {
             Matrix<Cols, Rows, T> out;
+            if constexpr (is_simd4)
+            {
+                if (!std::is_constant_evaluated())
+                {
+                    simd4::kernels<T>::transpose(data(), out.data());
+                    return out;
+                }
+            }
+
             for (std::size_t i = 0; i < Rows; ++i)
             {
                 for (std::size_t j = 0; j < Cols; ++j)
@@ -160,7 +189,110 @@ namespace math
             return out;
         }
 
+        [[nodiscard]] constexpr T determinant() const noexcept
+            requires (Rows == 4 && Cols == 4)
+        {
+            const auto s = sub_determinants(0, 1);
+            const auto c = sub_determinants(2, 3);
+            return s[0] * c[5] - s[1] * c[4] + s[2] * c[3] + s[3] * c[2] - s[4] * c[1] + s[5] * c[0];
+        }
+
+        // The zero matrix when the determinant is within epsilon of 0 relative to the size of the
+        // columns, which bounds it: a uniformly scaled matrix is invertible at any scale.
+        [[nodiscard]] constexpr Matrix<Rows, Cols, T> inverse() const noexcept
+            requires (Rows == 4 && Cols == 4 && std::floating_point<T>)
+        {
+            Matrix<Rows, Cols, T> out{};
+            const auto tolerance = epsilon_v<T> * column_scale();
+            if constexpr (is_simd4 && simd4::inverse_enabled_v<T>)
+            {
+                if (!std::is_constant_evaluated())
+                {
+                    simd4::kernels<T>::inverse(data(), out.data(), tolerance);
+                    return out;
+                }
+            }
+
+            // cofactors from the 2x2 sub-determinants of columns (0, 1) and (2, 3)
+            const auto & a = m_cols;
+            const auto s = sub_determinants(0, 1);
+            const auto c = sub_determinants(2, 3);
+            const auto det = s[0] * c[5] - s[1] * c[4] + s[2] * c[3] + s[3] * c[2] - s[4] * c[1] + s[5] * c[0];
+            if (!(det > tolerance || det < -tolerance))
+            {
+                return out;
+            }
+
+            const auto inv = static_cast<T>(1) / det;
+            out[0] = Vector<Rows, T>{
+                ( a[1][1] * c[5] - a[1][2] * c[4] + a[1][3] * c[3]) * inv,
+                (-a[0][1] * c[5] + a[0][2] * c[4] - a[0][3] * c[3]) * inv,
+                ( a[3][1] * s[5] - a[3][2] * s[4] + a[3][3] * s[3]) * inv,
+                (-a[2][1] * s[5] + a[2][2] * s[4] - a[2][3] * s[3]) * inv
+            };
+            out[1] = Vector<Rows, T>{
+                (-a[1][0] * c[5] + a[1][2] * c[2] - a[1][3] * c[1]) * inv,
+                ( a[0][0] * c[5] - a[0][2] * c[2] + a[0][3] * c[1]) * inv,
+                (-a[3][0] * s[5] + a[3][2] * s[2] - a[3][3] * s[1]) * inv,
+                ( a[2][0] * s[5] - a[2][2] * s[2] + a[2][3] * s[1]) * inv
+            };
+            out[2] = Vector<Rows, T>{
+                ( a[1][0] * c[4] - a[1][1] * c[2] + a[1][3] * c[0]) * inv,
+                (-a[0][0] * c[4] + a[0][1] * c[2] - a[0][3] * c[0]) * inv,
+                ( a[3][0] * s[4] - a[3][1] * s[2] + a[3][3] * s[0]) * inv,
+                (-a[2][0] * s[4] + a[2][1] * s[2] - a[2][3] * s[0]) * inv
+            };
+            out[3] = Vector<Rows, T>{
+                (-a[1][0] * c[3] + a[1][1] * c[1] - a[1][2] * c[0]) * inv,
+                ( a[0][0] * c[3] - a[0][1] * c[1] + a[0][2] * c[0]) * inv,
+                (-a[3][0] * s[3] + a[3][1] * s[1] - a[3][2] * s[0]) * inv,
+                ( a[2][0] * s[3] - a[2][1] * s[1] + a[2][2] * s[0]) * inv
+            };
+            return out;
+        }
+
+        // contiguous column-major elements
+        [[nodiscard]] constexpr const T* data() const noexcept { return m_cols[0].data(); }
+        [[nodiscard]] constexpr T* data() noexcept { return m_cols[0].data(); }
+
     private:
+        // 4x4 float / double, with a register kernel in simd4
+        static constexpr bool is_simd4 = Rows == 4 && Cols == 4 && simd4::enabled_v<4, T>;
+        static_assert(sizeof(std::array<Vector<Rows, T>, Cols>) == sizeof(T) * Rows * Cols, "columns must be contiguous");
+
+        // the product of each column's largest magnitude: within a factor 2^4 of the product of
+        // the column lengths, which bounds |det| (Hadamard), without square roots
+        constexpr T column_scale() const noexcept
+        {
+            T scale = static_cast<T>(1);
+            for (const auto & column : m_cols)
+            {
+                T largest = static_cast<T>(0);
+                for (std::size_t r = 0; r < Rows; ++r)
+                {
+                    const auto magnitude = column[r] < static_cast<T>(0) ? -column[r] : column[r];
+                    largest = magnitude > largest ? magnitude : largest;
+                }
+                scale *= largest;
+            }
+            return scale;
+        }
+
+        // the six 2x2 determinants of columns i and j, rows (01 02 03 12 13 23)
+        constexpr std::array<T, 6> sub_determinants(std::size_t i, std::size_t j) const noexcept
+        {
+            const auto & a = m_cols[i];
+            const auto & b = m_cols[j];
+            return {
+                a[0] * b[1] - b[0] * a[1],
+                a[0] * b[2] - b[0] * a[2],
+                a[0] * b[3] - b[0] * a[3],
+                a[1] * b[2] - b[1] * a[2],
+                a[1] * b[3] - b[1] * a[3],
+                a[2] * b[3] - b[2] * a[3]
+            };
+        }
+
         template <std::size_t... I>
         constexpr Vector<Rows, T> multiply_vec_impl(const Vector<Cols, T>& vec, std::index_sequence<I...>) const noexcept
         {
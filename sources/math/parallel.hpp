@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <numeric>
+#include <span>
+#include <type_traits>
+
+#include "core/thread-pool.hpp"
+#include "vectors.hpp"
+
+namespace math
+{
+    namespace detail
+    {
+        template <typename V>
+        struct is_vector : std::false_type {};
+
+        template <std::size_t N, typename T>
+        struct is_vector<Vector<N, T>> : std::true_type {};
+
+        // smallest element count spanning a whole number of cache lines
+        template <typename V>
+        inline constexpr std::size_t cache_line_elements_v = 64 / std::gcd(sizeof(V), std::size_t{ 64 });
+    }
+
+    // Runs fn(chunk) over contiguous sub-spans of at least `grain` vectors on `pool`. Chunk
+    // boundaries are a whole number of cache lines apart, so chunks of a cache-line aligned span
+    // never share a line.
+    template <typename V, std::size_t Extent, typename Fn>
+        requires (detail::is_vector<std::remove_const_t<V>>::value && std::invocable<const Fn&, std::span<V>>)
+    void for_each_chunk(std::span<V, Extent> values, Fn && fn, std::size_t grain = detail::cache_line_elements_v<V>,
+                        ThreadPool & pool = ThreadPool::global())
+    {
+        pool.parallel_for(values.size(), grain, detail::cache_line_elements_v<V>, [&](std::size_t begin, std::size_t end)
+        {
+            fn(std::span<V>(values.data() + begin, end - begin));
+        });
+    }
+}
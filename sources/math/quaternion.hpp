@@ -34,6 +34,12 @@ namespace math
             return data.w();
         }
 
+        // (x, y, z, w)
+        constexpr const Vector4<T>& vector() const
+        {
+            return data;
+        }
+
         // --- Shared Features ---
 
         constexpr T length() const
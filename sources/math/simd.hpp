@@ -0,0 +1,433 @@
+#pragma once
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+#if !defined(MATH_SIMD_DISABLE)
+    #if defined(__AVX__)
+        #include <immintrin.h>
+        #define MATH_SIMD_AVX 1
+    #endif
+    #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        #include <emmintrin.h>
+        #define MATH_SIMD_SSE2 1
+    #endif
+    #if defined(__ARM_NEON) || defined(__ARM_NEON__)
+        #include <arm_neon.h>
+        #define MATH_SIMD_NEON 1
+        #if defined(__aarch64__)
+            #define MATH_SIMD_NEON64 1
+        #endif
+    #endif
+#endif
+
+namespace math::simd
+{
+    // --- ABI tags ---
+
+    struct scalar_abi {};
+    struct sse_abi {};
+    struct avx_abi {};
+    struct neon_abi {};
+
+    template <typename T>
+    struct native_abi
+    {
+        using type = scalar_abi;
+    };
+
+#if defined(MATH_SIMD_AVX)
+    template <> struct native_abi<float>  { using type = avx_abi; };
+    template <> struct native_abi<double> { using type = avx_abi; };
+#elif defined(MATH_SIMD_SSE2)
+    template <> struct native_abi<float>  { using type = sse_abi; };
+    template <> struct native_abi<double> { using type = sse_abi; };
+#elif defined(MATH_SIMD_NEON)
+    template <> struct native_abi<float>  { using type = neon_abi; };
+    #if defined(MATH_SIMD_NEON64)
+    template <> struct native_abi<double> { using type = neon_abi; };
+    #endif
+#endif
+
+    template <typename T>
+    using native_abi_t = typename native_abi<T>::type;
+
+    // --- Batch ---
+
+    // A batch holds `width` lanes of T in one register. The primary template is the scalar
+    // fallback (width 1), used for tails and for types/targets without a vector unit.
+    // store_stream is an aligned store that bypasses the cache where the target has one (see
+    // stream_fence); elsewhere it is store_aligned. rsqrt is 1 / sqrt: exact for the scalar
+    // batch and double; for float vectors, the hardware estimate refined by Newton-Raphson to a
+    // relative error below 1e-6. Either way it is not finite for 0.
+    template <typename T, typename Abi = native_abi_t<T>>
+        requires std::is_arithmetic_v<T>
+    struct batch
+    {
+        using value_type = T;
+        using abi_type = scalar_abi;
+        static constexpr std::size_t width = 1;
+
+        T v;
+
+        static batch broadcast(T value) noexcept { return { value }; }
+        static batch load(const T * ptr) noexcept { return { *ptr }; }
+        static batch load_aligned(const T * ptr) noexcept { return { *ptr }; }
+
+        void store(T * ptr) const noexcept { *ptr = v; }
+        void store_aligned(T * ptr) const noexcept { *ptr = v; }
+        void store_stream(T * ptr) const noexcept { *ptr = v; }
+
+        friend batch operator+(batch a, batch b) noexcept { return { static_cast<T>(a.v + b.v) }; }
+        friend batch operator-(batch a, batch b) noexcept { return { static_cast<T>(a.v - b.v) }; }
+        friend batch operator*(batch a, batch b) noexcept { return { static_cast<T>(a.v * b.v) }; }
+        friend batch operator/(batch a, batch b) noexcept { return { static_cast<T>(a.v / b.v) }; }
+
+        // a * b + c
+        friend batch fma(batch a, batch b, batch c) noexcept { return { static_cast<T>(a.v * b.v + c.v) }; }
+        friend batch sqrt(batch a) noexcept { return { static_cast<T>(std::sqrt(a.v)) }; }
+        friend batch rsqrt(batch a) noexcept { return { static_cast<T>(1 / std::sqrt(a.v)) }; }
+
+        // per lane: x where a > b, y otherwise
+        friend batch select_gt(batch a, batch b, batch x, batch y) noexcept { return { a.v > b.v ? x.v : y.v }; }
+    };
+
+#if defined(MATH_SIMD_SSE2)
+    template <>
+    struct batch<float, sse_abi>
+    {
+        using value_type = float;
+        using abi_type = sse_abi;
+        static constexpr std::size_t width = 4;
+
+        __m128 v;
+
+        static batch broadcast(float value) noexcept { return { _mm_set1_ps(value) }; }
+        static batch load(const float * ptr) noexcept { return { _mm_loadu_ps(ptr) }; }
+        static batch load_aligned(const float * ptr) noexcept { return { _mm_load_ps(ptr) }; }
+
+        void store(float * ptr) const noexcept { _mm_storeu_ps(ptr, v); }
+        void store_aligned(float * ptr) const noexcept { _mm_store_ps(ptr, v); }
+        void store_stream(float * ptr) const noexcept { _mm_stream_ps(ptr, v); }
+
+        friend batch operator+(batch a, batch b) noexcept { return { _mm_add_ps(a.v, b.v) }; }
+        friend batch operator-(batch a, batch b) noexcept { return { _mm_sub_ps(a.v, b.v) }; }
+        friend batch operator*(batch a, batch b) noexcept { return { _mm_mul_ps(a.v, b.v) }; }
+        friend batch operator/(batch a, batch b) noexcept { return { _mm_div_ps(a.v, b.v) }; }
+
+        friend batch fma(batch a, batch b, batch c) noexcept
+        {
+    #if defined(__FMA__)
+            return { _mm_fmadd_ps(a.v, b.v, c.v) };
+    #else
+            return { _mm_add_ps(_mm_mul_ps(a.v, b.v), c.v) };
+    #endif
+        }
+
+        friend batch sqrt(batch a) noexcept { return { _mm_sqrt_ps(a.v) }; }
+
+        friend batch rsqrt(batch a) noexcept
+        {
+            // y * (1.5 - 0.5 * a * y * y) on the 12-bit estimate
+            const auto y = _mm_rsqrt_ps(a.v);
+            const auto half_ayy = _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.5f), a.v), _mm_mul_ps(y, y));
+            return { _mm_mul_ps(y, _mm_sub_ps(_mm_set1_ps(1.5f), half_ayy)) };
+        }
+
+        friend batch select_gt(batch a, batch b, batch x, batch y) noexcept
+        {
+            const auto mask = _mm_cmpgt_ps(a.v, b.v);
+            return { _mm_or_ps(_mm_and_ps(mask, x.v), _mm_andnot_ps(mask, y.v)) };
+        }
+    };
+
+    template <>
+    struct batch<double, sse_abi>
+    {
+        using value_type = double;
+        using abi_type = sse_abi;
+        static constexpr std::size_t width = 2;
+
+        __m128d v;
+
+        static batch broadcast(double value) noexcept { return { _mm_set1_pd(value) }; }
+        static batch load(const double * ptr) noexcept { return { _mm_loadu_pd(ptr) }; }
+        static batch load_aligned(const double * ptr) noexcept { return { _mm_load_pd(ptr) }; }
+
+        void store(double * ptr) const noexcept { _mm_storeu_pd(ptr, v); }
+        void store_aligned(double * ptr) const noexcept { _mm_store_pd(ptr, v); }
+        void store_stream(double * ptr) const noexcept { _mm_stream_pd(ptr, v); }
+
+        friend batch operator+(batch a, batch b) noexcept { return { _mm_add_pd(a.v, b.v) }; }
+        friend batch operator-(batch a, batch b) noexcept { return { _mm_sub_pd(a.v, b.v) }; }
+        friend batch operator*(batch a, batch b) noexcept { return { _mm_mul_pd(a.v, b.v) }; }
+        friend batch operator/(batch a, batch b) noexcept { return { _mm_div_pd(a.v, b.v) }; }
+
+        friend batch fma(batch a, batch b, batch c) noexcept
+        {
+    #if defined(__FMA__)
+            return { _mm_fmadd_pd(a.v, b.v, c.v) };
+    #else
+            return { _mm_add_pd(_mm_mul_pd(a.v, b.v), c.v) };
+    #endif
+        }
+
+        friend batch sqrt(batch a) noexcept { return { _mm_sqrt_pd(a.v) }; }
+        friend batch rsqrt(batch a) noexcept { return { _mm_div_pd(_mm_set1_pd(1.0), _mm_sqrt_pd(a.v)) }; }
+
+        friend batch select_gt(batch a, batch b, batch x, batch y) noexcept
+        {
+            const auto mask = _mm_cmpgt_pd(a.v, b.v);
+            return { _mm_or_pd(_mm_and_pd(mask, x.v), _mm_andnot_pd(mask, y.v)) };
+        }
+    };
+#endif
+
+#if defined(MATH_SIMD_AVX)
+    template <>
+    struct batch<float, avx_abi>
+    {
+        using value_type = float;
+        using abi_type = avx_abi;
+        static constexpr std::size_t width = 8;
+
+        __m256 v;
+
+        static batch broadcast(float value) noexcept { return { _mm256_set1_ps(value) }; }
+        static batch load(const float * ptr) noexcept { return { _mm256_loadu_ps(ptr) }; }
+        static batch load_aligned(const float * ptr) noexcept { return { _mm256_load_ps(ptr) }; }
+
+        void store(float * ptr) const noexcept { _mm256_storeu_ps(ptr, v); }
+        void store_aligned(float * ptr) const noexcept { _mm256_store_ps(ptr, v); }
+        void store_stream(float * ptr) const noexcept { _mm256_stream_ps(ptr, v); }
+
+        friend batch operator+(batch a, batch b) noexcept { return { _mm256_add_ps(a.v, b.v) }; }
+        friend batch operator-(batch a, batch b) noexcept { return { _mm256_sub_ps(a.v, b.v) }; }
+        friend batch operator*(batch a, batch b) noexcept { return { _mm256_mul_ps(a.v, b.v) }; }
+        friend batch operator/(batch a, batch b) noexcept { return { _mm256_div_ps(a.v, b.v) }; }
+
+        friend batch fma(batch a, batch b, batch c) noexcept
+        {
+    #if defined(__FMA__)
+            return { _mm256_fmadd_ps(a.v, b.v, c.v) };
+    #else
+            return { _mm256_add_ps(_mm256_mul_ps(a.v, b.v), c.v) };
+    #endif
+        }
+
+        friend batch sqrt(batch a) noexcept { return { _mm256_sqrt_ps(a.v) }; }
+
+        friend batch rsqrt(batch a) noexcept
+        {
+            const auto y = _mm256_rsqrt_ps(a.v);
+            const auto half_ayy = _mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(0.5f), a.v), _mm256_mul_ps(y, y));
+            return { _mm256_mul_ps(y, _mm256_sub_ps(_mm256_set1_ps(1.5f), half_ayy)) };
+        }
+
+        friend batch select_gt(batch a, batch b, batch x, batch y) noexcept
+        {
+            return { _mm256_blendv_ps(y.v, x.v, _mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ)) };
+        }
+    };
+
+    template <>
+    struct batch<double, avx_abi>
+    {
+        using value_type = double;
+        using abi_type = avx_abi;
+        static constexpr std::size_t width = 4;
+
+        __m256d v;
+
+        static batch broadcast(double value) noexcept { return { _mm256_set1_pd(value) }; }
+        static batch load(const double * ptr) noexcept { return { _mm256_loadu_pd(ptr) }; }
+        static batch load_aligned(const double * ptr) noexcept { return { _mm256_load_pd(ptr) }; }
+
+        void store(double * ptr) const noexcept { _mm256_storeu_pd(ptr, v); }
+        void store_aligned(double * ptr) const noexcept { _mm256_store_pd(ptr, v); }
+        void store_stream(double * ptr) const noexcept { _mm256_stream_pd(ptr, v); }
+
+        friend batch operator+(batch a, batch b) noexcept { return { _mm256_add_pd(a.v, b.v) }; }
+        friend batch operator-(batch a, batch b) noexcept { return { _mm256_sub_pd(a.v, b.v) }; }
+        friend batch operator*(batch a, batch b) noexcept { return { _mm256_mul_pd(a.v, b.v) }; }
+        friend batch operator/(batch a, batch b) noexcept { return { _mm256_div_pd(a.v, b.v) }; }
+
+        friend batch fma(batch a, batch b, batch c) noexcept
+        {
+    #if defined(__FMA__)
+            return { _mm256_fmadd_pd(a.v, b.v, c.v) };
+    #else
+            return { _mm256_add_pd(_mm256_mul_pd(a.v, b.v), c.v) };
+    #endif
+        }
+
+        friend batch sqrt(batch a) noexcept { return { _mm256_sqrt_pd(a.v) }; }
+        friend batch rsqrt(batch a) noexcept { return { _mm256_div_pd(_mm256_set1_pd(1.0), _mm256_sqrt_pd(a.v)) }; }
+
+        friend batch select_gt(batch a, batch b, batch x, batch y) noexcept
+        {
+            return { _mm256_blendv_pd(y.v, x.v, _mm256_cmp_pd(a.v, b.v, _CMP_GT_OQ)) };
+        }
+    };
+#endif
+
+#if defined(MATH_SIMD_NEON)
+    template <>
+    struct batch<float, neon_abi>
+    {
+        using value_type = float;
+        using abi_type = neon_abi;
+        static constexpr std::size_t width = 4;
+
+        float32x4_t v;
+
+        static batch broadcast(float value) noexcept { return { vdupq_n_f32(value) }; }
+        static batch load(const float * ptr) noexcept { return { vld1q_f32(ptr) }; }
+        static batch load_aligned(const float * ptr) noexcept { return { vld1q_f32(ptr) }; }
+
+        void store(float * ptr) const noexcept { vst1q_f32(ptr, v); }
+        void store_aligned(float * ptr) const noexcept { vst1q_f32(ptr, v); }
+        void store_stream(float * ptr) const noexcept { vst1q_f32(ptr, v); }
+
+        friend batch operator+(batch a, batch b) noexcept { return { vaddq_f32(a.v, b.v) }; }
+        friend batch operator-(batch a, batch b) noexcept { return { vsubq_f32(a.v, b.v) }; }
+        friend batch operator*(batch a, batch b) noexcept { return { vmulq_f32(a.v, b.v) }; }
+
+        friend batch operator/(batch a, batch b) noexcept
+        {
+    #if defined(MATH_SIMD_NEON64)
+            return { vdivq_f32(a.v, b.v) };
+    #else
+            // two Newton-Raphson refinements of the reciprocal estimate (armv7 has no divide)
+            auto r = vrecpeq_f32(b.v);
+            r = vmulq_f32(vrecpsq_f32(b.v, r), r);
+            r = vmulq_f32(vrecpsq_f32(b.v, r), r);
+            return { vmulq_f32(a.v, r) };
+    #endif
+        }
+
+        friend batch fma(batch a, batch b, batch c) noexcept { return { vmlaq_f32(c.v, a.v, b.v) }; }
+
+        friend batch sqrt(batch a) noexcept
+        {
+    #if defined(MATH_SIMD_NEON64)
+            return { vsqrtq_f32(a.v) };
+    #else
+            float lanes[4];
+            vst1q_f32(lanes, a.v);
+            for (auto & lane : lanes)
+            {
+                lane = std::sqrt(lane);
+            }
+            return { vld1q_f32(lanes) };
+    #endif
+        }
+
+        friend batch rsqrt(batch a) noexcept
+        {
+            // two steps on the 8-bit estimate; vrsqrts(a * y, y) is (3 - a * y * y) / 2
+            auto y = vrsqrteq_f32(a.v);
+            y = vmulq_f32(y, vrsqrtsq_f32(vmulq_f32(a.v, y), y));
+            y = vmulq_f32(y, vrsqrtsq_f32(vmulq_f32(a.v, y), y));
+            return { y };
+        }
+
+        friend batch select_gt(batch a, batch b, batch x, batch y) noexcept
+        {
+            return { vbslq_f32(vcgtq_f32(a.v, b.v), x.v, y.v) };
+        }
+    };
+
+    #if defined(MATH_SIMD_NEON64)
+    template <>
+    struct batch<double, neon_abi>
+    {
+        using value_type = double;
+        using abi_type = neon_abi;
+        static constexpr std::size_t width = 2;
+
+        float64x2_t v;
+
+        static batch broadcast(double value) noexcept { return { vdupq_n_f64(value) }; }
+        static batch load(const double * ptr) noexcept { return { vld1q_f64(ptr) }; }
+        static batch load_aligned(const double * ptr) noexcept { return { vld1q_f64(ptr) }; }
+
+        void store(double * ptr) const noexcept { vst1q_f64(ptr, v); }
+        void store_aligned(double * ptr) const noexcept { vst1q_f64(ptr, v); }
+        void store_stream(double * ptr) const noexcept { vst1q_f64(ptr, v); }
+
+        friend batch operator+(batch a, batch b) noexcept { return { vaddq_f64(a.v, b.v) }; }
+        friend batch operator-(batch a, batch b) noexcept { return { vsubq_f64(a.v, b.v) }; }
+        friend batch operator*(batch a, batch b) noexcept { return { vmulq_f64(a.v, b.v) }; }
+        friend batch operator/(batch a, batch b) noexcept { return { vdivq_f64(a.v, b.v) }; }
+
+        friend batch fma(batch a, batch b, batch c) noexcept { return { vfmaq_f64(c.v, a.v, b.v) }; }
+        friend batch sqrt(batch a) noexcept { return { vsqrtq_f64(a.v) }; }
+        friend batch rsqrt(batch a) noexcept { return { vdivq_f64(vdupq_n_f64(1.0), vsqrtq_f64(a.v)) }; }
+
+        friend batch select_gt(batch a, batch b, batch x, batch y) noexcept
+        {
+            return { vbslq_f64(vcgtq_f64(a.v, b.v), x.v, y.v) };
+        }
+    };
+    #endif
+#endif
+
+    // orders preceding store_stream writes before any later store, so other threads see them
+    inline void stream_fence() noexcept
+    {
+#if defined(MATH_SIMD_SSE2)
+        _mm_sfence();
+#endif
+    }
+
+    template <typename T>
+    using native_batch = batch<T, native_abi_t<T>>;
+
+    template <typename T>
+    using scalar_batch = batch<T, scalar_abi>;
+
+    template <typename T>
+    inline constexpr std::size_t native_width_v = native_batch<T>::width;
+
+    // --- Loop driver ---
+
+    // Invokes `kernel(std::type_identity<B>{}, i)` over [0, count): full native batches first,
+    // then the remaining tail one element at a time with the scalar batch.
+    template <typename T, typename Kernel>
+    inline void for_each_batch(std::size_t count, Kernel && kernel)
+    {
+        using wide = native_batch<T>;
+        using narrow = scalar_batch<T>;
+
+        std::size_t i = 0;
+        if constexpr (wide::width > 1)
+        {
+            for (; i + wide::width <= count; i += wide::width)
+            {
+                kernel(std::type_identity<wide>{}, i);
+            }
+        }
+
+        for (; i < count; ++i)
+        {
+            kernel(std::type_identity<narrow>{}, i);
+        }
+    }
+
+    // Invokes `kernel(std::type_identity<B>{}, i)` over [0, count) in native batches only.
+    // `count` must be a multiple of the native width (e.g. a padded VectorSOA lane).
+    template <typename T, typename Kernel>
+    inline void for_each_full_batch(std::size_t count, Kernel && kernel)
+    {
+        using wide = native_batch<T>;
+
+        assert(count % wide::width == 0);
+        for (std::size_t i = 0; i < count; i += wide::width)
+        {
+            kernel(std::type_identity<wide>{}, i);
+        }
+    }
+}
@@ -0,0 +1,305 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+
+#include "simd.hpp"
+
+// Register kernels for 4-wide vectors and 4x4 column-major matrices: float in one SSE / NEON
+// register, double in one AVX register. Vector<4, T> and Matrix4x4<T> call them from their
+// operators when enabled_v holds and the call is not constant-evaluated; everything else keeps
+// the generic code. The kernels are static members of kernels<T>, which keeps those calls
+// dependent so the operators still compile where kernels<T> is not defined. Pointers are to 4
+// (vectors) or 16 (matrices) contiguous elements, with no alignment requirement; outputs may
+// alias inputs.
+namespace math::simd4
+{
+    // add, sub, scale, dot, mat_vec, mat_mul, transpose and, when inverse_enabled_v, inverse
+    template <typename T>
+    struct kernels;
+
+    template <std::size_t N, typename T>
+    inline constexpr bool enabled_v =
+#if defined(MATH_SIMD_SSE2) || defined(MATH_SIMD_NEON)
+        (N == 4 && std::is_same_v<T, float>) ||
+#endif
+#if defined(MATH_SIMD_AVX)
+        (N == 4 && std::is_same_v<T, double>) ||
+#endif
+        false;
+
+    template <typename T>
+    inline constexpr bool inverse_enabled_v =
+#if defined(MATH_SIMD_SSE2)
+        std::is_same_v<T, float> ||
+#endif
+        false;
+
+#if defined(MATH_SIMD_SSE2)
+    namespace detail
+    {
+        inline __m128 fmadd(__m128 a, __m128 b, __m128 c) noexcept
+        {
+    #if defined(__FMA__)
+            return _mm_fmadd_ps(a, b, c);
+    #else
+            return _mm_add_ps(_mm_mul_ps(a, b), c);
+    #endif
+        }
+
+        template <int I>
+        inline __m128 splat(__m128 v) noexcept
+        {
+            return _mm_shuffle_ps(v, v, _MM_SHUFFLE(I, I, I, I));
+        }
+
+        // m * v for the columns c0..c3
+        inline __m128 mat_vec(__m128 c0, __m128 c1, __m128 c2, __m128 c3, __m128 v) noexcept
+        {
+            auto acc = _mm_mul_ps(c0, splat<0>(v));
+            acc = fmadd(c1, splat<1>(v), acc);
+            acc = fmadd(c2, splat<2>(v), acc);
+            return fmadd(c3, splat<3>(v), acc);
+        }
+
+        // 2x2 blocks packed as (m00, m01, m10, m11): a * b, adj(a) * b and a * adj(b)
+        inline __m128 mat2_mul(__m128 a, __m128 b) noexcept
+        {
+            return _mm_add_ps(_mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 3, 0))),
+                              _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2))));
+        }
+
+        inline __m128 mat2_adj_mul(__m128 a, __m128 b) noexcept
+        {
+            return _mm_sub_ps(_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 3, 3)), b),
+                              _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 1, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2))));
+        }
+
+        inline __m128 mat2_mul_adj(__m128 a, __m128 b) noexcept
+        {
+            return _mm_sub_ps(_mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 3, 0, 3))),
+                              _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2))));
+        }
+    }
+
+    template <>
+    struct kernels<float>
+    {
+        static void add(const float * a, const float * b, float * out) noexcept { _mm_storeu_ps(out, _mm_add_ps(_mm_loadu_ps(a), _mm_loadu_ps(b))); }
+        static void sub(const float * a, const float * b, float * out) noexcept { _mm_storeu_ps(out, _mm_sub_ps(_mm_loadu_ps(a), _mm_loadu_ps(b))); }
+        static void scale(const float * a, float s, float * out) noexcept { _mm_storeu_ps(out, _mm_mul_ps(_mm_loadu_ps(a), _mm_set1_ps(s))); }
+
+        static float dot(const float * a, const float * b) noexcept
+        {
+            auto p = _mm_mul_ps(_mm_loadu_ps(a), _mm_loadu_ps(b));
+            p = _mm_add_ps(p, _mm_shuffle_ps(p, p, _MM_SHUFFLE(2, 3, 0, 1)));
+            p = _mm_add_ps(p, _mm_shuffle_ps(p, p, _MM_SHUFFLE(1, 0, 3, 2)));
+            return _mm_cvtss_f32(p);
+        }
+
+        static void mat_vec(const float * m, const float * v, float * out) noexcept
+        {
+            _mm_storeu_ps(out, detail::mat_vec(_mm_loadu_ps(m), _mm_loadu_ps(m + 4), _mm_loadu_ps(m + 8), _mm_loadu_ps(m + 12), _mm_loadu_ps(v)));
+        }
+
+        static void mat_mul(const float * a, const float * b, float * out) noexcept
+        {
+            const auto c0 = _mm_loadu_ps(a), c1 = _mm_loadu_ps(a + 4), c2 = _mm_loadu_ps(a + 8), c3 = _mm_loadu_ps(a + 12);
+            const auto r0 = detail::mat_vec(c0, c1, c2, c3, _mm_loadu_ps(b));
+            const auto r1 = detail::mat_vec(c0, c1, c2, c3, _mm_loadu_ps(b + 4));
+            const auto r2 = detail::mat_vec(c0, c1, c2, c3, _mm_loadu_ps(b + 8));
+            const auto r3 = detail::mat_vec(c0, c1, c2, c3, _mm_loadu_ps(b + 12));
+            _mm_storeu_ps(out, r0);
+            _mm_storeu_ps(out + 4, r1);
+            _mm_storeu_ps(out + 8, r2);
+            _mm_storeu_ps(out + 12, r3);
+        }
+
+        static void transpose(const float * m, float * out) noexcept
+        {
+            auto c0 = _mm_loadu_ps(m), c1 = _mm_loadu_ps(m + 4), c2 = _mm_loadu_ps(m + 8), c3 = _mm_loadu_ps(m + 12);
+            _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+            _mm_storeu_ps(out, c0);
+            _mm_storeu_ps(out + 4, c1);
+            _mm_storeu_ps(out + 8, c2);
+            _mm_storeu_ps(out + 12, c3);
+        }
+
+        // blockwise inverse through 2x2 adjugates; returns the determinant, and writes nothing when
+        // it is not above tolerance in magnitude
+        static float inverse(const float * m, float * out, float tolerance) noexcept
+        {
+            using namespace detail;
+
+            const auto c0 = _mm_loadu_ps(m), c1 = _mm_loadu_ps(m + 4), c2 = _mm_loadu_ps(m + 8), c3 = _mm_loadu_ps(m + 12);
+
+            // the four 2x2 blocks and their determinants (|A| |B| |C| |D|)
+            const auto a = _mm_movelh_ps(c0, c1);
+            const auto b = _mm_movehl_ps(c1, c0);
+            const auto c = _mm_movelh_ps(c2, c3);
+            const auto d = _mm_movehl_ps(c3, c2);
+            const auto dets = _mm_sub_ps(
+                _mm_mul_ps(_mm_shuffle_ps(c0, c2, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(c1, c3, _MM_SHUFFLE(3, 1, 3, 1))),
+                _mm_mul_ps(_mm_shuffle_ps(c0, c2, _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_ps(c1, c3, _MM_SHUFFLE(2, 0, 2, 0))));
+            const auto detA = splat<0>(dets);
+            const auto detB = splat<1>(dets);
+            const auto detC = splat<2>(dets);
+            const auto detD = splat<3>(dets);
+
+            const auto dc = mat2_adj_mul(d, c);
+            const auto ab = mat2_adj_mul(a, b);
+            auto x = _mm_sub_ps(_mm_mul_ps(detD, a), mat2_mul(b, dc));
+            auto w = _mm_sub_ps(_mm_mul_ps(detA, d), mat2_mul(c, ab));
+            auto y = _mm_sub_ps(_mm_mul_ps(detB, c), mat2_mul_adj(d, ab));
+            auto z = _mm_sub_ps(_mm_mul_ps(detC, b), mat2_mul_adj(a, dc));
+
+            // |M| = |A||D| + |B||C| - tr(adj(A) B adj(D) C)
+            auto tr = _mm_mul_ps(ab, _mm_shuffle_ps(dc, dc, _MM_SHUFFLE(3, 1, 2, 0)));
+            tr = _mm_add_ps(tr, _mm_shuffle_ps(tr, tr, _MM_SHUFFLE(2, 3, 0, 1)));
+            tr = _mm_add_ps(tr, _mm_shuffle_ps(tr, tr, _MM_SHUFFLE(1, 0, 3, 2)));
+            const auto det = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC)), tr);
+
+            const auto value = _mm_cvtss_f32(det);
+            if (!(value > tolerance || value < -tolerance))
+            {
+                return value;
+            }
+
+            const auto scale = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), det);
+            x = _mm_mul_ps(x, scale);
+            y = _mm_mul_ps(y, scale);
+            z = _mm_mul_ps(z, scale);
+            w = _mm_mul_ps(w, scale);
+
+            // the adjugate of each block, shuffled back into columns
+            _mm_storeu_ps(out, _mm_shuffle_ps(x, y, _MM_SHUFFLE(1, 3, 1, 3)));
+            _mm_storeu_ps(out + 4, _mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 2, 0, 2)));
+            _mm_storeu_ps(out + 8, _mm_shuffle_ps(z, w, _MM_SHUFFLE(1, 3, 1, 3)));
+            _mm_storeu_ps(out + 12, _mm_shuffle_ps(z, w, _MM_SHUFFLE(0, 2, 0, 2)));
+            return value;
+        }
+    };
+#elif defined(MATH_SIMD_NEON)
+    namespace detail
+    {
+        inline float32x4_t mat_vec(float32x4_t c0, float32x4_t c1, float32x4_t c2, float32x4_t c3, float32x4_t v) noexcept
+        {
+            auto acc = vmulq_n_f32(c0, vgetq_lane_f32(v, 0));
+            acc = vmlaq_n_f32(acc, c1, vgetq_lane_f32(v, 1));
+            acc = vmlaq_n_f32(acc, c2, vgetq_lane_f32(v, 2));
+            return vmlaq_n_f32(acc, c3, vgetq_lane_f32(v, 3));
+        }
+    }
+
+    template <>
+    struct kernels<float>
+    {
+        static void add(const float * a, const float * b, float * out) noexcept { vst1q_f32(out, vaddq_f32(vld1q_f32(a), vld1q_f32(b))); }
+        static void sub(const float * a, const float * b, float * out) noexcept { vst1q_f32(out, vsubq_f32(vld1q_f32(a), vld1q_f32(b))); }
+        static void scale(const float * a, float s, float * out) noexcept { vst1q_f32(out, vmulq_n_f32(vld1q_f32(a), s)); }
+
+        static float dot(const float * a, const float * b) noexcept
+        {
+            const auto p = vmulq_f32(vld1q_f32(a), vld1q_f32(b));
+            const auto h = vadd_f32(vget_low_f32(p), vget_high_f32(p));
+            return vget_lane_f32(vpadd_f32(h, h), 0);
+        }
+
+        static void mat_vec(const float * m, const float * v, float * out) noexcept
+        {
+            vst1q_f32(out, detail::mat_vec(vld1q_f32(m), vld1q_f32(m + 4), vld1q_f32(m + 8), vld1q_f32(m + 12), vld1q_f32(v)));
+        }
+
+        static void mat_mul(const float * a, const float * b, float * out) noexcept
+        {
+            const auto c0 = vld1q_f32(a), c1 = vld1q_f32(a + 4), c2 = vld1q_f32(a + 8), c3 = vld1q_f32(a + 12);
+            const auto r0 = detail::mat_vec(c0, c1, c2, c3, vld1q_f32(b));
+            const auto r1 = detail::mat_vec(c0, c1, c2, c3, vld1q_f32(b + 4));
+            const auto r2 = detail::mat_vec(c0, c1, c2, c3, vld1q_f32(b + 8));
+            const auto r3 = detail::mat_vec(c0, c1, c2, c3, vld1q_f32(b + 12));
+            vst1q_f32(out, r0);
+            vst1q_f32(out + 4, r1);
+            vst1q_f32(out + 8, r2);
+            vst1q_f32(out + 12, r3);
+        }
+
+        static void transpose(const float * m, float * out) noexcept
+        {
+            // the de-interleaving load gathers every fourth element, i.e. the rows
+            const auto rows = vld4q_f32(m);
+            vst1q_f32(out, rows.val[0]);
+            vst1q_f32(out + 4, rows.val[1]);
+            vst1q_f32(out + 8, rows.val[2]);
+            vst1q_f32(out + 12, rows.val[3]);
+        }
+    };
+#endif
+
+#if defined(MATH_SIMD_AVX)
+    namespace detail
+    {
+        inline __m256d fmadd(__m256d a, __m256d b, __m256d c) noexcept
+        {
+    #if defined(__FMA__)
+            return _mm256_fmadd_pd(a, b, c);
+    #else
+            return _mm256_add_pd(_mm256_mul_pd(a, b), c);
+    #endif
+        }
+
+        inline __m256d mat_vec(const double * m, const double * v) noexcept
+        {
+            auto acc = _mm256_mul_pd(_mm256_loadu_pd(m), _mm256_broadcast_sd(v));
+            acc = fmadd(_mm256_loadu_pd(m + 4), _mm256_broadcast_sd(v + 1), acc);
+            acc = fmadd(_mm256_loadu_pd(m + 8), _mm256_broadcast_sd(v + 2), acc);
+            return fmadd(_mm256_loadu_pd(m + 12), _mm256_broadcast_sd(v + 3), acc);
+        }
+    }
+
+    template <>
+    struct kernels<double>
+    {
+        static void add(const double * a, const double * b, double * out) noexcept { _mm256_storeu_pd(out, _mm256_add_pd(_mm256_loadu_pd(a), _mm256_loadu_pd(b))); }
+        static void sub(const double * a, const double * b, double * out) noexcept { _mm256_storeu_pd(out, _mm256_sub_pd(_mm256_loadu_pd(a), _mm256_loadu_pd(b))); }
+        static void scale(const double * a, double s, double * out) noexcept { _mm256_storeu_pd(out, _mm256_mul_pd(_mm256_loadu_pd(a), _mm256_set1_pd(s))); }
+
+        static double dot(const double * a, const double * b) noexcept
+        {
+            const auto p = _mm256_mul_pd(_mm256_loadu_pd(a), _mm256_loadu_pd(b));
+            const auto h = _mm_add_pd(_mm256_castpd256_pd128(p), _mm256_extractf128_pd(p, 1));
+            return _mm_cvtsd_f64(_mm_add_sd(h, _mm_unpackhi_pd(h, h)));
+        }
+
+        static void mat_vec(const double * m, const double * v, double * out) noexcept
+        {
+            _mm256_storeu_pd(out, detail::mat_vec(m, v));
+        }
+
+        static void mat_mul(const double * a, const double * b, double * out) noexcept
+        {
+            // every column of the result is read from b before it is written, so out may alias b
+            const auto r0 = detail::mat_vec(a, b);
+            const auto r1 = detail::mat_vec(a, b + 4);
+            const auto r2 = detail::mat_vec(a, b + 8);
+            const auto r3 = detail::mat_vec(a, b + 12);
+            _mm256_storeu_pd(out, r0);
+            _mm256_storeu_pd(out + 4, r1);
+            _mm256_storeu_pd(out + 8, r2);
+            _mm256_storeu_pd(out + 12, r3);
+        }
+
+        static void transpose(const double * m, double * out) noexcept
+        {
+            const auto c0 = _mm256_loadu_pd(m), c1 = _mm256_loadu_pd(m + 4), c2 = _mm256_loadu_pd(m + 8), c3 = _mm256_loadu_pd(m + 12);
+            const auto t0 = _mm256_unpacklo_pd(c0, c1); // m00 m01 m20 m21
+            const auto t1 = _mm256_unpackhi_pd(c0, c1); // m10 m11 m30 m31
+            const auto t2 = _mm256_unpacklo_pd(c2, c3); // m02 m03 m22 m23
+            const auto t3 = _mm256_unpackhi_pd(c2, c3); // m12 m13 m32 m33
+            _mm256_storeu_pd(out, _mm256_permute2f128_pd(t0, t2, 0x20));
+            _mm256_storeu_pd(out + 4, _mm256_permute2f128_pd(t1, t3, 0x20));
+            _mm256_storeu_pd(out + 8, _mm256_permute2f128_pd(t0, t2, 0x31));
+            _mm256_storeu_pd(out + 12, _mm256_permute2f128_pd(t1, t3, 0x31));
+        }
+    };
+#endif
+}
@@ -0,0 +1,538 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include "core/handle.hpp"
+#include "core/thread-pool.hpp"
+#include "vectors-soa.hpp"
+#include "vectors.hpp"
+
+namespace math
+{
+    // Uniform hash grid over 3D points, keyed by the Handles of a VectorSOA<3, T>, for radius and
+    // box queries. Space is cut into cubes of cell_size; each occupied cube hashes to one of a
+    // power-of-two number of buckets holding a list of entries (handle, position, cube). The grid
+    // keeps its own copy of the positions, so queries never touch the VectorSOA.
+    //
+    // rebuild() fills the grid from scratch in parallel and lays each bucket out contiguously;
+    // insert / update / erase keep it current one entity at a time, and update(positions) syncs
+    // it with a moved VectorSOA without a rebuild. Queries are const, may run concurrently with
+    // each other, and write into a caller-provided span without allocating.
+    //
+    // Pick cell_size near the usual query radius: a query visits every cube its box overlaps,
+    // and a box covering more cubes than there are entries falls back to a linear scan.
+    template <typename T = float>
+        requires std::floating_point<T>
+    class SpatialHashGrid
+    {
+    public:
+        using cell_type = std::array<int32_t, 3>;
+
+        explicit SpatialHashGrid(T cell_size)
+            : m_cell_size(cell_size)
+            , m_inv_cell_size(static_cast<T>(1) / cell_size)
+        {
+            assert(cell_size > static_cast<T>(0));
+        }
+
+        [[nodiscard]] T cell_size() const noexcept
+        {
+            return m_cell_size;
+        }
+
+        [[nodiscard]] std::size_t size() const noexcept
+        {
+            return m_entries.size();
+        }
+
+        [[nodiscard]] bool empty() const noexcept
+        {
+            return m_entries.empty();
+        }
+
+        [[nodiscard]] bool contains(Handle handle) const noexcept
+        {
+            return find(handle) != npos;
+        }
+
+        // the grid's copy of the position of `handle`, if present
+        [[nodiscard]] const Vector3<T> * position(Handle handle) const noexcept
+        {
+            const auto slot = find(handle);
+            return slot != npos ? &m_entries[slot].position : nullptr;
+        }
+
+        void reserve(std::size_t count)
+        {
+            m_entries.reserve(count);
+            if (m_heads.size() < bucket_count_for(count))
+            {
+                rehash(count);
+            }
+        }
+
+        void clear() noexcept
+        {
+            m_entries.clear();
+            std::fill(m_heads.begin(), m_heads.end(), npos);
+            std::fill(m_slots.begin(), m_slots.end(), npos);
+        }
+
+        // --- Bulk ---
+
+        // Replaces the contents with every element of `positions` that has a handle, on `pool`.
+        // Reuses the grid's storage, so rebuilding every frame does not allocate once it has grown.
+        template <typename A>
+        void rebuild(const VectorSOA<3, T, A> & positions, ThreadPool & pool = ThreadPool::global())
+        {
+            const auto count = positions.size();
+            const auto & handles = positions.handles();
+            auto & buckets = m_scratch;     // bucket of element i, npos without a handle
+            auto & target = m_scratch_target; // entry slot of element i
+            buckets.resize(count);
+            target.resize(count);
+
+            if (m_heads.size() < bucket_count_for(count))
+            {
+                m_heads.resize(bucket_count_for(count));
+            }
+            const auto mask = static_cast<uint32_t>(m_heads.size() - 1);
+
+            pool.parallel_for(count, rebuild_grain, [&](std::size_t begin, std::size_t end)
+            {
+                for (std::size_t i = begin; i < end; ++i)
+                {
+                    buckets[i] = handles.get_handle(static_cast<uint32_t>(i)).is_valid()
+                        ? hash(cell_of(load(positions, i))) & mask
+                        : npos;
+                }
+            });
+
+            // counting sort by bucket: m_starts[b] is the first slot of bucket b once shifted
+            m_starts.assign(m_heads.size() + 1, 0);
+            uint32_t max_id = 0;
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                if (buckets[i] != npos)
+                {
+                    ++m_starts[buckets[i] + 1];
+                    max_id = std::max(max_id, handles.get_handle(static_cast<uint32_t>(i)).id + 1);
+                }
+            }
+            for (std::size_t b = 1; b < m_starts.size(); ++b)
+            {
+                m_starts[b] += m_starts[b - 1];
+            }
+            const auto entries = m_starts.back();
+            {
+                // per-bucket cursors, borrowed from m_heads and restored below
+                std::copy(m_starts.begin(), m_starts.end() - 1, m_heads.begin());
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    if (buckets[i] != npos)
+                    {
+                        target[i] = m_heads[buckets[i]]++;
+                    }
+                }
+            }
+
+            m_entries.resize(entries);
+            m_slots.assign(max_id, npos);
+            pool.parallel_for(count, rebuild_grain, [&](std::size_t begin, std::size_t end)
+            {
+                for (std::size_t i = begin; i < end; ++i)
+                {
+                    const auto bucket = buckets[i];
+                    if (bucket == npos)
+                    {
+                        continue;
+                    }
+
+                    const auto slot = target[i];
+                    auto & entry = m_entries[slot];
+                    entry.position = load(positions, i);
+                    entry.cell = cell_of(entry.position);
+                    entry.handle = handles.get_handle(static_cast<uint32_t>(i));
+                    entry.prev = slot > m_starts[bucket] ? slot - 1 : npos;
+                    entry.next = slot + 1 < m_starts[bucket + 1] ? slot + 1 : npos;
+                    m_slots[entry.handle.id] = slot;
+                }
+            });
+
+            for (std::size_t b = 0; b < m_heads.size(); ++b)
+            {
+                m_heads[b] = m_starts[b] < m_starts[b + 1] ? m_starts[b] : npos;
+            }
+        }
+
+        // Brings the grid in line with `positions` after its elements moved: entries take their
+        // element's current position (on `pool`), entries whose handle is gone are erased, and
+        // elements with a handle the grid does not hold yet are inserted. Only entries that
+        // changed cube are relinked; the price is a bucket layout that grows less contiguous
+        // until the next rebuild().
+        template <typename A>
+        void update(const VectorSOA<3, T, A> & positions, ThreadPool & pool = ThreadPool::global())
+        {
+            enum : uint32_t { same_cube, new_cube, missing, no_handle };
+
+            const auto & handles = positions.handles();
+            auto & state = m_scratch;         // per element
+            auto & seen = m_scratch_target;   // per entry: whether an element still carries it
+            state.resize(positions.size());
+            seen.assign(m_entries.size(), 0);
+
+            // in element order, so the container is read front to back
+            pool.parallel_for(positions.size(), rebuild_grain, [&](std::size_t begin, std::size_t end)
+            {
+                for (std::size_t i = begin; i < end; ++i)
+                {
+                    const auto handle = handles.get_handle(static_cast<uint32_t>(i));
+                    const auto slot = handle.is_valid() ? find(handle) : npos;
+                    if (slot == npos)
+                    {
+                        state[i] = handle.is_valid() ? missing : no_handle;
+                        continue;
+                    }
+
+                    auto & entry = m_entries[slot];
+                    entry.position = load(positions, i);
+                    seen[slot] = 1;
+                    state[i] = cell_of(entry.position) != entry.cell ? new_cube : same_cube;
+                }
+            });
+
+            for (std::size_t i = 0; i < state.size(); ++i)
+            {
+                if (state[i] == new_cube)
+                {
+                    const auto slot = find(handles.get_handle(static_cast<uint32_t>(i)));
+                    unlink(slot);
+                    m_entries[slot].cell = cell_of(m_entries[slot].position);
+                    link(slot);
+                }
+            }
+
+            // from the back, so that the entry swapped into an erased slot has been seen already
+            for (std::size_t slot = seen.size(); slot-- > 0;)
+            {
+                if (seen[slot] == 0)
+                {
+                    erase_slot(static_cast<uint32_t>(slot));
+                }
+            }
+
+            for (std::size_t i = 0; i < state.size(); ++i)
+            {
+                if (state[i] == missing)
+                {
+                    insert(handles.get_handle(static_cast<uint32_t>(i)), load(positions, i));
+                }
+            }
+        }
+
+        // --- Per entity ---
+
+        // false if `handle` is invalid or already present
+        bool insert(Handle handle, const Vector3<T> & position)
+        {
+            if (!handle.is_valid() || contains(handle))
+            {
+                return false;
+            }
+
+            if (m_heads.size() < bucket_count_for(m_entries.size() + 1) / 2)
+            {
+                rehash(m_entries.size() + 1);
+            }
+            if (handle.id >= m_slots.size())
+            {
+                m_slots.resize(static_cast<std::size_t>(handle.id) + 1, npos);
+            }
+
+            const auto slot = static_cast<uint32_t>(m_entries.size());
+            m_entries.push_back(Entry{ position, cell_of(position), handle, npos, npos });
+            m_slots[handle.id] = slot;
+            link(slot);
+            return true;
+        }
+
+        // moves `handle` to `position`; false if it is not present
+        bool update(Handle handle, const Vector3<T> & position) noexcept
+        {
+            const auto slot = find(handle);
+            if (slot == npos)
+            {
+                return false;
+            }
+
+            auto & entry = m_entries[slot];
+            entry.position = position;
+            const auto cell = cell_of(position);
+            if (cell != entry.cell)
+            {
+                unlink(slot);
+                entry.cell = cell;
+                link(slot);
+            }
+            return true;
+        }
+
+        bool erase(Handle handle) noexcept
+        {
+            const auto slot = find(handle);
+            if (slot == npos)
+            {
+                return false;
+            }
+
+            erase_slot(slot);
+            return true;
+        }
+
+        // --- Queries ---
+
+        // Handles of the entries within `radius` of `centre` (inclusive), in no particular order.
+        // Writes the first out.size() of them and returns how many there are in total, so a
+        // result larger than `out` means the buffer was too small.
+        [[nodiscard]] std::size_t query_radius(const Vector3<T> & centre, T radius, std::span<Handle> out) const noexcept
+        {
+            if (!(radius >= static_cast<T>(0)))
+            {
+                return 0;
+            }
+
+            const auto extent = Vector3<T>{ radius, radius, radius };
+            const auto r2 = radius * radius;
+            return collect(centre - extent, centre + extent, out, [&](const Vector3<T> & p)
+            {
+                return (p - centre).squared_length() <= r2;
+            });
+        }
+
+        // Handles of the entries inside the box [min, max] (inclusive); same buffer contract as
+        // query_radius.
+        [[nodiscard]] std::size_t query_box(const Vector3<T> & min, const Vector3<T> & max, std::span<Handle> out) const noexcept
+        {
+            return collect(min, max, out, [&](const Vector3<T> & p)
+            {
+                return p[0] >= min[0] && p[1] >= min[1] && p[2] >= min[2]
+                    && p[0] <= max[0] && p[1] <= max[1] && p[2] <= max[2];
+            });
+        }
+
+    private:
+        static constexpr uint32_t npos = std::numeric_limits<uint32_t>::max();
+        static constexpr std::size_t rebuild_grain = 4096;
+        static constexpr std::size_t min_buckets = 16;
+
+        struct Entry
+        {
+            Vector3<T> position;
+            cell_type  cell;
+            Handle     handle;
+            uint32_t   next;
+            uint32_t   prev;
+        };
+
+        T m_cell_size;
+        T m_inv_cell_size;
+        std::vector<Entry> m_entries;
+        std::vector<uint32_t> m_heads;   // bucket -> first entry; the size is a power of two
+        std::vector<uint32_t> m_slots;   // handle id -> entry
+        std::vector<uint32_t> m_starts;  // rebuild: first entry of each bucket
+        std::vector<uint32_t> m_scratch; // rebuild, update: one value per element
+        std::vector<uint32_t> m_scratch_target; // rebuild: per element; update: per entry
+
+        template <typename A>
+        static Vector3<T> load(const VectorSOA<3, T, A> & positions, std::size_t i) noexcept
+        {
+            return Vector3<T>{ positions.data(0)[i], positions.data(1)[i], positions.data(2)[i] };
+        }
+
+        // at least two buckets per entry, to keep the lists short
+        static std::size_t bucket_count_for(std::size_t count) noexcept
+        {
+            return std::bit_ceil(std::max(count * 2, min_buckets));
+        }
+
+        [[nodiscard]] int32_t cell_coordinate(T value) const noexcept
+        {
+            // clamped, so that far-away (or non-finite) points land in the outermost cubes rather
+            // than overflow; NaN ends up in cube 0
+            constexpr auto limit = static_cast<T>(1 << 30);
+            const auto scaled = std::floor(value * m_inv_cell_size);
+            return static_cast<int32_t>(std::clamp(scaled == scaled ? scaled : static_cast<T>(0), -limit, limit));
+        }
+
+        [[nodiscard]] cell_type cell_of(const Vector3<T> & p) const noexcept
+        {
+            return { cell_coordinate(p[0]), cell_coordinate(p[1]), cell_coordinate(p[2]) };
+        }
+
+        static uint32_t hash(const cell_type & cell) noexcept
+        {
+            return (static_cast<uint32_t>(cell[0]) * 73856093u)
+                 ^ (static_cast<uint32_t>(cell[1]) * 19349663u)
+                 ^ (static_cast<uint32_t>(cell[2]) * 83492791u);
+        }
+
+        [[nodiscard]] uint32_t bucket_of(const cell_type & cell) const noexcept
+        {
+            return hash(cell) & static_cast<uint32_t>(m_heads.size() - 1);
+        }
+
+        [[nodiscard]] uint32_t find(Handle handle) const noexcept
+        {
+            if (handle.id >= m_slots.size())
+            {
+                return npos;
+            }
+            const auto slot = m_slots[handle.id];
+            return slot != npos && m_entries[slot].handle.generation == handle.generation ? slot : npos;
+        }
+
+        void link(uint32_t slot) noexcept
+        {
+            auto & entry = m_entries[slot];
+            auto & head = m_heads[bucket_of(entry.cell)];
+            entry.prev = npos;
+            entry.next = head;
+            if (head != npos)
+            {
+                m_entries[head].prev = slot;
+            }
+            head = slot;
+        }
+
+        void unlink(uint32_t slot) noexcept
+        {
+            const auto & entry = m_entries[slot];
+            if (entry.prev != npos)
+            {
+                m_entries[entry.prev].next = entry.next;
+            }
+            else
+            {
+                m_heads[bucket_of(entry.cell)] = entry.next;
+            }
+            if (entry.next != npos)
+            {
+                m_entries[entry.next].prev = entry.prev;
+            }
+        }
+
+        // swap-and-pop, as VectorSOA::erase
+        void erase_slot(uint32_t slot) noexcept
+        {
+            unlink(slot);
+            m_slots[m_entries[slot].handle.id] = npos;
+
+            const auto last = static_cast<uint32_t>(m_entries.size() - 1);
+            if (slot != last)
+            {
+                auto & moved = m_entries[slot];
+                moved = m_entries[last];
+                if (moved.prev != npos)
+                {
+                    m_entries[moved.prev].next = slot;
+                }
+                else
+                {
+                    m_heads[bucket_of(moved.cell)] = slot;
+                }
+                if (moved.next != npos)
+                {
+                    m_entries[moved.next].prev = slot;
+                }
+                m_slots[moved.handle.id] = slot;
+            }
+            m_entries.pop_back();
+        }
+
+        void rehash(std::size_t count)
+        {
+            m_heads.assign(bucket_count_for(count), npos);
+            for (std::size_t slot = 0; slot < m_entries.size(); ++slot)
+            {
+                link(static_cast<uint32_t>(slot));
+            }
+        }
+
+        template <typename Inside>
+        std::size_t collect(const Vector3<T> & min, const Vector3<T> & max, std::span<Handle> out, Inside && inside) const noexcept
+        {
+            std::size_t found = 0;
+            const auto emit = [&](const Entry & entry)
+            {
+                if (found < out.size())
+                {
+                    out[found] = entry.handle;
+                }
+                ++found;
+            };
+
+            if (m_entries.empty())
+            {
+                return 0;
+            }
+
+            const auto lo = cell_of(min);
+            const auto hi = cell_of(max);
+            std::size_t cubes = 1;
+            for (std::size_t c = 0; c < 3; ++c)
+            {
+                if (hi[c] < lo[c])
+                {
+                    return 0;
+                }
+                cubes *= static_cast<std::size_t>(static_cast<int64_t>(hi[c]) - lo[c] + 1);
+                if (cubes > m_entries.size())
+                {
+                    break;
+                }
+            }
+
+            if (cubes > m_entries.size())
+            {
+                for (const auto & entry : m_entries)
+                {
+                    if (inside(entry.position))
+                    {
+                        emit(entry);
+                    }
+                }
+                return found;
+            }
+
+            // an entry is reported from its own cube only, so cubes sharing a bucket add no duplicates
+            for (auto x = lo[0]; x <= hi[0]; ++x)
+            {
+                for (auto y = lo[1]; y <= hi[1]; ++y)
+                {
+                    for (auto z = lo[2]; z <= hi[2]; ++z)
+                    {
+                        const cell_type cell{ x, y, z };
+                        for (auto slot = m_heads[bucket_of(cell)]; slot != npos; slot = m_entries[slot].next)
+                        {
+                            const auto & entry = m_entries[slot];
+                            if (entry.cell == cell && inside(entry.position))
+                            {
+                                emit(entry);
+                            }
+                        }
+                    }
+                }
+            }
+            return found;
+        }
+    };
+}
@@ -0,0 +1,482 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <span>
+#include <type_traits>
+
+#include "matrix.hpp"
+#include "quaternion.hpp"
+#include "simd.hpp"
+#include "vectors-soa.hpp"
+
+// Column-wise bulk operations over VectorSOA lanes.
+// Lanes are 64-byte aligned and padded, so container-to-container kernels run aligned native batches
+// over padded_size() with no scalar tail when the output has the input's size; a larger output keeps
+// its elements past the input's size, the last partial batch going one element at a time, and kernels
+// writing into a span finish the tail the same way.
+// Outputs must already be sized (out.size() >= input size); an output may alias any of its inputs.
+// Transforms and rotations broadcast their matrix or quaternion once per call and can store with
+// non-temporal writes (store_mode::streaming) when the output is too large to stay cached.
+
+namespace math::soa
+{
+    // How kernels that write whole lanes store their results. cached keeps the output in cache for
+    // whoever reads it next; streaming writes around the cache, which pays off for outputs much
+    // larger than the cache that are not read again right away (it leaves the inputs cached).
+    enum class store_mode { cached, streaming };
+
+    namespace detail
+    {
+        template <bool Stream, typename B, typename T>
+        inline void store_lane(B value, T * ptr) noexcept
+        {
+            if constexpr (Stream)
+            {
+                value.store_stream(ptr);
+            }
+            else
+            {
+                value.store_aligned(ptr);
+            }
+        }
+
+        // runs kernel(std::bool_constant<Stream>) so the mode is decided once, outside the loop
+        template <typename Kernel>
+        inline void with_store_mode(store_mode mode, Kernel && kernel)
+        {
+            if (mode == store_mode::streaming)
+            {
+                kernel(std::true_type{ });
+                simd::stream_fence();
+            }
+            else
+            {
+                kernel(std::false_type{ });
+            }
+        }
+
+        // Runs kernel over the `size` live elements of an input lane. When the output has the same
+        // size, its padding takes the results past size() and the whole padded lane goes in native
+        // batches; a larger output has live elements there, so the last partial batch is done one
+        // element at a time with the scalar batch.
+        template <typename T, typename Kernel>
+        inline void for_each_output_batch(std::size_t out_size, std::size_t size, std::size_t padded, Kernel && kernel)
+        {
+            if (out_size == size)
+            {
+                simd::for_each_full_batch<T>(padded, kernel);
+            }
+            else
+            {
+                simd::for_each_batch<T>(size, kernel);
+            }
+        }
+
+        // of a value prepared once per call at both widths, the one for batch B
+        template <typename B, typename Wide, typename Narrow>
+        inline const auto & for_batch(const Wide & wide, const Narrow & narrow) noexcept
+        {
+            if constexpr (B::width > 1)
+            {
+                return wide;
+            }
+            else
+            {
+                return narrow;
+            }
+        }
+
+        // every matrix element broadcast into a batch once per call, [column][row]
+        template <typename B, typename T>
+        inline std::array<std::array<B, 4>, 4> broadcast_matrix(const Matrix4x4<T> & m) noexcept
+        {
+            std::array<std::array<B, 4>, 4> mb;
+            for (size_t c = 0; c < 4; ++c)
+            {
+                for (size_t r = 0; r < 4; ++r)
+                {
+                    mb[c][r] = B::broadcast(m[c][r]);
+                }
+            }
+            return mb;
+        }
+
+        template <typename B, typename T>
+        inline std::array<B, 4> broadcast_quaternion(const Quaternion<T> & q) noexcept
+        {
+            return { B::broadcast(q.x()), B::broadcast(q.y()), B::broadcast(q.z()), B::broadcast(q.w()) };
+        }
+
+        // v + w * t + cross(q.xyz, t) with t = 2 * cross(q.xyz, v), as math::rotate
+        template <typename B>
+        inline std::array<B, 3> rotate_at(const std::array<B, 4> & q, const std::array<B, 3> & v) noexcept
+        {
+            const auto two = B::broadcast(2);
+            const auto tx = (q[1] * v[2] - q[2] * v[1]) * two;
+            const auto ty = (q[2] * v[0] - q[0] * v[2]) * two;
+            const auto tz = (q[0] * v[1] - q[1] * v[0]) * two;
+            return {
+                fma(q[3], tx, v[0] + (q[1] * tz - q[2] * ty)),
+                fma(q[3], ty, v[1] + (q[2] * tx - q[0] * tz)),
+                fma(q[3], tz, v[2] + (q[0] * ty - q[1] * tx))
+            };
+        }
+
+        template <typename T, typename Op>
+        inline void unary_lane(T * out, std::size_t out_size, const T * a, std::size_t size, std::size_t padded, Op op) noexcept
+        {
+            for_each_output_batch<T>(out_size, size, padded, [&]<typename B>(std::type_identity<B>, std::size_t i)
+            {
+                op(B::load_aligned(a + i)).store_aligned(out + i);
+            });
+        }
+
+        template <typename T, typename Op>
+        inline void binary_lane(T * out, std::size_t out_size, const T * a, const T * b, std::size_t size, std::size_t padded, Op op) noexcept
+        {
+            for_each_output_batch<T>(out_size, size, padded, [&]<typename B>(std::type_identity<B>, std::size_t i)
+            {
+                op(B::load_aligned(a + i), B::load_aligned(b + i)).store_aligned(out + i);
+            });
+        }
+
+        template <size_t N, typename T, typename A, size_t... Is>
+        inline std::array<const T*, N> lanes(const VectorSOA<N, T, A> & v, std::index_sequence<Is...>) noexcept
+        {
+            return { v.data(Is)... };
+        }
+
+        template <size_t N, typename T, typename A, size_t... Is>
+        inline std::array<T*, N> lanes(VectorSOA<N, T, A> & v, std::index_sequence<Is...>) noexcept
+        {
+            return { v.data(Is)... };
+        }
+
+        template <typename B, size_t N, typename T>
+        inline B dot_at(const std::array<const T*, N> & a, const std::array<const T*, N> & b, std::size_t i) noexcept
+        {
+            auto acc = B::load_aligned(a[0] + i) * B::load_aligned(b[0] + i);
+            for (size_t c = 1; c < N; ++c)
+            {
+                acc = fma(B::load_aligned(a[c] + i), B::load_aligned(b[c] + i), acc);
+            }
+            return acc;
+        }
+    }
+
+    // --- Element-wise arithmetic ---
+
+    // out = a + b
+    template <size_t N, typename T, typename Ao, typename Aa, typename Ab>
+    void add(VectorSOA<N, T, Ao> & out, const VectorSOA<N, T, Aa> & a, const VectorSOA<N, T, Ab> & b) noexcept
+    {
+        assert(a.size() == b.size() && out.size() >= a.size());
+        for (size_t c = 0; c < N; ++c)
+        {
+            detail::binary_lane(out.data(c), out.size(), a.data(c), b.data(c), a.size(), a.padded_size(), [](auto x, auto y) { return x + y; });
+        }
+    }
+
+    // out = a - b
+    template <size_t N, typename T, typename Ao, typename Aa, typename Ab>
+    void sub(VectorSOA<N, T, Ao> & out, const VectorSOA<N, T, Aa> & a, const VectorSOA<N, T, Ab> & b) noexcept
+    {
+        assert(a.size() == b.size() && out.size() >= a.size());
+        for (size_t c = 0; c < N; ++c)
+        {
+            detail::binary_lane(out.data(c), out.size(), a.data(c), b.data(c), a.size(), a.padded_size(), [](auto x, auto y) { return x - y; });
+        }
+    }
+
+    // out = a * scalar
+    template <size_t N, typename T, typename Ao, typename Aa, typename U>
+        requires std::is_convertible_v<U, T>
+    void scale(VectorSOA<N, T, Ao> & out, const VectorSOA<N, T, Aa> & a, U scalar) noexcept
+    {
+        assert(out.size() >= a.size());
+        const auto s = static_cast<T>(scalar);
+        for (size_t c = 0; c < N; ++c)
+        {
+            detail::unary_lane(out.data(c), out.size(), a.data(c), a.size(), a.padded_size(), [s]<typename B>(B x) { return x * B::broadcast(s); });
+        }
+    }
+
+    // out = a * scalar + b (e.g. position += velocity * dt)
+    template <size_t N, typename T, typename Ao, typename Aa, typename Ab, typename U>
+        requires std::is_convertible_v<U, T>
+    void fma(VectorSOA<N, T, Ao> & out, const VectorSOA<N, T, Aa> & a, U scalar, const VectorSOA<N, T, Ab> & b) noexcept
+    {
+        assert(a.size() == b.size() && out.size() >= a.size());
+        const auto s = static_cast<T>(scalar);
+        for (size_t c = 0; c < N; ++c)
+        {
+            detail::binary_lane(out.data(c), out.size(), a.data(c), b.data(c), a.size(), a.padded_size(), [s]<typename B>(B x, B y) {
+                return fma(x, B::broadcast(s), y);
+            });
+        }
+    }
+
+    // --- Reductions per element ---
+
+    // out[i] = dot(a[i], b[i])
+    template <size_t N, typename T, typename Aa, typename Ab>
+    void dot(std::span<T> out, const VectorSOA<N, T, Aa> & a, const VectorSOA<N, T, Ab> & b) noexcept
+    {
+        assert(a.size() == b.size() && out.size() >= a.size());
+        const auto la = detail::lanes(a, std::make_index_sequence<N>{});
+        const auto lb = detail::lanes(b, std::make_index_sequence<N>{});
+        simd::for_each_batch<T>(a.size(), [&]<typename B>(std::type_identity<B>, std::size_t i)
+        {
+            detail::dot_at<B, N, T>(la, lb, i).store(out.data() + i);
+        });
+    }
+
+    // out[i] = dot(a[i], a[i])
+    template <size_t N, typename T, typename A>
+    void squared_length(std::span<T> out, const VectorSOA<N, T, A> & a) noexcept
+    {
+        dot(out, a, a);
+    }
+
+    // out[i] = |a[i]|
+    template <size_t N, typename T, typename A>
+        requires std::floating_point<T>
+    void length(std::span<T> out, const VectorSOA<N, T, A> & a) noexcept
+    {
+        assert(out.size() >= a.size());
+        const auto la = detail::lanes(a, std::make_index_sequence<N>{});
+        simd::for_each_batch<T>(a.size(), [&]<typename B>(std::type_identity<B>, std::size_t i)
+        {
+            sqrt(detail::dot_at<B, N, T>(la, la, i)).store(out.data() + i);
+        });
+    }
+
+    // --- Geometric ---
+
+    // out[i] = a[i] / |a[i]|; elements shorter than epsilon are copied unchanged (as VectorView::normalize)
+    template <size_t N, typename T, typename Ao, typename Aa>
+        requires std::floating_point<T>
+    void normalize(VectorSOA<N, T, Ao> & out, const VectorSOA<N, T, Aa> & a) noexcept
+    {
+        assert(out.size() >= a.size());
+        const auto la = detail::lanes(a, std::make_index_sequence<N>{});
+        const auto lo = detail::lanes(out, std::make_index_sequence<N>{});
+        detail::for_each_output_batch<T>(out.size(), a.size(), a.padded_size(), [&]<typename B>(std::type_identity<B>, std::size_t i)
+        {
+            const auto len = sqrt(detail::dot_at<B, N, T>(la, la, i));
+            const auto inv = B::broadcast(static_cast<T>(1)) / len;
+            const auto eps = B::broadcast(epsilon_v<T>);
+
+            std::array<B, N> v;
+            for (size_t c = 0; c < N; ++c)
+            {
+                v[c] = B::load_aligned(la[c] + i);
+            }
+            for (size_t c = 0; c < N; ++c)
+            {
+                select_gt(len, eps, v[c] * inv, v[c]).store_aligned(lo[c] + i);
+            }
+        });
+    }
+
+    template <size_t N, typename T, typename A>
+        requires std::floating_point<T>
+    void normalize(VectorSOA<N, T, A> & inout) noexcept
+    {
+        normalize(inout, inout);
+    }
+
+    // out[i] = cross(a[i], b[i])
+    template <typename T, typename Ao, typename Aa, typename Ab>
+    void cross(VectorSOA<3, T, Ao> & out, const VectorSOA<3, T, Aa> & a, const VectorSOA<3, T, Ab> & b) noexcept
+    {
+        assert(a.size() == b.size() && out.size() >= a.size());
+        const auto la = detail::lanes(a, std::make_index_sequence<3>{});
+        const auto lb = detail::lanes(b, std::make_index_sequence<3>{});
+        const auto lo = detail::lanes(out, std::make_index_sequence<3>{});
+        detail::for_each_output_batch<T>(out.size(), a.size(), a.padded_size(), [&]<typename B>(std::type_identity<B>, std::size_t i)
+        {
+            const auto ax = B::load_aligned(la[0] + i), ay = B::load_aligned(la[1] + i), az = B::load_aligned(la[2] + i);
+            const auto bx = B::load_aligned(lb[0] + i), by = B::load_aligned(lb[1] + i), bz = B::load_aligned(lb[2] + i);
+
+            (ay * bz - az * by).store_aligned(lo[0] + i);
+            (az * bx - ax * bz).store_aligned(lo[1] + i);
+            (ax * by - ay * bx).store_aligned(lo[2] + i);
+        });
+    }
+
+    // out[i] = m * a[i]
+    template <typename T, typename Ao, typename Aa>
+    void transform(VectorSOA<4, T, Ao> & out, const Matrix4x4<T> & m, const VectorSOA<4, T, Aa> & a,
+                   store_mode mode = store_mode::cached) noexcept
+    {
+        assert(out.size() >= a.size());
+        const auto la = detail::lanes(a, std::make_index_sequence<4>{});
+        const auto lo = detail::lanes(out, std::make_index_sequence<4>{});
+        const auto mb = detail::broadcast_matrix<simd::native_batch<T>>(m);
+        const auto ms = detail::broadcast_matrix<simd::scalar_batch<T>>(m);
+        detail::with_store_mode(mode, [&]<bool Stream>(std::bool_constant<Stream>)
+        {
+            detail::for_each_output_batch<T>(out.size(), a.size(), a.padded_size(), [&]<typename B>(std::type_identity<B>, std::size_t i)
+            {
+                const auto & mx = detail::for_batch<B>(mb, ms);
+                const std::array<B, 4> v{
+                    B::load_aligned(la[0] + i), B::load_aligned(la[1] + i), B::load_aligned(la[2] + i), B::load_aligned(la[3] + i)
+                };
+                for (size_t r = 0; r < 4; ++r)
+                {
+                    auto acc = v[0] * mx[0][r];
+                    acc = fma(v[1], mx[1][r], acc);
+                    acc = fma(v[2], mx[2][r], acc);
+                    acc = fma(v[3], mx[3][r], acc);
+                    detail::store_lane<Stream>(acc, lo[r] + i);
+                }
+            });
+        });
+    }
+
+    template <typename T, typename A>
+    void transform(VectorSOA<4, T, A> & inout, const Matrix4x4<T> & m, store_mode mode = store_mode::cached) noexcept
+    {
+        transform(inout, m, inout, mode);
+    }
+
+    // out[i] = (m * (a[i], 1)).xyz, i.e. points under an affine transform (no perspective divide)
+    template <typename T, typename Ao, typename Aa>
+    void transform(VectorSOA<3, T, Ao> & out, const Matrix4x4<T> & m, const VectorSOA<3, T, Aa> & a,
+                   store_mode mode = store_mode::cached) noexcept
+    {
+        assert(out.size() >= a.size());
+        const auto la = detail::lanes(a, std::make_index_sequence<3>{});
+        const auto lo = detail::lanes(out, std::make_index_sequence<3>{});
+        const auto mb = detail::broadcast_matrix<simd::native_batch<T>>(m);
+        const auto ms = detail::broadcast_matrix<simd::scalar_batch<T>>(m);
+        detail::with_store_mode(mode, [&]<bool Stream>(std::bool_constant<Stream>)
+        {
+            detail::for_each_output_batch<T>(out.size(), a.size(), a.padded_size(), [&]<typename B>(std::type_identity<B>, std::size_t i)
+            {
+                const auto & mx = detail::for_batch<B>(mb, ms);
+                const std::array<B, 3> v{ B::load_aligned(la[0] + i), B::load_aligned(la[1] + i), B::load_aligned(la[2] + i) };
+                for (size_t r = 0; r < 3; ++r)
+                {
+                    auto acc = fma(v[0], mx[0][r], mx[3][r]);
+                    acc = fma(v[1], mx[1][r], acc);
+                    acc = fma(v[2], mx[2][r], acc);
+                    detail::store_lane<Stream>(acc, lo[r] + i);
+                }
+            });
+        });
+    }
+
+    template <typename T, typename A>
+    void transform(VectorSOA<3, T, A> & inout, const Matrix4x4<T> & m, store_mode mode = store_mode::cached) noexcept
+    {
+        transform(inout, m, inout, mode);
+    }
+
+    // out[i] = rotate(a[i], q), one rotation for every element
+    template <typename T, typename Ao, typename Aa>
+    void rotate(VectorSOA<3, T, Ao> & out, const Quaternion<T> & q, const VectorSOA<3, T, Aa> & a,
+                store_mode mode = store_mode::cached) noexcept
+    {
+        assert(out.size() >= a.size());
+        const auto la = detail::lanes(a, std::make_index_sequence<3>{});
+        const auto lo = detail::lanes(out, std::make_index_sequence<3>{});
+        const auto qb = detail::broadcast_quaternion<simd::native_batch<T>>(q);
+        const auto qs = detail::broadcast_quaternion<simd::scalar_batch<T>>(q);
+        detail::with_store_mode(mode, [&]<bool Stream>(std::bool_constant<Stream>)
+        {
+            detail::for_each_output_batch<T>(out.size(), a.size(), a.padded_size(), [&]<typename B>(std::type_identity<B>, std::size_t i)
+            {
+                const auto v = detail::rotate_at(detail::for_batch<B>(qb, qs), { B::load_aligned(la[0] + i), B::load_aligned(la[1] + i), B::load_aligned(la[2] + i) });
+                for (size_t c = 0; c < 3; ++c)
+                {
+                    detail::store_lane<Stream>(v[c], lo[c] + i);
+                }
+            });
+        });
+    }
+
+    template <typename T, typename A>
+    void rotate(VectorSOA<3, T, A> & inout, const Quaternion<T> & q, store_mode mode = store_mode::cached) noexcept
+    {
+        rotate(inout, q, inout, mode);
+    }
+
+    // out[i] = rotate(a[i], q[i]); q holds at least a.size() rotations. The quaternions are
+    // transposed into lanes batch by batch, which costs about as much as the rotation itself;
+    // rotations kept as a VectorSOA<4, T> (x, y, z, w) avoid that
+    template <typename T, typename Ao, typename Aa>
+    void rotate(VectorSOA<3, T, Ao> & out, std::span<const Quaternion<T>> q, const VectorSOA<3, T, Aa> & a,
+                store_mode mode = store_mode::cached) noexcept
+    {
+        assert(out.size() >= a.size() && q.size() >= a.size());
+        const auto la = detail::lanes(a, std::make_index_sequence<3>{});
+        const auto lo = detail::lanes(out, std::make_index_sequence<3>{});
+        const auto count = a.size();
+        detail::with_store_mode(mode, [&]<bool Stream>(std::bool_constant<Stream>)
+        {
+            detail::for_each_output_batch<T>(out.size(), a.size(), a.padded_size(), [&]<typename B>(std::type_identity<B>, std::size_t i)
+            {
+                // transpose a batch of quaternions into lanes; the padding past size() gets the identity
+                alignas(64) std::array<std::array<T, B::width>, 4> qs;
+                for (size_t k = 0; k < B::width; ++k)
+                {
+                    const auto rotation = i + k < count ? q[i + k] : Quaternion<T>{ };
+                    qs[0][k] = rotation.x();
+                    qs[1][k] = rotation.y();
+                    qs[2][k] = rotation.z();
+                    qs[3][k] = rotation.w();
+                }
+
+                const std::array<B, 4> qb{
+                    B::load_aligned(qs[0].data()), B::load_aligned(qs[1].data()), B::load_aligned(qs[2].data()), B::load_aligned(qs[3].data())
+                };
+                const auto v = detail::rotate_at(qb, { B::load_aligned(la[0] + i), B::load_aligned(la[1] + i), B::load_aligned(la[2] + i) });
+                for (size_t c = 0; c < 3; ++c)
+                {
+                    detail::store_lane<Stream>(v[c], lo[c] + i);
+                }
+            });
+        });
+    }
+
+    template <typename T, typename A>
+    void rotate(VectorSOA<3, T, A> & inout, std::span<const Quaternion<T>> q, store_mode mode = store_mode::cached) noexcept
+    {
+        rotate(inout, q, inout, mode);
+    }
+
+    // out[i] = rotate(a[i], (q[i].x, q[i].y, q[i].z, q[i].w)); q.size() >= a.size()
+    template <typename T, typename Ao, typename Aq, typename Aa>
+    void rotate(VectorSOA<3, T, Ao> & out, const VectorSOA<4, T, Aq> & q, const VectorSOA<3, T, Aa> & a,
+                store_mode mode = store_mode::cached) noexcept
+    {
+        assert(out.size() >= a.size() && q.size() >= a.size());
+        const auto la = detail::lanes(a, std::make_index_sequence<3>{});
+        const auto lq = detail::lanes(q, std::make_index_sequence<4>{});
+        const auto lo = detail::lanes(out, std::make_index_sequence<3>{});
+        detail::with_store_mode(mode, [&]<bool Stream>(std::bool_constant<Stream>)
+        {
+            // q's padding may hold anything, but its results land in out's padding too
+            detail::for_each_output_batch<T>(out.size(), a.size(), a.padded_size(), [&]<typename B>(std::type_identity<B>, std::size_t i)
+            {
+                const std::array<B, 4> qb{
+                    B::load_aligned(lq[0] + i), B::load_aligned(lq[1] + i), B::load_aligned(lq[2] + i), B::load_aligned(lq[3] + i)
+                };
+                const auto v = detail::rotate_at(qb, { B::load_aligned(la[0] + i), B::load_aligned(la[1] + i), B::load_aligned(la[2] + i) });
+                for (size_t c = 0; c < 3; ++c)
+                {
+                    detail::store_lane<Stream>(v[c], lo[c] + i);
+                }
+            });
+        });
+    }
+
+    template <typename T, typename Aq, typename A>
+    void rotate(VectorSOA<3, T, A> & inout, const VectorSOA<4, T, Aq> & q, store_mode mode = store_mode::cached) noexcept
+    {
+        rotate(inout, q, inout, mode);
+    }
+}
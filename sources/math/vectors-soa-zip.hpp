@@ -0,0 +1,95 @@
+#pragma once
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <tuple>
+
+#include "vectors-soa.hpp"
+
+namespace math
+{
+    // Walks several SoA containers in lockstep, yielding a tuple of their element views.
+    // The zipped length is the smallest container size. Containers may be const (ConstVectorView).
+    template <typename... Containers>
+        requires (sizeof...(Containers) > 0)
+    class ZipView : public std::ranges::view_interface<ZipView<Containers...>>
+    {
+        std::tuple<Containers*...> m_containers{};
+        size_t                     m_size{ 0 };
+
+    public:
+        class iterator
+        {
+        public:
+            using iterator_concept  = std::random_access_iterator_tag;
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type        = std::tuple<decltype(std::declval<Containers&>()[size_t{}])...>;
+            using difference_type   = std::ptrdiff_t;
+            using pointer           = void;
+            using reference         = value_type;
+
+        private:
+            std::tuple<Containers*...> m_containers{};
+            size_t                     m_index{ 0 };
+
+        public:
+            constexpr iterator() noexcept = default;
+
+            constexpr iterator(const std::tuple<Containers*...> & containers, size_t index) noexcept
+                : m_containers(containers)
+                , m_index(index)
+            { }
+
+            [[nodiscard]] constexpr size_t index() const noexcept { return m_index; }
+
+            reference operator*() const { return at(m_index); }
+            reference operator[](difference_type n) const { return at(m_index + n); }
+
+            iterator& operator++() noexcept { ++m_index; return *this; }
+            iterator operator++(int) noexcept { auto tmp = *this; ++m_index; return tmp; }
+            iterator& operator--() noexcept { --m_index; return *this; }
+            iterator operator--(int) noexcept { auto tmp = *this; --m_index; return tmp; }
+
+            iterator& operator+=(difference_type n) noexcept { m_index += n; return *this; }
+            iterator& operator-=(difference_type n) noexcept { m_index -= n; return *this; }
+
+            friend iterator operator+(iterator it, difference_type n) noexcept { return it += n; }
+            friend iterator operator+(difference_type n, iterator it) noexcept { return it += n; }
+            friend iterator operator-(iterator it, difference_type n) noexcept { return it -= n; }
+
+            friend difference_type operator-(const iterator & a, const iterator & b) noexcept
+            {
+                return static_cast<difference_type>(a.m_index) - static_cast<difference_type>(b.m_index);
+            }
+
+            friend bool operator==(const iterator & a, const iterator & b) noexcept { return a.m_index == b.m_index; }
+            friend auto operator<=>(const iterator & a, const iterator & b) noexcept { return a.m_index <=> b.m_index; }
+
+        private:
+            reference at(size_t i) const
+            {
+                return std::apply([i](auto *... containers) { return reference{ (*containers)[i]... }; }, m_containers);
+            }
+        };
+
+        constexpr ZipView() noexcept = default;
+
+        explicit constexpr ZipView(Containers & ... containers) noexcept
+            : m_containers(&containers...)
+            , m_size(std::min({ static_cast<size_t>(containers.size())... }))
+        { }
+
+        [[nodiscard]] iterator begin() const noexcept { return { m_containers, 0 }; }
+        [[nodiscard]] iterator end() const noexcept { return { m_containers, m_size }; }
+        [[nodiscard]] constexpr size_t size() const noexcept { return m_size; }
+    };
+
+    template <typename... Containers>
+    [[nodiscard]] ZipView<Containers...> zip(Containers & ... containers) noexcept
+    {
+        return ZipView<Containers...>(containers...);
+    }
+}
@@ -1,78 +1,142 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <cassert>
+#include <compare>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <span>
+#include <vector>
 
+#include "core/aligned-allocator.hpp"
 #include "core/handle.hpp"
+#include "core/thread-pool.hpp"
+#include "simd.hpp"
 #include "vectors-view.hpp"
 
 namespace math
 {
-    template <size_t N, typename T>
+    template <size_t N, typename T, typename Allocator = AlignedAllocator<T, 64>>
     class VectorSOA
     {
     public:
-        // template <bool IsConst>
-        // struct IteratorImpl
-        // {
-        //     using iterator_category = std::random_access_iterator_tag;
-        //     using value_type        = VectorView<N, T>;
-        //     using difference_type   = std::ptrdiff_t;
-        //     using pointer           = void;
-        //     using reference         = std::conditional_t<IsConst, ConstVectorView<N, T>, VectorView<N, T>>;
-        //     using ContainerPtr      = std::conditional_t<IsConst, const VectorSOA*, VectorSOA*>;
-        //
-        //     size_t index;
-        //     ContainerPtr container;
-        //
-        //     reference operator*() const { return container->operator[](index); }
-        //
-        //     IteratorImpl& operator++() { ++index; return *this; }
-        //     IteratorImpl operator++(int) { IteratorImpl tmp = *this; ++index; return tmp; }
-        //     IteratorImpl& operator--() { --index; return *this; }
-        //
-        //     bool operator==(const IteratorImpl& other) const { return index == other.index; }
-        //     bool operator!=(const IteratorImpl& other) const { return index != other.index; }
-        //
-        //     IteratorImpl operator+(difference_type n) const { return {container, index + n}; }
-        //     difference_type operator-(const IteratorImpl& other) const { return index - other.index; }
-        // };
-        //
-        // using iterator = IteratorImpl<false>;
-        // using const_iterator = IteratorImpl<true>;
-        //
-        // iterator begin() { return {0, this}; }
-        // iterator end() { return {m_size, this}; }
-        //
-        // const_iterator begin() const { return {0, this}; }
-        // const_iterator end() const { return {m_size, this}; }
-        // const_iterator cbegin() const { return {0, this}; }
-        // const_iterator cend() const { return {m_size, this}; }
+        // Random-access iterator over elements; dereferencing yields a VectorView proxy (like
+        // std::vector<bool>), so the legacy category is still random access for parallel algorithms.
+        template <bool IsConst>
+        class IteratorImpl
+        {
+        public:
+            using iterator_concept  = std::random_access_iterator_tag;
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type        = std::conditional_t<IsConst, ConstVectorView<N, T>, VectorView<N, T>>;
+            using difference_type   = std::ptrdiff_t;
+            using pointer           = void;
+            using reference         = value_type;
+            using container_pointer = std::conditional_t<IsConst, const VectorSOA*, VectorSOA*>;
+
+        private:
+            container_pointer m_container{ nullptr };
+            size_t            m_index{ 0 };
+
+            friend class IteratorImpl<!IsConst>;
+
+        public:
+            constexpr IteratorImpl() noexcept = default;
+
+            constexpr IteratorImpl(container_pointer container, size_t index) noexcept
+                : m_container(container)
+                , m_index(index)
+            { }
+
+            constexpr IteratorImpl(const IteratorImpl<!IsConst> & other) noexcept
+                requires (IsConst)
+                : m_container(other.m_container)
+                , m_index(other.m_index)
+            { }
+
+            [[nodiscard]] constexpr size_t index() const noexcept { return m_index; }
+
+            reference operator*() const { return (*m_container)[m_index]; }
+            reference operator[](difference_type n) const { return (*m_container)[m_index + n]; }
+
+            IteratorImpl& operator++() noexcept { ++m_index; return *this; }
+            IteratorImpl operator++(int) noexcept { auto tmp = *this; ++m_index; return tmp; }
+            IteratorImpl& operator--() noexcept { --m_index; return *this; }
+            IteratorImpl operator--(int) noexcept { auto tmp = *this; --m_index; return tmp; }
+
+            IteratorImpl& operator+=(difference_type n) noexcept { m_index += n; return *this; }
+            IteratorImpl& operator-=(difference_type n) noexcept { m_index -= n; return *this; }
+
+            friend IteratorImpl operator+(IteratorImpl it, difference_type n) noexcept { return it += n; }
+            friend IteratorImpl operator+(difference_type n, IteratorImpl it) noexcept { return it += n; }
+            friend IteratorImpl operator-(IteratorImpl it, difference_type n) noexcept { return it -= n; }
+
+            friend difference_type operator-(const IteratorImpl & a, const IteratorImpl & b) noexcept
+            {
+                return static_cast<difference_type>(a.m_index) - static_cast<difference_type>(b.m_index);
+            }
+
+            friend bool operator==(const IteratorImpl & a, const IteratorImpl & b) noexcept { return a.m_index == b.m_index; }
+            friend auto operator<=>(const IteratorImpl & a, const IteratorImpl & b) noexcept { return a.m_index <=> b.m_index; }
+        };
+
+        using iterator = IteratorImpl<false>;
+        using const_iterator = IteratorImpl<true>;
+
+        iterator begin() noexcept { return { this, 0 }; }
+        iterator end() noexcept { return { this, m_size }; }
+
+        const_iterator begin() const noexcept { return { this, 0 }; }
+        const_iterator end() const noexcept { return { this, m_size }; }
+        const_iterator cbegin() const noexcept { return { this, 0 }; }
+        const_iterator cend() const noexcept { return { this, m_size }; }
+
+        // non-owning, copyable std::ranges::view over the current elements
+        [[nodiscard]] std::ranges::subrange<iterator> view() noexcept { return { begin(), end() }; }
+        [[nodiscard]] std::ranges::subrange<const_iterator> view() const noexcept { return { begin(), end() }; }
+
+    public:
+        using allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<T>;
+
+        // every lane starts on a cache line and spans a whole number of cache lines,
+        // so kernels can run full aligned SIMD batches up to padded_size()
+        static constexpr size_t alignment = 64;
+        static constexpr size_t lane_multiple = alignment / sizeof(T);
+
+        static_assert(alignment % sizeof(T) == 0);
+        static_assert(lane_multiple % simd::native_width_v<T> == 0);
 
     private:
+        using allocator_traits = std::allocator_traits<allocator_type>;
+
         std::array<T*, N> m_data{ nullptr };
-        size_t            m_capacity{ 0 };
+        T*                m_block{ nullptr };
+        size_t            m_capacity{ 0 }; // per lane, always a multiple of lane_multiple
         size_t            m_size{ 0 };
         HandleRegister    m_handles;
+        std::vector<uint32_t> m_scratch; // reused by erase_many
+        [[no_unique_address]] allocator_type m_allocator;
 
     public:
         VectorSOA() = default;
 
-        explicit VectorSOA(size_t capacity)
-            : m_capacity(capacity)
+        explicit VectorSOA(const Allocator & allocator)
+            : m_allocator(allocator)
+        { }
+
+        explicit VectorSOA(size_t capacity, const Allocator & allocator = Allocator{})
+            : m_allocator(allocator)
         {
-            for (size_t i = 0; i < N; ++i)
-            {
-                m_data[i] = new T[m_capacity];
-            }
+            reallocate(capacity);
             m_handles.reserve(capacity, capacity);
         }
 
         ~VectorSOA()
         {
-            for (size_t i = 0; i < N; ++i)
-            {
-                delete[] m_data[i];
-            }
+            release();
         }
 
         VectorSOA(const VectorSOA &) = delete;
@@ -80,15 +144,45 @@ namespace math
 
         VectorSOA(VectorSOA && other) noexcept
             : m_data(std::move(other.m_data))
+            , m_block(other.m_block)
             , m_capacity(other.m_capacity)
             , m_size(other.m_size)
             , m_handles(std::move(other.m_handles))
+            , m_scratch(std::move(other.m_scratch))
+            , m_allocator(std::move(other.m_allocator))
         {
             other.m_data.fill(nullptr);
+            other.m_block = nullptr;
             other.m_capacity = 0;
             other.m_size = 0;
         }
 
+        VectorSOA& operator=(VectorSOA && other) noexcept
+            requires (allocator_traits::is_always_equal::value)
+        {
+            if (this != &other)
+            {
+                release();
+                m_data = other.m_data;
+                m_block = other.m_block;
+                m_capacity = other.m_capacity;
+                m_size = other.m_size;
+                m_handles = std::move(other.m_handles);
+                m_scratch = std::move(other.m_scratch);
+
+                other.m_data.fill(nullptr);
+                other.m_block = nullptr;
+                other.m_capacity = 0;
+                other.m_size = 0;
+            }
+            return *this;
+        }
+
+        [[nodiscard]] allocator_type get_allocator() const noexcept
+        {
+            return m_allocator;
+        }
+
         void reserve(size_t capacity)
         {
             if (capacity <= m_capacity)
@@ -100,6 +194,7 @@ namespace math
             m_handles.reserve(capacity, capacity);
         }
 
+        // elements added by resize() carry no handle; shrinking releases the handles of dropped elements
         void resize(size_t size)
         {
             if (size > m_capacity)
@@ -107,21 +202,21 @@ namespace math
                 reallocate(size);
             }
 
-            m_handles.resize(size, size);
+            release_handles(size, m_size);
             m_size = size;
         }
 
         void shrink_to_fit()
         {
-            if (m_size < m_capacity)
+            if (padded(m_size) < m_capacity)
             {
                 reallocate(m_size);
-                m_handles.resize(m_size, m_size);
             }
         }
 
         void clear() noexcept
         {
+            release_handles(0, m_size);
             m_size = 0;
         }
 
@@ -140,6 +235,12 @@ namespace math
             return m_size == 0;
         }
 
+        // size rounded up to lane_multiple; elements in [size(), padded_size()) are valid storage
+        [[nodiscard]] std::size_t padded_size() const noexcept
+        {
+            return padded(m_size);
+        }
+
         VectorView<N, T> operator[](const size_t i)
         {
             return get_view_internal(i, std::make_index_sequence<N>{});
@@ -150,6 +251,41 @@ namespace math
             return get_view_internal(i, std::make_index_sequence<N>{});
         }
 
+        [[nodiscard]] T* data(const size_t component) noexcept
+        {
+            return m_data[component];
+        }
+
+        [[nodiscard]] const T* data(const size_t component) const noexcept
+        {
+            return m_data[component];
+        }
+
+        // Runs fn(begin, end) over contiguous index ranges of at least `grain` elements on `pool`.
+        // Range boundaries are multiples of lane_multiple: no two chunks share a cache line of any lane.
+        template <typename Fn>
+            requires std::invocable<const Fn&, size_t, size_t>
+        void for_each_chunk(Fn && fn, size_t grain = lane_multiple, ThreadPool & pool = ThreadPool::global()) const
+        {
+            pool.parallel_for(m_size, grain, lane_multiple, std::forward<Fn>(fn));
+        }
+
+        [[nodiscard]] const HandleRegister & handles() const noexcept
+        {
+            return m_handles;
+        }
+
+        [[nodiscard]] bool contains(Handle handle) const noexcept
+        {
+            return m_handles.is_valid(handle);
+        }
+
+        // element indices of many handles at once, invalid_index for stale ones
+        void resolve(std::span<const Handle> handles, std::span<uint32_t> out) const noexcept
+        {
+            m_handles.resolve(handles, out);
+        }
+
         template <class... Args>
             requires (sizeof...(Args) == N && (std::is_convertible_v<Args, T> && ...))
         Handle emplace(Args&& ... xs)
@@ -161,24 +297,67 @@ namespace math
 
             const auto index = static_cast<uint32_t>(m_size);
             const auto handle = m_handles.insert(index);
+            if (!handle.is_valid())
+            {
+                return handle;
+            }
 
-            // TODO
+            const std::array<T, N> values{ static_cast<T>(std::forward<Args>(xs))... };
+            for (size_t c = 0; c < N; ++c)
+            {
+                m_data[c][index] = values[c];
+            }
 
             ++m_size;
             return handle;
         }
 
+        // Appends out.size() elements, reading component c of element i from components[c][i],
+        // and writes their handles into `out` in a single register pass.
+        template <class... Spans>
+            requires (sizeof...(Spans) == N && (std::is_convertible_v<const Spans&, std::span<const T>> && ...))
+        void emplace_n(std::span<Handle> out, const Spans & ... components)
+        {
+            const std::array<std::span<const T>, N> lanes{ std::span<const T>(components)... };
+            const auto count = out.size();
+            for (size_t c = 0; c < N; ++c)
+            {
+                assert(lanes[c].size() >= count && "VectorSOA::emplace_n: component span is too short");
+            }
+
+            if (count == 0)
+            {
+                return;
+            }
+
+            if (m_size + count > m_capacity)
+            {
+                reserve(std::max(m_size + count, m_capacity * 2));
+            }
+
+            for (size_t c = 0; c < N; ++c)
+            {
+                std::copy_n(lanes[c].data(), count, m_data[c] + m_size);
+            }
+
+            m_handles.insert(static_cast<uint32_t>(m_size), out);
+            m_size += count;
+        }
+
+        // swap-and-pop: the last element moves into the erased slot
         bool erase(Handle handle) noexcept
         {
-            if (!m_handles.is_valid(h))
+            if (!m_handles.is_valid(handle))
             {
                 return false;
             }
 
-            const uint32_t index_u32 = m_handles.get_index(h);
+            const uint32_t index_u32 = m_handles.get_index(handle);
             const size_t index = static_cast<size_t>(index_u32);
             const size_t last  = m_size - 1;
 
+            m_handles.erase(handle);
+
             if (index != last)
             {
                 // Move last element into the hole.
@@ -188,36 +367,137 @@ namespace math
                 }
 
                 // Retarget moved element's handle from `last` to `index`.
-                Handle moved = m_handles.get_handle(static_cast<uint32_t>(last));
+                const Handle moved = m_handles.get_handle(static_cast<uint32_t>(last));
                 m_handles.update(moved, index_u32);
             }
 
-            m_handles.erase(h);
             --m_size;
             return true;
         }
 
+        // Erases every valid handle in `handles` (invalid and duplicate handles are skipped) with
+        // one register pass and one compaction: surviving tail elements fill the holes in index order.
+        // Returns the number of erased elements.
+        size_t erase_many(std::span<const Handle> handles)
+        {
+            auto & holes = m_scratch;
+            holes.clear();
+            holes.reserve(handles.size() * 2);
+
+            for (const auto handle : handles)
+            {
+                if (m_handles.is_valid(handle))
+                {
+                    holes.push_back(m_handles.get_index(handle));
+                    m_handles.erase(handle);
+                }
+            }
+
+            const auto removed = holes.size();
+            if (removed == 0)
+            {
+                return 0;
+            }
+
+            std::sort(holes.begin(), holes.end());
+
+            const auto new_size = m_size - removed;
+            const auto tail_begin = std::lower_bound(holes.begin(), holes.end(), static_cast<uint32_t>(new_size));
+            const auto moves = static_cast<size_t>(tail_begin - holes.begin());
+
+            // pair each hole below new_size with the next surviving element of the tail
+            auto tail_removed = static_cast<size_t>(tail_begin - holes.begin());
+            auto src = static_cast<uint32_t>(new_size);
+            for (size_t i = 0; i < moves; ++i)
+            {
+                while (tail_removed < removed && holes[tail_removed] == src)
+                {
+                    ++tail_removed;
+                    ++src;
+                }
+                holes.push_back(src++);
+            }
+
+            const auto dst = std::span<const uint32_t>(holes.data(), moves);
+            const auto srcs = std::span<const uint32_t>(holes.data() + removed, moves);
+            for (size_t c = 0; c < N; ++c)
+            {
+                T * lane = m_data[c];
+                for (size_t i = 0; i < moves; ++i)
+                {
+                    lane[dst[i]] = lane[srcs[i]];
+                }
+            }
+
+            for (size_t i = 0; i < moves; ++i)
+            {
+                const Handle moved = m_handles.get_handle(srcs[i]);
+                m_handles.update(moved, dst[i]);
+            }
+
+            m_size = new_size;
+            return removed;
+        }
+
     private:
+        static constexpr size_t padded(size_t count) noexcept
+        {
+            return (count + lane_multiple - 1) / lane_multiple * lane_multiple;
+        }
+
+        // carves all N lanes out of a single block; padding and new slots are zero-filled
         void reallocate(size_t capacity)
         {
+            const auto stride = padded(capacity);
+            const auto kept = std::min(m_size, stride);
+
+            T* block = stride > 0 ? allocator_traits::allocate(m_allocator, stride * N) : nullptr;
+            assert(reinterpret_cast<std::uintptr_t>(block) % alignment == 0 && "VectorSOA: allocator must return 64-byte aligned storage");
+
             for (size_t i = 0; i < N; ++i)
             {
-                T* new_buffer = (capacity > 0) ? new T[capacity] : nullptr;
-                if (m_size > 0 && m_data[i])
+                T* lane = block + i * stride;
+                if (kept > 0)
                 {
-                    std::copy_n(m_data[i], std::min(m_size, capacity), new_buffer);
-                    delete[] m_data[i];
+                    std::copy_n(m_data[i], kept, lane);
                 }
-                m_data[i] = new_buffer;
+                std::fill(lane + kept, lane + stride, T{});
+                m_data[i] = (stride > 0) ? lane : nullptr;
+            }
+
+            release();
+            m_block = block;
+            m_capacity = stride;
+            m_size = kept;
+        }
+
+        void release_handles(size_t first, size_t last) noexcept
+        {
+            for (size_t i = first; i < last; ++i)
+            {
+                m_handles.erase(m_handles.get_handle(static_cast<uint32_t>(i)));
+            }
+        }
+
+        void release() noexcept
+        {
+            if (m_block)
+            {
+                allocator_traits::deallocate(m_allocator, m_block, m_capacity * N);
+                m_block = nullptr;
             }
-            m_capacity = capacity;
-            if (m_size > m_capacity) m_size = m_capacity;
         }
 
         template <size_t... Is>
         VectorView<N, T> get_view_internal(size_t i, std::index_sequence<Is...>)
         {
-            return VectorView<N, T>(m_data[Is][i]...);
+            return VectorView<N, T>((m_data[Is] + i)...);
+        }
+
+        template <size_t... Is>
+        ConstVectorView<N, T> get_view_internal(size_t i, std::index_sequence<Is...>) const
+        {
+            return ConstVectorView<N, T>(static_cast<const T*>(m_data[Is] + i)...);
         }
     };
 }
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "core/value.hpp"
+#include "vectors-soa.hpp"
+#include "vectors.hpp"
+
+namespace math
+{
+    // Conversions between math containers and Value typed arrays. Each one is a single copy of
+    // contiguous items, so a Vector or a whole VectorSOA component moves in and out of a Value
+    // (and from there through JSON or the binary formats) without a Value per item.
+
+    template <size_t N, typename T>
+        requires is_typed_array_v<std::vector<T>>
+    [[nodiscard]] Value to_value(const Vector<N, T> & vector)
+    {
+        return Value{ std::vector<T>(vector.data(), vector.data() + N) };
+    }
+
+    // false, leaving `out` untouched, unless `value` is a T typed array of exactly N items
+    template <size_t N, typename T>
+        requires is_typed_array_v<std::vector<T>>
+    bool from_value(const Value & value, Vector<N, T> & out)
+    {
+        if (!value.is<std::vector<T>>() || value.as<std::vector<T>>().size() != N)
+        {
+            return false;
+        }
+        std::copy_n(value.as<std::vector<T>>().data(), N, out.data());
+        return true;
+    }
+
+    // one component of every element, as a T typed array of size() items
+    template <size_t N, typename T, typename Allocator>
+        requires is_typed_array_v<std::vector<T>>
+    [[nodiscard]] Value column_to_value(const VectorSOA<N, T, Allocator> & soa, size_t component)
+    {
+        const auto * lane = soa.data(component);
+        return Value{ std::vector<T>(lane, lane + soa.size()) };
+    }
+
+    // overwrites one component of every element; false, leaving `soa` untouched, unless `value`
+    // is a T typed array of exactly size() items
+    template <size_t N, typename T, typename Allocator>
+        requires is_typed_array_v<std::vector<T>>
+    bool column_from_value(VectorSOA<N, T, Allocator> & soa, size_t component, const Value & value)
+    {
+        if (!value.is<std::vector<T>>() || value.as<std::vector<T>>().size() != soa.size())
+        {
+            return false;
+        }
+        std::copy_n(value.as<std::vector<T>>().data(), soa.size(), soa.data(component));
+        return true;
+    }
+
+    // all N components, as an array of N typed arrays
+    template <size_t N, typename T, typename Allocator>
+        requires is_typed_array_v<std::vector<T>>
+    [[nodiscard]] Value columns_to_value(const VectorSOA<N, T, Allocator> & soa)
+    {
+        auto columns = Value::array_t{ };
+        columns.reserve(N);
+        for (size_t c = 0; c < N; ++c)
+        {
+            columns.push_back(column_to_value(soa, c));
+        }
+        return Value{ std::move(columns) };
+    }
+
+    // resizes `soa` to the column length and fills every component; false, leaving `soa`
+    // untouched, unless `value` is an array of N T typed arrays of one length. Elements added by
+    // the resize carry no handle, as with VectorSOA::resize.
+    template <size_t N, typename T, typename Allocator>
+        requires is_typed_array_v<std::vector<T>>
+    bool columns_from_value(const Value & value, VectorSOA<N, T, Allocator> & soa)
+    {
+        if (!value.is<Value::array_t>() || value.as<Value::array_t>().size() != N)
+        {
+            return false;
+        }
+
+        const auto & columns = value.as<Value::array_t>();
+        for (const auto & column : columns)
+        {
+            if (!column.is<std::vector<T>>()
+                || column.as<std::vector<T>>().size() != columns.front().as<std::vector<T>>().size())
+            {
+                return false;
+            }
+        }
+
+        soa.resize(columns.front().as<std::vector<T>>().size());
+        for (size_t c = 0; c < N; ++c)
+        {
+            const auto & items = columns[c].as<std::vector<T>>();
+            std::copy_n(items.data(), items.size(), soa.data(c));
+        }
+        return true;
+    }
+}
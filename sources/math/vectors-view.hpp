@@ -62,9 +62,9 @@ namespace math
 
         // --- Helpers ---
 
-        [[nodiscard]] constexpr Vector<N, T> as_vector() const
+        [[nodiscard]] constexpr Vector<N, std::remove_const_t<T>> as_vector() const
         {
-            Vector<N, T> out{};
+            Vector<N, std::remove_const_t<T>> out{};
             for (std::size_t i = 0; i < N; ++i)
             {
                 out[i] = *(m_data[i]);
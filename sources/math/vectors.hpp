@@ -9,6 +9,7 @@
 #include <functional>
 
 #include "constants.hpp"
+#include "simd4.hpp"
 
 namespace math
 {
@@ -240,13 +241,34 @@ namespace math
 
         // --- Basic Arithmetic ---
 
+        // 4-wide float and double go through simd4 at run time; constant evaluation and every
+        // other shape use the generic transform
+
         [[nodiscard]] constexpr Vector<N, T> operator+(const Vector<N, T> & other) const noexcept
         {
+            if constexpr (simd4::enabled_v<N, T>)
+            {
+                if (!std::is_constant_evaluated())
+                {
+                    Vector<N, T> out;
+                    simd4::kernels<T>::add(data(), other.data(), out.data());
+                    return out;
+                }
+            }
             return transform(other, std::plus<T>{});
         }
 
         [[nodiscard]] constexpr Vector<N, T> operator-(const Vector<N, T> & other) const noexcept
         {
+            if constexpr (simd4::enabled_v<N, T>)
+            {
+                if (!std::is_constant_evaluated())
+                {
+                    Vector<N, T> out;
+                    simd4::kernels<T>::sub(data(), other.data(), out.data());
+                    return out;
+                }
+            }
             return transform(other, std::minus<T>{});
         }
 
@@ -255,6 +277,15 @@ namespace math
         [[nodiscard]] constexpr Vector<N, T> operator*(U scalar) const noexcept
         {
             const auto s = static_cast<T>(scalar);
+            if constexpr (simd4::enabled_v<N, T>)
+            {
+                if (!std::is_constant_evaluated())
+                {
+                    Vector<N, T> out;
+                    simd4::kernels<T>::scale(data(), s, out.data());
+                    return out;
+                }
+            }
             return transform([s](T val) { return val * s; });
         }
 
@@ -278,6 +309,14 @@ namespace math
 
         [[nodiscard]] constexpr T dot(const Vector<N, T> & other) const noexcept
         {
+            if constexpr (simd4::enabled_v<N, T>)
+            {
+                if (!std::is_constant_evaluated())
+                {
+                    return simd4::kernels<T>::dot(data(), other.data());
+                }
+            }
+
             if constexpr (N <= K_UNROLL_THRESHOLD)
             {
                 return dot_impl(other, std::make_index_sequence<N>{});
@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+
+#include <memory_resource>
+#include <string>
+
+#include "core/arena-value.hpp"
+
+static_assert(sizeof(ArenaValue) == 16);
+static_assert(std::is_trivially_destructible_v<ArenaValue>);
+
+namespace {
+
+// forwards to new/delete and counts the calls
+class CountingResource : public std::pmr::memory_resource {
+public:
+    size_t allocations = 0;
+    size_t deallocations = 0;
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        ++allocations;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+        ++deallocations;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+    bool do_is_equal(const memory_resource& other) const noexcept override { return this == &other; }
+};
+
+std::string make_records(size_t count) {
+    std::string json = "[";
+    for (size_t i = 0; i < count; ++i) {
+        json += (i ? "," : "");
+        json += "{\"id\":" + std::to_string(i) + ",\"name\":\"item " + std::to_string(i) + "\",\"tags\":[\"a\",\"b\"]}";
+    }
+    return json + "]";
+}
+
+} // namespace
+
+TEST(ArenaDocumentTest, ParsesEveryKindOfValue) {
+    ArenaDocument document;
+    ASSERT_TRUE(document.parse(R"({"int": -42, "big": 123456789012345678901, "real": 2.5e1,
+                                   "text": "tab\there \"q\"", "none": null, "list": [1, [], {}]})"))
+        << document.error();
+
+    const auto& root = document.root();
+    ASSERT_EQ(root.type(), ArenaValue::Type::Object);
+    EXPECT_EQ(root.size(), 6u);
+
+    EXPECT_EQ(root.find("int")->type(), ArenaValue::Type::Int);
+    EXPECT_EQ(root.find("int")->as_int(), -42);
+    EXPECT_EQ(root.find("big")->type(), ArenaValue::Type::Double);
+    EXPECT_DOUBLE_EQ(root.find("big")->as_double(), 123456789012345678901.0);
+    EXPECT_DOUBLE_EQ(root.find("real")->as_double(), 25.0);
+    EXPECT_EQ(root.find("text")->as_string(), "tab\there \"q\"");
+    EXPECT_TRUE(root.find("none")->is_null());
+    EXPECT_EQ(root.find("missing"), nullptr);
+
+    const auto& list = *root.find("list");
+    ASSERT_EQ(list.items().size(), 3u);
+    EXPECT_EQ(list[0].as_int(), 1);
+    EXPECT_EQ(list[1].type(), ArenaValue::Type::Array);
+    EXPECT_EQ(list[2].type(), ArenaValue::Type::Object);
+    EXPECT_THROW((void)list[3], std::invalid_argument);
+
+    // members keep document order
+    EXPECT_EQ(root.members().front().key, "int");
+    EXPECT_EQ(root.members().back().key, "list");
+}
+
+TEST(ArenaDocumentTest, KeysAreInternedAcrossObjects) {
+    ArenaDocument document;
+    ASSERT_TRUE(document.parse(make_records(100)));
+
+    EXPECT_EQ(document.key_count(), 3u);
+    const auto& first = document.root()[0].members();
+    const auto& last = document.root()[99].members();
+    for (size_t i = 0; i < first.size(); ++i) {
+        EXPECT_EQ(first[i].key.data(), last[i].key.data());
+    }
+    EXPECT_EQ(document.intern("name").data(), first[1].key.data());
+}
+
+TEST(ArenaDocumentTest, ParsingAllocatesInBulk) {
+    CountingResource upstream;
+    {
+        ArenaDocument document{ &upstream };
+        ASSERT_TRUE(document.parse(make_records(5000)));
+        EXPECT_EQ(document.root().size(), 5000u);
+
+        // the arena grows geometrically from the input size: a handful of blocks for ~35k nodes
+        EXPECT_LE(upstream.allocations, 8u);
+    }
+    EXPECT_EQ(upstream.deallocations, upstream.allocations);
+}
+
+TEST(ArenaDocumentTest, ConvertsToValue) {
+    ArenaDocument document;
+    ASSERT_TRUE(document.parse(R"({"a": [1, 2.5, "x", null], "b": {"c": 3}})"));
+
+    const auto value = document.root().to_value();
+    const auto& object = value.as<Value::object_t>();
+    const auto& a = object.at("a").as<Value::array_t>();
+    ASSERT_EQ(a.size(), 4u);
+    EXPECT_EQ(a[0].as<int64_t>(), 1);
+    EXPECT_DOUBLE_EQ(a[1].as<double>(), 2.5);
+    EXPECT_EQ(a[2].as<std::string>(), "x");
+    EXPECT_TRUE(a[3].empty());
+    EXPECT_EQ(object.at("b").as<Value::object_t>().at("c").as<int64_t>(), 3);
+}
+
+TEST(ArenaDocumentTest, RejectsInvalidDocuments) {
+    ArenaDocument document;
+    EXPECT_FALSE(document.parse("[1, 2"));
+    EXPECT_TRUE(document.root().is_null());
+    EXPECT_FALSE(document.error().empty());
+
+    EXPECT_FALSE(document.parse("[1] [2]"));
+    EXPECT_EQ(document.error(), "more than one top-level value");
+
+    // a later parse recovers
+    EXPECT_TRUE(document.parse("[]"));
+    EXPECT_TRUE(document.error().empty());
+}
+
+TEST(ArenaDocumentTest, MovingKeepsValuesValid) {
+    ArenaDocument document;
+    ASSERT_TRUE(document.parse(R"({"key": "value"})"));
+    const auto* value = document.root().find("key");
+
+    ArenaDocument moved = std::move(document);
+    EXPECT_EQ(moved.root().find("key"), value);
+    EXPECT_EQ(value->as_string(), "value");
+}
@@ -0,0 +1,170 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/channel.hpp"
+#include "core/value.hpp"
+#include "math/vectors.hpp"
+
+TEST(SpscChannelTest, RoundsCapacityAndRejectsZero) {
+    SpscChannel<int> channel(5);
+    EXPECT_EQ(channel.capacity(), 8u);
+    EXPECT_THROW(SpscChannel<int>(0), std::invalid_argument);
+}
+
+TEST(SpscChannelTest, PushPopPreservesOrderAndReportsFull) {
+    SpscChannel<int> channel(4);
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(channel.try_push(i));
+    }
+    EXPECT_FALSE(channel.try_push(4));
+    EXPECT_EQ(channel.size(), 4u);
+
+    int out = -1;
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(channel.try_pop(out));
+        EXPECT_EQ(out, i);
+    }
+    EXPECT_FALSE(channel.try_pop(out));
+}
+
+TEST(SpscChannelTest, BatchOperationsWrapAround) {
+    SpscChannel<int> channel(8);
+    std::vector<int> in{ 0, 1, 2, 3, 4, 5 };
+    std::vector<int> out(6, -1);
+
+    EXPECT_EQ(channel.push_n(in), 6u);
+    EXPECT_EQ(channel.pop_n(std::span<int>(out).first(4)), 4u);
+
+    // 2 left, 6 free: only 6 of the next 8 fit, crossing the end of the ring
+    std::vector<int> more{ 6, 7, 8, 9, 10, 11, 12, 13 };
+    EXPECT_EQ(channel.push_n(more), 6u);
+
+    std::vector<int> drained(16, -1);
+    ASSERT_EQ(channel.pop_n(drained), 8u);
+    for (int i = 0; i < 8; ++i) {
+        EXPECT_EQ(drained[i], i + 4);
+    }
+}
+
+TEST(SpscChannelTest, CarriesVectorsAndValues) {
+    SpscChannel<math::Vector3f> vectors(4);
+    EXPECT_TRUE(vectors.try_push(math::Vector3f{ 1.0f, 2.0f, 3.0f }));
+    math::Vector3f v;
+    ASSERT_TRUE(vectors.try_pop(v));
+    EXPECT_FLOAT_EQ(v[2], 3.0f);
+
+    SpscChannel<Value> values(4);
+    EXPECT_TRUE(values.try_push(Value{ std::string("hello") }));
+    Value message;
+    ASSERT_TRUE(values.try_pop(message));
+    EXPECT_EQ(message.as<std::string>(), "hello");
+}
+
+TEST(SpscChannelTest, ConcurrentStreamArrivesInOrder) {
+    constexpr int count = 200000;
+    SpscChannel<int> channel(64);
+
+    std::thread producer([&] {
+        for (int i = 0; i < count; ++i) {
+            while (!channel.try_push(i)) std::this_thread::yield();
+        }
+        channel.close();
+    });
+
+    int expected = 0;
+    int value = 0;
+    bool ordered = true;
+    while (channel.pop_wait(value)) {
+        ordered = ordered && value == expected;
+        ++expected;
+    }
+    producer.join();
+
+    EXPECT_TRUE(ordered);
+    EXPECT_EQ(expected, count);
+}
+
+TEST(SpscChannelTest, CloseWakesBlockedConsumer) {
+    SpscChannel<int> channel(4);
+    std::atomic<bool> returned{ false };
+    std::thread consumer([&] {
+        int value;
+        EXPECT_FALSE(channel.pop_wait(value));
+        returned = true;
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_FALSE(returned.load());
+    channel.close();
+    consumer.join();
+    EXPECT_TRUE(returned.load());
+}
+
+TEST(MpmcChannelTest, PushPopAndFull) {
+    MpmcChannel<int> channel(2);
+    EXPECT_TRUE(channel.try_push(1));
+    EXPECT_TRUE(channel.try_push(2));
+    EXPECT_FALSE(channel.try_push(3));
+
+    int out = 0;
+    ASSERT_TRUE(channel.try_pop(out));
+    EXPECT_EQ(out, 1);
+    EXPECT_TRUE(channel.try_push(3));
+
+    std::vector<int> drained(4, 0);
+    EXPECT_EQ(channel.pop_n(drained), 2u);
+    EXPECT_EQ(drained[0], 2);
+    EXPECT_EQ(drained[1], 3);
+}
+
+TEST(MpmcChannelTest, ManyProducersAndConsumersDeliverEverythingOnce) {
+    constexpr int producers = 3;
+    constexpr int consumers = 3;
+    constexpr int perProducer = 50000;
+    MpmcChannel<int> channel(128);
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p] {
+            std::vector<int> batch;
+            for (int i = 0; i < perProducer; ++i) {
+                batch.push_back(p * perProducer + i);
+                if (batch.size() == 16 || i + 1 == perProducer) {
+                    std::span<const int> rest(batch);
+                    while (!rest.empty()) {
+                        rest = rest.subspan(channel.push_n(rest));
+                        if (!rest.empty()) std::this_thread::yield();
+                    }
+                    batch.clear();
+                }
+            }
+        });
+    }
+
+    std::vector<std::vector<int>> received(consumers);
+    for (int c = 0; c < consumers; ++c) {
+        threads.emplace_back([&, c] {
+            int value;
+            while (channel.pop_wait(value)) received[c].push_back(value);
+        });
+    }
+
+    for (int p = 0; p < producers; ++p) threads[p].join();
+    channel.close();
+    for (int c = 0; c < consumers; ++c) threads[producers + c].join();
+
+    std::vector<int> all;
+    for (auto& r : received) all.insert(all.end(), r.begin(), r.end());
+    std::sort(all.begin(), all.end());
+    ASSERT_EQ(all.size(), static_cast<size_t>(producers * perProducer));
+    for (size_t i = 0; i < all.size(); ++i) {
+        ASSERT_EQ(all[i], static_cast<int>(i));
+    }
+}
@@ -0,0 +1,179 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "core/concurrent-handle.hpp"
+
+TEST(ConcurrentHandleRegisterTest, InsertMapsToIndex) {
+    ConcurrentHandleRegister reg(16);
+
+    Handle a = reg.insert(7);
+    Handle b = reg.insert(9);
+
+    EXPECT_TRUE(reg.is_valid(a));
+    EXPECT_TRUE(reg.is_valid(b));
+    EXPECT_NE(a.id, b.id);
+    EXPECT_EQ(reg.get_index(a), 7u);
+    EXPECT_EQ(reg.get_index(b), 9u);
+}
+
+TEST(ConcurrentHandleRegisterTest, EraseInvalidatesAndReuseBumpsGeneration) {
+    ConcurrentHandleRegister reg(4);
+
+    Handle h = reg.insert(1);
+    reg.erase(h);
+    EXPECT_FALSE(reg.is_valid(h));
+    EXPECT_EQ(reg.get_index(h), ConcurrentHandleRegister::invalid_index);
+
+    Handle again = reg.insert(2);
+    EXPECT_EQ(again.id, h.id);
+    EXPECT_EQ(again.generation, h.generation + 1u);
+    EXPECT_FALSE(reg.is_valid(h));
+    EXPECT_EQ(reg.get_index(again), 2u);
+
+    // a stale erase must not touch the new owner of the id
+    reg.erase(h);
+    EXPECT_TRUE(reg.is_valid(again));
+}
+
+TEST(ConcurrentHandleRegisterTest, UpdateMovesLiveHandlesOnly) {
+    ConcurrentHandleRegister reg(4);
+
+    Handle h = reg.insert(3);
+    EXPECT_TRUE(reg.update(h, 5));
+    EXPECT_EQ(reg.get_index(h), 5u);
+
+    reg.erase(h);
+    EXPECT_FALSE(reg.update(h, 6));
+    EXPECT_FALSE(reg.update(Handle{}, 6));
+}
+
+TEST(ConcurrentHandleRegisterTest, ReturnsInvalidHandleWhenExhausted) {
+    ConcurrentHandleRegister reg(2);
+
+    Handle a = reg.insert(0);
+    Handle b = reg.insert(1);
+    EXPECT_FALSE(reg.insert(2).is_valid());
+
+    reg.erase(a);
+    Handle c = reg.insert(2);
+    EXPECT_TRUE(c.is_valid());
+    EXPECT_TRUE(reg.is_valid(b));
+}
+
+TEST(ConcurrentHandleRegisterTest, IgnoresOutOfRangeHandles) {
+    ConcurrentHandleRegister reg(2);
+
+    EXPECT_FALSE(reg.is_valid(Handle{}));
+    EXPECT_FALSE(reg.is_valid(Handle{ 5, 0 }));
+    reg.erase(Handle{ 5, 0 });
+    EXPECT_FALSE(reg.insert(ConcurrentHandleRegister::invalid_index).is_valid());
+}
+
+TEST(ConcurrentHandleRegisterTest, RejectsCapacityOutOfRange) {
+    EXPECT_THROW(ConcurrentHandleRegister(static_cast<std::size_t>(Handle::invalid_id)), std::invalid_argument);
+}
+
+TEST(ConcurrentHandleRegisterTest, ConcurrentChurnKeepsIdsUnique) {
+    constexpr std::size_t threadCount = 4;
+    constexpr std::size_t rounds = 2000;
+    constexpr std::size_t batch = 16;
+
+    ConcurrentHandleRegister reg(threadCount * batch);
+
+    std::atomic<bool> failed{ false };
+    std::vector<std::vector<Handle>> kept(threadCount);
+    std::vector<std::thread> threads;
+
+    for (std::size_t t = 0; t < threadCount; ++t)
+    {
+        threads.emplace_back([&, t] {
+            std::vector<Handle> live;
+            for (std::size_t r = 0; r < rounds; ++r)
+            {
+                for (std::size_t i = 0; i < batch; ++i)
+                {
+                    const auto index = static_cast<uint32_t>(t * batch + i);
+                    const Handle h = reg.insert(index);
+                    if (!h.is_valid() || reg.get_index(h) != index)
+                    {
+                        failed = true;
+                    }
+                    live.push_back(h);
+                }
+
+                // keep the last round alive, release everything else
+                if (r + 1 < rounds)
+                {
+                    for (const auto & h : live)
+                    {
+                        reg.erase(h);
+                        if (reg.is_valid(h))
+                        {
+                            failed = true;
+                        }
+                    }
+                    live.clear();
+                }
+            }
+            kept[t] = std::move(live);
+        });
+    }
+
+    for (auto & thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_FALSE(failed.load());
+
+    std::vector<uint32_t> ids;
+    for (std::size_t t = 0; t < threadCount; ++t)
+    {
+        for (std::size_t i = 0; i < kept[t].size(); ++i)
+        {
+            EXPECT_EQ(reg.get_index(kept[t][i]), static_cast<uint32_t>(t * batch + i));
+            ids.push_back(kept[t][i].id);
+        }
+    }
+
+    std::sort(ids.begin(), ids.end());
+    EXPECT_EQ(std::adjacent_find(ids.begin(), ids.end()), ids.end());
+    EXPECT_EQ(ids.size(), threadCount * batch);
+}
+
+TEST(ConcurrentHandleRegisterTest, ReadersNeverSeeStaleHandlesAsValid) {
+    ConcurrentHandleRegister reg(64);
+
+    std::atomic<bool> stop{ false };
+    std::atomic<bool> failed{ false };
+
+    // the reader keeps resolving one handle it knows to be stale
+    Handle stale = reg.insert(0);
+    reg.erase(stale);
+
+    std::thread reader([&] {
+        while (!stop.load(std::memory_order_relaxed))
+        {
+            if (reg.is_valid(stale))
+            {
+                failed = true;
+            }
+        }
+    });
+
+    for (int i = 0; i < 20000; ++i)
+    {
+        const Handle h = reg.insert(static_cast<uint32_t>(i % 64));
+        reg.erase(h);
+    }
+
+    stop = true;
+    reader.join();
+    EXPECT_FALSE(failed.load());
+}
@@ -3,6 +3,7 @@
 #include <cstdint>
 #include <limits>
 #include <random>
+#include <stdexcept>
 #include <unordered_map>
 #include <vector>
 
@@ -134,6 +135,167 @@ TEST_F(HandleRegisterTest, StaleGenerationIsInvalid) {
     ExpectValid(reg, h, 7u);
 }
 
+TEST_F(HandleRegisterTest, BatchInsertMapsConsecutiveIndices) {
+    std::vector<Handle> out(8);
+    reg.insert(100, out);
+
+    for (uint32_t i = 0; i < out.size(); ++i) {
+        ExpectValid(reg, out[i], 100u + i);
+        EXPECT_EQ(reg.get_handle(100u + i).id, out[i].id);
+    }
+}
+
+TEST_F(HandleRegisterTest, BatchInsertSkipsAlreadyMappedIndices) {
+    Handle existing = reg.insert(3);
+
+    std::vector<Handle> out(4);
+    reg.insert(2, out);
+
+    ExpectValid(reg, out[0], 2u);
+    EXPECT_FALSE(out[1].is_valid());
+    ExpectValid(reg, out[2], 4u);
+    ExpectValid(reg, out[3], 5u);
+    ExpectValid(reg, existing, 3u);
+}
+
+TEST_F(HandleRegisterTest, GetHandleFollowsUpdateAndErase) {
+    Handle h = reg.insert(4);
+    EXPECT_EQ(reg.get_handle(4).id, h.id);
+    EXPECT_EQ(reg.get_handle(4).generation, h.generation);
+
+    ASSERT_TRUE(reg.update(h, 8));
+    EXPECT_FALSE(reg.get_handle(4).is_valid());
+    EXPECT_EQ(reg.get_handle(8).id, h.id);
+
+    reg.erase(h);
+    EXPECT_FALSE(reg.get_handle(8).is_valid());
+    EXPECT_FALSE(reg.get_handle(5000).is_valid());
+}
+
+TEST_F(HandleRegisterTest, ResolveMatchesGetIndex) {
+    std::vector<Handle> handles;
+    for (uint32_t i = 0; i < 40; ++i) {
+        handles.push_back(reg.insert(i * 3));
+    }
+    reg.erase(handles[5]);
+    handles.push_back(Handle{});
+    handles.push_back(Handle{ 900, 0 });
+
+    std::vector<uint32_t> out(handles.size(), 0);
+    reg.resolve(handles, out);
+
+    for (size_t i = 0; i < handles.size(); ++i) {
+        EXPECT_EQ(out[i], reg.get_index(handles[i]));
+    }
+    EXPECT_EQ(out[5], HandleRegister::invalid_index);
+    EXPECT_EQ(out[6], 18u);
+}
+
+TEST_F(HandleRegisterTest, ShrinkingIndexCapacityInvalidatesTruncatedMappings) {
+    Handle low = reg.insert(2);
+    Handle high = reg.insert(900);
+
+    reg.resize(16, 10);
+
+    ExpectValid(reg, low, 2u);
+    EXPECT_FALSE(reg.is_valid(high));
+    EXPECT_EQ(reg.get_index(high), HandleRegister::invalid_index);
+}
+
+TEST_F(HandleRegisterTest, ChurnReusesIdsWithoutGrowing) {
+    std::vector<Handle> live(16);
+    reg.insert(0, live);
+    const auto capacity = reg.handle_capacity();
+
+    for (int round = 0; round < 10000; ++round) {
+        const auto slot = static_cast<size_t>(round) % live.size();
+        const auto index = reg.get_index(live[slot]);
+        reg.erase(live[slot]);
+        live[slot] = reg.insert(index);
+        ASSERT_TRUE(reg.is_valid(live[slot]));
+    }
+
+    EXPECT_EQ(reg.handle_capacity(), capacity);
+    for (size_t i = 0; i < live.size(); ++i) {
+        ExpectValid(reg, live[i], static_cast<uint32_t>(i));
+    }
+}
+
+TEST_F(HandleRegisterTest, FreedIdsAreReusedMostRecentFirst) {
+    Handle a = reg.insert(0);
+    Handle b = reg.insert(1);
+    reg.erase(a);
+    reg.erase(b);
+
+    EXPECT_EQ(reg.insert(2).id, b.id);
+    EXPECT_EQ(reg.insert(3).id, a.id);
+}
+
+TEST_F(HandleRegisterTest, ResizeNeverHandsOutLiveIds) {
+    std::vector<Handle> live(8);
+    reg.insert(0, live);
+
+    // growing used to seed the free list with zeros, reissuing id 0
+    reg.resize(64, 64);
+
+    std::vector<Handle> more(8);
+    reg.insert(8, more);
+    for (const Handle & h : more) {
+        for (const Handle & other : live) {
+            EXPECT_NE(h.id, other.id);
+        }
+    }
+    for (size_t i = 0; i < live.size(); ++i) {
+        ExpectValid(reg, live[i], static_cast<uint32_t>(i));
+    }
+}
+
+TEST_F(HandleRegisterTest, ShrinkingHandleCapacityDropsTruncatedIds) {
+    std::vector<Handle> live(8);
+    reg.insert(0, live);
+
+    reg.resize(4, 64);
+
+    for (size_t i = 0; i < live.size(); ++i) {
+        EXPECT_EQ(reg.is_valid(live[i]), live[i].id < 4);
+    }
+    EXPECT_FALSE(reg.get_handle(6).is_valid());
+
+    // the freed index can be mapped again
+    ExpectValid(reg, reg.insert(6), 6u);
+}
+
+TEST_F(HandleRegisterTest, IndicesBeyondMaxCapacityAreRejected) {
+    EXPECT_THROW((void)reg.insert(HandleRegister::max_capacity), std::invalid_argument);
+    EXPECT_THROW(reg.resize(HandleRegister::max_capacity + size_t{ 1 }, 0), std::invalid_argument);
+
+    Handle h = reg.insert(1);
+    EXPECT_FALSE(reg.update(h, HandleRegister::invalid_index));
+    ExpectValid(reg, h, 1u);
+}
+
+TEST_F(HandleRegisterTest, ForgedHandleToFreeSlotIsInvalid) {
+    Handle h = reg.insert(1);
+    reg.erase(h);
+
+    // matches the generation the slot will hand out next, yet the slot is free
+    Handle forged{ h.id, h.generation + 1u };
+    EXPECT_FALSE(reg.is_valid(forged));
+    EXPECT_EQ(reg.get_index(forged), HandleRegister::invalid_index);
+}
+
+TEST_F(HandleRegisterTest, MovedFromRegisterIsEmptyAndReusable) {
+    Handle h = reg.insert(1);
+    reg.erase(reg.insert(2));
+
+    HandleRegister moved(std::move(reg));
+    ExpectValid(moved, h, 1u);
+
+    Handle fresh = reg.insert(5);
+    ExpectValid(reg, fresh, 5u);
+    EXPECT_EQ(fresh.id, 0u);
+}
+
 TEST_F(HandleRegisterTest, RandomizedOperationsMaintainConsistency) {
     std::mt19937 rng(0xC0FFEEu);
     std::uniform_int_distribution<int> opDist(0, 2); // 0 insert, 1 update, 2 erase
@@ -143,18 +305,23 @@ TEST_F(HandleRegisterTest, RandomizedOperationsMaintainConsistency) {
     handles.reserve(2000);
 
     std::unordered_map<uint32_t, AliveInfo> aliveById; // id -> {index, generation}
+    std::unordered_map<uint32_t, uint32_t> idByIndex;  // occupied index -> id
+
+    auto isAlive = [&](Handle h) {
+        auto it = aliveById.find(h.id);
+        return it != aliveById.end() && it->second.generation == h.generation;
+    };
 
     auto checkAllAlive = [&] {
         for (const Handle& h : handles) {
             if (!h.is_valid()) continue;
 
-            auto it = aliveById.find(h.id);
-            const bool shouldBeAlive = (it != aliveById.end() && it->second.generation == h.generation);
-
+            const bool shouldBeAlive = isAlive(h);
             EXPECT_EQ(reg.is_valid(h), shouldBeAlive);
 
             if (shouldBeAlive) {
-                EXPECT_EQ(reg.get_index(h), it->second.index);
+                EXPECT_EQ(reg.get_index(h), aliveById[h.id].index);
+                EXPECT_EQ(reg.get_handle(aliveById[h.id].index).id, h.id);
             } else {
                 EXPECT_EQ(reg.get_index(h), HandleRegister::invalid_index);
             }
@@ -167,13 +334,19 @@ TEST_F(HandleRegisterTest, RandomizedOperationsMaintainConsistency) {
         const int op = opDist(rng);
 
         if (op == 0 || handles.empty()) {
-            // INSERT
+            // INSERT, refused when the index is already mapped
             const uint32_t idx = idxDist(rng);
             Handle h = reg.insert(idx);
 
+            if (idByIndex.contains(idx)) {
+                ExpectInvalid(reg, h);
+                continue;
+            }
+
             ExpectValid(reg, h, idx);
 
             aliveById[h.id] = AliveInfo{idx, h.generation};
+            idByIndex[idx] = h.id;
             handles.push_back(h);
         } else {
             // Pick an existing handle (may be stale).
@@ -181,17 +354,20 @@ TEST_F(HandleRegisterTest, RandomizedOperationsMaintainConsistency) {
             Handle h = handles[pick(rng)];
 
             if (op == 1) {
-                // UPDATE
+                // UPDATE, refused for stale handles and already mapped indices
                 const uint32_t newIdx = idxDist(rng);
+                const bool expected = isAlive(h) && !idByIndex.contains(newIdx);
                 const bool ok = reg.update(h, newIdx);
 
-                const bool isAlive = reg.is_valid(h);
-                EXPECT_EQ(ok, isAlive);
+                EXPECT_EQ(ok, expected);
+                EXPECT_EQ(reg.is_valid(h), isAlive(h));
 
-                if (isAlive) {
+                if (ok) {
                     EXPECT_EQ(reg.get_index(h), newIdx);
-                    aliveById[h.id] = AliveInfo{newIdx, h.generation};
-                } else {
+                    idByIndex.erase(aliveById[h.id].index);
+                    idByIndex[newIdx] = h.id;
+                    aliveById[h.id].index = newIdx;
+                } else if (!isAlive(h)) {
                     EXPECT_EQ(reg.get_index(h), HandleRegister::invalid_index);
                 }
             } else {
@@ -201,9 +377,9 @@ TEST_F(HandleRegisterTest, RandomizedOperationsMaintainConsistency) {
                 EXPECT_EQ(reg.get_index(h), HandleRegister::invalid_index);
 
                 // If it was alive in the model, remove it.
-                auto it = aliveById.find(h.id);
-                if (it != aliveById.end() && it->second.generation == h.generation) {
-                    aliveById.erase(it);
+                if (isAlive(h)) {
+                    idByIndex.erase(aliveById[h.id].index);
+                    aliveById.erase(h.id);
                 }
             }
         }
@@ -212,4 +388,4 @@ TEST_F(HandleRegisterTest, RandomizedOperationsMaintainConsistency) {
     }
 
     checkAllAlive();
-}
\ No newline at end of file
+}
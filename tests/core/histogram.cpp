@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "core/histogram.hpp"
+
+TEST(LatencyHistogramTest, EmptyHistogramReportsZero) {
+    LatencyHistogram histogram;
+    EXPECT_EQ(histogram.count(), 0u);
+    EXPECT_EQ(histogram.min(), 0u);
+    EXPECT_EQ(histogram.max(), 0u);
+    EXPECT_EQ(histogram.mean(), 0u);
+    EXPECT_EQ(histogram.percentile(0.99), 0u);
+}
+
+TEST(LatencyHistogramTest, BucketsAreContiguousAndBoundsContainTheirValues) {
+    std::size_t previous = 0;
+    for (std::uint64_t value = 0; value < 100000; ++value) {
+        const auto bucket = LatencyHistogram::bucket_of(value);
+        EXPECT_TRUE(bucket == previous || bucket == previous + 1);
+        EXPECT_LE(value, LatencyHistogram::upper_bound_of(bucket));
+        previous = bucket;
+    }
+    EXPECT_EQ(LatencyHistogram::bucket_of(UINT64_MAX), LatencyHistogram::bucket_count - 1);
+}
+
+TEST(LatencyHistogramTest, PercentilesStayWithinBucketPrecision) {
+    LatencyHistogram histogram;
+    for (std::uint64_t value = 1; value <= 10000; ++value) {
+        histogram.record(value * 1000);
+    }
+
+    EXPECT_EQ(histogram.count(), 10000u);
+    EXPECT_EQ(histogram.min(), 1000u);
+    EXPECT_EQ(histogram.max(), 10000000u);
+    EXPECT_EQ(histogram.mean(), 5000500u);
+
+    const auto p50 = static_cast<double>(histogram.percentile(0.5));
+    const auto p99 = static_cast<double>(histogram.percentile(0.99));
+    EXPECT_NEAR(p50, 5000000.0, 5000000.0 * 0.07);
+    EXPECT_NEAR(p99, 9900000.0, 9900000.0 * 0.07);
+    EXPECT_EQ(histogram.percentile(1.0), histogram.max());
+
+    histogram.reset();
+    EXPECT_EQ(histogram.count(), 0u);
+}
+
+TEST(LatencyHistogramTest, ConcurrentRecordsAreAllCounted) {
+    LatencyHistogram histogram;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&histogram, t] {
+            for (std::uint64_t i = 0; i < 10000; ++i) histogram.record(i + t);
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    EXPECT_EQ(histogram.count(), 40000u);
+    EXPECT_EQ(histogram.min(), 0u);
+    EXPECT_EQ(histogram.max(), 10002u);
+}
@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "core/module-executor.hpp"
+#include "core/module.hpp"
+
+using namespace std::chrono_literals;
+
+namespace {
+
+class ProbeModule : public IModule {
+public:
+    using IModule::IModule;
+
+    std::atomic<int> steps{ 0 };
+    std::atomic<int> inFlight{ 0 };
+    std::atomic<bool> overlapped{ false };
+
+protected:
+    void step(std::chrono::duration<double>) override {
+        if (++inFlight > 1) {
+            overlapped = true;
+        }
+        ++steps;
+        std::this_thread::sleep_for(100us);
+        --inFlight;
+    }
+};
+
+template <typename Predicate>
+bool eventually(Predicate predicate, std::chrono::milliseconds timeout = 2000ms) {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (predicate()) return true;
+        std::this_thread::sleep_for(1ms);
+    }
+    return predicate();
+}
+
+} // namespace
+
+TEST(ModuleExecutorTest, RunsManyFixedRateModulesOnFewThreads) {
+    ModuleExecutor executor(2);
+    std::vector<std::unique_ptr<ProbeModule>> modules;
+    for (int i = 0; i < 50; ++i) {
+        auto module = std::make_unique<ProbeModule>(IModule::ExecutionMode::FIXED_RATE, 100.0);
+        ASSERT_TRUE(module->setExecutor(&executor));
+        ASSERT_TRUE(module->init());
+        modules.push_back(std::move(module));
+    }
+
+    for (auto& module : modules) ASSERT_TRUE(module->start());
+    std::this_thread::sleep_for(300ms);
+    for (auto& module : modules) ASSERT_TRUE(module->stop());
+
+    for (auto& module : modules) {
+        // 30 ticks expected, generous bounds for loaded machines
+        EXPECT_GE(module->steps.load(), 15);
+        EXPECT_LE(module->steps.load(), 32);
+        EXPECT_FALSE(module->overlapped.load());
+    }
+}
+
+TEST(ModuleExecutorTest, MaxRateModulesShareOneWorker) {
+    ModuleExecutor executor(1);
+    std::vector<std::unique_ptr<ProbeModule>> modules;
+    for (int i = 0; i < 3; ++i) {
+        modules.push_back(std::make_unique<ProbeModule>(IModule::ExecutionMode::MAX_RATE));
+        ASSERT_TRUE(modules.back()->setExecutor(&executor));
+        ASSERT_TRUE(modules.back()->init());
+        ASSERT_TRUE(modules.back()->start());
+    }
+
+    EXPECT_TRUE(eventually([&] {
+        for (auto& module : modules) {
+            if (module->steps.load() < 20) return false;
+        }
+        return true;
+    }));
+
+    for (auto& module : modules) ASSERT_TRUE(module->stop());
+}
+
+TEST(ModuleExecutorTest, LifecycleMatchesDedicatedThread) {
+    ModuleExecutor executor(2);
+    ProbeModule module(IModule::ExecutionMode::MAX_RATE);
+    ASSERT_TRUE(module.setExecutor(&executor));
+    ASSERT_TRUE(module.init());
+    ASSERT_TRUE(module.start());
+    EXPECT_FALSE(module.setExecutor(nullptr));
+
+    ASSERT_TRUE(eventually([&] { return module.steps.load() > 10; }));
+
+    ASSERT_TRUE(module.pause());
+    std::this_thread::sleep_for(5ms);
+    const int paused = module.steps.load();
+    std::this_thread::sleep_for(20ms);
+    EXPECT_EQ(module.steps.load(), paused);
+
+    ASSERT_TRUE(module.start());
+    EXPECT_TRUE(eventually([&] { return module.steps.load() > paused + 10; }));
+
+    ASSERT_TRUE(module.stop());
+    ASSERT_TRUE(module.reset());
+    const int stopped = module.steps.load();
+    ASSERT_TRUE(module.start());
+    EXPECT_TRUE(eventually([&] { return module.steps.load() > stopped + 10; }));
+    ASSERT_TRUE(module.stop());
+}
+
+TEST(ModuleExecutorTest, OnceModuleRunsASingleStep) {
+    ModuleExecutor executor(1);
+    ProbeModule module(IModule::ExecutionMode::ONCE);
+    ASSERT_TRUE(module.setExecutor(&executor));
+    ASSERT_TRUE(module.init());
+    ASSERT_TRUE(module.start());
+
+    EXPECT_TRUE(eventually([&] { return !module.isRunning(); }));
+    std::this_thread::sleep_for(10ms);
+    EXPECT_EQ(module.steps.load(), 1);
+}
+
+TEST(ModuleExecutorTest, DestroyingARunningModuleDetachesIt) {
+    ModuleExecutor executor(2);
+    {
+        ProbeModule module(IModule::ExecutionMode::MAX_RATE);
+        ASSERT_TRUE(module.setExecutor(&executor));
+        ASSERT_TRUE(module.init());
+        ASSERT_TRUE(module.start());
+        ASSERT_TRUE(eventually([&] { return module.steps.load() > 5; }));
+    }
+
+    // the executor keeps working for other modules
+    ProbeModule other(IModule::ExecutionMode::MAX_RATE);
+    ASSERT_TRUE(other.setExecutor(&executor));
+    ASSERT_TRUE(other.init());
+    ASSERT_TRUE(other.start());
+    EXPECT_TRUE(eventually([&] { return other.steps.load() > 5; }));
+    ASSERT_TRUE(other.stop());
+}
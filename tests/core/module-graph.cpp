@@ -0,0 +1,219 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "core/module-graph.hpp"
+#include "core/module.hpp"
+
+using namespace std::chrono_literals;
+
+namespace {
+
+class FnModule : public IModule {
+public:
+    explicit FnModule(std::function<void(std::uint64_t)> fn)
+        : IModule(ExecutionMode::MAX_RATE)
+        , m_fn(std::move(fn))
+    { }
+
+protected:
+    void step(std::chrono::duration<double>) override {
+        m_fn(ModuleGraph::currentFrame());
+    }
+
+private:
+    std::function<void(std::uint64_t)> m_fn;
+};
+
+struct Log {
+    std::mutex mutex;
+    std::vector<std::pair<std::uint64_t, std::string>> entries;
+
+    std::function<void(std::uint64_t)> recorder(std::string name) {
+        return [this, name](std::uint64_t frame) {
+            std::lock_guard<std::mutex> lock(mutex);
+            entries.emplace_back(frame, name);
+        };
+    }
+
+    size_t position(std::uint64_t frame, const std::string& name) {
+        for (size_t i = 0; i < entries.size(); ++i) {
+            if (entries[i].first == frame && entries[i].second == name) return i;
+        }
+        return entries.size();
+    }
+};
+
+void startAll(std::initializer_list<IModule*> modules) {
+    for (auto* module : modules) {
+        ASSERT_TRUE(module->init());
+        ASSERT_TRUE(module->start());
+    }
+}
+
+} // namespace
+
+TEST(ModuleGraphTest, DiamondRespectsDependenciesEveryFrame) {
+    ThreadPool pool(3);
+    Log log;
+    FnModule a(log.recorder("a")), b(log.recorder("b")), c(log.recorder("c")), d(log.recorder("d"));
+
+    ModuleGraph graph(1, pool);
+    graph.connect(a, b);
+    graph.connect(a, c);
+    graph.connect(b, d);
+    graph.connect(c, d);
+    startAll({ &a, &b, &c, &d });
+
+    graph.runFrames(20);
+    EXPECT_EQ(graph.frame(), 20u);
+    ASSERT_EQ(log.entries.size(), 80u);
+
+    for (std::uint64_t f = 0; f < 20; ++f) {
+        EXPECT_LT(log.position(f, "a"), log.position(f, "b"));
+        EXPECT_LT(log.position(f, "a"), log.position(f, "c"));
+        EXPECT_LT(log.position(f, "b"), log.position(f, "d"));
+        EXPECT_LT(log.position(f, "c"), log.position(f, "d"));
+        if (f > 0) {
+            // with a single frame in flight a producer waits for its consumers' previous frame
+            EXPECT_LT(log.position(f - 1, "b"), log.position(f, "a"));
+            EXPECT_LT(log.position(f - 1, "c"), log.position(f, "a"));
+        }
+    }
+}
+
+TEST(ModuleGraphTest, PipelinesProducersAheadOfConsumers) {
+    ThreadPool pool(3);
+    std::atomic<std::uint64_t> consumed{ 0 };
+    std::atomic<bool> consumerBusy{ false };
+    std::atomic<bool> overlapped{ false };
+    std::atomic<bool> tooFarAhead{ false };
+
+    FnModule input([&](std::uint64_t frame) {
+        if (consumerBusy.load()) overlapped = true;
+        // two frames in flight: at most one frame ahead of what the consumer finished
+        if (frame > consumed.load() + 1) tooFarAhead = true;
+    });
+    FnModule simulate([&](std::uint64_t) {
+        consumerBusy = true;
+        std::this_thread::sleep_for(2ms);
+        consumerBusy = false;
+        ++consumed;
+    });
+
+    ModuleGraph graph(2, pool);
+    graph.connect(input, simulate);
+    startAll({ &input, &simulate });
+
+    graph.runFrames(20);
+    EXPECT_EQ(consumed.load(), 20u);
+    EXPECT_TRUE(overlapped.load());
+    EXPECT_FALSE(tooFarAhead.load());
+}
+
+TEST(ModuleGraphTest, RejectsCyclesAndForeignModules) {
+    Log log;
+    FnModule a(log.recorder("a")), b(log.recorder("b")), c(log.recorder("c"));
+
+    ModuleGraph graph;
+    graph.connect(a, b);
+    graph.connect(b, c);
+    EXPECT_THROW(graph.connect(c, a), std::invalid_argument);
+    EXPECT_THROW(graph.connect(a, a), std::invalid_argument);
+
+    FnModule running(log.recorder("running"));
+    ASSERT_TRUE(running.init());
+    ASSERT_TRUE(running.start());
+    EXPECT_THROW(graph.add(running), std::invalid_argument);
+    ASSERT_TRUE(running.stop());
+
+    ModuleGraph other;
+    EXPECT_THROW(other.add(a), std::invalid_argument);
+    EXPECT_FALSE(a.setExecutor(nullptr));
+}
+
+TEST(ModuleGraphTest, PausedModulesPassFramesThrough) {
+    ThreadPool pool(2);
+    Log log;
+    FnModule a(log.recorder("a")), b(log.recorder("b"));
+
+    ModuleGraph graph(2, pool);
+    graph.connect(a, b);
+    startAll({ &a, &b });
+    ASSERT_TRUE(a.pause());
+
+    graph.runFrames(5);
+    EXPECT_EQ(log.entries.size(), 5u);
+
+    ASSERT_TRUE(a.start());
+    graph.runFrames(5);
+    EXPECT_EQ(log.entries.size(), 15u);
+    EXPECT_EQ(graph.frame(), 10u);
+}
+
+TEST(ModuleGraphTest, RethrowsStepExceptions) {
+    ThreadPool pool(2);
+    Log log;
+    FnModule ok(log.recorder("ok"));
+    FnModule failing([](std::uint64_t frame) {
+        if (frame == 3) throw std::runtime_error("boom");
+    });
+
+    ModuleGraph graph(2, pool);
+    graph.connect(ok, failing);
+    startAll({ &ok, &failing });
+
+    EXPECT_THROW(graph.runFrames(10), std::runtime_error);
+
+    // the graph stays usable afterwards
+    EXPECT_NO_THROW(graph.runFrames(0));
+}
+
+TEST(ModuleGraphTest, StepsCanUseThePoolTheGraphRunsOn) {
+    // a waiting parallel_for runs other pool tasks, which may be other steps of the graph
+    ThreadPool pool(3);
+    std::atomic<std::size_t> total{ 0 };
+    std::atomic<bool> wrongFrame{ false };
+    const auto work = [&](std::uint64_t frame) {
+        pool.parallel_for(4096, 64, [&](std::size_t b, std::size_t e) { total.fetch_add(e - b); });
+        if (ModuleGraph::currentFrame() != frame) wrongFrame = true;
+    };
+    FnModule a(work), b(work), c(work), d(work);
+
+    ModuleGraph graph(2, pool);
+    graph.connect(a, b);
+    graph.connect(a, c);
+    graph.add(d);
+    startAll({ &a, &b, &c, &d });
+
+    for (int i = 0; i < 200; ++i) {
+        graph.runFrames(4);
+    }
+    EXPECT_EQ(graph.frame(), 800u);
+    EXPECT_EQ(total.load(), 800u * 4u * 4096u);
+    EXPECT_FALSE(wrongFrame.load());
+}
+
+TEST(ModuleGraphTest, RunsWithoutWorkerThreads) {
+    ThreadPool pool(0);
+    Log log;
+    FnModule a(log.recorder("a")), b(log.recorder("b"));
+
+    ModuleGraph graph(2, pool);
+    graph.connect(a, b);
+    startAll({ &a, &b });
+
+    graph.runFrames(10);
+    ASSERT_EQ(log.entries.size(), 20u);
+    for (std::uint64_t f = 0; f < 10; ++f) {
+        EXPECT_LT(log.position(f, "a"), log.position(f, "b"));
+    }
+}
@@ -0,0 +1,172 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "core/module.hpp"
+
+using namespace std::chrono_literals;
+
+namespace {
+
+class CountingModule : public IModule {
+public:
+    explicit CountingModule(double frequencyHz, std::chrono::microseconds work = 0us,
+                            std::chrono::microseconds slowWork = 0us, int slowEvery = 0)
+        : IModule(ExecutionMode::FIXED_RATE, frequencyHz)
+        , m_work(work)
+        , m_slowWork(slowWork)
+        , m_slowEvery(slowEvery)
+    { }
+
+    std::atomic<int> steps{ 0 };
+
+protected:
+    void step(std::chrono::duration<double>) override {
+        const int n = ++steps;
+        const auto work = (m_slowEvery > 0 && n % m_slowEvery == 0) ? m_slowWork : m_work;
+        if (work > 0us) {
+            std::this_thread::sleep_for(work);
+        }
+    }
+
+private:
+    std::chrono::microseconds m_work;
+    std::chrono::microseconds m_slowWork;
+    int m_slowEvery;
+};
+
+void runFor(IModule& module, std::chrono::milliseconds duration) {
+    ASSERT_TRUE(module.init());
+    ASSERT_TRUE(module.start());
+    std::this_thread::sleep_for(duration);
+    ASSERT_TRUE(module.stop());
+}
+
+} // namespace
+
+TEST(ModuleSchedulerTest, FixedRateDoesNotDriftWithStepDuration) {
+    // each step costs a third of the period; relative scheduling would lose time every tick
+    CountingModule module(200.0, 1500us);
+    runFor(module, 500ms);
+
+    // 100 ticks expected, generous bounds for loaded machines
+    EXPECT_GE(module.steps.load(), 85);
+    EXPECT_LE(module.steps.load(), 102);
+
+    const auto stats = module.timingStats();
+    EXPECT_EQ(stats.steps, static_cast<std::uint64_t>(module.steps.load()));
+    EXPECT_LE(stats.meanJitter(), stats.maxJitter);
+}
+
+TEST(ModuleSchedulerTest, SkipDropsMissedTicks) {
+    // every 5th step spans about three periods
+    CountingModule module(100.0, 0us, 30ms, 5);
+    module.setOverrunPolicy(IModule::OverrunPolicy::SKIP);
+    runFor(module, 400ms);
+
+    const auto stats = module.timingStats();
+    EXPECT_GT(stats.overruns, 0u);
+    EXPECT_GE(stats.skippedTicks, stats.overruns);
+
+    // the original grid is kept: executed plus skipped ticks cover the elapsed time
+    EXPECT_LE(stats.steps + stats.skippedTicks, 42u);
+}
+
+TEST(ModuleSchedulerTest, CatchUpRunsMissedTicks) {
+    CountingModule module(100.0, 0us, 30ms, 5);
+    module.setOverrunPolicy(IModule::OverrunPolicy::CATCH_UP);
+    runFor(module, 400ms);
+
+    const auto stats = module.timingStats();
+    EXPECT_GT(stats.overruns, 0u);
+    EXPECT_EQ(stats.skippedTicks, 0u);
+
+    // missed ticks are made up, so the count stays close to 40
+    EXPECT_GE(stats.steps, 30u);
+    EXPECT_LE(stats.steps, 42u);
+}
+
+TEST(ModuleSchedulerTest, StretchShiftsTheGrid) {
+    CountingModule module(100.0, 0us, 30ms, 5);
+    module.setOverrunPolicy(IModule::OverrunPolicy::STRETCH);
+    runFor(module, 400ms);
+
+    const auto stats = module.timingStats();
+    EXPECT_GT(stats.overruns, 0u);
+    EXPECT_EQ(stats.skippedTicks, 0u);
+
+    // lost time is never made up: 4 good ticks per 70ms cycle
+    EXPECT_LE(stats.steps, 30u);
+}
+
+TEST(ModuleSchedulerTest, HybridWaitKeepsRunning) {
+    CountingModule module(500.0);
+    module.setSpinWindow(200us);
+    runFor(module, 200ms);
+
+    EXPECT_GE(module.steps.load(), 80);
+    EXPECT_LE(module.steps.load(), 102);
+
+    module.resetTimingStats();
+    EXPECT_EQ(module.timingStats().steps, 0u);
+}
+
+TEST(ModuleLifecycleTest, PauseResumeAndRestartOnDedicatedThread) {
+    CountingModule module(500.0);
+    ASSERT_TRUE(module.init());
+    ASSERT_TRUE(module.start());
+    std::this_thread::sleep_for(20ms);
+
+    ASSERT_TRUE(module.pause());
+    std::this_thread::sleep_for(5ms);
+    const int paused = module.steps.load();
+    std::this_thread::sleep_for(20ms);
+    EXPECT_EQ(module.steps.load(), paused);
+
+    ASSERT_TRUE(module.start());
+    std::this_thread::sleep_for(20ms);
+    EXPECT_GT(module.steps.load(), paused);
+
+    // a stopped and reset module starts a fresh thread
+    ASSERT_TRUE(module.stop());
+    ASSERT_TRUE(module.reset());
+    std::this_thread::sleep_for(5ms);
+    const int stopped = module.steps.load();
+    ASSERT_TRUE(module.start());
+    std::this_thread::sleep_for(20ms);
+    EXPECT_GT(module.steps.load(), stopped);
+    ASSERT_TRUE(module.stop());
+}
+
+TEST(ModuleStatsTest, StepStatsTrackLatencyRateAndPauses) {
+    CountingModule module(200.0, 1000us);
+    ASSERT_TRUE(module.init());
+    ASSERT_TRUE(module.start());
+    std::this_thread::sleep_for(100ms);
+    ASSERT_TRUE(module.pause());
+    std::this_thread::sleep_for(50ms);
+    ASSERT_TRUE(module.start());
+    std::this_thread::sleep_for(100ms);
+    ASSERT_TRUE(module.stop());
+    // stop() does not wait for a step in flight to be recorded
+    std::this_thread::sleep_for(20ms);
+
+    const auto stats = module.stepStats();
+    EXPECT_EQ(stats.steps, static_cast<std::uint64_t>(module.steps.load()));
+    EXPECT_GE(stats.minStep, 1000us);
+    EXPECT_LE(stats.minStep, stats.meanStep);
+    EXPECT_LE(stats.meanStep, stats.p99Step);
+    EXPECT_LE(stats.p99Step, stats.maxStep);
+    EXPECT_GE(stats.pausedTime, 40ms);
+    EXPECT_GT(stats.waitTime, 0ms);
+
+    // pauses are excluded from the achieved rate
+    EXPECT_GT(stats.achievedHz, 150.0);
+    EXPECT_LT(stats.achievedHz, 260.0);
+
+    module.resetTimingStats();
+    EXPECT_EQ(module.stepStats().steps, 0u);
+}
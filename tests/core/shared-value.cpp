@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/shared-value.hpp"
+
+namespace {
+
+Value make_config() {
+    auto physics = Value::object_t{ };
+    physics.emplace("gravity", Value{ -9.81 });
+    physics.emplace("substeps", Value{ int32_t{ 4 } });
+
+    auto root = Value::object_t{ };
+    root.emplace("name", Value{ std::string{ "level 1" } });
+    root.emplace("physics", Value{ std::move(physics) });
+    root.emplace("spawns", Value{ Value::array_t{ Value{ int32_t{ 1 } }, Value{ int32_t{ 2 } } } });
+    root.emplace("weights", Value{ std::vector<float>{ 0.25f, 0.75f } });
+    root.emplace("a/b", Value{ std::string{ "escaped" } });
+    return Value{ std::move(root) };
+}
+
+} // namespace
+
+TEST(SharedValueTest, ReadsLikeTheValueItWasMadeFrom) {
+    const SharedValue config{ make_config() };
+
+    ASSERT_TRUE(config.is_object());
+    EXPECT_EQ(config.size(), 5u);
+    EXPECT_EQ(config["name"].as<std::string>(), "level 1");
+    EXPECT_EQ(config.find("physics/substeps").as<int32_t>(), 4);
+    EXPECT_EQ(config.find("spawns/1").as<int32_t>(), 2);
+    EXPECT_EQ(config.find("a~1b").as<std::string>(), "escaped");
+    EXPECT_EQ(config["weights"].as<std::vector<float>>()[1], 0.75f);
+
+    // members come in key order
+    EXPECT_EQ(config.key(0), "a/b");
+    EXPECT_EQ(config.key(4), "weights");
+    EXPECT_TRUE(config.member(2).is_object()); // physics
+
+    EXPECT_TRUE(config.find("physics/missing").empty());
+    EXPECT_TRUE(config.find("spawns/2").empty());
+    EXPECT_TRUE(config.find("name/0").empty());
+    EXPECT_FALSE(config["name"].is<int32_t>());
+    EXPECT_THROW((void)config["physics"].as<int32_t>(), std::bad_variant_access);
+
+    const auto back = config.to_value();
+    const auto& members = back.as<Value::object_t>();
+    ASSERT_EQ(members.size(), 5u);
+    EXPECT_EQ(members.at("physics").as<Value::object_t>().at("gravity").as<double>(), -9.81);
+    EXPECT_EQ(members.at("spawns").as<Value::array_t>()[1].as<int32_t>(), 2);
+    EXPECT_EQ(members.at("weights").as<std::vector<float>>(), (std::vector<float>{ 0.25f, 0.75f }));
+}
+
+TEST(SharedValueTest, SnapshotsShareEverythingUntilWritten) {
+    SharedValue state{ make_config() };
+    const auto snapshot = state;
+    EXPECT_TRUE(snapshot.same(state));
+
+    ASSERT_TRUE(state.set("physics/gravity", Value{ -1.62 }));
+
+    // the snapshot is untouched
+    EXPECT_EQ(snapshot.find("physics/gravity").as<double>(), -9.81);
+    EXPECT_EQ(state.find("physics/gravity").as<double>(), -1.62);
+
+    // only the path to the change was copied
+    EXPECT_FALSE(state.same(snapshot));
+    EXPECT_FALSE(state["physics"].same(snapshot["physics"]));
+    EXPECT_TRUE(state.find("physics/substeps").same(snapshot.find("physics/substeps")));
+    EXPECT_TRUE(state["spawns"].same(snapshot["spawns"]));
+    EXPECT_TRUE(state["name"].same(snapshot["name"]));
+}
+
+TEST(SharedValueTest, UnsharedTreesAreUpdatedInPlace) {
+    // keys are views into their node, so they only move when the node is copied
+    SharedValue state{ make_config() };
+    const auto* rootKey = state.key(0).data();
+    const auto* physicsKey = state["physics"].key(0).data();
+
+    ASSERT_TRUE(state.set("physics/substeps", Value{ int32_t{ 8 } }));
+    EXPECT_EQ(state.key(0).data(), rootKey);
+    EXPECT_EQ(state["physics"].key(0).data(), physicsKey);
+
+    // a second owner of the physics node makes the next write copy it, and only it
+    const auto physics = state["physics"];
+    ASSERT_TRUE(state.set("physics/substeps", Value{ int32_t{ 16 } }));
+    EXPECT_EQ(state.key(0).data(), rootKey);
+    EXPECT_NE(state["physics"].key(0).data(), physicsKey);
+    EXPECT_EQ(physics["substeps"].as<int32_t>(), 8);
+    EXPECT_EQ(state.find("physics/substeps").as<int32_t>(), 16);
+}
+
+TEST(SharedValueTest, SetCreatesAppendsAndRejects) {
+    SharedValue state;
+    ASSERT_TRUE(state.set("render/shadows/cascades", Value{ int32_t{ 3 } }));
+    EXPECT_EQ(state.find("render/shadows/cascades").as<int32_t>(), 3);
+
+    ASSERT_TRUE(state.set("list", Value::array()));
+    ASSERT_TRUE(state.set("list/0", Value{ std::string{ "first" } }));
+    ASSERT_TRUE(state.set("list/1", Value{ std::string{ "second" } }));
+    EXPECT_EQ(state["list"].size(), 2u);
+
+    const auto before = state;
+    EXPECT_FALSE(state.set("list/3", Value{ }));            // past the end
+    EXPECT_FALSE(state.set("list/2/x", Value{ }));          // appends only as the last segment
+    EXPECT_FALSE(state.set("list/x", Value{ }));            // not an index
+    EXPECT_FALSE(state.set("list/0/deeper", Value{ }));     // into a string
+    EXPECT_TRUE(state.same(before));
+
+    ASSERT_TRUE(state.set("", Value{ int32_t{ 7 } }));
+    EXPECT_EQ(state.as<int32_t>(), 7);
+}
+
+TEST(SharedValueTest, EraseCopiesThePathToo) {
+    SharedValue state{ make_config() };
+    const auto snapshot = state;
+
+    EXPECT_TRUE(state.erase("spawns/0"));
+    EXPECT_TRUE(state.erase("physics/gravity"));
+    EXPECT_FALSE(state.erase("physics/gravity"));
+    EXPECT_FALSE(state.erase("spawns/5"));
+    EXPECT_FALSE(state.erase("name/0"));
+    EXPECT_FALSE(state.erase(""));
+
+    EXPECT_EQ(state["spawns"].size(), 1u);
+    EXPECT_EQ(state.find("spawns/0").as<int32_t>(), 2);
+    EXPECT_TRUE(state.find("physics/gravity").empty());
+    EXPECT_EQ(snapshot["spawns"].size(), 2u);
+    EXPECT_EQ(snapshot.find("physics/gravity").as<double>(), -9.81);
+}
+
+TEST(SharedValueTest, ReadersSeeConsistentVersionsAcrossThreads) {
+    // every version keeps "a" and "b" equal; a reader finding them apart saw a torn update
+    SharedValue state;
+    state.set("a", Value{ int32_t{ 0 } });
+    state.set("b", Value{ int32_t{ 0 } });
+    AtomicSharedValue current{ state };
+
+    std::atomic<bool> done{ false };
+    std::atomic<bool> torn{ false };
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; ++r) {
+        readers.emplace_back([&] {
+            while (!done.load()) {
+                const auto snapshot = current.load();
+                if (snapshot["a"].as<int32_t>() != snapshot["b"].as<int32_t>()) {
+                    torn = true;
+                }
+            }
+        });
+    }
+
+    for (int32_t i = 1; i <= 2000; ++i) {
+        state.set("a", Value{ i });
+        state.set("b", Value{ i });
+        current.store(state);
+    }
+    done = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    EXPECT_FALSE(torn.load());
+    EXPECT_EQ(current.load()["a"].as<int32_t>(), 2000);
+}
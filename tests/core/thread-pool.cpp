@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "core/thread-pool.hpp"
+
+namespace {
+
+struct Range {
+    std::size_t begin;
+    std::size_t end;
+};
+
+std::vector<Range> collect_ranges(ThreadPool& pool, std::size_t count, std::size_t grain, std::size_t alignment) {
+    std::mutex mutex;
+    std::vector<Range> ranges;
+    pool.parallel_for(count, grain, alignment, [&](std::size_t b, std::size_t e) {
+        std::lock_guard<std::mutex> lock(mutex);
+        ranges.push_back({b, e});
+    });
+    std::sort(ranges.begin(), ranges.end(), [](const Range& a, const Range& b) { return a.begin < b.begin; });
+    return ranges;
+}
+
+} // namespace
+
+TEST(ThreadPool, ParallelForCoversEveryIndexExactlyOnce) {
+    ThreadPool pool(4);
+    constexpr std::size_t count = 100000;
+
+    std::vector<std::atomic<int>> hits(count);
+    pool.parallel_for(count, 64, [&](std::size_t b, std::size_t e) {
+        for (auto i = b; i < e; ++i) {
+            hits[i].fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+
+    for (std::size_t i = 0; i < count; ++i) {
+        ASSERT_EQ(hits[i].load(), 1) << "i=" << i;
+    }
+}
+
+TEST(ThreadPool, ChunksAreContiguousAlignedAndRespectGrain) {
+    ThreadPool pool(3);
+    const auto ranges = collect_ranges(pool, 10007, 100, 16);
+
+    ASSERT_FALSE(ranges.empty());
+    EXPECT_EQ(ranges.front().begin, 0u);
+    EXPECT_EQ(ranges.back().end, 10007u);
+    for (std::size_t i = 0; i < ranges.size(); ++i) {
+        EXPECT_EQ(ranges[i].begin % 16, 0u);
+        if (i + 1 < ranges.size()) {
+            EXPECT_EQ(ranges[i].end, ranges[i + 1].begin);
+            EXPECT_GE(ranges[i].end - ranges[i].begin, 100u);
+        }
+    }
+}
+
+TEST(ThreadPool, SmallRangesRunInlineOnTheCaller) {
+    ThreadPool pool(2);
+    const auto caller = std::this_thread::get_id();
+    std::thread::id ran_on{};
+
+    pool.parallel_for(10, 64, [&](std::size_t, std::size_t) { ran_on = std::this_thread::get_id(); });
+    EXPECT_EQ(ran_on, caller);
+}
+
+TEST(ThreadPool, WorksWithoutWorkerThreads) {
+    ThreadPool pool(0);
+    std::size_t total = 0;
+    pool.parallel_for(1000, 1, [&](std::size_t b, std::size_t e) { total += e - b; });
+    EXPECT_EQ(total, 1000u);
+}
+
+TEST(ThreadPool, RethrowsFirstExceptionAfterAllChunksFinish) {
+    ThreadPool pool(4);
+    std::atomic<std::size_t> processed{0};
+
+    EXPECT_THROW(pool.parallel_for(4096, 16, [&](std::size_t b, std::size_t e) {
+        processed.fetch_add(e - b);
+        if (b == 0) {
+            throw std::runtime_error("boom");
+        }
+    }), std::runtime_error);
+
+    EXPECT_EQ(processed.load(), 4096u);
+}
+
+TEST(ThreadPool, NestedParallelForDoesNotDeadlock) {
+    ThreadPool pool(2);
+    std::atomic<std::size_t> total{0};
+
+    pool.parallel_for(64, 1, [&](std::size_t b, std::size_t e) {
+        for (auto i = b; i < e; ++i) {
+            pool.parallel_for(256, 8, [&](std::size_t ib, std::size_t ie) { total.fetch_add(ie - ib); });
+        }
+    });
+
+    EXPECT_EQ(total.load(), 64u * 256u);
+}
+
+TEST(ThreadPool, TaskGroupsRunTasksSpawnedByTasks) {
+    for (const std::size_t workers : { 0u, 3u }) {
+        ThreadPool pool(workers);
+        std::atomic<std::size_t> ran{ 0 };
+        std::atomic<std::size_t> nested{ 0 };
+
+        // a binary tree of tasks 10 levels deep, each also running a parallel_for of its own
+        ThreadPool::TaskGroup* group = nullptr;
+        const auto task = [&](std::size_t depth) {
+            ++ran;
+            pool.parallel_for(64, 4, [&](std::size_t b, std::size_t e) { nested.fetch_add(e - b); });
+            if (depth < 9) {
+                group->spawn(depth + 1);
+                group->spawn(depth + 1);
+            }
+        };
+        ThreadPool::TaskGroup tasks(pool, task);
+        group = &tasks;
+        tasks.spawn(0);
+        tasks.wait();
+
+        EXPECT_EQ(ran.load(), 1023u) << workers << " workers";
+        EXPECT_EQ(nested.load(), 1023u * 64u) << workers << " workers";
+    }
+}
+
+TEST(ThreadPool, TaskGroupsRethrowTheFirstException) {
+    ThreadPool pool(2);
+    std::atomic<std::size_t> ran{ 0 };
+    const auto task = [&](std::size_t index) {
+        ++ran;
+        if (index == 5) throw std::runtime_error("boom");
+    };
+    ThreadPool::TaskGroup tasks(pool, task);
+    for (std::size_t i = 0; i < 10; ++i) {
+        tasks.spawn(i);
+    }
+    EXPECT_THROW(tasks.wait(), std::runtime_error);
+    EXPECT_EQ(ran.load(), 10u);
+
+    // and the group can be used again
+    tasks.spawn(0);
+    EXPECT_NO_THROW(tasks.wait());
+}
@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "core/trace.hpp"
+
+namespace {
+
+size_t occurrences(const std::string& text, const std::string& needle) {
+    size_t count = 0;
+    for (auto pos = text.find(needle); pos != std::string::npos; pos = text.find(needle, pos + 1)) ++count;
+    return count;
+}
+
+struct TraceTest : ::testing::Test {
+    void SetUp() override { trace::clear(); }
+    void TearDown() override {
+        trace::set_enabled(false);
+        trace::clear();
+    }
+};
+
+} // namespace
+
+TEST_F(TraceTest, DisabledScopesRecordNothing) {
+    trace::set_enabled(false);
+    { trace::Scope scope("ignored"); }
+
+    std::ostringstream out;
+    trace::write_chrome_json(out);
+    EXPECT_EQ(out.str(), "{\"traceEvents\":[],\"displayTimeUnit\":\"ns\"}");
+}
+
+TEST_F(TraceTest, ExportsCompleteEventsFromEveryThread) {
+    trace::set_enabled(true);
+    { trace::Scope scope("main-scope", "test"); }
+    std::thread worker([] { trace::Scope scope("worker-scope", "test"); });
+    worker.join();
+
+    std::ostringstream out;
+    trace::write_chrome_json(out);
+    const auto json = out.str();
+
+    EXPECT_EQ(occurrences(json, "\"ph\":\"X\""), 2u);
+    EXPECT_NE(json.find("\"name\":\"main-scope\""), std::string::npos);
+    EXPECT_NE(json.find("\"name\":\"worker-scope\""), std::string::npos);
+    EXPECT_NE(json.find("\"cat\":\"test\""), std::string::npos);
+}
+
+TEST_F(TraceTest, InternedNamesAreStableAndEscaped) {
+    const char* a = trace::intern("say \"hi\"");
+    const char* b = trace::intern(std::string("say \"hi\""));
+    EXPECT_EQ(a, b);
+
+    trace::set_enabled(true);
+    { trace::Scope scope(a); }
+
+    std::ostringstream out;
+    trace::write_chrome_json(out);
+    EXPECT_NE(out.str().find("say \\\"hi\\\""), std::string::npos);
+}
+
+TEST_F(TraceTest, FullBufferDropsAndCounts) {
+    trace::set_enabled(true);
+    const auto now = trace::clock::now();
+    for (size_t i = 0; i < trace::thread_capacity + 5; ++i) {
+        trace::record("spam", "test", now, now);
+    }
+    EXPECT_EQ(trace::dropped(), 5u);
+}
+
+TEST_F(TraceTest, ExitedThreadsHandTheirBuffersOn) {
+    trace::set_enabled(true);
+    for (int i = 0; i < 50; ++i) {
+        std::thread worker([] { trace::Scope scope("short-lived", "test"); });
+        worker.join();
+    }
+
+    std::ostringstream out;
+    trace::write_chrome_json(out);
+    const auto json = out.str();
+
+    // every event is kept, and all from one buffer: the threads never ran at the same time
+    EXPECT_EQ(occurrences(json, "\"name\":\"short-lived\""), 50u);
+    std::set<std::string> tids;
+    for (auto pos = json.find("\"tid\":"); pos != std::string::npos; pos = json.find("\"tid\":", pos + 1)) {
+        tids.insert(json.substr(pos, json.find('}', pos) - pos));
+    }
+    EXPECT_EQ(tids.size(), 1u);
+}
+
+TEST_F(TraceTest, ClearWhileRecordingNeverBringsEventsBack) {
+    trace::set_enabled(true);
+    for (int round = 0; round < 20; ++round) {
+        std::atomic<bool> cleared{ false };
+        std::atomic<bool> stop{ false };
+        std::atomic<size_t> recorded{ 0 };
+        std::thread recorder([&] {
+            while (!stop.load()) {
+                const auto now = trace::clock::now();
+                trace::record(cleared.load() ? "after" : "before", "test", now, now);
+                ++recorded;
+            }
+        });
+
+        while (recorded.load() < 100) {
+            std::this_thread::yield();
+        }
+        cleared = true;
+        trace::clear();
+        const auto at = recorded.load();
+        while (recorded.load() < at + 100) {
+            std::this_thread::yield();
+        }
+        stop = true;
+        recorder.join();
+
+        std::ostringstream out;
+        trace::write_chrome_json(out);
+        // at most the event that was being recorded during the clear
+        EXPECT_LE(occurrences(out.str(), "\"name\":\"before\""), 1u) << "round " << round;
+        EXPECT_GT(occurrences(out.str(), "\"name\":\"after\""), 0u);
+        trace::clear();
+    }
+}
@@ -0,0 +1,188 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "io/binary-stream.hpp"
+#include "io/binary-value.hpp"
+
+namespace {
+
+Value make_sample() {
+    auto samples = Value::array_t{ };
+    for (int i = 0; i < 1000; ++i) {
+        samples.emplace_back(static_cast<float>(i) * 0.5f);
+    }
+
+    auto root = Value::object_t{ };
+    root.emplace("samples", Value{ std::move(samples) });
+    root.emplace("mixed", Value{ Value::array_t{ Value{ int32_t{ 1 } }, Value{ 2.0 }, Value{ std::string{ } } } });
+    root.emplace("ticks", Value{ Value::array_t{ Value{ uint64_t{ 1 } }, Value{ ~uint64_t{ 0 } } } });
+    root.emplace("name", Value{ std::string{ "probe" } });
+    root.emplace("", Value{ });
+    root.emplace("chars", Value{ Value::array_t{ Value{ 'a' }, Value{ 'b' } } });
+    root.emplace("signal", Value{ std::vector<double>{ 0.25, -8.0 } });
+    root.emplace("none", Value{ std::vector<int32_t>{ } });
+    return Value{ std::move(root) };
+}
+
+// keys come back in hash order, so compare through the key-sorted binary document format
+std::vector<char> canonical(const Value& value) {
+    std::vector<char> bytes;
+    EXPECT_TRUE(BinaryDocument::encode(value, bytes));
+    return bytes;
+}
+
+} // namespace
+
+TEST(BinaryStreamTest, RoundTripsThroughABuffer) {
+    std::vector<char> bytes;
+    {
+        BinaryStreamWriter writer{ bytes };
+        writer.write(make_sample());
+        writer.write(Value{ int32_t{ 42 } });
+    }
+
+    BinaryStreamReader reader{ bytes };
+    Value first;
+    Value second;
+    Value third;
+    ASSERT_TRUE(reader.read(first)) << reader.error();
+    ASSERT_TRUE(reader.read(second)) << reader.error();
+    EXPECT_FALSE(reader.read(third));
+    EXPECT_TRUE(reader.error().empty()); // a clean end
+
+    EXPECT_EQ(canonical(first), canonical(make_sample()));
+    EXPECT_EQ(second.as<int32_t>(), 42);
+}
+
+TEST(BinaryStreamTest, PacksHomogeneousArrays) {
+    std::vector<char> bytes;
+    {
+        BinaryStreamWriter writer{ bytes };
+        writer.write(Value{ Value::array_t(100, Value{ 1.0 }) });
+    }
+    // tag, item type, count, then the doubles back to back
+    ASSERT_EQ(bytes.size(), 1 + 1 + sizeof(Value::size_t) + 100 * sizeof(double));
+    EXPECT_EQ(static_cast<uint8_t>(bytes[0]), binary_stream_detail::packed_array);
+    EXPECT_EQ(bytes[1], 8);
+}
+
+TEST(BinaryStreamTest, TypedArraysKeepTheirTypeAndLength) {
+    // longer than a Value::size_t count and than the read-ahead buffer
+    std::vector<float> signal(100000);
+    for (std::size_t i = 0; i < signal.size(); ++i) {
+        signal[i] = static_cast<float>(i) * 0.25f;
+    }
+
+    std::vector<char> bytes;
+    {
+        BinaryStreamWriter writer{ bytes };
+        writer.write(Value{ signal });
+    }
+    // tag, item type, count, then the floats as they sit in the vector
+    ASSERT_EQ(bytes.size(), 1 + 1 + sizeof(uint32_t) + signal.size() * sizeof(float));
+    EXPECT_EQ(static_cast<uint8_t>(bytes[0]), binary_stream_detail::typed_array);
+    EXPECT_EQ(bytes[1], 7);
+
+    BinaryStreamReader reader{ bytes };
+    Value value;
+    ASSERT_TRUE(reader.read(value)) << reader.error();
+    ASSERT_TRUE(value.is<std::vector<float>>());
+    EXPECT_EQ(value.as<std::vector<float>>(), signal);
+
+    // and the same through the istream path
+    std::stringstream stream;
+    Value{ signal }.write_binary(stream);
+    EXPECT_EQ(Value::read_binary(stream).as<std::vector<float>>(), signal);
+}
+
+TEST(BinaryStreamTest, ReadsTheUnpackedArrayForm) {
+    // an array of int32 as the earlier writer laid it out: tag 10, count, tagged items
+    std::vector<char> bytes = { 10, 2, 0, 1, 7, 0, 0, 0, 1, 8, 0, 0, 0 };
+    BinaryStreamReader reader{ bytes };
+    Value value;
+    ASSERT_TRUE(reader.read(value)) << reader.error();
+    ASSERT_EQ(value.as<Value::array_t>().size(), 2u);
+    EXPECT_EQ(value.as<Value::array_t>()[1].as<int32_t>(), 8);
+}
+
+TEST(BinaryStreamTest, ReportsTruncationAndUnknownTags) {
+    std::vector<char> bytes;
+    {
+        BinaryStreamWriter writer{ bytes };
+        writer.write(make_sample());
+    }
+
+    for (const auto cut : { std::size_t{ 1 }, std::size_t{ 10 }, bytes.size() / 2, bytes.size() - 1 }) {
+        BinaryStreamReader reader{ std::span<const char>{ bytes.data(), cut } };
+        Value value;
+        EXPECT_FALSE(reader.read(value)) << cut;
+        EXPECT_FALSE(reader.error().empty()) << cut;
+        EXPECT_TRUE(value.empty()) << cut;
+    }
+
+    const std::vector<char> unknown = { 42 };
+    BinaryStreamReader reader{ unknown };
+    Value value;
+    EXPECT_FALSE(reader.read(value));
+    EXPECT_FALSE(reader.error().empty());
+}
+
+TEST(BinaryStreamTest, IstreamReadsStopAtTheValue) {
+    std::stringstream stream;
+    make_sample().write_binary(stream);
+    Value{ std::string{ "next" } }.write_binary(stream);
+
+    EXPECT_EQ(canonical(Value::read_binary(stream)), canonical(make_sample()));
+    EXPECT_EQ(Value::read_binary(stream).as<std::string>(), "next");
+    EXPECT_TRUE(Value::read_binary(stream).empty());
+}
+
+TEST(BinaryStreamTest, LoadsMappedFiles) {
+    const std::string path = ::testing::TempDir() + "binary-stream-mapped.bin";
+    {
+        std::ofstream os{ path, std::ios::binary };
+        make_sample().write_binary(os);
+    }
+
+    EXPECT_EQ(canonical(Value::load_binary(path)), canonical(make_sample()));
+
+    std::remove(path.c_str());
+    EXPECT_TRUE(Value::load_binary(path).empty());
+}
+
+TEST(BinaryStreamTest, BuffersFileDescriptors) {
+    const std::string path = ::testing::TempDir() + "binary-stream-test.bin";
+    const auto out = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600);
+    ASSERT_GE(out, 0);
+    {
+        // a buffer smaller than the sample forces several flushes and refills
+        BinaryStreamWriter writer{ out, 64 };
+        for (int i = 0; i < 10; ++i) {
+            writer.write(make_sample());
+        }
+        EXPECT_TRUE(writer.flush());
+    }
+    ::close(out);
+
+    const auto in = ::open(path.c_str(), O_RDONLY);
+    ASSERT_GE(in, 0);
+    BinaryStreamReader reader{ in, 64 };
+    Value value;
+    int count = 0;
+    while (reader.read(value)) {
+        EXPECT_EQ(canonical(value), canonical(make_sample()));
+        ++count;
+    }
+    EXPECT_TRUE(reader.error().empty()) << reader.error();
+    EXPECT_EQ(count, 10);
+    ::close(in);
+    std::remove(path.c_str());
+}
@@ -0,0 +1,228 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "io/binary-value.hpp"
+
+namespace {
+
+Value make_sample() {
+    auto pose = Value::object_t{ };
+    pose.emplace("x", Value{ 1.5f });
+    pose.emplace("y", Value{ -2.25 });
+
+    auto root = Value::object_t{ };
+    root.emplace("i32", Value{ int32_t{ -7 } });
+    root.emplace("u32", Value{ uint32_t{ 4000000000u } });
+    root.emplace("i64", Value{ int64_t{ -1 } << 40 });
+    root.emplace("u64", Value{ ~uint64_t{ 0 } });
+    root.emplace("c", Value{ char{ 'q' } });
+    root.emplace("uc", Value{ static_cast<unsigned char>(200) });
+    root.emplace("name", Value{ std::string{ "probe" } });
+    root.emplace("nothing", Value{ });
+    root.emplace("pose", Value{ std::move(pose) });
+    root.emplace("list", Value{ Value::array_t{ Value{ int32_t{ 1 } }, Value{ std::string{ "two" } }, Value::array() } });
+    root.emplace("signal", Value{ std::vector<float>{ 0.5f, -1.0f, 3.25f } });
+    root.emplace("ticks", Value{ std::vector<uint64_t>{ 1, ~uint64_t{ 0 } } });
+    root.emplace("raw", Value{ std::vector<unsigned char>{ 1, 2, 3 } });
+    root.emplace("none", Value{ std::vector<double>{ } });
+    return Value{ std::move(root) };
+}
+
+std::vector<char> encode(const Value& value) {
+    std::vector<char> bytes;
+    EXPECT_TRUE(BinaryDocument::encode(value, bytes));
+    return bytes;
+}
+
+} // namespace
+
+TEST(BinaryValueTest, NavigatesWithoutDecoding) {
+    const auto bytes = encode(make_sample());
+    BinaryDocument document;
+    ASSERT_TRUE(document.open(bytes)) << document.error();
+
+    const auto root = document.root();
+    ASSERT_TRUE(root.is_object());
+    EXPECT_EQ(root.size(), 14u);
+    EXPECT_EQ(root["i32"].as<int32_t>(), -7);
+    EXPECT_EQ(root["u32"].as<uint32_t>(), 4000000000u);
+    EXPECT_EQ(root["i64"].as<int64_t>(), int64_t{ -1 } << 40);
+    EXPECT_EQ(root["u64"].as<uint64_t>(), ~uint64_t{ 0 });
+    EXPECT_EQ(root["c"].as<char>(), 'q');
+    EXPECT_EQ(root["uc"].as<unsigned char>(), 200);
+    EXPECT_EQ(root["pose"]["x"].as<float>(), 1.5f);
+    EXPECT_EQ(root["pose"]["y"].as<double>(), -2.25);
+    EXPECT_TRUE(root["nothing"].valid());
+    EXPECT_TRUE(root["nothing"].is_null());
+    EXPECT_EQ(root["list"][1].as_string(), "two");
+    EXPECT_EQ(root["list"][2].size(), 0u);
+
+    // strings point into the buffer
+    const auto name = root["name"].as_string();
+    EXPECT_EQ(name, "probe");
+    EXPECT_GE(name.data(), bytes.data());
+    EXPECT_LT(name.data(), bytes.data() + bytes.size());
+
+    // members are in key order
+    for (std::size_t i = 1; i < root.size(); ++i) {
+        EXPECT_LT(root.key(i - 1), root.key(i));
+    }
+}
+
+TEST(BinaryValueTest, MissingAndMistypedLookupsAreEmpty) {
+    const auto bytes = encode(make_sample());
+    BinaryDocument document;
+    ASSERT_TRUE(document.open(bytes));
+    const auto root = document.root();
+
+    EXPECT_FALSE(root["missing"].valid());
+    EXPECT_FALSE(root["list"][3].valid());
+    EXPECT_FALSE(root["name"]["x"].valid());
+    EXPECT_EQ(root["i32"].as<int64_t>(), 0); // no conversion between types
+    EXPECT_EQ(root["missing"]["deeper"].as_string(), "");
+}
+
+TEST(BinaryValueTest, ScalarPayloadsAreAligned) {
+    const auto bytes = encode(Value{ Value::array_t{ Value{ std::string{ "abc" } }, Value{ 3.0 }, Value{ int64_t{ 9 } } } });
+    BinaryDocument document;
+    ASSERT_TRUE(document.open(bytes));
+    EXPECT_EQ(document.root()[1].as<double>(), 3.0);
+
+    // the root's item table holds node offsets; payloads start 8 bytes into a node
+    const auto root = binary_detail::load_u32(bytes.data() + 8);
+    for (std::size_t i = 0; i < 3; ++i) {
+        EXPECT_EQ(binary_detail::load_u32(bytes.data() + root + 8 + i * 4) % 8, 0u) << i;
+    }
+    EXPECT_EQ(bytes.size() % 8, 0u);
+}
+
+TEST(BinaryValueTest, TypedArraysReadInPlace) {
+    const auto bytes = encode(make_sample());
+    BinaryDocument document;
+    ASSERT_TRUE(document.open(bytes));
+
+    const auto signal = document.root()["signal"];
+    EXPECT_TRUE(signal.is_typed_array());
+    EXPECT_EQ(signal.type(), binary_detail::index_of<std::vector<float>>);
+    EXPECT_EQ(signal.size(), 3u);
+    const auto items = signal.items<float>();
+    ASSERT_EQ(items.size(), 3u);
+    // a view of the document bytes, not a copy
+    EXPECT_GE(reinterpret_cast<const char*>(items.data()), bytes.data());
+    EXPECT_LT(reinterpret_cast<const char*>(items.data()), bytes.data() + bytes.size());
+    EXPECT_EQ(items[2], 3.25f);
+    EXPECT_EQ(document.root()["ticks"].items<uint64_t>()[1], ~uint64_t{ 0 });
+    EXPECT_TRUE(document.root()["none"].items<double>().empty());
+    EXPECT_TRUE(document.root()["none"].is_typed_array());
+
+    // the item type must match exactly
+    EXPECT_TRUE(signal.items<double>().empty());
+    EXPECT_TRUE(document.root()["list"].items<int32_t>().empty());
+    EXPECT_FALSE(document.root()["list"].is_typed_array());
+}
+
+TEST(BinaryValueTest, TypedArrayCountsAreBoundsChecked) {
+    auto bytes = encode(Value{ std::vector<double>{ 1.0, 2.0 } });
+    const auto root = binary_detail::load_u32(bytes.data() + 8);
+    const uint32_t count = 3; // one item past the end of the file
+    std::memcpy(bytes.data() + root + 4, &count, sizeof(count));
+
+    BinaryDocument document;
+    EXPECT_FALSE(document.open(bytes));
+}
+
+TEST(BinaryValueTest, RoundTripsThroughToValue) {
+    const auto sample = make_sample();
+    BinaryDocument document;
+    const auto bytes = encode(sample);
+    ASSERT_TRUE(document.open(bytes));
+    // keys are sorted, so equal values encode to equal bytes whatever their hash order
+    EXPECT_EQ(encode(document.root().to_value()), bytes);
+}
+
+TEST(BinaryValueTest, HoldsWhatTheStreamFormatTruncated) {
+    // more than 65535 items and bytes, the limit of Value::size_t
+    auto items = Value::array_t(70000, Value{ int32_t{ 5 } });
+    items.back() = Value{ std::string(100000, 'z') };
+
+    BinaryDocument document;
+    const auto bytes = encode(Value{ std::move(items) });
+    ASSERT_TRUE(document.open(bytes));
+    EXPECT_EQ(document.root().size(), 70000u);
+    EXPECT_EQ(document.root()[69998].as<int32_t>(), 5);
+    EXPECT_EQ(document.root()[69999].as_string().size(), 100000u);
+}
+
+TEST(BinaryValueTest, MapsSavedFiles) {
+    const std::string path = ::testing::TempDir() + "binary-value-test.sbvf";
+    ASSERT_TRUE(BinaryDocument::save(make_sample(), path));
+
+    BinaryDocument document;
+    ASSERT_TRUE(document.open(path)) << document.error();
+    EXPECT_EQ(document.root()["pose"]["x"].as<float>(), 1.5f);
+
+    // the moved-to document keeps the mapping, and refs stay usable
+    const auto name = document.root()["name"];
+    BinaryDocument moved = std::move(document);
+    EXPECT_EQ(name.as_string(), "probe");
+    EXPECT_EQ(moved.root()["u32"].as<uint32_t>(), 4000000000u);
+
+    std::remove(path.c_str());
+    EXPECT_FALSE(BinaryDocument{ }.open(path));
+}
+
+TEST(BinaryValueTest, RejectsBadHeaders) {
+    const auto good = encode(make_sample());
+    BinaryDocument document;
+
+    EXPECT_FALSE(document.open(std::span<const char>{ good.data(), 10 }));
+
+    auto bytes = good;
+    bytes[0] = 'X';
+    EXPECT_FALSE(document.open(bytes));
+
+    bytes = good;
+    bytes[4] = binary_detail::version + 1; // a newer version
+    EXPECT_FALSE(document.open(bytes));
+
+    bytes = good;
+    bytes.push_back(0); // size mismatch
+    EXPECT_FALSE(document.open(bytes));
+
+    bytes = good;
+    bytes[8] = 3; // root offset not on a node boundary
+    EXPECT_FALSE(document.open(bytes));
+    EXPECT_FALSE(document.root().valid());
+}
+
+TEST(BinaryValueTest, CorruptedNodesNeverReadOutOfBounds) {
+    const auto good = encode(make_sample());
+    std::mt19937 rng{ 20 };
+
+    for (int round = 0; round < 500; ++round) {
+        auto bytes = good;
+        for (int flips = 0; flips < 4; ++flips) {
+            const auto at = 24 + rng() % (bytes.size() - 24);
+            bytes[at] = static_cast<char>(rng());
+        }
+
+        BinaryDocument document;
+        if (document.open(bytes)) {
+            // walks every reachable node; sanitizers or a crash would flag stray reads
+            (void)document.root().to_value();
+        }
+    }
+}
+
+TEST(BinaryValueTest, StreamFormatRoundTripsObjectKeys) {
+    std::stringstream stream;
+    make_sample().write_binary(stream);
+    const auto read = Value::read_binary(stream);
+    EXPECT_EQ(encode(read), encode(make_sample()));
+}
@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "io/json.hpp"
+#include "io/json-scan.hpp"
+
+namespace {
+
+std::vector<Token> lex(std::string_view source) {
+    JsonLexer lexer{ source };
+    std::vector<Token> tokens;
+    while (true) {
+        tokens.push_back(lexer.next());
+        if (tokens.back().type == TokenType::Eof || tokens.back().type == TokenType::Error) return tokens;
+    }
+}
+
+} // namespace
+
+TEST(JsonScanTest, ClassifyBlockMatchesScalarTable) {
+    std::mt19937 rng(7);
+    const std::string alphabet = " \t\n\r\"\\{}[]:,abc019-.\x0c\x1a\x7f\x80\xff";
+    std::uniform_int_distribution<size_t> pick(0, alphabet.size() - 1);
+
+    for (int round = 0; round < 200; ++round) {
+        std::string block(json_detail::block_size, ' ');
+        for (auto& c : block) c = alphabet[pick(rng)];
+
+        const auto masks = json_detail::classify_block(block.data());
+        for (size_t i = 0; i < block.size(); ++i) {
+            const auto bit = [&](uint64_t mask) { return ((mask >> i) & 1) != 0; };
+            EXPECT_EQ(bit(masks.whitespace), json_detail::is(block[i], json_detail::WHITESPACE)) << i;
+            EXPECT_EQ(bit(masks.quote), block[i] == '"') << i;
+            EXPECT_EQ(bit(masks.backslash), block[i] == '\\') << i;
+            EXPECT_EQ(bit(masks.structural), json_detail::is(block[i], json_detail::STRUCTURAL)) << i;
+        }
+    }
+}
+
+TEST(JsonLexerTest, TokenizesStructureAndScalars) {
+    const auto tokens = lex(" [ \"a\" , -1.5e+3 ,null,{\"k\":2}]\n");
+    const std::vector<TokenType> expected = {
+        TokenType::LBracket, TokenType::String, TokenType::Comma, TokenType::Number, TokenType::Comma,
+        TokenType::Null, TokenType::Comma, TokenType::LBrace, TokenType::String, TokenType::Colon,
+        TokenType::Number, TokenType::RBrace, TokenType::RBracket, TokenType::Eof,
+    };
+
+    ASSERT_EQ(tokens.size(), expected.size());
+    for (size_t i = 0; i < tokens.size(); ++i) EXPECT_EQ(tokens[i].type, expected[i]) << i;
+    EXPECT_EQ(tokens[1].text, "a");
+    EXPECT_EQ(tokens[3].text, "-1.5e+3");
+    EXPECT_EQ(tokens[8].text, "k");
+}
+
+TEST(JsonLexerTest, WhitespaceRunsOfEveryLengthAroundBlockBoundaries) {
+    for (size_t length = 0; length < 3 * json_detail::block_size; ++length) {
+        std::string source(length, ' ');
+        for (size_t i = 0; i < length; ++i) source[i] = " \t\n\r"[i % 4];
+        source += "null";
+        source += std::string(length, '\n');
+
+        const auto tokens = lex(source);
+        ASSERT_EQ(tokens.size(), 2u) << length;
+        EXPECT_EQ(tokens[0].type, TokenType::Null);
+        EXPECT_EQ(tokens[1].type, TokenType::Eof);
+    }
+}
+
+TEST(JsonLexerTest, StringsAreViewsIntoTheSourceAcrossBlocks) {
+    for (size_t length = 0; length < 3 * json_detail::block_size; ++length) {
+        std::string body(length, 'x');
+        // an escaped quote and backslash at varying offsets, including block edges
+        if (length >= 8) {
+            body[length / 3] = '\\';
+            body[length / 3 + 1] = '"';
+            body[length - 2] = '\\';
+            body[length - 1] = '\\';
+        }
+        const std::string source = "\"" + body + "\"";
+
+        const auto tokens = lex(source);
+        ASSERT_EQ(tokens.size(), 2u) << length;
+        ASSERT_EQ(tokens[0].type, TokenType::String) << length;
+        EXPECT_EQ(tokens[0].text, body);
+        EXPECT_EQ(tokens[0].text.data(), source.data() + 1);
+    }
+}
+
+TEST(JsonLexerTest, RandomTokenStreamsRoundTrip) {
+    std::mt19937 rng(1234);
+    const auto below = [&](size_t n) { return std::uniform_int_distribution<size_t>(0, n - 1)(rng); };
+
+    for (int round = 0; round < 300; ++round) {
+        std::string source;
+        std::vector<std::pair<TokenType, std::string>> expected;
+
+        const auto tokenCount = 1 + below(60);
+        for (size_t t = 0; t < tokenCount; ++t) {
+            source.append(below(4) == 0 ? below(80) : below(2), " \t\n\r"[below(4)]);
+
+            switch (below(4)) {
+                case 0: {
+                    static const std::string structural = "{}[]:,";
+                    const char c = structural[below(structural.size())];
+                    source += c;
+                    expected.emplace_back(JsonLexer{ std::string_view(&c, 1) }.next().type, std::string(1, c));
+                    break;
+                }
+                case 1: {
+                    // long runs of backslashes make escapes cross block boundaries
+                    std::string body;
+                    const auto length = below(150);
+                    while (body.size() < length) {
+                        if (below(6) == 0) body.append(2 * (1 + below(3)), '\\');
+                        else if (below(6) == 0) body += "\\\"";
+                        else body += static_cast<char>('a' + below(26));
+                    }
+                    source += '"' + body + '"';
+                    expected.emplace_back(TokenType::String, body);
+                    break;
+                }
+                case 2: {
+                    const auto number = std::to_string(static_cast<int>(below(200000)) - 100000) + (below(2) ? ".5e-3" : "");
+                    source += number;
+                    expected.emplace_back(TokenType::Number, number);
+                    break;
+                }
+                default:
+                    source += "null";
+                    expected.emplace_back(TokenType::Null, "null");
+                    break;
+            }
+            // scalars need a separator before the next token
+            source += ' ';
+        }
+
+        const auto tokens = lex(source);
+        ASSERT_EQ(tokens.size(), expected.size() + 1) << source;
+        for (size_t i = 0; i < expected.size(); ++i) {
+            EXPECT_EQ(tokens[i].type, expected[i].first) << i;
+            EXPECT_EQ(tokens[i].text, expected[i].second) << i;
+            EXPECT_EQ(source.substr(tokens[i].position, 1), tokens[i].type == TokenType::String ? "\"" : expected[i].second.substr(0, 1));
+        }
+        EXPECT_EQ(tokens.back().type, TokenType::Eof);
+    }
+}
+
+TEST(JsonLexerTest, GarbageAfterScalarIsAnError) {
+    const auto tokens = lex("[12x]");
+    ASSERT_EQ(tokens.size(), 3u);
+    EXPECT_EQ(tokens[1].text, "12");
+    EXPECT_EQ(tokens[2].type, TokenType::Error);
+    EXPECT_EQ(tokens[2].position, 3u);
+}
+
+TEST(JsonLexerTest, UnterminatedStringIsAnError) {
+    const std::string source = "\"" + std::string(100, 'x') + "\\\"";
+    const auto tokens = lex(source);
+    EXPECT_EQ(tokens.back().type, TokenType::Error);
+}
+
+TEST(JsonLexerTest, VerticalTabIsNotJsonWhitespace) {
+    const auto tokens = lex("\v1");
+    EXPECT_EQ(tokens.front().type, TokenType::Error);
+}
@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "io/json-lines.hpp"
+
+namespace {
+
+// one record per line, written the way Value writes them
+std::string make_lines(std::size_t count) {
+    std::string text;
+    for (std::size_t i = 0; i < count; ++i) {
+        auto record = Value::object_t{ };
+        record.emplace("id", Value{ static_cast<uint32_t>(i) });
+        record.emplace("name", Value{ "sensor " + std::to_string(i % 13) });
+        record.emplace("samples", Value{ std::vector<float>{ 0.5f, static_cast<float>(i) } });
+        text += Value{ std::move(record) }.toString();
+        text += '\n';
+    }
+    return text;
+}
+
+uint32_t id_of(const Value& record) {
+    return record.as<Value::object_t>().at("id").as<uint32_t>();
+}
+
+} // namespace
+
+TEST(JsonLinesParserTest, DeliversRecordsInOrder) {
+    const auto text = make_lines(2000);
+    for (const std::size_t workers : { 0u, 1u, 3u }) {
+        ThreadPool pool{ workers };
+        // chunks far smaller than the input, so every window holds many of them
+        JsonLinesParser parser{ pool, 512 };
+
+        std::vector<uint32_t> ids;
+        EXPECT_EQ(parser.parse(text, [&](Value&& record) { ids.push_back(id_of(record)); }), 2000u);
+
+        ASSERT_EQ(ids.size(), 2000u) << workers << " workers";
+        for (uint32_t i = 0; i < ids.size(); ++i) {
+            ASSERT_EQ(ids[i], i) << workers << " workers";
+        }
+    }
+}
+
+TEST(JsonLinesParserTest, AsParsedDeliversEveryRecordOnceAndNeverConcurrently) {
+    const auto text = make_lines(3000);
+    ThreadPool pool{ 3 };
+    JsonLinesParser parser{ pool, 256 };
+
+    std::atomic<int> inside{ 0 };
+    bool overlapped = false;
+    std::vector<uint32_t> ids;
+    const auto records = parser.parse(text, [&](Value&& record) {
+        overlapped |= ++inside > 1;
+        ids.push_back(id_of(record));
+        --inside;
+    }, JsonLinesParser::Delivery::AsParsed);
+
+    EXPECT_EQ(records, 3000u);
+    EXPECT_FALSE(overlapped);
+    std::sort(ids.begin(), ids.end());
+    ASSERT_EQ(ids.size(), 3000u);
+    for (uint32_t i = 0; i < ids.size(); ++i) {
+        ASSERT_EQ(ids[i], i);
+    }
+}
+
+TEST(JsonLinesParserTest, KeepsTypedValuesAndSkipsBlankLines) {
+    const std::string text = "\n{\"a\": 1}\r\n   \n\n[{ \"type\": \"uint64\", \"value\": 18446744073709551615 }, \"x\"]\r\n  null\n\"last\"";
+    ThreadPool pool{ 2 };
+    JsonLinesParser parser{ pool, 4 };
+
+    std::vector<Value> records;
+    EXPECT_EQ(parser.parse(text, [&](Value&& record) { records.push_back(std::move(record)); }), 4u);
+
+    ASSERT_EQ(records.size(), 4u);
+    EXPECT_DOUBLE_EQ(records[0].as<Value::object_t>().at("a").as<double>(), 1.0);
+    EXPECT_EQ(records[1].as<Value::array_t>()[0].as<uint64_t>(), ~uint64_t{ 0 });
+    EXPECT_TRUE(records[2].empty());
+    EXPECT_EQ(records[3].as<std::string>(), "last"); // no newline after the last record
+
+    EXPECT_EQ(parser.parse("", [](Value&&) { FAIL(); }), 0u);
+    EXPECT_EQ(parser.parse("\n\r\n  \n", [](Value&&) { FAIL(); }), 0u);
+}
+
+TEST(JsonLinesParserTest, ParsesMappedFiles) {
+    const std::string path = ::testing::TempDir() + "json-lines-test.jsonl";
+    {
+        std::ofstream os{ path, std::ios::binary };
+        os << make_lines(500);
+    }
+
+    ThreadPool pool{ 2 };
+    JsonLinesParser parser{ pool, 1024 };
+    uint32_t next = 0;
+    EXPECT_EQ(parser.parseFile(path, [&](Value&& record) { EXPECT_EQ(id_of(record), next++); }), 500u);
+    EXPECT_TRUE(parser.error().empty());
+
+    std::remove(path.c_str());
+    EXPECT_EQ(parser.parseFile(path, [](Value&&) { FAIL(); }), 0u);
+    EXPECT_FALSE(parser.error().empty());
+}
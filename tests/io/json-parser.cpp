@@ -0,0 +1,259 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "helpers/numbers.hpp"
+#include "io/json.hpp"
+
+namespace {
+
+template <typename T>
+Value round_trip(T value) {
+    std::ostringstream os;
+    Value{ value }.write_json(os);
+    return JsonParser{}.parse(os.str());
+}
+
+template <typename T>
+void expect_round_trip(T value) {
+    const auto parsed = round_trip(value);
+    ASSERT_TRUE(parsed.template is<T>()) << Value{ value }.toString();
+    EXPECT_EQ(std::memcmp(&parsed.template as<T>(), &value, sizeof(T)), 0) << Value{ value }.toString();
+}
+
+} // namespace
+
+TEST(JsonParserTest, DecodesEveryArithmeticTypeExactly) {
+    expect_round_trip(int32_t{ -7 });
+    expect_round_trip(std::numeric_limits<int32_t>::min());
+    expect_round_trip(std::numeric_limits<uint32_t>::max());
+    expect_round_trip(std::numeric_limits<int64_t>::min());
+    expect_round_trip(std::numeric_limits<uint64_t>::max()); // not representable as a double
+    expect_round_trip(char{ -128 });
+    expect_round_trip(char{ 'A' });
+    expect_round_trip(static_cast<unsigned char>(255));
+    expect_round_trip(0.1f);
+    expect_round_trip(std::numeric_limits<float>::denorm_min());
+    expect_round_trip(0.1);
+    expect_round_trip(-1e-300);
+    expect_round_trip(std::numeric_limits<double>::max());
+}
+
+TEST(JsonParserTest, WritesCharsAsNumbersAndFloatsShortest) {
+    EXPECT_EQ(Value{ char{ 'A' } }.toString(), R"({ "type": "char", "value": 65 })");
+    EXPECT_EQ(Value{ 0.1f }.toString(), R"({ "type": "float", "value": 0.1 })");
+    EXPECT_EQ(Value{ 1e21 }.toString(), R"({ "type": "double", "value": 1e+21 })");
+}
+
+TEST(JsonParserTest, RoundTripsRandomFloatsBitExactly) {
+    std::mt19937_64 rng{ 18 };
+    for (int i = 0; i < 2000; ++i) {
+        double d;
+        float f;
+        do {
+            const auto bits = rng();
+            std::memcpy(&d, &bits, sizeof(d));
+            const auto low = static_cast<uint32_t>(bits);
+            std::memcpy(&f, &low, sizeof(f));
+        } while (!std::isfinite(d) || !std::isfinite(f));
+
+        expect_round_trip(d);
+        expect_round_trip(f);
+    }
+}
+
+TEST(JsonParserTest, NonFiniteFloatsRoundTripThroughStrings) {
+    EXPECT_EQ(Value{ std::numeric_limits<double>::infinity() }.toString(),
+              R"({ "type": "double", "value": "inf" })");
+
+    EXPECT_EQ(round_trip(-std::numeric_limits<float>::infinity()).as<float>(),
+              -std::numeric_limits<float>::infinity());
+    EXPECT_TRUE(std::isnan(round_trip(std::numeric_limits<double>::quiet_NaN()).as<double>()));
+}
+
+TEST(JsonParserTest, ParsesNestedContainers) {
+    auto obj = Value::object_t{ };
+    obj.emplace("id", Value{ uint64_t{ 1234567890123456789u } });
+    obj.emplace("name", Value{ std::string{ "probe" } });
+    obj.emplace("samples", Value{ Value::array_t{ Value{ 1.5f }, Value{ int32_t{ -2 } }, Value{ std::string{ "x" } } } });
+    obj.emplace("empty", Value::object());
+
+    std::ostringstream os;
+    Value{ obj }.write_json(os);
+
+    std::istringstream is{ os.str() };
+    const auto parsed = Value::read_json(is);
+    ASSERT_TRUE(parsed.is<Value::object_t>()) << os.str();
+
+    const auto& members = parsed.as<Value::object_t>();
+    EXPECT_EQ(members.at("id").as<uint64_t>(), 1234567890123456789u);
+    EXPECT_EQ(members.at("name").as<std::string>(), "probe");
+    EXPECT_TRUE(members.at("empty").is<Value::object_t>());
+
+    const auto& samples = members.at("samples").as<Value::array_t>();
+    ASSERT_EQ(samples.size(), 3u);
+    EXPECT_EQ(samples[0].as<float>(), 1.5f);
+    EXPECT_EQ(samples[1].as<int32_t>(), -2);
+    EXPECT_EQ(samples[2].as<std::string>(), "x");
+}
+
+TEST(JsonParserTest, LoadsMappedFiles) {
+    auto obj = Value::object_t{ };
+    obj.emplace("name", Value{ std::string{ "probe" } });
+    obj.emplace("ticks", Value{ std::vector<uint64_t>{ 1, ~uint64_t{ 0 } } });
+
+    const std::string path = ::testing::TempDir() + "json-parser-test.json";
+    {
+        std::ofstream os{ path, std::ios::binary };
+        Value{ obj }.write_json(os);
+    }
+
+    const auto loaded = Value::load_json(path);
+    ASSERT_TRUE(loaded.is<Value::object_t>());
+    EXPECT_EQ(loaded.as<Value::object_t>().at("name").as<std::string>(), "probe");
+    EXPECT_EQ(loaded.as<Value::object_t>().at("ticks").as<std::vector<uint64_t>>()[1], ~uint64_t{ 0 });
+
+    std::remove(path.c_str());
+    EXPECT_TRUE(Value::load_json(path).empty());
+}
+
+TEST(JsonParserTest, PlainNumbersAreDoubles) {
+    const auto parsed = JsonParser{}.parse("[1, -2.5e3, 0.1]");
+    ASSERT_TRUE(parsed.is<Value::array_t>());
+    const auto& items = parsed.as<Value::array_t>();
+    ASSERT_EQ(items.size(), 3u);
+    EXPECT_EQ(items[0].as<double>(), 1.0);
+    EXPECT_EQ(items[1].as<double>(), -2500.0);
+    EXPECT_EQ(items[2].as<double>(), 0.1);
+}
+
+TEST(JsonParserTest, ObjectsThatOnlyLookLikeWrappersStayObjects) {
+    // unknown type name, extra member, value that does not fit the type
+    for (const auto* json : {
+             R"({ "type": "vector", "value": 1 })",
+             R"({ "type": "int32", "value": 1, "unit": "m" })",
+             R"({ "type": "uchar", "value": 300 })",
+         }) {
+        const auto parsed = JsonParser{}.parse(json);
+        ASSERT_TRUE(parsed.is<Value::object_t>()) << json;
+        EXPECT_TRUE(parsed.as<Value::object_t>().at("type").is<std::string>()) << json;
+    }
+
+    // with more members after it, the value is a plain number like any other member
+    const auto extra = JsonParser{}.parse(R"({ "type": "int32", "value": 1, "unit": "m" })");
+    ASSERT_TRUE(extra.as<Value::object_t>().at("value").is<double>());
+    EXPECT_EQ(extra.as<Value::object_t>().at("value").as<double>(), 1.0);
+
+    const auto tight = JsonParser{}.parse(R"({"type":"int32","value":5,"x":1})");
+    ASSERT_TRUE(tight.is<Value::object_t>());
+    const auto& members = tight.as<Value::object_t>();
+    ASSERT_TRUE(members.at("value").is<double>());
+    EXPECT_EQ(members.at("value").as<double>(), 5.0);
+    ASSERT_TRUE(members.at("x").is<double>());
+    EXPECT_EQ(members.at("x").as<double>(), 1.0);
+}
+
+TEST(JsonParserTest, TypedArraysRoundTrip) {
+    const auto check = [](auto items) {
+        using T = decltype(items);
+        for (const auto pretty : { false, true }) {
+            std::ostringstream os;
+            if (pretty) {
+                Value{ items }.write_pretty_json(os);
+            } else {
+                Value{ items }.write_json(os);
+            }
+            const auto parsed = JsonParser{}.parse(os.str());
+            ASSERT_TRUE(parsed.template is<T>()) << os.str();
+            EXPECT_EQ(parsed.template as<T>(), items) << os.str();
+        }
+    };
+
+    check(std::vector<int32_t>{ std::numeric_limits<int32_t>::min(), 0, 7 });
+    check(std::vector<uint32_t>{ 4000000000u });
+    check(std::vector<int64_t>{ -1, int64_t{ 1 } << 60 });
+    check(std::vector<uint64_t>{ ~uint64_t{ 0 } });
+    check(std::vector<char>{ 'a', '\0', '"' });
+    check(std::vector<unsigned char>{ 0, 255 });
+    check(std::vector<float>{ 0.1f, -1e-30f, std::numeric_limits<float>::infinity() });
+    check(std::vector<double>{ });
+
+    EXPECT_EQ((Value{ std::vector<uint32_t>{ 1, 2 } }.toString()), R"({ "type": "uint32[]", "value": [ 1, 2 ] })");
+
+    const auto nan = round_trip(std::vector<double>{ std::numeric_limits<double>::quiet_NaN() });
+    ASSERT_TRUE(nan.is<std::vector<double>>());
+    EXPECT_TRUE(std::isnan(nan.as<std::vector<double>>()[0]));
+}
+
+TEST(JsonParserTest, TypedArraysAreStrict) {
+    // an item that does not fit fails the whole parse, since the array cannot be re-read
+    for (const auto* json : {
+             R"({ "type": "uchar[]", "value": [ 1, 256 ] })",
+             R"({ "type": "int32[]", "value": [ 1.5 ] })",
+             R"({ "type": "float[]", "value": [ 1, [ 2 ] ] })",
+             R"({ "type": "float[]", "value": [ 1, ] })",
+         }) {
+        EXPECT_TRUE(JsonParser{}.parse(json).empty()) << json;
+    }
+
+    // not a bracketed value, or followed by more members: an ordinary object
+    const auto scalar = JsonParser{}.parse(R"({ "type": "float[]", "value": 1 })");
+    EXPECT_TRUE(scalar.is<Value::object_t>());
+    const auto extra = JsonParser{}.parse(R"({ "type": "float[]", "value": [ 1 ], "unit": "m" })");
+    ASSERT_TRUE(extra.is<Value::object_t>());
+    EXPECT_EQ(extra.as<Value::object_t>().at("value").as<std::vector<float>>(), std::vector<float>{ 1.0f });
+}
+
+TEST(JsonParserTest, DecodesUnicodeEscapesToUtf8) {
+    const auto parse = [](const std::string& json) { return JsonParser{}.parse(json).as<std::string>(); };
+    EXPECT_EQ(parse(R"("a\u0001b\u001F")"), "a\x01" "b\x1f");
+    EXPECT_EQ(parse(R"("\u00e9\u20AC")"), "\xc3\xa9\xe2\x82\xac");      // U+00E9 U+20AC
+    EXPECT_EQ(parse(R"("\ud83d\ude00!")"), "\xf0\x9f\x98\x80!");        // U+1F600, a surrogate pair
+    EXPECT_EQ(parse(R"("\ud83dx\ude00")"), "\xef\xbf\xbdx\xef\xbf\xbd");      // lone halves
+    EXPECT_EQ(parse(R"("\u12")"), "u12");                                     // too short: as before
+    EXPECT_EQ(parse(R"("\u0000")"), std::string(1, '\0'));
+}
+
+TEST(JsonParserTest, StringsRoundTripThroughTheWriter) {
+    // every byte value, so each control character is written as \u00XX and read back
+    std::string text;
+    for (int c = 0; c < 256; ++c) {
+        text += static_cast<char>(c);
+    }
+    for (const auto& sample : { text, std::string{ "plain" }, std::string{ "\x01" }, std::string{ "tab\tquote\"" } }) {
+        const auto parsed = JsonParser{}.parse(Value{ sample }.toString());
+        ASSERT_TRUE(parsed.is<std::string>());
+        EXPECT_EQ(parsed.as<std::string>(), sample);
+    }
+}
+
+TEST(JsonParserTest, RejectsMalformedObjects) {
+    for (const auto* json : { R"({ "a" 1 })", R"({ 1: 2 })", R"({ "a": 1 )", R"({ "a": 1, })" }) {
+        EXPECT_TRUE(JsonParser{}.parse(json).empty()) << json;
+    }
+}
+
+TEST(NumbersTest, ParseRejectsTrailingCharactersAndOverflow) {
+    int32_t i = 0;
+    EXPECT_FALSE(num::parse("12x", i));
+    EXPECT_FALSE(num::parse("2147483648", i));
+    EXPECT_TRUE(num::parse("-2147483648", i));
+    EXPECT_EQ(i, std::numeric_limits<int32_t>::min());
+
+    unsigned char c = 0;
+    EXPECT_FALSE(num::parse("-1", c));
+    EXPECT_FALSE(num::parse("256", c));
+
+    double d = 0.0;
+    EXPECT_FALSE(num::parse("", d));
+    EXPECT_TRUE(num::parse("-0.0e0", d));
+    EXPECT_TRUE(std::signbit(d));
+}
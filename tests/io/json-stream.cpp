@@ -0,0 +1,188 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "io/json-stream.hpp"
+
+namespace {
+
+// records every event as text, e.g. "{", "k:name", "s:value", "n:1.5", "null", "}"
+class RecordingHandler : public IJsonHandler {
+public:
+    std::vector<std::string> events;
+    size_t stopAfter = SIZE_MAX;
+
+    bool beginObject() override { return push("{"); }
+    bool endObject() override { return push("}"); }
+    bool beginArray() override { return push("["); }
+    bool endArray() override { return push("]"); }
+    bool key(std::string_view raw) override { return push("k:" + std::string(raw)); }
+    bool string(std::string_view raw) override { return push("s:" + std::string(raw)); }
+    bool number(std::string_view text) override { return push("n:" + std::string(text)); }
+    bool null() override { return push("null"); }
+
+private:
+    bool push(std::string event) {
+        events.push_back(std::move(event));
+        return events.size() < stopAfter;
+    }
+};
+
+const std::string document = R"({
+    "name": "sensor \"A\"",
+    "values": [1, -2.5, 3e2, null],
+    "nested": { "empty": {}, "list": [[], [ "x" ]] },
+    "path\\with\\backslashes": "\\\\"
+})";
+
+std::vector<std::string> parse_in_chunks(const std::string& json, const std::vector<size_t>& cuts) {
+    RecordingHandler handler;
+    JsonStreamParser parser{ handler };
+    size_t begin = 0;
+    for (const auto cut : cuts) {
+        EXPECT_TRUE(parser.feed(std::string_view(json).substr(begin, cut - begin))) << parser.error();
+        begin = cut;
+    }
+    EXPECT_TRUE(parser.feed(std::string_view(json).substr(begin))) << parser.error();
+    EXPECT_TRUE(parser.finish()) << parser.error();
+    return handler.events;
+}
+
+} // namespace
+
+TEST(JsonStreamParserTest, EmitsEventsInDocumentOrder) {
+    const auto events = parse_in_chunks(document, {});
+    const std::vector<std::string> expected = {
+        "{", "k:name", "s:sensor \\\"A\\\"",
+        "k:values", "[", "n:1", "n:-2.5", "n:3e2", "null", "]",
+        "k:nested", "{", "k:empty", "{", "}", "k:list", "[", "[", "]", "[", "s:x", "]", "]", "}",
+        "k:path\\\\with\\\\backslashes", "s:\\\\\\\\",
+        "}",
+    };
+    EXPECT_EQ(events, expected);
+}
+
+TEST(JsonStreamParserTest, AnyChunkingGivesTheSameEvents) {
+    const auto whole = parse_in_chunks(document, {});
+
+    // every single split point, then byte-by-byte
+    for (size_t cut = 1; cut < document.size(); ++cut) {
+        ASSERT_EQ(parse_in_chunks(document, { cut }), whole) << cut;
+    }
+
+    std::vector<size_t> everyByte;
+    for (size_t i = 1; i < document.size(); ++i) everyByte.push_back(i);
+    EXPECT_EQ(parse_in_chunks(document, everyByte), whole);
+}
+
+TEST(JsonStreamParserTest, DeepNestingDoesNotRecurse) {
+    constexpr size_t depth = 200000;
+    const std::string json = std::string(depth, '[') + std::string(depth, ']');
+
+    RecordingHandler handler;
+    JsonStreamParser parser{ handler };
+    EXPECT_TRUE(parser.feed(json));
+    EXPECT_TRUE(parser.finish());
+    EXPECT_EQ(handler.events.size(), 2 * depth);
+}
+
+TEST(JsonStreamParserTest, AcceptsConsecutiveTopLevelValues) {
+    RecordingHandler handler;
+    JsonStreamParser parser{ handler };
+    EXPECT_TRUE(parser.feed("{\"a\":1}\n{\"a\":2}\n12"));
+    EXPECT_TRUE(parser.feed("3\n"));
+    EXPECT_TRUE(parser.finish());
+
+    const std::vector<std::string> expected = { "{", "k:a", "n:1", "}", "{", "k:a", "n:2", "}", "n:123" };
+    EXPECT_EQ(handler.events, expected);
+}
+
+TEST(JsonStreamParserTest, ReportsSyntaxErrorsWithTheirOffset) {
+    const struct { std::string json; std::string_view error; uint64_t offset; } cases[] = {
+        { "[1 2]", "expected ',' or the end of the container", 3 },
+        { "[1,]", "expected a value", 3 },
+        { "{\"a\" 1}", "expected ':'", 5 },
+        { "{1:2}", "expected a string key", 1 },
+        { "{\"a\":1,}", "expected a string key", 7 },
+        { "[1, \"open", "unexpected EOF", 4 },
+        { "{\"a\": [1]", "unexpected EOF inside a container", 9 },
+        { "[nul]", "unexpected character", 1 },
+    };
+
+    for (const auto& c : cases) {
+        RecordingHandler handler;
+        JsonStreamParser parser{ handler };
+        const bool ok = parser.feed(c.json) && parser.finish();
+        EXPECT_FALSE(ok) << c.json;
+        EXPECT_EQ(parser.error(), c.error) << c.json;
+        EXPECT_EQ(parser.errorOffset(), c.offset) << c.json;
+        EXPECT_FALSE(parser.feed("[]")) << "stays failed";
+    }
+}
+
+TEST(JsonStreamParserTest, HandlerCanStopParsing) {
+    RecordingHandler handler;
+    handler.stopAfter = 3;
+    JsonStreamParser parser{ handler };
+    EXPECT_FALSE(parser.feed("[1, 2, 3, 4]"));
+    EXPECT_EQ(parser.error(), "stopped by the handler");
+    EXPECT_EQ(handler.events.size(), 3u);
+}
+
+TEST(JsonValueCollectorTest, BuildsOnlyTheSelectedSubtrees) {
+    const std::string json = R"({
+        "frames": [
+            { "id": 1, "pose": { "x": 1.5, "tags": ["a", "b"] } },
+            { "id": 2, "pose": null },
+            { "id": 3 }
+        ],
+        "pose": "not selected"
+    })";
+
+    std::vector<Value> poses;
+    JsonValueCollector collector("/frames/*/pose", [&](Value&& value) { poses.push_back(std::move(value)); });
+    JsonStreamParser parser{ collector };
+
+    // split inside a key and inside a number on purpose
+    ASSERT_TRUE(parser.feed(std::string_view(json).substr(0, 60)));
+    ASSERT_TRUE(parser.feed(std::string_view(json).substr(60, 17)));
+    ASSERT_TRUE(parser.feed(std::string_view(json).substr(77)));
+    ASSERT_TRUE(parser.finish());
+
+    ASSERT_EQ(poses.size(), 2u);
+    ASSERT_TRUE(poses[0].is<Value::object_t>());
+    const auto& pose = poses[0].as<Value::object_t>();
+    EXPECT_DOUBLE_EQ(pose.at("x").as<double>(), 1.5);
+    ASSERT_EQ(pose.at("tags").as<Value::array_t>().size(), 2u);
+    EXPECT_EQ(pose.at("tags").as<Value::array_t>()[1].as<std::string>(), "b");
+    EXPECT_TRUE(poses[1].empty());
+}
+
+TEST(JsonValueCollectorTest, MatchesIndicesEscapedKeysAndTheRoot) {
+    std::vector<Value> values;
+    const auto collect = [&](Value&& value) { values.push_back(std::move(value)); };
+
+    {
+        JsonValueCollector collector("/list/1", collect);
+        JsonStreamParser parser{ collector };
+        ASSERT_TRUE(parser.feed(R"({"list": ["a", "b", "c"]})") && parser.finish());
+    }
+    {
+        JsonValueCollector collector("/a~1b/q\"", collect);
+        JsonStreamParser parser{ collector };
+        ASSERT_TRUE(parser.feed(R"({"a/b": {"q\"": "hit"}})") && parser.finish());
+    }
+    {
+        JsonValueCollector collector("", collect);
+        JsonStreamParser parser{ collector };
+        ASSERT_TRUE(parser.feed("[1] [2]") && parser.finish());
+    }
+
+    ASSERT_EQ(values.size(), 4u);
+    EXPECT_EQ(values[0].as<std::string>(), "b");
+    EXPECT_EQ(values[1].as<std::string>(), "hit");
+    EXPECT_EQ(values[2].as<Value::array_t>()[0].as<double>(), 1.0);
+    EXPECT_EQ(values[3].as<Value::array_t>()[0].as<double>(), 2.0);
+}
@@ -0,0 +1,154 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <string>
+
+#include "io/json-tape.hpp"
+
+namespace {
+
+bool in_source(const std::string& source, std::string_view view) {
+    return view.data() >= source.data() && view.data() + view.size() <= source.data() + source.size();
+}
+
+} // namespace
+
+TEST(JsonTapeTest, FindsNestedFieldsByPath) {
+    const std::string json = R"({
+        "meta": { "name": "run \"7\"", "count": 3 },
+        "frames": [
+            { "t": 0.5, "pos": [1, 2, 3] },
+            { "t": 1.0, "pos": [4, 5, 6] },
+            { "t": 1.5, "pos": [7, 8, 9], "extra": null }
+        ],
+        "last": -12
+    })";
+
+    JsonTape tape;
+    ASSERT_TRUE(tape.parse(json)) << tape.error();
+
+    EXPECT_EQ(tape.find("meta/name").as_string(), "run \"7\"");
+    EXPECT_EQ(tape.find("/meta/count").as_int(), 3);
+    EXPECT_DOUBLE_EQ(tape.find("frames/2/t").as_double(), 1.5);
+    EXPECT_EQ(tape.find("frames/1/pos/2").as_int(), 6);
+    EXPECT_TRUE(tape.find("frames/2/extra").is_null());
+    EXPECT_EQ(tape.find("last").as_int(), -12);
+
+    EXPECT_EQ(tape.find("frames").size(), 3u);
+    EXPECT_EQ(tape.find("frames/0").size(), 2u);
+    EXPECT_EQ(tape.root()["frames"][1]["pos"][0].as_int(), 4);
+}
+
+TEST(JsonTapeTest, MissingPathsGiveInvalidRefs) {
+    JsonTape tape;
+    ASSERT_TRUE(tape.parse(R"({"list": [1, 2], "obj": {"k": "v"}})"));
+
+    EXPECT_FALSE(tape.find("nope"));
+    EXPECT_FALSE(tape.find("list/2"));
+    EXPECT_FALSE(tape.find("list/x"));
+    EXPECT_FALSE(tape.find("obj/k/deeper"));
+    EXPECT_FALSE(tape.find("obj/missing/k"));
+    EXPECT_EQ(tape.find("nope").type(), TokenType::Eof);
+    EXPECT_EQ(tape.find("nope").as_string(), "");
+    EXPECT_EQ(tape.find("nope").size(), 0u);
+}
+
+TEST(JsonTapeTest, RawTextIsAViewIntoTheSource) {
+    const std::string json = R"({"s": "esc\"aped", "n": 1e3, "arr": ["x"]})";
+    JsonTape tape;
+    ASSERT_TRUE(tape.parse(json));
+
+    // nothing is converted until asked
+    EXPECT_EQ(tape.find("s").raw(), "esc\\\"aped");
+    EXPECT_TRUE(in_source(json, tape.find("s").raw()));
+    EXPECT_TRUE(in_source(json, tape.find("n").raw()));
+    EXPECT_TRUE(in_source(json, tape.find("arr/0").raw()));
+    EXPECT_DOUBLE_EQ(tape.find("n").as_double(), 1000.0);
+
+    // a top-level scalar at the very end is not copied either
+    const std::string scalar = "42";
+    ASSERT_TRUE(tape.parse(scalar));
+    EXPECT_TRUE(in_source(scalar, tape.root().raw()));
+    EXPECT_EQ(tape.root().as_int(), 42);
+}
+
+TEST(JsonTapeTest, AsIntReadsTheWholeNumber) {
+    JsonTape tape;
+    const std::string json = R"([1e3, 2.5e1, -7.9, 0.5, 9223372036854775807, 1e30, -1e30, -0.0, 12])";
+    ASSERT_TRUE(tape.parse(json));
+
+    const auto items = tape.root();
+    EXPECT_EQ(items[0].as_int(), 1000);
+    EXPECT_EQ(items[1].as_int(), 25);
+    EXPECT_EQ(items[2].as_int(), -7);
+    EXPECT_EQ(items[3].as_int(), 0);
+    EXPECT_EQ(items[4].as_int(), std::numeric_limits<int64_t>::max()); // exact, not via double
+    EXPECT_EQ(items[5].as_int(), std::numeric_limits<int64_t>::max());
+    EXPECT_EQ(items[6].as_int(), std::numeric_limits<int64_t>::min());
+    EXPECT_EQ(items[7].as_int(), 0);
+    EXPECT_EQ(items[8].as_int(), 12);
+}
+
+TEST(JsonTapeTest, OpensFilesInPlace) {
+    const std::string path = ::testing::TempDir() + "json-tape-test.json";
+    {
+        std::ofstream os{ path, std::ios::binary };
+        os << R"({"pose": {"x": 1.5}, "name": "probe"})";
+    }
+
+    JsonTape tape;
+    ASSERT_TRUE(tape.open(path)) << tape.error();
+    EXPECT_EQ(tape.find("name").raw(), "probe");
+    EXPECT_DOUBLE_EQ(tape.find("pose/x").as_double(), 1.5);
+
+    // the mapping outlives the file's name, and parse() drops it for caller-owned text
+    std::remove(path.c_str());
+    EXPECT_EQ(tape.find("name").as_string(), "probe");
+    const std::string json = "[1]";
+    ASSERT_TRUE(tape.parse(json));
+    EXPECT_TRUE(in_source(json, tape.find("0").raw()));
+
+    EXPECT_FALSE(tape.open(path));
+    EXPECT_FALSE(tape.error().empty());
+    EXPECT_FALSE(tape.root());
+}
+
+TEST(JsonTapeTest, EscapedKeysAndPointerEscapes) {
+    JsonTape tape;
+    ASSERT_TRUE(tape.parse(R"({"a/b": {"c~d": 1}, "q\"k": 2})"));
+
+    EXPECT_EQ(tape.find("a~1b/c~0d").as_int(), 1);
+    EXPECT_EQ(tape.find("q\"k").as_int(), 2);
+    EXPECT_EQ(tape.root()["q\"k"].as_int(), 2);
+}
+
+TEST(JsonTapeTest, ConvertsOnlyTheRequestedSubtree) {
+    JsonTape tape;
+    ASSERT_TRUE(tape.parse(R"({"skip": [1, 2, 3], "take": {"x": [1.5, "y", null]}})"));
+
+    const auto value = tape.find("take").to_value();
+    const auto& x = value.as<Value::object_t>().at("x").as<Value::array_t>();
+    ASSERT_EQ(x.size(), 3u);
+    EXPECT_DOUBLE_EQ(x[0].as<double>(), 1.5);
+    EXPECT_EQ(x[1].as<std::string>(), "y");
+    EXPECT_TRUE(x[2].empty());
+}
+
+TEST(JsonTapeTest, RecordsOneEntryPerValueAndKey) {
+    JsonTape tape;
+    ASSERT_TRUE(tape.parse(R"({"a": [1, {"b": null}], "c": "d"})"));
+    // {  "a"  [  1  {  "b"  null  "c"  "d": closing brackets are not recorded
+    EXPECT_EQ(tape.size(), 9u);
+}
+
+TEST(JsonTapeTest, RejectsInvalidDocuments) {
+    JsonTape tape;
+    EXPECT_FALSE(tape.parse(R"({"a": })"));
+    EXPECT_FALSE(tape.root());
+    EXPECT_FALSE(tape.error().empty());
+
+    EXPECT_FALSE(tape.parse("1 2"));
+    EXPECT_EQ(tape.error(), "more than one top-level value");
+}
@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <random>
+#include <sstream>
+#include <string>
+
+#include <unistd.h>
+
+#include "helpers/strings.hpp"
+#include "io/json.hpp"
+#include "io/json-writer.hpp"
+
+TEST(JsonWriterTest, EscapesLikeStrEscapeAtEveryPosition) {
+    // specials land at every offset within and across vector widths; UTF-8 bytes pass through
+    const std::string specials = std::string{ "\"\\\b\f\n\r\t\x01\x1f" } + '\0';
+    std::mt19937 rng{ 19 };
+    for (std::size_t length = 0; length < 100; ++length) {
+        for (int round = 0; round < 8; ++round) {
+            std::string text;
+            for (std::size_t i = 0; i < length; ++i) {
+                const auto pick = rng() % 8;
+                text += pick == 0 ? specials[rng() % specials.size()]
+                      : pick == 1 ? static_cast<char>(0x80 + rng() % 0x80)
+                                  : static_cast<char>('a' + rng() % 26);
+            }
+
+            JsonWriter writer;
+            writer.writeString(text);
+            ASSERT_EQ(writer.view(), "\"" + str::escape(text) + "\"") << "length " << length;
+        }
+    }
+}
+
+TEST(JsonWriterTest, MatchesValueFormatting) {
+    auto obj = Value::object_t{ };
+    obj.emplace("name", Value{ std::string{ "line\n\"two\"" } });
+    obj.emplace("n", Value{ int32_t{ -3 } });
+
+    JsonWriter writer;
+    writer.write(Value{ Value::array_t{ Value{ }, Value{ 2.5 }, Value{ obj } } });
+
+    const auto parsed = JsonParser{}.parse(writer.view());
+    ASSERT_TRUE(parsed.is<Value::array_t>()) << writer.view();
+    const auto& items = parsed.as<Value::array_t>();
+    ASSERT_EQ(items.size(), 2u); // the parser drops nulls inside arrays
+    EXPECT_EQ(items[0].as<double>(), 2.5);
+    EXPECT_EQ(items[1].as<Value::object_t>().at("name").as<std::string>(), "line\n\"two\"");
+    EXPECT_EQ(items[1].as<Value::object_t>().at("n").as<int32_t>(), -3);
+
+    const auto mixed = Value{ Value::array_t{ Value{ std::string{ "a" } }, Value{ } } };
+    EXPECT_EQ(mixed.toString(), R"([ "a", null ])");
+    EXPECT_EQ(Value::object().toString(), "{  }");
+}
+
+TEST(JsonWriterTest, PrettyOutput) {
+    auto obj = Value::object_t{ };
+    obj.emplace("v", Value{ uint32_t{ 7 } });
+
+    JsonWriter writer;
+    writer.writePretty(Value{ obj }, "\t");
+    EXPECT_EQ(writer.view(), "{ \t\"v\": {\n\t\t\"type\": \"uint32\",\n\t\t\"value\": 7\n } }");
+
+    std::ostringstream os;
+    Value{ obj }.write_pretty_json(os, "\t");
+    EXPECT_EQ(os.str(), writer.view());
+}
+
+TEST(JsonWriterTest, ReusesItsBufferAcrossFlushes) {
+    const auto value = Value{ Value::array_t(100, Value{ std::string(50, 'x') }) };
+
+    JsonWriter writer;
+    writer.write(value);
+    const auto* data = writer.view().data();
+    const auto size = writer.size();
+
+    std::ostringstream os;
+    EXPECT_TRUE(writer.flush(os));
+    EXPECT_EQ(os.str().size(), size);
+    EXPECT_EQ(writer.size(), 0u);
+
+    writer.write(value);
+    EXPECT_EQ(writer.view().data(), data);
+    EXPECT_EQ(writer.view(), os.str());
+}
+
+TEST(JsonWriterTest, FixedBufferKeepsACleanPrefixOnOverflow) {
+    std::array<char, 16> buffer{ };
+    JsonWriter writer{ buffer };
+
+    writer.writeString("short");
+    EXPECT_FALSE(writer.overflowed());
+    EXPECT_EQ(writer.view(), "\"short\"");
+    EXPECT_EQ(writer.view().data(), buffer.data());
+
+    writer.writeString("this one does not fit");
+    writer.writeString("x"); // would fit on its own, but must not be appended after a gap
+    EXPECT_TRUE(writer.overflowed());
+    EXPECT_EQ(writer.view().substr(0, 7), "\"short\"");
+    EXPECT_LE(writer.size(), buffer.size());
+
+    std::ostringstream os;
+    EXPECT_FALSE(writer.flush(os));
+
+    // clear() makes the whole span available again
+    writer.writeString("again");
+    EXPECT_FALSE(writer.overflowed());
+    EXPECT_EQ(writer.view(), "\"again\"");
+}
+
+TEST(JsonWriterTest, FixedBufferHoldsOutputOfExactlyItsSize) {
+    auto obj = Value::object_t{ };
+    obj.emplace("n", Value{ int32_t{ 5 } });
+    for (const auto& value : { Value{ int32_t{ 5 } }, Value{ -0.125 }, Value{ std::nan("") }, Value{ obj },
+                               Value{ std::vector<float>{ 1.5f, 2.0f, 3.25f } } }) {
+        const auto expected = value.toString();
+
+        std::string buffer(expected.size(), '\0');
+        JsonWriter writer{ buffer };
+        writer.write(value);
+        EXPECT_FALSE(writer.overflowed()) << expected;
+        EXPECT_EQ(writer.view(), expected);
+
+        // and one byte less does not fit
+        std::string smaller(expected.size() - 1, '\0');
+        JsonWriter shortWriter{ smaller };
+        shortWriter.write(value);
+        EXPECT_TRUE(shortWriter.overflowed()) << expected;
+    }
+}
+
+TEST(JsonWriterTest, FlushesToAFileDescriptor) {
+    int fds[2];
+    ASSERT_EQ(::pipe(fds), 0);
+
+    JsonWriter writer;
+    writer.write(Value{ std::string{ "piped" } });
+    EXPECT_TRUE(writer.flush(fds[1]));
+    ::close(fds[1]);
+
+    char buffer[64];
+    const auto count = ::read(fds[0], buffer, sizeof(buffer));
+    ::close(fds[0]);
+    EXPECT_EQ(std::string(buffer, count > 0 ? static_cast<std::size_t>(count) : 0), "\"piped\"");
+}
@@ -0,0 +1,259 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include "math/fast.hpp"
+#include "math/interpolation.hpp"
+
+using namespace math;
+
+namespace
+{
+    // Not a multiple of any SIMD width, so the batched kernels also run into the padding.
+    constexpr std::size_t kCount = 37;
+
+    template <typename T>
+    Quaternion<T> random_rotation(std::mt19937 & rng)
+    {
+        std::normal_distribution<T> normal;
+        return Quaternion<T>(normal(rng), normal(rng), normal(rng), normal(rng)).normalized();
+    }
+
+    // angle of the rotation taking b to a, for nearby unit quaternions (either sign)
+    template <typename T>
+    double angle_between(const Quaternion<T> & a, const Quaternion<T> & b)
+    {
+        const Vector4<double> da{ a.x(), a.y(), a.z(), a.w() };
+        const Vector4<double> db{ b.x(), b.y(), b.z(), b.w() };
+        return 2.0 * std::min((da - db).length(), (da + db).length());
+    }
+
+    // the reference, evaluated in double
+    template <typename T>
+    Quaternion<double> exact_slerp(const Quaternion<T> & a, const Quaternion<T> & b, T t)
+    {
+        return slerp(Quaternion<double>(a.x(), a.y(), a.z(), a.w()), Quaternion<double>(b.x(), b.y(), b.z(), b.w()),
+                     static_cast<double>(t));
+    }
+
+    template <typename T>
+    VectorSOA<4, T> to_soa(const std::vector<Quaternion<T>> & qs)
+    {
+        VectorSOA<4, T> out(qs.size());
+        out.resize(qs.size());
+        for (std::size_t i = 0; i < qs.size(); ++i)
+        {
+            out.data(0)[i] = qs[i].x();
+            out.data(1)[i] = qs[i].y();
+            out.data(2)[i] = qs[i].z();
+            out.data(3)[i] = qs[i].w();
+        }
+        return out;
+    }
+
+    template <typename T>
+    Quaternion<T> at(const VectorSOA<4, T> & soa, std::size_t i)
+    {
+        return Quaternion<T>(soa.data(0)[i], soa.data(1)[i], soa.data(2)[i], soa.data(3)[i]);
+    }
+}
+
+template <typename T>
+struct FastTypedTest : ::testing::Test {};
+
+using FloatTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(FastTypedTest, FloatTypes);
+
+TYPED_TEST(FastTypedTest, RsqrtRelativeErrorIsBelowOneInAMillion)
+{
+    using T = TypeParam;
+    double worst = 0.0;
+    for (double x = 1e-6; x < 1e6; x *= 1.001)
+    {
+        const auto exact = 1.0 / std::sqrt(static_cast<double>(static_cast<T>(x)));
+        worst = std::max(worst, std::abs(fast::rsqrt(static_cast<T>(x)) - exact) / exact);
+    }
+    EXPECT_LT(worst, 1e-6);
+
+    // and the batch form, through soa normalize against the exact kernel
+    VectorSOA<3, T> v(kCount);
+    v.resize(kCount);
+    for (std::size_t i = 0; i < kCount; ++i)
+    {
+        v.data(0)[i] = static_cast<T>(i) * T(0.5) + T(0.1);
+        v.data(1)[i] = T(3) - static_cast<T>(i);
+        v.data(2)[i] = T(0.25);
+    }
+    VectorSOA<3, T> fast_out(kCount);
+    VectorSOA<3, T> exact_out(kCount);
+    fast_out.resize(kCount);
+    exact_out.resize(kCount);
+    fast::normalize(fast_out, v);
+    soa::normalize(exact_out, v);
+    for (std::size_t i = 0; i < kCount; ++i)
+    {
+        for (std::size_t c = 0; c < 3; ++c)
+        {
+            EXPECT_NEAR(fast_out.data(c)[i], exact_out.data(c)[i], 1e-6) << "i=" << i << " c=" << c;
+        }
+    }
+}
+
+TYPED_TEST(FastTypedTest, NormalizedMatchesVectorNormalized)
+{
+    using T = TypeParam;
+    const Vector4<T> v{ T(1), T(-2), T(3), T(0.5) };
+    const auto fast_v = fast::normalized(v);
+    const auto exact = v.normalized();
+    for (std::size_t c = 0; c < 4; ++c)
+    {
+        EXPECT_NEAR(fast_v[c], exact[c], 1e-6);
+    }
+
+    auto in_place = Vector3<T>{ T(0), T(4), T(3) };
+    fast::normalize(in_place);
+    EXPECT_NEAR(in_place[1], T(0.8), 1e-6);
+
+    // as the exact versions: zero out, or leave alone, anything within epsilon of zero
+    EXPECT_EQ(fast::normalized(Vector3<T>::zero), Vector3<T>::zero);
+    auto tiny = Vector3<T>{ epsilon_v<T> / 4, T(0), T(0) };
+    fast::normalize(tiny);
+    EXPECT_EQ(tiny[0], epsilon_v<T> / 4);
+}
+
+TYPED_TEST(FastTypedTest, SlerpStaysWithinTheDocumentedBound)
+{
+    using T = TypeParam;
+    std::mt19937 rng{ 7 };
+    std::uniform_real_distribution<T> weight{ T(0), T(1) };
+
+    double worst_slerp = 0.0;
+    double worst_nlerp = 0.0;
+    for (int i = 0; i < 20000; ++i)
+    {
+        const auto a = random_rotation<T>(rng);
+        const auto b = random_rotation<T>(rng);
+        const auto t = weight(rng);
+        const auto exact = exact_slerp(a, b, t);
+        worst_slerp = std::max(worst_slerp, angle_between(fast::slerp(a, b, t), Quaternion<T>(exact.x(), exact.y(), exact.z(), exact.w())));
+        worst_nlerp = std::max(worst_nlerp, angle_between(fast::nlerp(a, b, t), Quaternion<T>(exact.x(), exact.y(), exact.z(), exact.w())));
+    }
+    EXPECT_LT(worst_slerp, 1e-3);
+    EXPECT_LT(worst_nlerp, 0.15);
+    // the correction buys more than two orders of magnitude over plain nlerp
+    EXPECT_LT(worst_slerp * 100, worst_nlerp);
+}
+
+TYPED_TEST(FastTypedTest, SlerpHitsTheEndpointsAndTakesTheShortArc)
+{
+    using T = TypeParam;
+    const auto a = Quaternion<T>(T(0), T(0), T(0), T(1));
+    const auto b = Quaternion<T>(T(0), T(1), T(0), T(1)).normalized();
+
+    EXPECT_LT(angle_between(fast::slerp(a, b, T(0)), a), 1e-6);
+    EXPECT_LT(angle_between(fast::slerp(a, b, T(1)), b), 1e-6);
+
+    // -b is the same rotation; the blend must not swing the long way round
+    const auto negated = Quaternion<T>(-b.x(), -b.y(), -b.z(), -b.w());
+    EXPECT_LT(angle_between(fast::slerp(a, negated, T(0.5)), fast::slerp(a, b, T(0.5))), 1e-6);
+    EXPECT_LT(angle_between(fast::nlerp(a, negated, T(0.5)), fast::nlerp(a, b, T(0.5))), 1e-6);
+}
+
+TYPED_TEST(FastTypedTest, BatchedBlendsMatchTheScalarOnes)
+{
+    using T = TypeParam;
+    std::mt19937 rng{ 11 };
+    std::vector<Quaternion<T>> qa, qb;
+    std::vector<T> weights;
+    for (std::size_t i = 0; i < kCount; ++i)
+    {
+        qa.push_back(random_rotation<T>(rng));
+        qb.push_back(random_rotation<T>(rng));
+        weights.push_back(static_cast<T>(i) / static_cast<T>(kCount - 1));
+    }
+    const auto a = to_soa(qa);
+    const auto b = to_soa(qb);
+
+    VectorSOA<4, T> out(kCount);
+    out.resize(kCount);
+
+    fast::slerp(out, a, b, T(0.3));
+    for (std::size_t i = 0; i < kCount; ++i)
+    {
+        EXPECT_LT(angle_between(at(out, i), fast::slerp(qa[i], qb[i], T(0.3))), 1e-5) << i;
+    }
+
+    fast::nlerp(out, a, b, T(0.3), soa::store_mode::streaming);
+    for (std::size_t i = 0; i < kCount; ++i)
+    {
+        EXPECT_LT(angle_between(at(out, i), fast::nlerp(qa[i], qb[i], T(0.3))), 1e-5) << i;
+    }
+
+    fast::slerp(out, a, b, std::span<const T>{ weights });
+    for (std::size_t i = 0; i < kCount; ++i)
+    {
+        EXPECT_LT(angle_between(at(out, i), fast::slerp(qa[i], qb[i], weights[i])), 1e-5) << i;
+    }
+
+    // the padding stays finite
+    for (std::size_t i = kCount; i < out.padded_size(); ++i)
+    {
+        EXPECT_TRUE(std::isfinite(out.data(0)[i])) << i;
+    }
+
+    // in place over one of the inputs
+    auto blended = to_soa(qa);
+    fast::slerp(blended, blended, b, T(1));
+    for (std::size_t i = 0; i < kCount; ++i)
+    {
+        EXPECT_LT(angle_between(at(blended, i), qb[i]), 1e-5) << i;
+    }
+}
+
+TYPED_TEST(FastTypedTest, LargerOutputsKeepTheirElementsPastTheInput)
+{
+    using T = TypeParam;
+    constexpr std::size_t kInput = 5;
+    constexpr std::size_t kOutput = 20;
+    std::mt19937 rng{ 5 };
+    std::vector<Quaternion<T>> qa, qb, filler;
+    for (std::size_t i = 0; i < kInput; ++i)
+    {
+        qa.push_back(random_rotation<T>(rng));
+        qb.push_back(random_rotation<T>(rng));
+    }
+    for (std::size_t i = 0; i < kOutput; ++i)
+    {
+        filler.push_back(random_rotation<T>(rng));
+    }
+    const auto a = to_soa(qa);
+    const auto b = to_soa(qb);
+    const std::vector<T> weights(kInput, T(0.3));
+
+    const auto check = [&](const char * op, auto run, auto expected)
+    {
+        auto out = to_soa(filler);
+        run(out);
+        for (std::size_t i = 0; i < kInput; ++i)
+        {
+            EXPECT_LT(angle_between(at(out, i), expected(i)), 1e-5) << op << " i=" << i;
+        }
+        for (std::size_t i = kInput; i < kOutput; ++i)
+        {
+            EXPECT_EQ(at(out, i).vector(), filler[i].vector()) << op << " i=" << i;
+        }
+    };
+
+    check("nlerp", [&](auto & out) { fast::nlerp(out, a, b, T(0.3)); },
+          [&](std::size_t i) { return fast::nlerp(qa[i], qb[i], T(0.3)); });
+    check("slerp", [&](auto & out) { fast::slerp(out, a, b, T(0.3), soa::store_mode::streaming); },
+          [&](std::size_t i) { return fast::slerp(qa[i], qb[i], T(0.3)); });
+    check("slerp each", [&](auto & out) { fast::slerp(out, a, b, std::span<const T>{ weights }); },
+          [&](std::size_t i) { return fast::slerp(qa[i], qb[i], T(0.3)); });
+    check("normalize", [&](auto & out) { fast::normalize(out, a); },
+          [&](std::size_t i) { return qa[i]; });
+}
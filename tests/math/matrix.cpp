@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+
+#include "math/matrix.hpp"
+
+using namespace math;
+
+namespace
+{
+    template <typename T>
+    constexpr Matrix4x4<T> sample_matrix()
+    {
+        return Matrix4x4<T>{
+            Vector4<T>{ T{2}, T{0}, T{1}, T{0} },
+            Vector4<T>{ T{1}, T{3}, T{0}, T{-1} },
+            Vector4<T>{ T{0}, T{1}, T{4}, T{2} },
+            Vector4<T>{ T{5}, T{-2}, T{1}, T{1} }
+        };
+    }
+
+    template <typename T>
+    constexpr Matrix4x4<T> other_matrix()
+    {
+        return Matrix4x4<T>{
+            Vector4<T>{ T{1}, T{2}, T{3}, T{4} },
+            Vector4<T>{ T{0}, T{1}, T{0}, T{0} },
+            Vector4<T>{ T{-1}, T{0}, T{2}, T{1} },
+            Vector4<T>{ T{3}, T{0}, T{0}, T{1} }
+        };
+    }
+
+    template <typename T>
+    void ExpectMatrixNear(const Matrix4x4<T> & a, const Matrix4x4<T> & b, T tol)
+    {
+        for (std::size_t c = 0; c < 4; ++c)
+        {
+            for (std::size_t r = 0; r < 4; ++r)
+            {
+                EXPECT_NEAR(a[c][r], b[c][r], tol) << "c=" << c << " r=" << r;
+            }
+        }
+    }
+
+    // evaluated by the compiler, i.e. through the generic code rather than simd4
+    constexpr auto product_f = sample_matrix<float>() * other_matrix<float>();
+    constexpr auto product_d = sample_matrix<double>() * other_matrix<double>();
+    constexpr auto inverse_f = sample_matrix<float>().inverse();
+    constexpr auto inverse_d = sample_matrix<double>().inverse();
+}
+
+static_assert(sample_matrix<float>().transposed()[1][0] == 0.0f);
+static_assert(sample_matrix<float>().transposed()[0][1] == 1.0f);
+static_assert((sample_matrix<double>() * Vector4<double>{ 1.0, 0.0, 0.0, 0.0 })[2] == 1.0);
+static_assert(Matrix4x4<float>::identity().determinant() == 1.0f);
+static_assert(Vector4<float>{ 1, 2, 3, 4 }.dot(Vector4<float>{ 1, 1, 1, 1 }) == 10.0f);
+
+template <typename T>
+struct MatrixTypedTest : ::testing::Test {};
+
+using FloatTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(MatrixTypedTest, FloatTypes);
+
+TYPED_TEST(MatrixTypedTest, RuntimeMultiplyMatchesCompileTime)
+{
+    using T = TypeParam;
+    const auto & expected = []() -> const Matrix4x4<T> & {
+        if constexpr (std::is_same_v<T, float>) return product_f; else return product_d;
+    }();
+
+    auto a = sample_matrix<T>();
+    const auto b = other_matrix<T>();
+    ExpectMatrixNear(a * b, expected, T{0});
+
+    // column by column through matrix * vector
+    for (std::size_t c = 0; c < 4; ++c)
+    {
+        const auto column = a * b[c];
+        for (std::size_t r = 0; r < 4; ++r)
+        {
+            EXPECT_EQ(column[r], expected[c][r]) << c << r;
+        }
+    }
+}
+
+TYPED_TEST(MatrixTypedTest, TransposeSwapsRowsAndColumns)
+{
+    using T = TypeParam;
+    const auto m = sample_matrix<T>();
+    const auto t = m.transposed();
+    for (std::size_t c = 0; c < 4; ++c)
+    {
+        for (std::size_t r = 0; r < 4; ++r)
+        {
+            EXPECT_EQ(t[c][r], m[r][c]);
+        }
+    }
+}
+
+TYPED_TEST(MatrixTypedTest, InverseMatchesCompileTimeAndUndoesTheMatrix)
+{
+    using T = TypeParam;
+    const auto & expected = []() -> const Matrix4x4<T> & {
+        if constexpr (std::is_same_v<T, float>) return inverse_f; else return inverse_d;
+    }();
+
+    const auto m = sample_matrix<T>();
+    const auto inv = m.inverse();
+    ExpectMatrixNear(inv, expected, static_cast<T>(1e-5));
+    ExpectMatrixNear(m * inv, Matrix4x4<T>::identity(), static_cast<T>(1e-5));
+    ExpectMatrixNear(inv * m, Matrix4x4<T>::identity(), static_cast<T>(1e-5));
+    EXPECT_NEAR(m.determinant() * inv.determinant(), T{1}, static_cast<T>(1e-5));
+}
+
+TYPED_TEST(MatrixTypedTest, SingularMatricesInvertToZero)
+{
+    using T = TypeParam;
+    auto m = sample_matrix<T>();
+    m[3] = m[0] + m[1]; // dependent columns
+
+    const auto inv = m.inverse();
+    ExpectMatrixNear(inv, Matrix4x4<T>{ }, T{0});
+    EXPECT_NEAR(m.determinant(), T{0}, static_cast<T>(1e-5));
+}
+
+TYPED_TEST(MatrixTypedTest, SmallScalesStillInvert)
+{
+    using T = TypeParam;
+    // det 1e-6, far below epsilon, yet perfectly conditioned
+    auto m = Matrix4x4<T>::identity();
+    m[0][0] = m[1][1] = m[2][2] = static_cast<T>(0.01);
+
+    const auto inv = m.inverse();
+    ExpectMatrixNear(m * inv, Matrix4x4<T>::identity(), static_cast<T>(1e-5));
+    EXPECT_NEAR(inv[1][1], T{100}, static_cast<T>(1e-3));
+
+    // the same dependent columns as above, scaled down: still singular
+    auto singular = sample_matrix<T>() * static_cast<T>(0.001);
+    singular[3] = singular[0] + singular[1];
+    ExpectMatrixNear(singular.inverse(), Matrix4x4<T>{ }, T{0});
+}
+
+TYPED_TEST(MatrixTypedTest, VectorOperatorsMatchCompileTime)
+{
+    using T = TypeParam;
+    constexpr Vector4<T> a{ T{1}, T{-2}, T{3}, T{0.5} };
+    constexpr Vector4<T> b{ T{4}, T{5}, T{-6}, T{2} };
+    constexpr auto sum = a + b;
+    constexpr auto difference = a - b;
+    constexpr auto scaled = a * T{3};
+    constexpr auto dot = a.dot(b);
+
+    const auto ra = a;
+    const auto rb = b;
+    for (std::size_t i = 0; i < 4; ++i)
+    {
+        EXPECT_EQ((ra + rb)[i], sum[i]);
+        EXPECT_EQ((ra - rb)[i], difference[i]);
+        EXPECT_EQ((ra * T{3})[i], scaled[i]);
+    }
+    EXPECT_EQ(ra.dot(rb), dot);
+}
@@ -0,0 +1,44 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <vector>
+
+#include "math/parallel.hpp"
+
+using namespace math;
+
+TEST(ParallelForEachChunk, SpanChunksCoverEveryVector)
+{
+    ThreadPool pool(3);
+    std::vector<Vector3f> values(5000, Vector3f::one);
+
+    for_each_chunk(std::span<Vector3f>(values), [](std::span<Vector3f> chunk) {
+        for (auto & v : chunk)
+        {
+            v *= 2.0f;
+        }
+    }, 64, pool);
+
+    for (const auto & v : values)
+    {
+        EXPECT_EQ(v, Vector3f::fill(2.0f));
+    }
+}
+
+TEST(ParallelForEachChunk, ChunkSizesAreWholeCacheLines)
+{
+    ThreadPool pool(3);
+    std::vector<Vector3f> values(4096);
+    const auto base = values.data();
+    std::atomic<bool> aligned{ true };
+
+    // 12-byte vectors: 16 of them span exactly three cache lines
+    for_each_chunk(std::span<const Vector3f>(values), [&](std::span<const Vector3f> chunk) {
+        if ((chunk.data() - base) % 16 != 0)
+        {
+            aligned = false;
+        }
+    }, 1, pool);
+
+    EXPECT_TRUE(aligned.load());
+}
@@ -0,0 +1,248 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include "core/thread-pool.hpp"
+#include "math/spatial-grid.hpp"
+
+using namespace math;
+
+namespace
+{
+    constexpr std::size_t kCount = 2000;
+
+    VectorSOA<3, float> make_points(std::size_t count, std::vector<Handle> & handles, unsigned seed)
+    {
+        std::mt19937 rng{ seed };
+        std::uniform_real_distribution<float> coordinate{ -50.0f, 50.0f };
+        VectorSOA<3, float> points(count);
+        handles.clear();
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            handles.push_back(points.emplace(coordinate(rng), coordinate(rng), coordinate(rng)));
+        }
+        return points;
+    }
+
+    Vector3<float> at(const VectorSOA<3, float> & points, std::size_t i)
+    {
+        return Vector3<float>{ points.data(0)[i], points.data(1)[i], points.data(2)[i] };
+    }
+
+    // handle ids, sorted, for order-independent comparison
+    std::vector<uint32_t> ids(std::span<const Handle> handles)
+    {
+        std::vector<uint32_t> out;
+        for (const auto handle : handles)
+        {
+            out.push_back(handle.id);
+        }
+        std::sort(out.begin(), out.end());
+        return out;
+    }
+
+    std::vector<uint32_t> brute_radius(const VectorSOA<3, float> & points, const Vector3<float> & centre, float radius)
+    {
+        std::vector<Handle> out;
+        for (std::size_t i = 0; i < points.size(); ++i)
+        {
+            if ((at(points, i) - centre).squared_length() <= radius * radius)
+            {
+                out.push_back(points.handles().get_handle(static_cast<uint32_t>(i)));
+            }
+        }
+        return ids(out);
+    }
+
+    std::vector<uint32_t> brute_box(const VectorSOA<3, float> & points, const Vector3<float> & min, const Vector3<float> & max)
+    {
+        std::vector<Handle> out;
+        for (std::size_t i = 0; i < points.size(); ++i)
+        {
+            const auto p = at(points, i);
+            if (p[0] >= min[0] && p[1] >= min[1] && p[2] >= min[2] && p[0] <= max[0] && p[1] <= max[1] && p[2] <= max[2])
+            {
+                out.push_back(points.handles().get_handle(static_cast<uint32_t>(i)));
+            }
+        }
+        return ids(out);
+    }
+
+    std::vector<uint32_t> grid_radius(const SpatialHashGrid<float> & grid, const Vector3<float> & centre, float radius)
+    {
+        std::vector<Handle> out(kCount);
+        const auto found = grid.query_radius(centre, radius, out);
+        EXPECT_LE(found, out.size());
+        return ids(std::span<const Handle>(out.data(), found));
+    }
+
+    std::vector<uint32_t> grid_box(const SpatialHashGrid<float> & grid, const Vector3<float> & min, const Vector3<float> & max)
+    {
+        std::vector<Handle> out(kCount);
+        const auto found = grid.query_box(min, max, out);
+        EXPECT_LE(found, out.size());
+        return ids(std::span<const Handle>(out.data(), found));
+    }
+
+    void ExpectMatchesBruteForce(const SpatialHashGrid<float> & grid, const VectorSOA<3, float> & points)
+    {
+        std::mt19937 rng{ 99 };
+        std::uniform_real_distribution<float> coordinate{ -60.0f, 60.0f };
+        std::uniform_real_distribution<float> extent{ 0.0f, 12.0f };
+        for (int q = 0; q < 50; ++q)
+        {
+            const Vector3<float> centre{ coordinate(rng), coordinate(rng), coordinate(rng) };
+            const auto radius = extent(rng);
+            EXPECT_EQ(grid_radius(grid, centre, radius), brute_radius(points, centre, radius)) << "query " << q;
+
+            const Vector3<float> half{ extent(rng), extent(rng), extent(rng) };
+            EXPECT_EQ(grid_box(grid, centre - half, centre + half), brute_box(points, centre - half, centre + half)) << "query " << q;
+        }
+    }
+}
+
+TEST(SpatialHashGridTest, RebuildAnswersLikeABruteForceSweep)
+{
+    std::vector<Handle> handles;
+    const auto points = make_points(kCount, handles, 1);
+
+    SpatialHashGrid<float> grid{ 4.0f };
+    grid.rebuild(points);
+    EXPECT_EQ(grid.size(), kCount);
+    ExpectMatchesBruteForce(grid, points);
+
+    // a second rebuild reuses the storage and gives the same answers
+    ThreadPool pool{ 3 };
+    grid.rebuild(points, pool);
+    EXPECT_EQ(grid.size(), kCount);
+    ExpectMatchesBruteForce(grid, points);
+}
+
+TEST(SpatialHashGridTest, LargeCellsAndHugeQueriesStayCorrect)
+{
+    std::vector<Handle> handles;
+    const auto points = make_points(kCount, handles, 2);
+
+    // every point in a handful of cubes, and queries covering more cubes than there are points
+    SpatialHashGrid<float> coarse{ 64.0f };
+    coarse.rebuild(points);
+    ExpectMatchesBruteForce(coarse, points);
+
+    SpatialHashGrid<float> fine{ 0.25f };
+    fine.rebuild(points);
+    EXPECT_EQ(grid_radius(fine, Vector3<float>::zero, 1000.0f).size(), kCount);
+    EXPECT_EQ(grid_box(fine, Vector3<float>{ -1e30f, -1e30f, -1e30f }, Vector3<float>{ 1e30f, 1e30f, 1e30f }).size(), kCount);
+    EXPECT_TRUE(grid_radius(fine, Vector3<float>::zero, -1.0f).empty());
+    EXPECT_TRUE(grid_box(fine, Vector3<float>{ 1, 1, 1 }, Vector3<float>{ 0, 0, 0 }).empty());
+}
+
+TEST(SpatialHashGridTest, ReportsTheTotalWhenTheBufferIsTooSmall)
+{
+    std::vector<Handle> handles;
+    const auto points = make_points(kCount, handles, 3);
+    SpatialHashGrid<float> grid{ 4.0f };
+    grid.rebuild(points);
+
+    const auto expected = brute_radius(points, Vector3<float>::zero, 20.0f);
+    ASSERT_GT(expected.size(), 4u);
+
+    std::array<Handle, 4> out{ };
+    EXPECT_EQ(grid.query_radius(Vector3<float>::zero, 20.0f, out), expected.size());
+    for (const auto handle : out)
+    {
+        EXPECT_TRUE(std::binary_search(expected.begin(), expected.end(), handle.id));
+    }
+    EXPECT_EQ(grid.query_radius(Vector3<float>::zero, 20.0f, {}), expected.size());
+}
+
+TEST(SpatialHashGridTest, IncrementalInsertUpdateAndErase)
+{
+    std::vector<Handle> handles;
+    auto points = make_points(kCount, handles, 4);
+
+    SpatialHashGrid<float> grid{ 4.0f };
+    for (std::size_t i = 0; i < kCount; ++i)
+    {
+        EXPECT_TRUE(grid.insert(handles[i], at(points, i)));
+    }
+    EXPECT_FALSE(grid.insert(handles[0], Vector3<float>::zero)); // already present
+    EXPECT_FALSE(grid.insert(Handle{ }, Vector3<float>::zero));
+    ExpectMatchesBruteForce(grid, points);
+
+    // move every other point across the grid, in both containers
+    std::mt19937 rng{ 5 };
+    std::uniform_real_distribution<float> coordinate{ -50.0f, 50.0f };
+    for (std::size_t i = 0; i < kCount; i += 2)
+    {
+        const Vector3<float> p{ coordinate(rng), coordinate(rng), coordinate(rng) };
+        for (std::size_t c = 0; c < 3; ++c)
+        {
+            points.data(c)[i] = p[c];
+        }
+        EXPECT_TRUE(grid.update(handles[i], p));
+    }
+    ExpectMatchesBruteForce(grid, points);
+    EXPECT_EQ(*grid.position(handles[2]), at(points, 2));
+
+    // erase a third of them from both
+    for (std::size_t i = 0; i < kCount; i += 3)
+    {
+        EXPECT_TRUE(grid.erase(handles[i]));
+        EXPECT_FALSE(grid.erase(handles[i]));
+        points.erase(handles[i]);
+    }
+    EXPECT_EQ(grid.size(), points.size());
+    EXPECT_FALSE(grid.contains(handles[0]));
+    EXPECT_FALSE(grid.update(handles[0], Vector3<float>::zero));
+    EXPECT_EQ(grid.position(handles[0]), nullptr);
+    ExpectMatchesBruteForce(grid, points);
+}
+
+TEST(SpatialHashGridTest, UpdateSyncsWithTheContainer)
+{
+    std::vector<Handle> handles;
+    auto points = make_points(kCount, handles, 6);
+    SpatialHashGrid<float> grid{ 4.0f };
+    grid.rebuild(points);
+
+    // move all points a little (most stay in their cube), erase some, add some
+    for (std::size_t i = 0; i < points.size(); ++i)
+    {
+        points.data(0)[i] += 0.5f;
+        points.data(2)[i] -= 0.25f * static_cast<float>(i % 7);
+    }
+    for (std::size_t i = 0; i < kCount; i += 5)
+    {
+        points.erase(handles[i]);
+    }
+    std::vector<Handle> added;
+    for (int i = 0; i < 100; ++i)
+    {
+        added.push_back(points.emplace(static_cast<float>(i) - 50.0f, 1.0f, 2.0f));
+    }
+
+    ThreadPool pool{ 2 };
+    grid.update(points, pool);
+    EXPECT_EQ(grid.size(), points.size());
+    EXPECT_FALSE(grid.contains(handles[0]));
+    EXPECT_TRUE(grid.contains(added.back()));
+    ExpectMatchesBruteForce(grid, points);
+}
+
+TEST(SpatialHashGridTest, SkipsElementsWithoutHandles)
+{
+    VectorSOA<3, float> points(8);
+    const auto kept = points.emplace(1.0f, 1.0f, 1.0f);
+    points.resize(4); // three more elements with no handle, all at the origin
+
+    SpatialHashGrid<float> grid{ 1.0f };
+    grid.rebuild(points);
+    EXPECT_EQ(grid.size(), 1u);
+
+    std::array<Handle, 4> out{ };
+    ASSERT_EQ(grid.query_radius(Vector3<float>::zero, 2.0f, out), 1u);
+    EXPECT_EQ(out[0].id, kept.id);
+}
@@ -0,0 +1,315 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "math/geometric.hpp"
+#include "math/matrix.hpp"
+#include "math/vectors-soa-ops.hpp"
+
+using namespace math;
+
+namespace
+{
+    // Not a multiple of any SIMD width, so every kernel also runs its scalar tail.
+    constexpr std::size_t kCount = 37;
+
+    template <std::size_t N, typename T>
+    VectorSOA<N, T> make_soa(std::size_t count, T seed)
+    {
+        VectorSOA<N, T> out(count);
+        out.resize(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            for (std::size_t c = 0; c < N; ++c)
+            {
+                out.data(c)[i] = seed + static_cast<T>(i) * static_cast<T>(0.25) - static_cast<T>(c) * static_cast<T>(1.5);
+            }
+        }
+        return out;
+    }
+
+    template <std::size_t N, typename T>
+    void ExpectViewNear(const VectorSOA<N, T> & soa, std::size_t i, const Vector<N, T> & expected, T tol)
+    {
+        const auto actual = soa[i].as_vector();
+        for (std::size_t c = 0; c < N; ++c)
+        {
+            EXPECT_NEAR(actual[c], expected[c], tol) << "i=" << i << " c=" << c;
+        }
+    }
+}
+
+template <typename T>
+struct SoaOpsTypedTest : ::testing::Test {};
+
+using FloatTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(SoaOpsTypedTest, FloatTypes);
+
+template <typename T>
+constexpr T kTol()
+{
+    return epsilon_v<T> * T{16};
+}
+
+TYPED_TEST(SoaOpsTypedTest, AddSubMatchPerElementVectorMath)
+{
+    using T = TypeParam;
+    const auto a = make_soa<3, T>(kCount, T{1});
+    const auto b = make_soa<3, T>(kCount, T{-4});
+
+    VectorSOA<3, T> sum(kCount), diff(kCount);
+    sum.resize(kCount);
+    diff.resize(kCount);
+
+    soa::add(sum, a, b);
+    soa::sub(diff, a, b);
+
+    for (std::size_t i = 0; i < kCount; ++i)
+    {
+        ExpectViewNear(sum, i, a[i].as_vector() + b[i].as_vector(), kTol<T>());
+        ExpectViewNear(diff, i, a[i].as_vector() - b[i].as_vector(), kTol<T>());
+    }
+}
+
+TYPED_TEST(SoaOpsTypedTest, ScaleAndFmaMatchPerElementVectorMath)
+{
+    using T = TypeParam;
+    const auto a = make_soa<3, T>(kCount, T{2});
+    auto b = make_soa<3, T>(kCount, T{5});
+    const auto original = make_soa<3, T>(kCount, T{5});
+
+    VectorSOA<3, T> scaled(kCount);
+    scaled.resize(kCount);
+    soa::scale(scaled, a, T{3});
+
+    // in-place: b = a * 0.5 + b
+    soa::fma(b, a, T{0.5}, b);
+
+    for (std::size_t i = 0; i < kCount; ++i)
+    {
+        ExpectViewNear(scaled, i, a[i].as_vector() * T{3}, kTol<T>());
+        ExpectViewNear(b, i, a[i].as_vector() * T{0.5} + original[i].as_vector(), kTol<T>());
+    }
+}
+
+TYPED_TEST(SoaOpsTypedTest, DotSquaredLengthAndLength)
+{
+    using T = TypeParam;
+    const auto a = make_soa<4, T>(kCount, T{1});
+    const auto b = make_soa<4, T>(kCount, T{-2});
+
+    std::vector<T> dots(kCount), squared(kCount), lengths(kCount);
+    soa::dot(std::span<T>(dots), a, b);
+    soa::squared_length(std::span<T>(squared), a);
+    soa::length(std::span<T>(lengths), a);
+
+    for (std::size_t i = 0; i < kCount; ++i)
+    {
+        const auto va = a[i].as_vector();
+        const auto vb = b[i].as_vector();
+        const auto tol = kTol<T>() * std::max(T{1}, std::abs(va.dot(vb)));
+        EXPECT_NEAR(dots[i], va.dot(vb), tol) << "i=" << i;
+        EXPECT_NEAR(squared[i], va.squared_length(), kTol<T>() * va.squared_length()) << "i=" << i;
+        EXPECT_NEAR(lengths[i], va.length(), kTol<T>() * va.length()) << "i=" << i;
+    }
+}
+
+TYPED_TEST(SoaOpsTypedTest, NormalizeInPlaceKeepsNearZeroElements)
+{
+    using T = TypeParam;
+    auto a = make_soa<3, T>(kCount, T{1});
+    a[5].fill(T{0});
+    const auto src = make_soa<3, T>(kCount, T{1});
+
+    soa::normalize(a);
+
+    for (std::size_t i = 0; i < kCount; ++i)
+    {
+        if (i == 5)
+        {
+            ExpectViewNear(a, i, Vector<3, T>::zero, T{0});
+            continue;
+        }
+        ExpectViewNear(a, i, src[i].as_vector().normalized(), kTol<T>());
+    }
+}
+
+TYPED_TEST(SoaOpsTypedTest, CrossMatchesGeometricCross)
+{
+    using T = TypeParam;
+    const auto a = make_soa<3, T>(kCount, T{1});
+    const auto b = make_soa<3, T>(kCount, T{7});
+
+    VectorSOA<3, T> out(kCount);
+    out.resize(kCount);
+    soa::cross(out, a, b);
+
+    for (std::size_t i = 0; i < kCount; ++i)
+    {
+        const auto expected = cross(a[i].as_vector(), b[i].as_vector());
+        ExpectViewNear(out, i, expected, kTol<T>() * std::max(T{1}, expected.length()));
+    }
+}
+
+TYPED_TEST(SoaOpsTypedTest, TransformMatchesMatrixTimesVector)
+{
+    using T = TypeParam;
+    const Matrix4x4<T> m{
+        Vector4<T>{ T{1}, T{2}, T{0}, T{0} },
+        Vector4<T>{ T{0}, T{1}, T{3}, T{0} },
+        Vector4<T>{ T{4}, T{0}, T{1}, T{0} },
+        Vector4<T>{ T{5}, T{6}, T{7}, T{1} }
+    };
+
+    const auto points = make_soa<3, T>(kCount, T{1});
+    VectorSOA<3, T> transformed(kCount);
+    transformed.resize(kCount);
+    soa::transform(transformed, m, points);
+
+    const auto vectors = make_soa<4, T>(kCount, T{-1});
+    VectorSOA<4, T> transformed4(kCount);
+    transformed4.resize(kCount);
+    soa::transform(transformed4, m, vectors);
+
+    for (std::size_t i = 0; i < kCount; ++i)
+    {
+        const auto p = points[i].as_vector();
+        const auto hp = m * Vector4<T>{ p.x(), p.y(), p.z(), T{1} };
+        ExpectViewNear(transformed, i, Vector3<T>{ hp.x(), hp.y(), hp.z() }, kTol<T>() * hp.length());
+
+        const auto hv = m * vectors[i].as_vector();
+        ExpectViewNear(transformed4, i, hv, kTol<T>() * std::max(T{1}, hv.length()));
+    }
+}
+
+TYPED_TEST(SoaOpsTypedTest, StreamingAndInPlaceTransformsMatchCached)
+{
+    using T = TypeParam;
+    const Matrix4x4<T> m{
+        Vector4<T>{ T{0}, T{1}, T{0}, T{0} },
+        Vector4<T>{ T{-1}, T{0}, T{0}, T{0} },
+        Vector4<T>{ T{0}, T{0}, T{2}, T{0} },
+        Vector4<T>{ T{3}, T{-4}, T{5}, T{1} }
+    };
+
+    auto points = make_soa<3, T>(kCount, T{2});
+    VectorSOA<3, T> cached(kCount);
+    cached.resize(kCount);
+    VectorSOA<3, T> streamed(kCount);
+    streamed.resize(kCount);
+    soa::transform(cached, m, points);
+    soa::transform(streamed, m, points, soa::store_mode::streaming);
+    soa::transform(points, m, soa::store_mode::streaming);
+
+    for (std::size_t i = 0; i < kCount; ++i)
+    {
+        EXPECT_EQ(streamed[i].as_vector(), cached[i].as_vector()) << i;
+        EXPECT_EQ(points[i].as_vector(), cached[i].as_vector()) << i;
+    }
+}
+
+TYPED_TEST(SoaOpsTypedTest, RotateMatchesQuaternionRotate)
+{
+    using T = TypeParam;
+    // unit quaternions: 90 degrees about z, and an arbitrary axis
+    const auto h = static_cast<T>(std::sqrt(0.5));
+    const Quaternion<T> q{ T{0}, T{0}, h, h };
+
+    const auto points = make_soa<3, T>(kCount, T{1});
+    VectorSOA<3, T> rotated(kCount);
+    rotated.resize(kCount);
+    soa::rotate(rotated, q, points);
+
+    std::vector<Quaternion<T>> rotations;
+    for (std::size_t i = 0; i < kCount; ++i)
+    {
+        const auto angle = static_cast<T>(i) * static_cast<T>(0.3);
+        const auto s = std::sin(angle / 2);
+        const auto axis = Vector3<T>{ T{1}, T{2}, T{-2} } / T{3};
+        rotations.emplace_back(axis.x() * s, axis.y() * s, axis.z() * s, std::cos(angle / 2));
+    }
+    auto each = make_soa<3, T>(kCount, T{1});
+    soa::rotate(each, std::span<const Quaternion<T>>{ rotations }, soa::store_mode::streaming);
+
+    VectorSOA<4, T> lanes(kCount);
+    lanes.resize(kCount);
+    for (std::size_t i = 0; i < kCount; ++i)
+    {
+        lanes.data(0)[i] = rotations[i].x();
+        lanes.data(1)[i] = rotations[i].y();
+        lanes.data(2)[i] = rotations[i].z();
+        lanes.data(3)[i] = rotations[i].w();
+    }
+    VectorSOA<3, T> fromLanes(kCount);
+    fromLanes.resize(kCount);
+    soa::rotate(fromLanes, lanes, points);
+
+    for (std::size_t i = 0; i < kCount; ++i)
+    {
+        const auto p = points[i].as_vector();
+        const auto expected = math::rotate(p, q);
+        ExpectViewNear(rotated, i, expected, kTol<T>() * std::max(T{1}, expected.length()));
+
+        const auto expectedEach = math::rotate(p, rotations[i]);
+        ExpectViewNear(each, i, expectedEach, kTol<T>() * std::max(T{1}, expectedEach.length()));
+        EXPECT_EQ(fromLanes[i].as_vector(), each[i].as_vector()) << i;
+    }
+}
+
+TYPED_TEST(SoaOpsTypedTest, LargerOutputsKeepTheirElementsPastTheInput)
+{
+    using T = TypeParam;
+    constexpr std::size_t kInput = 3;
+    constexpr std::size_t kOutput = 20;
+    const auto a = make_soa<3, T>(kInput, T{1});
+    const auto b = make_soa<3, T>(kInput, T{-4});
+    const auto a4 = make_soa<4, T>(kInput, T{1});
+    const auto m = Matrix4x4<T>::identity() * T{2};
+    const Quaternion<T> q{ };
+    const std::vector<Quaternion<T>> rotations(kInput);
+    VectorSOA<4, T> q4(kInput);
+    q4.resize(kInput);
+    for (std::size_t i = 0; i < kInput; ++i)
+    {
+        q4.data(0)[i] = q4.data(1)[i] = q4.data(2)[i] = T{0};
+        q4.data(3)[i] = T{1};
+    }
+
+    const auto check = [&]<std::size_t N>(const char * op, auto run, std::integral_constant<std::size_t, N>)
+    {
+        auto out = make_soa<N, T>(kOutput, T{7});
+        const auto before = make_soa<N, T>(kOutput, T{7});
+        run(out);
+        EXPECT_EQ(out.size(), kOutput) << op;
+        for (std::size_t i = kInput; i < kOutput; ++i)
+        {
+            EXPECT_EQ(out[i].as_vector(), before[i].as_vector()) << op << " i=" << i;
+        }
+    };
+    using three = std::integral_constant<std::size_t, 3>;
+    using four = std::integral_constant<std::size_t, 4>;
+
+    check("add", [&](auto & out) { soa::add(out, a, b); }, three{ });
+    check("scale", [&](auto & out) { soa::scale(out, a, T{2}); }, three{ });
+    check("fma", [&](auto & out) { soa::fma(out, a, T{2}, b); }, three{ });
+    check("normalize", [&](auto & out) { soa::normalize(out, a); }, three{ });
+    check("cross", [&](auto & out) { soa::cross(out, a, b); }, three{ });
+    check("transform3", [&](auto & out) { soa::transform(out, m, a, soa::store_mode::streaming); }, three{ });
+    check("transform4", [&](auto & out) { soa::transform(out, m, a4); }, four{ });
+    check("rotate", [&](auto & out) { soa::rotate(out, q, a); }, three{ });
+    check("rotate each", [&](auto & out) { soa::rotate(out, std::span<const Quaternion<T>>{ rotations }, a); }, three{ });
+    check("rotate lanes", [&](auto & out) { soa::rotate(out, q4, a); }, three{ });
+
+    // and the live elements are still computed, tail included
+    auto sum = make_soa<3, T>(kOutput, T{7});
+    soa::add(sum, a, b);
+    auto transformed = make_soa<4, T>(kOutput, T{7});
+    soa::transform(transformed, m, a4);
+    for (std::size_t i = 0; i < kInput; ++i)
+    {
+        EXPECT_EQ(sum[i].as_vector(), a[i].as_vector() + b[i].as_vector()) << i;
+        EXPECT_EQ(transformed[i].as_vector(), m * a4[i].as_vector()) << i;
+    }
+}
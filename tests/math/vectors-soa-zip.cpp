@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+
+#include <iterator>
+#include <ranges>
+
+#include "math/vectors-soa-zip.hpp"
+
+using namespace math;
+
+static_assert(std::random_access_iterator<ZipView<VectorSOA<3, float>, const VectorSOA<3, float>>::iterator>);
+static_assert(std::ranges::view<ZipView<VectorSOA<3, float>, VectorSOA<2, int>>>);
+static_assert(std::ranges::sized_range<ZipView<VectorSOA<3, float>>>);
+
+TEST(ZipView, WalksContainersInLockstep)
+{
+    VectorSOA<3, float> positions;
+    VectorSOA<3, float> velocities;
+    for (int i = 0; i < 8; ++i)
+    {
+        positions.emplace(static_cast<float>(i), 0.0f, 0.0f);
+        velocities.emplace(1.0f, 2.0f, 3.0f);
+    }
+
+    const auto & cvelocities = velocities;
+    for (auto [p, v] : zip(positions, cvelocities))
+    {
+        for (std::size_t c = 0; c < 3; ++c)
+        {
+            p[c] += v[c] * 0.5f;
+        }
+    }
+
+    for (std::size_t i = 0; i < positions.size(); ++i)
+    {
+        EXPECT_EQ(positions[i].as_vector(), (Vector3f{ static_cast<float>(i) + 0.5f, 1.0f, 1.5f }));
+    }
+}
+
+TEST(ZipView, LengthIsTheShortestContainer)
+{
+    VectorSOA<3, float> a;
+    VectorSOA<2, int> b;
+    for (int i = 0; i < 5; ++i)
+    {
+        a.emplace(0.0f, 0.0f, 0.0f);
+    }
+    for (int i = 0; i < 3; ++i)
+    {
+        b.emplace(i, i);
+    }
+
+    auto zipped = zip(a, b);
+    EXPECT_EQ(zipped.size(), 3u);
+    EXPECT_EQ(std::ranges::distance(zipped), 3);
+
+    // random access into the middle, as a chunked scheduler would
+    auto [va, vb] = zipped[2];
+    EXPECT_EQ(vb[0], 2);
+    va.fill(9.0f);
+    EXPECT_EQ(a[2].x(), 9.0f);
+}
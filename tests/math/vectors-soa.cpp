@@ -0,0 +1,355 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <atomic>
+#include <cstddef>
+#include <ranges>
+#include <span>
+#include <vector>
+
+#include "math/vectors-soa.hpp"
+
+using namespace math;
+
+namespace
+{
+    struct AllocationStats
+    {
+        std::size_t allocations{ 0 };
+        std::size_t deallocations{ 0 };
+        std::size_t live_elements{ 0 };
+    };
+
+    // Aligned allocator that records every call into a shared counter.
+    template <typename T>
+    struct CountingAllocator
+    {
+        using value_type = T;
+
+        AllocationStats * stats;
+
+        explicit CountingAllocator(AllocationStats * s) noexcept : stats(s) {}
+
+        template <typename U>
+        CountingAllocator(const CountingAllocator<U> & other) noexcept : stats(other.stats) {}
+
+        T* allocate(std::size_t n)
+        {
+            ++stats->allocations;
+            stats->live_elements += n;
+            return AlignedAllocator<T, 64>{}.allocate(n);
+        }
+
+        void deallocate(T* ptr, std::size_t n) noexcept
+        {
+            ++stats->deallocations;
+            stats->live_elements -= n;
+            AlignedAllocator<T, 64>{}.deallocate(ptr, n);
+        }
+
+        template <typename U>
+        bool operator==(const CountingAllocator<U> & other) const noexcept { return stats == other.stats; }
+    };
+
+    bool is_aligned(const void * ptr, std::size_t alignment)
+    {
+        return reinterpret_cast<std::uintptr_t>(ptr) % alignment == 0;
+    }
+}
+
+TEST(VectorSOA, LanesAreCacheLineAlignedAndPadded)
+{
+    using Soa = VectorSOA<3, float>;
+    Soa soa(5);
+
+    EXPECT_EQ(soa.capacity() % Soa::lane_multiple, 0u);
+    EXPECT_GE(soa.capacity(), 5u);
+    for (std::size_t c = 0; c < 3; ++c)
+    {
+        EXPECT_TRUE(is_aligned(soa.data(c), 64)) << "c=" << c;
+    }
+
+    // lanes are carved back to back from one block
+    EXPECT_EQ(soa.data(1) - soa.data(0), static_cast<std::ptrdiff_t>(soa.capacity()));
+    EXPECT_EQ(soa.data(2) - soa.data(1), static_cast<std::ptrdiff_t>(soa.capacity()));
+}
+
+TEST(VectorSOA, PaddedSizeRoundsUpToLaneMultiple)
+{
+    VectorSOA<2, double> soa;
+    constexpr auto multiple = VectorSOA<2, double>::lane_multiple;
+
+    EXPECT_EQ(soa.padded_size(), 0u);
+
+    soa.resize(1);
+    EXPECT_EQ(soa.padded_size(), multiple);
+
+    soa.resize(multiple + 1);
+    EXPECT_EQ(soa.padded_size(), 2 * multiple);
+    EXPECT_LE(soa.padded_size(), soa.capacity());
+}
+
+TEST(VectorSOA, GrowthUsesOneAllocationAndKeepsContents)
+{
+    AllocationStats stats;
+    {
+        VectorSOA<3, float, CountingAllocator<float>> soa{ CountingAllocator<float>{ &stats } };
+        soa.resize(10);
+        for (std::size_t i = 0; i < 10; ++i)
+        {
+            soa[i].fill(static_cast<float>(i));
+        }
+        EXPECT_EQ(stats.allocations, 1u);
+
+        soa.reserve(1000);
+        EXPECT_EQ(stats.allocations, 2u);
+        EXPECT_EQ(stats.deallocations, 1u);
+        EXPECT_EQ(stats.live_elements, soa.capacity() * 3);
+
+        for (std::size_t i = 0; i < 10; ++i)
+        {
+            for (std::size_t c = 0; c < 3; ++c)
+            {
+                EXPECT_EQ(soa[i][c], static_cast<float>(i));
+            }
+        }
+
+        // padding past size() is zero-initialized
+        for (std::size_t i = 10; i < soa.padded_size(); ++i)
+        {
+            EXPECT_EQ(soa.data(0)[i], 0.0f);
+        }
+    }
+    EXPECT_EQ(stats.allocations, stats.deallocations);
+    EXPECT_EQ(stats.live_elements, 0u);
+}
+
+TEST(VectorSOA, ShrinkToFitReleasesUnusedLanes)
+{
+    using Soa = VectorSOA<3, float>;
+    Soa soa(1000);
+    soa.resize(3);
+    soa[2].fill(7.0f);
+
+    soa.shrink_to_fit();
+    EXPECT_EQ(soa.capacity(), Soa::lane_multiple);
+    EXPECT_EQ(soa.size(), 3u);
+    EXPECT_EQ(soa[2].as_vector(), Vector3f::fill(7.0f));
+}
+
+TEST(VectorSOA, MoveTransfersStorage)
+{
+    VectorSOA<3, float> a(16);
+    a.resize(4);
+    const float * lane = a.data(0);
+
+    VectorSOA<3, float> b(std::move(a));
+    EXPECT_EQ(b.data(0), lane);
+    EXPECT_EQ(b.size(), 4u);
+    EXPECT_EQ(a.size(), 0u);
+    EXPECT_EQ(a.capacity(), 0u);
+
+    VectorSOA<3, float> c;
+    c = std::move(b);
+    EXPECT_EQ(c.data(0), lane);
+    EXPECT_EQ(b.capacity(), 0u);
+}
+
+// --- Handle-based storage ---
+
+TEST(VectorSOA, EmplaceWritesComponentsAndReturnsValidHandle)
+{
+    VectorSOA<3, float> soa;
+    const Handle a = soa.emplace(1.0f, 2.0f, 3.0f);
+    const Handle b = soa.emplace(4, 5, 6);
+
+    ASSERT_TRUE(soa.contains(a));
+    ASSERT_TRUE(soa.contains(b));
+    EXPECT_EQ(soa.size(), 2u);
+    EXPECT_EQ(soa[soa.handles().get_index(a)].as_vector(), (Vector3f{ 1.0f, 2.0f, 3.0f }));
+    EXPECT_EQ(soa[soa.handles().get_index(b)].as_vector(), (Vector3f{ 4.0f, 5.0f, 6.0f }));
+}
+
+TEST(VectorSOA, EraseSwapsLastIntoHoleAndRetargetsItsHandle)
+{
+    VectorSOA<2, int> soa;
+    const Handle a = soa.emplace(1, 1);
+    const Handle b = soa.emplace(2, 2);
+    const Handle c = soa.emplace(3, 3);
+
+    EXPECT_TRUE(soa.erase(a));
+    EXPECT_FALSE(soa.contains(a));
+    EXPECT_FALSE(soa.erase(a));
+    EXPECT_EQ(soa.size(), 2u);
+
+    // c was last and now lives at a's old index
+    EXPECT_EQ(soa.handles().get_index(c), 0u);
+    EXPECT_EQ(soa[0][0], 3);
+    EXPECT_EQ(soa.handles().get_index(b), 1u);
+    EXPECT_EQ(soa[1][0], 2);
+
+    EXPECT_TRUE(soa.erase(b));
+    EXPECT_TRUE(soa.erase(c));
+    EXPECT_TRUE(soa.empty());
+}
+
+TEST(VectorSOA, EmplaceNCopiesSpansAndFillsHandles)
+{
+    VectorSOA<3, float> soa;
+    soa.emplace(0.0f, 0.0f, 0.0f);
+
+    const std::vector<float> xs{ 1, 2, 3, 4 };
+    const std::vector<float> ys{ 10, 20, 30, 40 };
+    const std::vector<float> zs{ 100, 200, 300, 400 };
+    std::array<Handle, 4> handles{};
+
+    soa.emplace_n(std::span<Handle>(handles), xs, ys, zs);
+
+    ASSERT_EQ(soa.size(), 5u);
+    for (std::size_t i = 0; i < handles.size(); ++i)
+    {
+        ASSERT_TRUE(soa.contains(handles[i]));
+        const auto index = soa.handles().get_index(handles[i]);
+        EXPECT_EQ(index, i + 1);
+        EXPECT_EQ(soa[index].as_vector(), (Vector3f{ xs[i], ys[i], zs[i] }));
+    }
+}
+
+TEST(VectorSOA, EraseManyCompactsAndKeepsSurvivorHandlesStable)
+{
+    constexpr std::size_t count = 64;
+    VectorSOA<2, int> soa;
+    std::vector<Handle> handles;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        handles.push_back(soa.emplace(static_cast<int>(i), -static_cast<int>(i)));
+    }
+
+    // erase every third element, plus a duplicate and an invalid handle
+    std::vector<Handle> doomed;
+    for (std::size_t i = 0; i < count; i += 3)
+    {
+        doomed.push_back(handles[i]);
+    }
+    doomed.push_back(handles[0]);
+    doomed.push_back(Handle{});
+
+    const auto erased = soa.erase_many(doomed);
+    EXPECT_EQ(erased, (count + 2) / 3);
+    EXPECT_EQ(soa.size(), count - erased);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if (i % 3 == 0)
+        {
+            EXPECT_FALSE(soa.contains(handles[i])) << "i=" << i;
+            continue;
+        }
+
+        ASSERT_TRUE(soa.contains(handles[i])) << "i=" << i;
+        const auto index = soa.handles().get_index(handles[i]);
+        ASSERT_LT(index, soa.size());
+        EXPECT_EQ(soa[index][0], static_cast<int>(i));
+        EXPECT_EQ(soa[index][1], -static_cast<int>(i));
+    }
+}
+
+TEST(VectorSOA, ClearReleasesHandles)
+{
+    VectorSOA<3, float> soa;
+    const Handle a = soa.emplace(1.0f, 2.0f, 3.0f);
+    soa.clear();
+
+    EXPECT_FALSE(soa.contains(a));
+    const Handle b = soa.emplace(4.0f, 5.0f, 6.0f);
+    EXPECT_TRUE(soa.contains(b));
+    EXPECT_EQ(soa.handles().get_index(b), 0u);
+}
+
+// --- Iterators & ranges ---
+
+static_assert(std::random_access_iterator<VectorSOA<3, float>::iterator>);
+static_assert(std::random_access_iterator<VectorSOA<3, float>::const_iterator>);
+static_assert(std::ranges::random_access_range<VectorSOA<3, float>>);
+static_assert(std::ranges::sized_range<VectorSOA<3, float>>);
+static_assert(std::ranges::view<decltype(std::declval<VectorSOA<3, float>&>().view())>);
+static_assert(std::is_convertible_v<VectorSOA<3, float>::iterator, VectorSOA<3, float>::const_iterator>);
+
+// parallel STL algorithms dispatch on the legacy category
+static_assert(std::is_same_v<std::iterator_traits<VectorSOA<3, float>::iterator>::iterator_category, std::random_access_iterator_tag>);
+
+TEST(VectorSOA, IteratorsVisitEveryElementInIndexOrder)
+{
+    VectorSOA<2, int> soa;
+    for (int i = 0; i < 10; ++i)
+    {
+        soa.emplace(i, 10 * i);
+    }
+
+    int expected = 0;
+    for (auto v : soa)
+    {
+        EXPECT_EQ(v[0], expected);
+        EXPECT_EQ(v[1], 10 * expected);
+        ++expected;
+    }
+    EXPECT_EQ(expected, 10);
+
+    auto it = soa.begin();
+    EXPECT_EQ((*(it + 4))[0], 4);
+    EXPECT_EQ(it[7][1], 70);
+    EXPECT_EQ(soa.end() - soa.begin(), 10);
+    EXPECT_LT(it, soa.end());
+}
+
+TEST(VectorSOA, RangesAlgorithmsWriteThroughViews)
+{
+    VectorSOA<3, float> soa;
+    for (int i = 0; i < 5; ++i)
+    {
+        soa.emplace(1.0f, 2.0f, 3.0f);
+    }
+
+    std::ranges::for_each(soa.view() | std::views::drop(2), [](auto v) { v.multiply(2.0f); });
+
+    const auto & csoa = soa;
+    std::vector<float> xs;
+    for (auto v : csoa.view())
+    {
+        static_assert(std::is_same_v<decltype(v), ConstVectorView<3, float>>);
+        xs.push_back(v.x());
+    }
+    EXPECT_EQ(xs, (std::vector<float>{ 1.0f, 1.0f, 2.0f, 2.0f, 2.0f }));
+}
+
+// --- Parallel passes ---
+
+TEST(VectorSOA, ForEachChunkHandsOutLaneAlignedRanges)
+{
+    using Soa = VectorSOA<3, float>;
+    ThreadPool pool(3);
+
+    Soa soa;
+    for (int i = 0; i < 10000; ++i)
+    {
+        soa.emplace(static_cast<float>(i), 1.0f, 0.0f);
+    }
+
+    std::atomic<bool> aligned{ true };
+    soa.for_each_chunk([&](std::size_t begin, std::size_t end) {
+        if (begin % Soa::lane_multiple != 0)
+        {
+            aligned = false;
+        }
+        for (auto i = begin; i < end; ++i)
+        {
+            soa.data(2)[i] = soa.data(0)[i] + soa.data(1)[i];
+        }
+    }, 256, pool);
+
+    EXPECT_TRUE(aligned.load());
+    for (std::size_t i = 0; i < soa.size(); ++i)
+    {
+        ASSERT_EQ(soa[i].z(), static_cast<float>(i) + 1.0f);
+    }
+}
@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "io/binary-value.hpp"
+#include "io/json.hpp"
+#include "math/vectors-value.hpp"
+
+using namespace math;
+
+TEST(VectorsValue, VectorsRoundTrip)
+{
+    const auto value = to_value(Vector3f{ 1.0f, -2.0f, 0.5f });
+    ASSERT_TRUE(value.is<std::vector<float>>());
+    EXPECT_EQ(value.as<std::vector<float>>(), (std::vector<float>{ 1.0f, -2.0f, 0.5f }));
+
+    Vector3f out;
+    ASSERT_TRUE(from_value(value, out));
+    EXPECT_EQ(out, (Vector3f{ 1.0f, -2.0f, 0.5f }));
+
+    // wrong length or item type leaves the vector alone
+    Vector<2, float> shorter{ 7.0f, 7.0f };
+    EXPECT_FALSE(from_value(value, shorter));
+    EXPECT_EQ(shorter, (Vector<2, float>{ 7.0f, 7.0f }));
+    Vector<3, double> wider;
+    EXPECT_FALSE(from_value(value, wider));
+}
+
+TEST(VectorsValue, ColumnsRoundTripThroughJsonAndBinary)
+{
+    VectorSOA<3, float> positions;
+    for (int i = 0; i < 100; ++i)
+    {
+        positions.emplace(static_cast<float>(i), static_cast<float>(i) * 0.5f, -static_cast<float>(i));
+    }
+
+    const auto columns = columns_to_value(positions);
+    ASSERT_EQ(columns.as<Value::array_t>().size(), 3u);
+    EXPECT_EQ(columns.as<Value::array_t>()[1].as<std::vector<float>>()[10], 5.0f);
+
+    std::vector<char> bytes;
+    ASSERT_TRUE(BinaryDocument::encode(columns, bytes));
+    BinaryDocument document;
+    ASSERT_TRUE(document.open(bytes));
+    EXPECT_EQ(document.root()[2].items<float>()[99], -99.0f);
+
+    const auto parsed = JsonParser{}.parse(columns.toString());
+    VectorSOA<3, float> restored;
+    ASSERT_TRUE(columns_from_value(parsed, restored));
+    ASSERT_EQ(restored.size(), positions.size());
+    for (std::size_t i = 0; i < positions.size(); ++i)
+    {
+        EXPECT_EQ(restored[i].as_vector(), positions[i].as_vector());
+    }
+}
+
+TEST(VectorsValue, SingleColumnsMustMatchTheSize)
+{
+    VectorSOA<2, double> soa;
+    soa.emplace(1.0, 2.0);
+    soa.emplace(3.0, 4.0);
+
+    EXPECT_EQ(column_to_value(soa, 1).as<std::vector<double>>(), (std::vector<double>{ 2.0, 4.0 }));
+
+    ASSERT_TRUE(column_from_value(soa, 0, Value{ std::vector<double>{ 9.0, 8.0 } }));
+    EXPECT_EQ(soa[1].as_vector(), (Vector<2, double>{ 8.0, 4.0 }));
+
+    EXPECT_FALSE(column_from_value(soa, 0, Value{ std::vector<double>{ 1.0 } }));
+    EXPECT_FALSE(column_from_value(soa, 0, Value{ std::vector<float>{ 1.0f, 2.0f } }));
+    EXPECT_EQ(soa[0].as_vector(), (Vector<2, double>{ 9.0, 2.0 }));
+
+    // ragged columns are rejected before anything is resized
+    const auto ragged = Value{ Value::array_t{ Value{ std::vector<double>{ 1.0 } }, Value{ std::vector<double>{ } } } };
+    EXPECT_FALSE(columns_from_value(ragged, soa));
+    EXPECT_EQ(soa.size(), 2u);
+}
@@ -86,12 +86,13 @@ namespace math::tests
 #ifndef NDEBUG
     TEST(VectorView, ConstructorRejectsNullPointer_DebugDeathTest)
     {
+        using View3i = VectorView<3, int>;
         int a = 1, b = 2;
 
         // Pack constructor uses assert_non_null_pack_
         EXPECT_DEATH(
             {
-                VectorView<3, int> v(&a, &b, nullptr);
+                View3i v(&a, &b, static_cast<int*>(nullptr));
                 (void)v;
             },
             "null pointer"
@@ -101,7 +102,7 @@ namespace math::tests
         std::array<int*, 3> ptrs{&a, &b, nullptr};
         EXPECT_DEATH(
             {
-                VectorView<3, int> v(ptrs);
+                View3i v(ptrs);
                 (void)v;
             },
             "null pointer"